@@ -0,0 +1,33 @@
+# Copyright (c) Facebook, Inc. and its affiliates.
+# - Try to find liburing
+# Once done, this will define
+#
+# URING_FOUND - system has liburing
+# uring::uring will be defined based on CMAKE_FIND_LIBRARY_SUFFIXES priority
+
+include(FindPackageHandleStandardArgs)
+
+find_library(URING_LIBRARY uring PATHS ${URING_LIBRARYDIR})
+
+find_path(URING_INCLUDE_DIR liburing.h PATHS ${URING_INCLUDEDIR})
+
+find_package_handle_standard_args(uring DEFAULT_MSG URING_LIBRARY
+                                  URING_INCLUDE_DIR)
+
+mark_as_advanced(URING_LIBRARY URING_INCLUDE_DIR)
+
+get_filename_component(liburing_ext ${URING_LIBRARY} EXT)
+if(liburing_ext STREQUAL ".a")
+  set(liburing_type STATIC)
+else()
+  set(liburing_type SHARED)
+endif()
+
+if(NOT TARGET uring::uring)
+  add_library(uring::uring ${liburing_type} IMPORTED)
+  set_target_properties(uring::uring PROPERTIES INTERFACE_INCLUDE_DIRECTORIES
+                                                "${URING_INCLUDE_DIR}")
+  set_target_properties(
+    uring::uring PROPERTIES IMPORTED_LINK_INTERFACE_LANGUAGES "C"
+                            IMPORTED_LOCATION "${URING_LIBRARY}")
+endif()
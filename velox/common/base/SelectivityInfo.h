@@ -24,6 +24,11 @@ namespace velox {
 
 class SelectivityInfo {
  public:
+  SelectivityInfo() = default;
+
+  SelectivityInfo(uint64_t numIn, uint64_t numOut, uint64_t timeClocks)
+      : numIn_(numIn), numOut_(numOut), timeClocks_(timeClocks) {}
+
   void addOutput(uint64_t numOut) {
     numOut_ += numOut;
   }
@@ -47,6 +52,25 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  uint64_t timeClocks() const {
+    return timeClocks_;
+  }
+
+  SelectivityInfo& operator+=(const SelectivityInfo& other) {
+    numIn_ += other.numIn_;
+    numOut_ += other.numOut_;
+    timeClocks_ += other.timeClocks_;
+    return *this;
+  }
+
+  /// Returns the counts added since 'this' was 'other'.
+  SelectivityInfo operator-(const SelectivityInfo& other) const {
+    return SelectivityInfo(
+        numIn_ - other.numIn_,
+        numOut_ - other.numOut_,
+        timeClocks_ - other.timeClocks_);
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -76,7 +76,8 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
 
   auto* ssdCache = shard_->cache()->ssdCache();
   if ((ssdCache != nullptr) && (ssdFile_ == nullptr)) {
-    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
+    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_) &&
+        shard_->admitToSsd(key_)) {
       ssdSaveable_ = true;
       shard_->cache()->possibleSsdSave(size_);
     }
@@ -151,6 +152,21 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+CacheShard::CacheShard(
+    AsyncDataCache* cache,
+    double maxWriteRatio,
+    uint64_t admissionSketchWidth,
+    uint64_t admissionAgingWindow,
+    int32_t ssdAdmissionMinFrequency)
+    : cache_(cache),
+      maxWriteRatio_(maxWriteRatio),
+      ssdAdmissionMinFrequency_(ssdAdmissionMinFrequency) {
+  if (admissionSketchWidth > 0) {
+    admissionSketch_ = std::make_unique<FrequencySketch>(
+        admissionSketchWidth, admissionAgingWindow);
+  }
+}
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
   if (freeEntries_.empty()) {
@@ -170,6 +186,10 @@ CachePin CacheShard::findOrCreate(
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
+    const auto hash = std::hash<RawFileCacheKey>()(key);
+    if (admissionSketch_ != nullptr) {
+      admissionSketch_->increment(hash);
+    }
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* foundEntry = it->second;
@@ -208,14 +228,28 @@ CachePin CacheShard::findOrCreate(
       // retain a valid read pin.
       RECORD_METRIC_VALUE(kMetricMemoryCacheNumStaleEntries);
       ++numStales_;
+      decrementFileBytesLocked(key.fileNum, foundEntry->size());
       foundEntry->key_.fileNum.clear();
       entryMap_.erase(it);
     }
 
+    // Decided before the new entry is added so that it is not its own victim.
+    const bool admit = admissionSketch_ == nullptr || admitLocked(hash);
     auto newEntry = getFreeEntry();
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
     newEntry->promise_ = nullptr;
+    if (admissionSketch_ != nullptr) {
+      // The reader needs the entry either way. A rejected entry is the first
+      // to evict unless it is hit before. Recycled entries keep the access
+      // stats of their previous key, so admitted entries start afresh.
+      if (admit) {
+        newEntry->accessStats_.reset();
+      } else {
+        newEntry->makeEvictable();
+        ++numAdmissionRejects_;
+      }
+    }
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
@@ -229,6 +263,7 @@ CachePin CacheShard::findOrCreate(
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
+    incrementFileBytesLocked(key.fileNum, size);
     entryToInit->isFirstUse_ = true;
   }
   return initEntry(key, entryToInit);
@@ -253,6 +288,86 @@ bool CacheShard::exists(RawFileCacheKey key) const {
   return false;
 }
 
+uint64_t CacheShard::fileBytes(uint64_t fileNum) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto it = fileBytes_.find(fileNum);
+  return it == fileBytes_.end() ? 0 : it->second;
+}
+
+void CacheShard::addFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& [fileNum, bytes] : fileBytes_) {
+    fileBytes[fileNum] += bytes;
+  }
+}
+
+void CacheShard::incrementFileBytesLocked(uint64_t fileNum, uint64_t bytes) {
+  fileBytes_[fileNum] += bytes;
+}
+
+void CacheShard::decrementFileBytesLocked(uint64_t fileNum, uint64_t bytes) {
+  auto it = fileBytes_.find(fileNum);
+  VELOX_CHECK(it != fileBytes_.end());
+  VELOX_CHECK_GE(it->second, bytes);
+  it->second -= bytes;
+  if (it->second == 0) {
+    fileBytes_.erase(it);
+  }
+}
+
+bool CacheShard::admitToSsd(const FileCacheKey& key) {
+  if (admissionSketch_ == nullptr) {
+    return true;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  // A rejected entry becomes admissible once accessed again after its
+  // eviction.
+  const auto hash = std::hash<RawFileCacheKey>()(
+      RawFileCacheKey{key.fileNum.id(), key.offset});
+  if (admissionSketch_->estimate(hash) >= ssdAdmissionMinFrequency_) {
+    return true;
+  }
+  ++numSsdAdmissionRejects_;
+  return false;
+}
+
+bool CacheShard::admitLocked(uint64_t hash) {
+  // Nothing is evicted before the cache first fills up.
+  if (evictionThreshold_ == kNoThreshold || entries_.empty()) {
+    return true;
+  }
+  // The victim is the worst scored evictable entry after the clock hand.
+  const auto now = accessTime();
+  const AsyncDataCacheEntry* victim = nullptr;
+  int32_t victimScore = 0;
+  const auto numSamples =
+      std::min<size_t>(kNumAdmissionSamples, entries_.size());
+  auto entryIndex = clockHand_ % entries_.size();
+  for (size_t i = 0; i < numSamples; ++i) {
+    const auto* candidate = entries_[entryIndex].get();
+    if (++entryIndex == entries_.size()) {
+      entryIndex = 0;
+    }
+    if (candidate == nullptr || candidate->numPins_ != 0 ||
+        !candidate->key_.fileNum.hasValue()) {
+      continue;
+    }
+    const auto score = candidate->score(now);
+    if (victim == nullptr || score > victimScore) {
+      victim = candidate;
+      victimScore = score;
+    }
+  }
+  if (victim == nullptr) {
+    return true;
+  }
+  const auto victimHash = std::hash<RawFileCacheKey>()(
+      RawFileCacheKey{victim->key_.fileNum.id(), victim->key_.offset});
+  return admissionSketch_->estimate(hash) >
+      admissionSketch_->estimate(victimHash);
+}
+
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
     AsyncDataCacheEntry* entry) {
@@ -345,6 +460,7 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
         RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
     VELOX_CHECK(it != entryMap_.end());
     entryMap_.erase(it);
+    decrementFileBytesLocked(entry->key_.fileNum.id(), entry->size_);
     entry->key_.fileNum.clear();
   }
   entry->setSsdFile(nullptr, 0);
@@ -438,8 +554,8 @@ uint64_t CacheShard::evict(
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
-        candidate->size_ = 0;
 
+        // Resets the size after removing it from the file bytes.
         removeEntryLocked(candidate);
         emptySlots_.push_back(entryIndex);
         tryAddFreeEntry(std::move(*iter));
@@ -553,6 +669,8 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numAgedOut += numAgedOut_;
   stats.numStales += numStales_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numAdmissionRejects += numAdmissionRejects_;
+  stats.numSsdAdmissionRejects += numSsdAdmissionRejects_;
   stats.allocClocks += allocClocks_;
 }
 
@@ -643,6 +761,9 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
   result.numStales = numStales - other.numStales;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numAdmissionRejects = numAdmissionRejects - other.numAdmissionRejects;
+  result.numSsdAdmissionRejects =
+      numSsdAdmissionRejects - other.numSsdAdmissionRejects;
   if (ssdStats != nullptr) {
     if (other.ssdStats != nullptr) {
       result.ssdStats =
@@ -651,6 +772,8 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
       result.ssdStats = std::make_shared<SsdCacheStats>(*ssdStats);
     }
   }
+  // The file metadata stats are reported as a snapshot.
+  result.fileMetadataStats = fileMetadataStats;
   return result;
 }
 
@@ -668,7 +791,16 @@ AsyncDataCache::AsyncDataCache(
       ssdCache_(std::move(ssdCache)),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this,
+        opts_.maxWriteRatio,
+        opts_.admissionSketchWidth,
+        opts_.admissionAgingWindow,
+        opts_.ssdAdmissionMinFrequency));
+  }
+  if (opts_.maxFileMetadataBytes > 0) {
+    fileMetadataCache_ =
+        std::make_unique<FileMetadataCache>(opts_.maxFileMetadataBytes);
   }
 }
 
@@ -713,6 +845,7 @@ void AsyncDataCache::shutdown() {
 void CacheShard::shutdown() {
   entries_.clear();
   freeEntries_.clear();
+  fileBytes_.clear();
 }
 
 CachePin AsyncDataCache::findOrCreate(
@@ -723,6 +856,71 @@ CachePin AsyncDataCache::findOrCreate(
   return shards_[shard]->findOrCreate(key, size, wait);
 }
 
+CacheResidency AsyncDataCache::fileResidency(uint64_t fileNum) const {
+  CacheResidency residency;
+  for (const auto& shard : shards_) {
+    residency.memoryBytes += shard->fileBytes(fileNum);
+  }
+  if (ssdCache_ != nullptr) {
+    residency.ssdBytes = ssdCache_->fileBytes(fileNum);
+  }
+  return residency;
+}
+
+std::vector<FileCacheResidency> AsyncDataCache::residencySummary(
+    int32_t maxFiles) const {
+  VELOX_CHECK_GE(maxFiles, 0);
+  folly::F14FastMap<uint64_t, uint64_t> memoryBytes;
+  for (const auto& shard : shards_) {
+    shard->addFileBytes(memoryBytes);
+  }
+  folly::F14FastMap<uint64_t, uint64_t> ssdBytes;
+  if (ssdCache_ != nullptr) {
+    ssdCache_->addFileBytes(ssdBytes);
+  }
+
+  std::vector<std::pair<uint64_t, CacheResidency>> files;
+  files.reserve(std::max(memoryBytes.size(), ssdBytes.size()));
+  for (const auto& [fileNum, bytes] : memoryBytes) {
+    const auto it = ssdBytes.find(fileNum);
+    files.push_back(
+        {fileNum, {bytes, it == ssdBytes.end() ? 0 : it->second}});
+  }
+  for (const auto& [fileNum, bytes] : ssdBytes) {
+    if (memoryBytes.count(fileNum) == 0) {
+      files.push_back({fileNum, {0, bytes}});
+    }
+  }
+  const auto numFiles = std::min<size_t>(maxFiles, files.size());
+  std::partial_sort(
+      files.begin(),
+      files.begin() + numFiles,
+      files.end(),
+      [](const auto& left, const auto& right) {
+        return left.second.memoryBytes + left.second.ssdBytes >
+            right.second.memoryBytes + right.second.ssdBytes;
+      });
+
+  std::vector<FileCacheResidency> summary;
+  summary.reserve(numFiles);
+  for (size_t i = 0; i < numFiles; ++i) {
+    auto path = fileIds().string(files[i].first);
+    // The file may have been forgotten since.
+    if (!path.empty()) {
+      summary.push_back({std::move(path), files[i].second});
+    }
+  }
+  return summary;
+}
+
+folly::dynamic FileCacheResidency::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["path"] = path;
+  obj["memoryBytes"] = residency.memoryBytes;
+  obj["ssdBytes"] = residency.ssdBytes;
+  return obj;
+}
+
 void AsyncDataCache::makeEvictable(RawFileCacheKey key) {
   const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
   return shards_[shard]->makeEvictable(key);
@@ -854,6 +1052,11 @@ uint64_t AsyncDataCache::shrink(uint64_t targetBytes) {
         break;
       }
     }
+    // Parsed file footers are outside of the cache memory but count against
+    // the process memory that the shrink is meant to free up.
+    if (fileMetadataCache_ != nullptr && evictedBytes < targetBytes) {
+      fileMetadataCache_->shrink(targetBytes - evictedBytes);
+    }
     // Call unmap to free up to 'targetBytes' unused memory space back to
     // operating system after shrink.
     allocator_->unmap(memory::AllocationTraits::numPages(targetBytes));
@@ -949,6 +1152,9 @@ bool AsyncDataCache::removeFileEntries(
   if (ssdCache_) {
     success &= ssdCache_->removeFileEntries(filesToRemove, filesRetained);
   }
+  if (fileMetadataCache_) {
+    fileMetadataCache_->removeFileEntries(filesToRemove);
+  }
   return success;
 }
 
@@ -960,6 +1166,10 @@ CacheStats AsyncDataCache::refreshStats() const {
   if (ssdCache_ != nullptr) {
     stats.ssdStats = std::make_shared<SsdCacheStats>(ssdCache_->stats());
   }
+  if (fileMetadataCache_ != nullptr) {
+    stats.fileMetadataStats =
+        std::make_shared<FileMetadataCacheStats>(fileMetadataCache_->stats());
+  }
   return stats;
 }
 
@@ -969,6 +1179,9 @@ void AsyncDataCache::clear() {
     shard->evict(std::numeric_limits<uint64_t>::max(), true, 0, unused);
     VELOX_CHECK(unused.empty());
   }
+  if (fileMetadataCache_ != nullptr) {
+    fileMetadataCache_->clear();
+  }
 }
 
 std::string AsyncDataCache::toString(bool details) const {
@@ -978,6 +1191,9 @@ std::string AsyncDataCache::toString(bool details) const {
       << stats.toString() << "\n"
       << "Allocated pages: " << allocator_->numAllocated()
       << " cached pages: " << cachedPages_ << "\n";
+  if (stats.fileMetadataStats != nullptr) {
+    out << stats.fileMetadataStats->toString() << "\n";
+  }
   if (details) {
     out << "Backing: " << allocator_->toString();
     if (ssdCache_) {
@@ -1008,8 +1224,12 @@ std::string CacheStats::toString() const {
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " savable eviction: " << numSavableEvict
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
-      << " stales: " << numStales
-      << "\n"
+      << " stales: " << numStales;
+  if (numAdmissionRejects > 0 || numSsdAdmissionRejects > 0) {
+    out << " admission rejects: " << numAdmissionRejects
+        << " ssd admission rejects: " << numSsdAdmissionRejects;
+  }
+  out << "\n"
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
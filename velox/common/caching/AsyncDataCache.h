@@ -22,6 +22,7 @@
 #include <folly/GLog.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
+#include <folly/dynamic.h>
 #include <folly/futures/SharedPromise.h>
 
 #include "velox/common/base/BitUtil.h"
@@ -29,6 +30,8 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FileMetadataCache.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -541,23 +544,56 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of new entries that the admission filter found less frequently
+  /// accessed than their eviction victim. These are cached as first to evict.
+  int64_t numAdmissionRejects{0};
+  /// Number of loaded entries that the admission filter did not save to SSD
+  /// because they were not accessed often enough.
+  int64_t numSsdAdmissionRejects{0};
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
+  /// Stats of the parsed file footer cache if enabled.
+  std::shared_ptr<FileMetadataCacheStats> fileMetadataStats = nullptr;
+
   CacheStats operator-(const CacheStats& other) const;
 
   std::string toString() const;
 };
 
+/// Estimated bytes of a file or a split that are resident in the memory and
+/// SSD caches. A scheduler may prefer the worker with the most resident bytes
+/// for a split. The SSD bytes are uncompressed sizes and may overlap the memory
+/// bytes.
+struct CacheResidency {
+  uint64_t memoryBytes{0};
+  uint64_t ssdBytes{0};
+};
+
+/// The resident bytes of one file by path. A list of these summarizes the
+/// content of a worker's cache for soft affinity scheduling.
+struct FileCacheResidency {
+  std::string path;
+  CacheResidency residency;
+
+  folly::dynamic serialize() const;
+};
+
 /// Collection of cache entries whose key hashes to the same shard of
 /// the hash number space.  The cache population is divided into shards
 /// to decrease contention on the mutex for the key to entry mapping
 /// and other housekeeping.
 class CacheShard {
  public:
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  /// If 'admissionSketchWidth' is not 0, new entries are admitted by the
+  /// access frequency of their keys. See AsyncDataCache::Options.
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      uint64_t admissionSketchWidth = 0,
+      uint64_t admissionAgingWindow = 0,
+      int32_t ssdAdmissionMinFrequency = 0);
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -571,6 +607,16 @@ class CacheShard {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Returns true if the entry with 'key' is accessed often enough to be saved
+  /// to SSD. Always true if the admission filter is disabled.
+  bool admitToSsd(const FileCacheKey& key);
+
+  /// Returns the size of the entries of file 'fileNum' in 'this'.
+  uint64_t fileBytes(uint64_t fileNum) const;
+
+  /// Adds the size of the entries of each file in 'this' to 'fileBytes'.
+  void addFileBytes(folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   AsyncDataCache* cache() const {
     return cache_;
   }
@@ -630,10 +676,23 @@ class CacheShard {
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
 
+  // Number of entries after the clock hand considered as the victim of a new
+  // entry by the admission filter.
+  static constexpr int32_t kNumAdmissionSamples = 8;
+
   void calibrateThreshold();
 
+  // Returns true if the key with 'hash' is accessed more often than the entry
+  // that eviction is likely to remove next, or if there is no such entry.
+  bool admitLocked(uint64_t hash);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
+  // Increments or decrements the size of the entries of file 'fileNum' by
+  // 'bytes'.
+  void incrementFileBytesLocked(uint64_t fileNum, uint64_t bytes);
+  void decrementFileBytesLocked(uint64_t fileNum, uint64_t bytes);
+
   // Returns an unused entry if found.
   //
   // TODO: consider to pass a size hint so as to select the a free entry which
@@ -648,9 +707,15 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
+  const int32_t ssdAdmissionMinFrequency_;
 
   mutable std::mutex mutex_;
+  // Access frequencies of the keys of 'this', including keys not in cache.
+  // nullptr if the admission filter is disabled.
+  std::unique_ptr<FrequencySketch> admissionSketch_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
+  // Size of the entries in 'entryMap_' of each file number.
+  folly::F14FastMap<uint64_t, uint64_t> fileBytes_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
   // Unused indices in 'entries_'.
@@ -687,6 +752,11 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Cumulative count of new entries rejected by the admission filter.
+  uint64_t numAdmissionRejects_{0};
+  // Cumulative count of loaded entries not saved to SSD by the admission
+  // filter.
+  uint64_t numSsdAdmissionRejects_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -700,10 +770,12 @@ class AsyncDataCache : public memory::Cache {
     Options(
         double _maxWriteRatio = 0.7,
         double _ssdSavableRatio = 0.125,
-        int32_t _minSsdSavableBytes = 1 << 24)
+        int32_t _minSsdSavableBytes = 1 << 24,
+        uint64_t _maxFileMetadataBytes = 0)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
-          minSsdSavableBytes(_minSsdSavableBytes){};
+          minSsdSavableBytes(_minSsdSavableBytes),
+          maxFileMetadataBytes(_maxFileMetadataBytes){};
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -722,6 +794,28 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// Capacity of the cache of parsed file footers. The footers are kept
+    /// outside of the cache memory. 0 disables the cache.
+    uint64_t maxFileMetadataBytes;
+
+    /// Number of counters per row of the frequency sketch of each shard that
+    /// admits new entries, TinyLFU style. Sized to a few times the number of
+    /// entries a shard holds. When the cache is full, a new entry that is not
+    /// accessed more often than its likely eviction victim is cached as first
+    /// to evict, so that one-off scans do not flush the working set. 0
+    /// disables the admission filter.
+    uint64_t admissionSketchWidth{0};
+
+    /// Number of accesses after which the counts of the sketch are halved,
+    /// i.e. the window of recent accesses the frequencies are counted over. 0
+    /// means 10 times 'admissionSketchWidth'.
+    uint64_t admissionAgingWindow{0};
+
+    /// Min estimated number of accesses of a loaded entry to save it to SSD if
+    /// the admission filter is enabled. The default keeps one-hit wonders out
+    /// of the SSD cache.
+    int32_t ssdAdmissionMinFrequency{2};
   };
 
   AsyncDataCache(
@@ -787,6 +881,13 @@ class AsyncDataCache : public memory::Cache {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Returns the bytes of file 'fileNum' resident in memory and on SSD.
+  CacheResidency fileResidency(uint64_t fileNum) const;
+
+  /// Returns up to 'maxFiles' files with the most resident bytes in memory and
+  /// on SSD, most first.
+  std::vector<FileCacheResidency> residencySummary(int32_t maxFiles) const;
+
 #if defined(__has_feature)
 #if __has_feature(thread_sanitizer)
   __attribute__((__no_sanitize__("thread")))
@@ -815,6 +916,11 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Returns the cache of parsed file footers or nullptr if disabled.
+  FileMetadataCache* fileMetadataCache() const {
+    return fileMetadataCache_.get();
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -893,6 +999,7 @@ class AsyncDataCache : public memory::Cache {
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  std::unique_ptr<FileMetadataCache> fileMetadataCache_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
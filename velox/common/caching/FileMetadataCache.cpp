@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileMetadataCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+std::string FileMetadataCacheStats::toString() const {
+  return fmt::format(
+      "File metadata entries: {} size: {} lookups: {} hits: {} evictions: {}",
+      numEntries,
+      succinctBytes(bytes),
+      numLookups,
+      numHits,
+      numEvictions);
+}
+
+std::shared_ptr<const void> FileMetadataCache::get(
+    const FileMetadataCacheKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::put(
+    const FileMetadataCacheKey& key,
+    std::shared_ptr<const void> metadata,
+    uint64_t bytes) {
+  VELOX_CHECK_NOT_NULL(metadata);
+  if (bytes > maxBytes_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.contains(key)) {
+    return;
+  }
+  while (bytes_ + bytes > maxBytes_) {
+    removeLocked(std::prev(lru_.end()));
+    ++numEvictions_;
+  }
+  lru_.push_front(Entry{
+      key,
+      StringIdLease(fileIds(), key.fileNum),
+      std::move(metadata),
+      bytes});
+  entries_[key] = lru_.begin();
+  bytes_ += bytes;
+}
+
+void FileMetadataCache::removeFileEntries(
+    const folly::F14FastSet<uint64_t>& fileNums) {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto it = lru_.begin(); it != lru_.end();) {
+    auto next = std::next(it);
+    if (fileNums.contains(it->key.fileNum)) {
+      removeLocked(it);
+    }
+    it = next;
+  }
+}
+
+uint64_t FileMetadataCache::shrink(uint64_t targetBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  uint64_t freedBytes = 0;
+  while (freedBytes < targetBytes && !lru_.empty()) {
+    auto last = std::prev(lru_.end());
+    freedBytes += last->bytes;
+    removeLocked(last);
+    ++numEvictions_;
+  }
+  return freedBytes;
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+FileMetadataCacheStats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  FileMetadataCacheStats stats;
+  stats.numEntries = entries_.size();
+  stats.bytes = bytes_;
+  stats.numLookups = numLookups_;
+  stats.numHits = numHits_;
+  stats.numEvictions = numEvictions_;
+  return stats;
+}
+
+void FileMetadataCache::removeLocked(EntryList::iterator it) {
+  bytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/caching/StringIdMap.h"
+
+namespace facebook::velox::cache {
+
+/// Identifies a version of a file. 'fileNum' is the id of the file path in
+/// fileIds(), as in the keys of AsyncDataCache. 'modificationTime' changes
+/// when the file is overwritten.
+struct FileMetadataCacheKey {
+  uint64_t fileNum{StringIdMap::kNoId};
+  int64_t modificationTime{0};
+
+  bool operator==(const FileMetadataCacheKey& other) const {
+    return fileNum == other.fileNum &&
+        modificationTime == other.modificationTime;
+  }
+};
+
+struct FileMetadataCacheKeyHasher {
+  size_t operator()(const FileMetadataCacheKey& key) const {
+    return folly::hash::hash_combine(key.fileNum, key.modificationTime);
+  }
+};
+
+struct FileMetadataCacheStats {
+  /// Number of cached entries.
+  int64_t numEntries{0};
+  /// Estimated memory held by the cached entries.
+  int64_t bytes{0};
+  /// Number of lookups and hits.
+  int64_t numLookups{0};
+  int64_t numHits{0};
+  /// Number of entries removed to make space.
+  int64_t numEvictions{0};
+
+  std::string toString() const;
+};
+
+/// Size bounded LRU cache of parsed file footers. Readers that parse a footer
+/// into an in-memory object, e.g. the thrift FileMetaData of a Parquet file,
+/// keep the result here so that other splits of the same file skip reading
+/// and deserializing it. The cached objects are immutable and shared, so an
+/// entry stays valid for its users after eviction. Each entry holds a lease on
+/// its file id so that the id is not reused for another path while cached.
+///
+/// The cache is owned by AsyncDataCache, which clears it together with the
+/// data cache, drops the entries of files aged out by TTL and shrinks it under
+/// memory pressure. Thread safe.
+class FileMetadataCache {
+ public:
+  explicit FileMetadataCache(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Returns the metadata for 'key' or nullptr if not cached.
+  std::shared_ptr<const void> get(const FileMetadataCacheKey& key);
+
+  template <typename T>
+  std::shared_ptr<const T> get(const FileMetadataCacheKey& key) {
+    return std::static_pointer_cast<const T>(get(key));
+  }
+
+  /// Adds 'metadata' for 'key'. 'bytes' is the estimated memory held by
+  /// 'metadata'. Evicts least recently used entries to stay within the
+  /// capacity. Does nothing if 'key' is already cached or 'bytes' exceeds the
+  /// capacity.
+  void put(
+      const FileMetadataCacheKey& key,
+      std::shared_ptr<const void> metadata,
+      uint64_t bytes);
+
+  /// Removes the entries of the files in 'fileNums'.
+  void removeFileEntries(const folly::F14FastSet<uint64_t>& fileNums);
+
+  /// Evicts least recently used entries until at least 'targetBytes' are
+  /// freed or the cache is empty. Returns the freed bytes.
+  uint64_t shrink(uint64_t targetBytes);
+
+  void clear();
+
+  uint64_t maxBytes() const {
+    return maxBytes_;
+  }
+
+  FileMetadataCacheStats stats() const;
+
+ private:
+  struct Entry {
+    FileMetadataCacheKey key;
+    StringIdLease fileId;
+    std::shared_ptr<const void> metadata;
+    uint64_t bytes;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // Removes 'it' from 'lru_' and 'entries_'. Requires 'mutex_'.
+  void removeLocked(EntryList::iterator it);
+
+  const uint64_t maxBytes_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  EntryList lru_;
+  folly::F14FastMap<
+      FileMetadataCacheKey,
+      EntryList::iterator,
+      FileMetadataCacheKeyHasher>
+      entries_;
+  uint64_t bytes_{0};
+  int64_t numLookups_{0};
+  int64_t numHits_{0};
+  int64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+FrequencySketch::FrequencySketch(uint64_t width, uint64_t agingWindow)
+    : width_(std::max<uint64_t>(bits::nextPowerOfTwo(width), kCountersPerWord)),
+      agingWindow_(agingWindow == 0 ? 10 * width_ : agingWindow) {
+  VELOX_CHECK_GT(width, 0);
+  table_.resize(kNumRows * width_ / kCountersPerWord);
+}
+
+uint64_t FrequencySketch::counterIndex(uint64_t hash, int32_t row) const {
+  // Each row has an independent hash so that keys that collide in one row are
+  // unlikely to collide in the others.
+  return row * width_ + (bits::hashMix(hash, row + 1) & (width_ - 1));
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  uint64_t indices[kNumRows];
+  uint8_t minCount = kMaxCount;
+  for (int32_t row = 0; row < kNumRows; ++row) {
+    indices[row] = counterIndex(hash, row);
+    minCount = std::min(minCount, counter(indices[row]));
+  }
+  // Conservative update: only the smallest counters are incremented since
+  // the others already overestimate the key.
+  if (minCount < kMaxCount) {
+    for (int32_t row = 0; row < kNumRows; ++row) {
+      if (counter(indices[row]) == minCount) {
+        table_[indices[row] / kCountersPerWord] += 1ULL
+            << (4 * (indices[row] % kCountersPerWord));
+      }
+    }
+  }
+  if (++numIncrements_ >= agingWindow_) {
+    age();
+  }
+}
+
+uint8_t FrequencySketch::estimate(uint64_t hash) const {
+  uint8_t minCount = kMaxCount;
+  for (int32_t row = 0; row < kNumRows; ++row) {
+    minCount = std::min(minCount, counter(counterIndex(hash, row)));
+  }
+  return minCount;
+}
+
+void FrequencySketch::age() {
+  for (auto& word : table_) {
+    word = (word >> 1) & 0x7777777777777777ULL;
+  }
+  numIncrements_ = 0;
+  ++numAgings_;
+}
+
+} // namespace facebook::velox::cache
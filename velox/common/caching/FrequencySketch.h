@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Approximate access counts of a large population of keys in constant memory,
+/// as used by TinyLFU cache admission. A count-min sketch of 4 rows of 4 bit
+/// counters that saturate at 15. The counters are halved every 'agingWindow'
+/// increments so that the sketch reflects recent accesses. The estimate of a
+/// key is never less than its number of increments since the last aging but
+/// may be more because of collisions. Not thread safe.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kNumRows = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  /// 'width' is the number of counters per row and is rounded up to a power
+  /// of 2. About the number of distinct keys to track. If 'agingWindow' is 0,
+  /// the counters are halved every 10 * 'width' increments.
+  FrequencySketch(uint64_t width, uint64_t agingWindow = 0);
+
+  /// Counts an access to the key with 'hash'.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of accesses to the key with 'hash'.
+  uint8_t estimate(uint64_t hash) const;
+
+  uint64_t width() const {
+    return width_;
+  }
+
+  uint64_t agingWindow() const {
+    return agingWindow_;
+  }
+
+  /// Number of times the counters have been halved.
+  uint64_t numAgings() const {
+    return numAgings_;
+  }
+
+ private:
+  static constexpr int32_t kCountersPerWord = 16;
+
+  // Returns the index of the counter of 'hash' in 'row'.
+  uint64_t counterIndex(uint64_t hash, int32_t row) const;
+
+  uint8_t counter(uint64_t index) const {
+    return (table_[index / kCountersPerWord] >>
+            (4 * (index % kCountersPerWord))) &
+        kMaxCount;
+  }
+
+  // Halves all counters.
+  void age();
+
+  const uint64_t width_;
+  const uint64_t agingWindow_;
+  // 'kNumRows' rows of 'width_' counters packed 16 to a word.
+  std::vector<uint64_t> table_;
+  uint64_t numIncrements_{0};
+  uint64_t numAgings_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -67,7 +67,8 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
+        executor_,
+        config.compressionKind);
     files_.push_back(std::make_unique<SsdFile>(fileConfig));
   }
 }
@@ -184,6 +185,17 @@ SsdCacheStats SsdCache::stats() const {
   return stats;
 }
 
+uint64_t SsdCache::fileBytes(uint64_t fileNum) const {
+  return files_[fileNum % numShards_]->fileBytes(fileNum);
+}
+
+void SsdCache::addFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  for (auto& file : files_) {
+    file->addFileBytes(fileBytes);
+  }
+}
+
 std::string SsdCache::toString() const {
   const auto data = stats();
   const uint64_t capacity = maxBytes();
@@ -192,6 +204,10 @@ std::string SsdCache::toString() const {
       << succinctBytes(data.bytesRead) << " Size " << succinctBytes(capacity)
       << " Occupied " << succinctBytes(data.bytesCached);
   out << " " << (data.entriesCached >> 10) << "K entries.";
+  if (data.bytesSavedByCompression > 0) {
+    out << " Saved by compression "
+        << succinctBytes(data.bytesSavedByCompression);
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
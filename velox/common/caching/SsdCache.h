@@ -41,7 +41,9 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -49,7 +51,8 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind){};
 
     std::string filePrefix;
     uint64_t maxBytes;
@@ -71,15 +74,19 @@ class SsdCache {
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
+    /// Compression of the entries written to SSD. See SsdFile::Config.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, compression {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          compressionKind);
     }
   };
 
@@ -143,6 +150,13 @@ class SsdCache {
   /// Returns stats aggregated from all shards.
   SsdCacheStats stats() const;
 
+  /// Returns the uncompressed size of the cached entries of file 'fileNum'.
+  uint64_t fileBytes(uint64_t fileNum) const;
+
+  /// Adds the uncompressed size of the cached entries of each file to
+  /// 'fileBytes'.
+  void addFileBytes(folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   FileGroupStats& groupStats() const {
     return *groupStats_;
   }
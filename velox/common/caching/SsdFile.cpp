@@ -18,6 +18,7 @@
 
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
@@ -67,6 +68,48 @@ uint32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   }
   return entry.data().numRuns();
 }
+
+// Adds the ranges to read the first entry.size() bytes of 'entry' to 'ranges'.
+void addEntryToRanges(
+    AsyncDataCacheEntry& entry,
+    std::vector<folly::Range<char*>>& ranges) {
+  const uint64_t size = entry.size();
+  if (entry.tinyData() != nullptr) {
+    ranges.emplace_back(entry.tinyData(), size);
+    return;
+  }
+  const auto& data = entry.data();
+  uint64_t offsetInRuns = 0;
+  for (auto i = 0; i < data.numRuns() && offsetInRuns < size; ++i) {
+    const auto run = data.runAt(i);
+    const uint64_t readSize =
+        std::min<uint64_t>(run.numBytes(), size - offsetInRuns);
+    ranges.emplace_back(run.data<char>(), readSize);
+    offsetInRuns += readSize;
+  }
+  VELOX_CHECK_EQ(offsetInRuns, size);
+}
+
+// Copies the first entry.size() bytes of 'source' into 'entry'.
+void copyToEntry(const char* source, AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    ::memcpy(entry.tinyData(), source, entry.size());
+    return;
+  }
+  const auto& data = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto bytesToCopy = std::min<int64_t>(bytesLeft, run.numBytes());
+    ::memcpy(run.data<char>(), source, bytesToCopy);
+    source += bytesToCopy;
+    bytesLeft -= bytesToCopy;
+  }
+}
+
+bool isCompressed(const SsdRun& run) {
+  return run.compressionKind() != common::CompressionKind_NONE;
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -111,11 +154,16 @@ SsdFile::SsdFile(const Config& config)
       checksumEnabled_(config.checksumEnabled),
       checksumReadVerificationEnabled_(
           config.checksumEnabled && config.checksumReadVerificationEnabled),
+      compressionKind_(config.compressionKind),
       shardId_(config.shardId),
       fs_(filesystems::getFileSystem(fileName_, nullptr)),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
       executor_(config.executor) {
   process::TraceContext trace("SsdFile::SsdFile");
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    // Fails on a compression kind without a codec.
+    common::compressionKindToCodec(compressionKind_);
+  }
   filesystems::FileOptions fileOptions;
   fileOptions.shouldThrowOnFileAlreadyExists = false;
   fileOptions.bufferIo = !FLAGS_velox_ssd_odirect;
@@ -134,6 +182,7 @@ SsdFile::SsdFile(const Config& config)
   tracker_.resize(maxRegions_);
   regionSizes_.resize(maxRegions_, 0);
   erasedRegionSizes_.resize(maxRegions_, 0);
+  regionBytesSavedByCompression_.resize(maxRegions_, 0);
   regionPins_.resize(maxRegions_, 0);
   if (checkpointEnabled()) {
     initializeCheckpoint();
@@ -184,6 +233,9 @@ bool SsdFile::erase(RawFileCacheKey key) {
   if (it == entries_.end()) {
     return false;
   }
+  regionBytesSavedByCompression_[regionIndex(it->second.offset())] -=
+      it->second.rawSize() - it->second.size();
+  decrementFileBytesLocked(key.fileNum, it->second.rawSize());
   entries_.erase(it);
   return true;
 }
@@ -196,18 +248,21 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   size_t totalPayloadBytes = 0;
+  bool hasCompressed = false;
   for (auto i = 0; i < pins.size(); ++i) {
-    const auto runSize = ssdPins[i].run().size();
+    const auto& ssdRun = ssdPins[i].run();
+    const auto rawSize = ssdRun.rawSize();
     auto* entry = pins[i].checkedEntry();
-    if (FOLLY_UNLIKELY(runSize < entry->size())) {
+    if (FOLLY_UNLIKELY(rawSize < entry->size())) {
       ++stats_.readSsdErrors;
       VELOX_FAIL(
           "IOERR: SSD cache cache entry {} short than requested range {}",
-          succinctBytes(runSize),
+          succinctBytes(rawSize),
           succinctBytes(entry->size()));
     }
+    hasCompressed |= isCompressed(ssdRun);
     totalPayloadBytes += entry->size();
-    regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
+    regionRead(regionIndex(ssdRun.offset()), ssdRun.size());
     ++stats_.entriesRead;
     stats_.bytesRead += entry->size();
   }
@@ -215,15 +270,86 @@ CoalesceIoStats SsdFile::load(
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
-  const auto stats = readPins(
-      pins,
-      totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
+  const int32_t maxGap =
+      totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000;
+  CoalesceIoStats stats;
+  if (hasCompressed) {
+    stats = readCompressedPins(ssdPins, pins, maxGap);
+  } else {
+    stats = readPins(
+        pins,
+        maxGap,
+        // Max ranges in one preadv call. Longest gap + longest cache entry are
+        // under 12 ranges. If a system has a limit of 1K ranges, coalesce
+        // limit of 1000 is safe.
+        900,
+        [&](int32_t index) { return ssdPins[index].run().offset(); },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          read(offset, buffers);
+        });
+  }
+
+  for (auto i = 0; i < ssdPins.size(); ++i) {
+    pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
+    auto* entry = pins[i].checkedEntry();
+    auto ssdRun = ssdPins[i].run();
+    // The checksum of a compressed entry is verified on decompression.
+    if (!isCompressed(ssdRun)) {
+      maybeVerifyChecksum(*entry, ssdRun);
+    }
+  }
+  return stats;
+}
+
+CoalesceIoStats SsdFile::readCompressedPins(
+    const std::vector<SsdPin>& ssdPins,
+    const std::vector<CachePin>& pins,
+    int32_t maxGap) {
+  // The compressed entries are read into 'compressed' and the others directly
+  // into their pins.
+  std::vector<std::string> compressed(pins.size());
+  std::vector<int32_t> indices(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    indices[i] = i;
+    if (isCompressed(ssdPins[i].run())) {
+      compressed[i].resize(ssdPins[i].run().size());
+    }
+  }
+  const auto stats = coalesceIo<int32_t, folly::Range<char*>>(
+      indices,
+      maxGap,
       900,
       [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
+      [&](int32_t index) -> uint64_t {
+        return isCompressed(ssdPins[index].run())
+            ? ssdPins[index].run().size()
+            : pins[index].checkedEntry()->size();
+      },
+      [&](int32_t index) {
+        if (isCompressed(ssdPins[index].run())) {
+          return 1;
+        }
+        return std::max<int32_t>(
+            1, pins[index].checkedEntry()->data().numRuns());
+      },
+      [&](int32_t index, std::vector<folly::Range<char*>>& ranges) {
+        if (isCompressed(ssdPins[index].run())) {
+          ranges.emplace_back(
+              compressed[index].data(), compressed[index].size());
+        } else {
+          addEntryToRanges(*pins[index].checkedEntry(), ranges);
+        }
+      },
+      [&](int32_t size, std::vector<folly::Range<char*>>& ranges) {
+        // The gap is not read into memory. See readPins().
+        ranges.push_back(folly::Range<char*>(
+            nullptr, reinterpret_cast<char*>(static_cast<uint64_t>(size))));
+      },
+      [&](const std::vector<int32_t>& /*indices*/,
           int32_t /*begin*/,
           int32_t /*end*/,
           uint64_t offset,
@@ -231,11 +357,18 @@ CoalesceIoStats SsdFile::load(
         read(offset, buffers);
       });
 
-  for (auto i = 0; i < ssdPins.size(); ++i) {
-    pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
-    auto* entry = pins[i].checkedEntry();
-    auto ssdRun = ssdPins[i].run();
-    maybeVerifyChecksum(*entry, ssdRun);
+  std::unique_ptr<folly::compression::Codec> codec;
+  for (auto i = 0; i < pins.size(); ++i) {
+    const auto& ssdRun = ssdPins[i].run();
+    if (!isCompressed(ssdRun)) {
+      continue;
+    }
+    if (codec == nullptr ||
+        common::codecTypeToCompressionKind(codec->type()) !=
+            ssdRun.compressionKind()) {
+      codec = common::compressionKindToCodec(ssdRun.compressionKind());
+    }
+    decompressEntry(*codec, compressed[i], ssdRun, *pins[i].checkedEntry());
   }
   return stats;
 }
@@ -249,6 +382,7 @@ void SsdFile::read(
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const std::vector<CachePin>& pins,
+    const std::vector<int32_t>& storedSizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -264,12 +398,11 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
     for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+      if (storedSizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= storedSizes[next];
+      toWrite += storedSizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -294,6 +427,7 @@ bool SsdFile::growOrEvictLocked() {
       writableRegions_.push_back(numRegions_);
       regionSizes_[numRegions_] = 0;
       erasedRegionSizes_[numRegions_] = 0;
+      regionBytesSavedByCompression_[numRegions_] = 0;
       ++numRegions_;
       VELOX_SSD_CACHE_LOG(INFO)
           << "Grow cache file " << fileName_ << " to " << numRegions_
@@ -329,6 +463,7 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
   while (it != entries_.end()) {
     const auto region = regionIndex(it->second.offset());
     if (regionSet.count(region) != 0) {
+      decrementFileBytesLocked(it->first.fileNum.id(), it->second.rawSize());
       it = entries_.erase(it);
     } else {
       ++it;
@@ -340,6 +475,7 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
     tracker_.regionCleared(region);
     regionSizes_[region] = 0;
     erasedRegionSizes_[region] = 0;
+    regionBytesSavedByCompression_[region] = 0;
   }
 }
 
@@ -353,9 +489,26 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The compressed bytes of each entry or nullptr if the entry is written as
+  // is.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  std::vector<int32_t> storedSizes(pins.size());
+  std::unique_ptr<folly::compression::Codec> codec;
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    codec = common::compressionKindToCodec(compressionKind_);
+  }
+  for (auto i = 0; i < pins.size(); ++i) {
+    auto* entry = pins[i].checkedEntry();
+    if (codec != nullptr) {
+      compressed[i] = compressEntry(*codec, *entry);
+    }
+    storedSizes[i] = compressed[i] != nullptr ? compressed[i]->length()
+                                              : entry->size();
+  }
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(pins, storedSizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -369,8 +522,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     std::vector<iovec> writeIovecs;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto entrySize = storedSizes[i];
+      const auto numIovecs =
+          compressed[i] != nullptr ? 1 : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
@@ -387,7 +541,12 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (compressed[i] != nullptr) {
+        writeIovecs.push_back(
+            {compressed[i]->writableData(), compressed[i]->length()});
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -409,16 +568,34 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = storedSizes[i];
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
         uint32_t checksum = 0;
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        SsdRun ssdRun(offset, size, checksum);
+        if (compressed[i] != nullptr) {
+          ssdRun = SsdRun(
+              offset, size, checksum, compressionKind_, entry->size());
+          ++stats_.entriesCompressed;
+          stats_.compressionInputBytes += entry->size();
+          stats_.compressedBytes += size;
+          regionBytesSavedByCompression_[regionIndex(offset)] +=
+              entry->size() - size;
+        }
+        const auto it = entries_.find(key);
+        if (it != entries_.end()) {
+          // The replaced run no longer saves space in its region.
+          regionBytesSavedByCompression_[regionIndex(it->second.offset())] -=
+              it->second.rawSize() - it->second.size();
+          decrementFileBytesLocked(key.fileNum.id(), it->second.rawSize());
+        }
+        incrementFileBytesLocked(key.fileNum.id(), ssdRun.rawSize());
+        entries_[std::move(key)] = ssdRun;
         if (FLAGS_velox_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, ssdRun);
         }
         offset += size;
         ++stats_.entriesWritten;
@@ -452,8 +629,84 @@ bool SsdFile::write(
   }
 }
 
+std::unique_ptr<folly::IOBuf> SsdFile::compressEntry(
+    folly::compression::Codec& codec,
+    AsyncDataCacheEntry& entry) {
+  std::unique_ptr<folly::IOBuf> input;
+  if (entry.tinyData() != nullptr) {
+    input = folly::IOBuf::wrapBuffer(entry.tinyData(), entry.size());
+  } else {
+    const auto& data = entry.data();
+    int64_t bytesLeft = entry.size();
+    for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+      const auto run = data.runAt(i);
+      const auto runBytes = std::min<int64_t>(bytesLeft, run.numBytes());
+      auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), runBytes);
+      if (input == nullptr) {
+        input = std::move(buffer);
+      } else {
+        input->appendToChain(std::move(buffer));
+      }
+      bytesLeft -= runBytes;
+    }
+  }
+
+  std::unique_ptr<folly::IOBuf> output;
+  try {
+    output = codec.compress(input.get());
+  } catch (const std::exception& e) {
+    VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
+        << "Writing SSD cache entry uncompressed after compression error: "
+        << e.what();
+    return nullptr;
+  }
+  if (output->computeChainDataLength() > entry.size() * kMaxCompressedRatio) {
+    return nullptr;
+  }
+  output->coalesce();
+  return output;
+}
+
+void SsdFile::decompressEntry(
+    folly::compression::Codec& codec,
+    std::string_view compressed,
+    const SsdRun& ssdRun,
+    AsyncDataCacheEntry& entry) {
+  std::string uncompressed;
+  try {
+    uncompressed = codec.uncompress(
+        folly::StringPiece(compressed.data(), compressed.size()),
+        ssdRun.rawSize());
+  } catch (const std::exception& e) {
+    ++stats_.readSsdCorruptions;
+    VELOX_FAIL(
+        "IOERR: Corrupt SSD cache entry - File: {}, Offset: {}, Size: {}: {}",
+        fileName_,
+        ssdRun.offset(),
+        ssdRun.size(),
+        e.what());
+  }
+  ++stats_.readSsdDecompressions;
+  // The checksum is of the uncompressed data.
+  bool corrupt = uncompressed.size() != ssdRun.rawSize();
+  if (!corrupt && checksumReadVerificationEnabled_) {
+    bits::Crc32 crc;
+    crc.process_bytes(uncompressed.data(), uncompressed.size());
+    corrupt = crc.checksum() != ssdRun.checksum();
+  }
+  if (corrupt) {
+    ++stats_.readSsdCorruptions;
+    VELOX_FAIL(
+        "IOERR: Corrupt SSD cache entry - File: {}, Offset: {}, Size: {}",
+        fileName_,
+        ssdRun.offset(),
+        ssdRun.size());
+  }
+  copyToEntry(uncompressed.data(), entry);
+}
+
 namespace {
-int32_t indexOfFirstMismatch(char* x, char* y, int n) {
+int32_t indexOfFirstMismatch(const char* x, const char* y, int n) {
   for (auto i = 0; i < n; ++i) {
     if (x[i] != y[i]) {
       return i;
@@ -465,12 +718,23 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   process::TraceContext trace("SsdFile::verifyWrite");
-  auto testData = std::make_unique<char[]>(entry.size());
+  auto testData = std::make_unique<char[]>(ssdRun.size());
   const auto rc =
-      readFile_->pread(ssdRun.offset(), entry.size(), testData.get());
-  VELOX_CHECK_EQ(rc.size(), entry.size());
+      readFile_->pread(ssdRun.offset(), ssdRun.size(), testData.get());
+  VELOX_CHECK_EQ(rc.size(), ssdRun.size());
+  const char* readData = testData.get();
+  std::string uncompressed;
+  if (isCompressed(ssdRun)) {
+    uncompressed =
+        common::compressionKindToCodec(ssdRun.compressionKind())
+            ->uncompress(
+                folly::StringPiece(testData.get(), ssdRun.size()),
+                ssdRun.rawSize());
+    VELOX_CHECK_EQ(uncompressed.size(), entry.size());
+    readData = uncompressed.data();
+  }
   if (entry.tinyData() != nullptr) {
-    if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
+    if (::memcmp(readData, entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
     }
   } else {
@@ -481,7 +745,7 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
       const auto run = data.runAt(i);
       const auto compareSize = std::min<int64_t>(bytesLeft, run.numBytes());
       const auto badIndex = indexOfFirstMismatch(
-          run.data<char>(), testData.get() + offset, compareSize);
+          run.data<char>(), readData + offset, compareSize);
       VELOX_CHECK_EQ(badIndex, -1, "Bad read back");
       bytesLeft -= run.numBytes();
       offset += run.numBytes();
@@ -525,6 +789,41 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
   stats.readSsdCorruptions += stats_.readSsdCorruptions;
   stats.readWithoutChecksumChecks += stats_.readWithoutChecksumChecks;
+  for (auto i = 0; i < numRegions_; ++i) {
+    stats.bytesSavedByCompression += regionBytesSavedByCompression_[i];
+  }
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.compressionInputBytes += stats_.compressionInputBytes;
+  stats.compressedBytes += stats_.compressedBytes;
+  stats.readSsdDecompressions += stats_.readSsdDecompressions;
+}
+
+uint64_t SsdFile::fileBytes(uint64_t fileNum) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  const auto it = fileBytes_.find(fileNum);
+  return it == fileBytes_.end() ? 0 : it->second;
+}
+
+void SsdFile::addFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [fileNum, bytes] : fileBytes_) {
+    fileBytes[fileNum] += bytes;
+  }
+}
+
+void SsdFile::incrementFileBytesLocked(uint64_t fileNum, uint64_t bytes) {
+  fileBytes_[fileNum] += bytes;
+}
+
+void SsdFile::decrementFileBytesLocked(uint64_t fileNum, uint64_t bytes) {
+  auto it = fileBytes_.find(fileNum);
+  VELOX_CHECK(it != fileBytes_.end());
+  VELOX_CHECK_GE(it->second, bytes);
+  it->second -= bytes;
+  if (it->second == 0) {
+    fileBytes_.erase(it);
+  }
 }
 
 void SsdFile::clear() {
@@ -532,6 +831,11 @@ void SsdFile::clear() {
   entries_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
+  std::fill(
+      regionBytesSavedByCompression_.begin(),
+      regionBytesSavedByCompression_.end(),
+      0);
+  fileBytes_.clear();
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
   tracker_.clear();
@@ -573,6 +877,8 @@ bool SsdFile::removeFileEntries(
 
     ++entriesAgedOut;
     erasedRegionSizes_[region] += ssdRun.size();
+    regionBytesSavedByCompression_[region] -= ssdRun.rawSize() - ssdRun.size();
+    decrementFileBytesLocked(cacheKey.fileNum.id(), ssdRun.rawSize());
 
     it = entries_.erase(it);
   }
@@ -762,12 +1068,17 @@ void SsdFile::checkpoint(bool force) {
       // kMapMarker,
       // {fileId, offset, SSdRun} triples,
       // kEndMarker.
+      // The SsdRun has the compression bits if the version has compression.
       allocateCheckpointBuffer();
       SCOPE_EXIT {
         freeCheckpointBuffer();
       };
-      const auto version = checkpointVersion();
-      appendToCheckpointBuffer(checkpointVersion());
+      bool hasCompression = compressionKind_ != common::CompressionKind_NONE;
+      for (auto it = entries_.begin(); !hasCompression && it != entries_.end();
+           ++it) {
+        hasCompression = isCompressed(it->second);
+      }
+      appendToCheckpointBuffer(checkpointVersion(hasCompression));
       appendToCheckpointBuffer(maxRegions_);
       appendToCheckpointBuffer(numRegions_);
 
@@ -796,6 +1107,10 @@ void SsdFile::checkpoint(bool force) {
           const auto checksum = pair.second.checksum();
           appendToCheckpointBuffer(checksum);
         }
+        if (hasCompression) {
+          const auto compressionBits = pair.second.compressionBits();
+          appendToCheckpointBuffer(compressionBits);
+        }
       }
 
       // NOTE: we need to ensure cache file data sync update completes before
@@ -867,6 +1182,7 @@ void SsdFile::initializeCheckpoint() {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
       entries_.clear();
+      fileBytes_.clear();
       deleteCheckpoint(true);
     } catch (const std::exception&) {
     }
@@ -980,6 +1296,8 @@ void SsdFile::readCheckpoint() {
   const auto versionMagic = readString(stream.get(), 4);
   const auto checkpoinHasChecksum =
       isChecksumEnabledOnCheckpointVersion(versionMagic);
+  const auto checkpointHasCompression =
+      isCompressionEnabledOnCheckpointVersion(versionMagic);
   if (checksumEnabled_ && !checkpoinHasChecksum) {
     VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
         "Starting shard {} without checkpoint: checksum is enabled but the checkpoint was made without checksum, so skip the checkpoint recovery, checkpoint file {}",
@@ -1034,7 +1352,11 @@ void SsdFile::readCheckpoint() {
     if (checkpoinHasChecksum) {
       checksum = readNumber<uint32_t>(stream.get());
     }
-    const auto run = SsdRun(fileBits, checksum);
+    uint32_t compressionBits = 0;
+    if (checkpointHasCompression) {
+      compressionBits = readNumber<uint32_t>(stream.get());
+    }
+    const auto run = SsdRun(fileBits, checksum, compressionBits);
     const auto region = regionIndex(run.offset());
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(region) != evictedMap.end()) {
@@ -1044,8 +1366,10 @@ void SsdFile::readCheckpoint() {
     const auto it = idMap.find(fileNum);
     VELOX_CHECK(it != idMap.end());
     FileCacheKey key{it->second, offset};
+    incrementFileBytesLocked(key.fileNum.id(), run.rawSize());
     entries_[std::move(key)] = run;
     regionCacheSizes[region] += run.size();
+    regionBytesSavedByCompression_[region] += run.rawSize() - run.size();
     regionSizes_[region] = std::max<uint32_t>(
         regionSizes_[region], regionOffset(run.offset()) + run.size());
   }
@@ -21,6 +21,7 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
@@ -34,21 +35,39 @@ class SsdCacheTestHelper;
 
 /// A 64 bit word describing a SSD cache entry in an SsdFile. The low 23 bits
 /// are the size, for a maximum entry size of 8MB. The high bits are the offset.
+/// A compressed entry also has the compression kind and the uncompressed size.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() : fileBits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
+  /// 'size' is the number of bytes stored on SSD. If 'compressionKind' is not
+  /// CompressionKind_NONE, these are the compressed bytes of an entry of
+  /// 'rawSize' bytes.
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE,
+      uint32_t rawSize = 0)
       : fileBits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
+    if (compressionKind != common::CompressionKind_NONE) {
+      VELOX_CHECK_NE(rawSize, 0);
+      VELOX_CHECK_LE(rawSize, 1 << kSizeBits);
+      compressionBits_ = (static_cast<uint32_t>(compressionKind)
+                          << kRawSizeBits) |
+          rawSize;
+    }
   }
 
-  SsdRun(uint64_t fileBits, uint32_t checksum)
-      : fileBits_(fileBits), checksum_(checksum) {}
+  SsdRun(uint64_t fileBits, uint32_t checksum, uint32_t compressionBits = 0)
+      : fileBits_(fileBits),
+        checksum_(checksum),
+        compressionBits_(compressionBits) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
@@ -56,11 +75,13 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    compressionBits_ = other.compressionBits_;
   }
 
   void operator=(SsdRun&& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    compressionBits_ = other.compressionBits_;
   }
 
   uint64_t offset() const {
@@ -81,10 +102,33 @@ class SsdRun {
     return fileBits_;
   }
 
+  /// Returns the compression of the stored bytes.
+  common::CompressionKind compressionKind() const {
+    return static_cast<common::CompressionKind>(
+        compressionBits_ >> kRawSizeBits);
+  }
+
+  /// Returns the size of the entry before compression. This is size() for an
+  /// uncompressed entry.
+  uint32_t rawSize() const {
+    return compressionBits_ == 0 ? size()
+                                 : compressionBits_ & ((1 << kRawSizeBits) - 1);
+  }
+
+  /// Returns raw bits for compression kind and raw size for serialization.
+  uint32_t compressionBits() const {
+    return compressionBits_;
+  }
+
  private:
+  static constexpr int32_t kRawSizeBits = 24;
+
   // Contains the file offset and size.
   uint64_t fileBits_;
   uint32_t checksum_;
+  // The compression kind in the high 8 bits and the uncompressed size in the
+  // low 24 bits. 0 if the entry is not compressed.
+  uint32_t compressionBits_{0};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -171,6 +215,11 @@ struct SsdCacheStats {
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
     readWithoutChecksumChecks =
         tsanAtomicValue(other.readWithoutChecksumChecks);
+    bytesSavedByCompression = tsanAtomicValue(other.bytesSavedByCompression);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    compressionInputBytes = tsanAtomicValue(other.compressionInputBytes);
+    compressedBytes = tsanAtomicValue(other.compressedBytes);
+    readSsdDecompressions = tsanAtomicValue(other.readSsdDecompressions);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -202,6 +251,12 @@ struct SsdCacheStats {
         readCheckpointErrors - other.readCheckpointErrors;
     result.readWithoutChecksumChecks =
         readWithoutChecksumChecks - other.readWithoutChecksumChecks;
+    result.entriesCompressed = entriesCompressed - other.entriesCompressed;
+    result.compressionInputBytes =
+        compressionInputBytes - other.compressionInputBytes;
+    result.compressedBytes = compressedBytes - other.compressedBytes;
+    result.readSsdDecompressions =
+        readSsdDecompressions - other.readSsdDecompressions;
     return result;
   }
 
@@ -214,6 +269,9 @@ struct SsdCacheStats {
   tsan_atomic<uint64_t> regionsCached{0};
   tsan_atomic<uint64_t> bytesCached{0};
   tsan_atomic<int32_t> numPins{0};
+  /// Uncompressed minus stored size of the cached compressed entries.
+  /// 'bytesCached' plus this is the effective capacity in use.
+  tsan_atomic<uint64_t> bytesSavedByCompression{0};
 
   /// Cumulative stats
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -238,6 +296,13 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
   tsan_atomic<uint32_t> readWithoutChecksumChecks{0};
+  /// Number of entries written compressed, their uncompressed and their
+  /// compressed size.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  tsan_atomic<uint64_t> compressionInputBytes{0};
+  tsan_atomic<uint64_t> compressedBytes{0};
+  /// Number of compressed entries read.
+  tsan_atomic<uint64_t> readSsdDecompressions{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -257,7 +322,9 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -266,7 +333,8 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -292,8 +360,17 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// Compression of the entries written. An entry that does not compress
+    /// to at most kMaxCompressedRatio of its size is written as is. Entries
+    /// are decompressed on load by the compression they were written with.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
   };
 
+  /// Max ratio of the compressed to the uncompressed size of an entry for the
+  /// entry to be stored compressed.
+  static constexpr double kMaxCompressedRatio = 0.9;
+
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
 
   /// Constructs a cache backed by filename. Discards any previous contents of
@@ -341,6 +418,13 @@ class SsdFile {
   /// Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  /// Returns the uncompressed size of the cached entries of file 'fileNum'.
+  uint64_t fileBytes(uint64_t fileNum) const;
+
+  /// Adds the uncompressed size of the cached entries of each file to
+  /// 'fileBytes'.
+  void addFileBytes(folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   /// Remove cached entries of files in the fileNum set 'filesToRemove'. If
   /// successful, return true, and 'filesRetained' contains entries that should
   /// not be removed, ex., from pinned regions. Otherwise, return false and
@@ -404,8 +488,12 @@ class SsdFile {
   }
 
   // The first 4 bytes of a checkpoint file contains version string to indicate
-  // if checksum write is enabled or not.
-  std::string checkpointVersion() const {
+  // if checksum write is enabled or not and if the entries have compression
+  // bits.
+  std::string checkpointVersion(bool hasCompression) const {
+    if (hasCompression) {
+      return checksumEnabled_ ? "CPT4" : "CPT3";
+    }
     return checksumEnabled_ ? "CPT2" : "CPT1";
   }
 
@@ -421,12 +509,17 @@ class SsdFile {
   // multiple calls starting at the first unwritten pin may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
       const std::vector<CachePin>& pins,
+      const std::vector<int32_t>& storedSizes,
       int32_t begin);
 
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
 
+  // Increments or decrements the cached bytes of file 'fileNum' by 'bytes'.
+  void incrementFileBytesLocked(uint64_t fileNum, uint64_t bytes);
+  void decrementFileBytesLocked(uint64_t fileNum, uint64_t bytes);
+
   // Clears one or more  regions for accommodating new entries. The regions are
   // added to 'writableRegions_'. Returns true if regions could be cleared.
   bool growOrEvictLocked();
@@ -434,6 +527,28 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Returns the compressed bytes of 'entry' or nullptr if 'entry' does not
+  // compress to at most kMaxCompressedRatio of its size.
+  std::unique_ptr<folly::IOBuf> compressEntry(
+      folly::compression::Codec& codec,
+      AsyncDataCacheEntry& entry);
+
+  // Reads the entries of 'ssdPins' into 'pins' like readPins() but reads the
+  // compressed entries into temporary buffers and decompresses them into their
+  // pins.
+  CoalesceIoStats readCompressedPins(
+      const std::vector<SsdPin>& ssdPins,
+      const std::vector<CachePin>& pins,
+      int32_t maxGap);
+
+  // Decompresses the 'compressed' bytes of the entry at 'ssdRun' into 'entry'
+  // with 'codec' and verifies the checksum if read verification is enabled.
+  void decompressEntry(
+      folly::compression::Codec& codec,
+      std::string_view compressed,
+      const SsdRun& ssdRun,
+      AsyncDataCacheEntry& entry);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -523,7 +638,13 @@ class SsdFile {
   // Returns true if checksum write is enabled for the given version.
   static bool isChecksumEnabledOnCheckpointVersion(
       const std::string& checkpointVersion) {
-    return checkpointVersion == "CPT2";
+    return checkpointVersion == "CPT2" || checkpointVersion == "CPT4";
+  }
+
+  // Returns true if the entries have compression bits for the given version.
+  static bool isCompressionEnabledOnCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion == "CPT3" || checkpointVersion == "CPT4";
   }
 
   static constexpr const char* kLogExtension = ".log";
@@ -545,6 +666,9 @@ class SsdFile {
   // If true, checksum read verification from SSD is enabled.
   const bool checksumReadVerificationEnabled_;
 
+  // Compression of the entries written.
+  const common::CompressionKind compressionKind_;
+
   // Shard index within 'cache_'.
   const int32_t shardId_;
 
@@ -566,6 +690,12 @@ class SsdFile {
 
   std::vector<uint32_t> erasedRegionSizes_;
 
+  // Uncompressed minus stored size of the compressed entries in each region.
+  std::vector<uint64_t> regionBytesSavedByCompression_;
+
+  // Uncompressed size of the cached entries of each file number.
+  folly::F14FastMap<uint64_t, uint64_t> fileBytes_;
+
   // Indices of regions available for writing new entries.
   std::vector<int32_t> writableRegions_;
 
@@ -1076,6 +1076,122 @@ TEST_P(AsyncDataCacheTest, staleEntry) {
   ASSERT_EQ(stats.numHit, 1);
 }
 
+TEST_P(AsyncDataCacheTest, admissionFilter) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr int32_t kSize = 4096;
+  constexpr int32_t kNumHot = 64;
+  constexpr int32_t kNumScan = 100;
+  AsyncDataCache::Options cacheOptions;
+  cacheOptions.admissionSketchWidth = 1 << 10;
+  initializeCache(kRamBytes, 0, 0, false, cacheOptions);
+
+  // Loads the entry at 'offset' unless cached. Returns true if the entry is
+  // the first to evict.
+  auto load = [&](uint64_t offset) {
+    auto pin = cache_->findOrCreate({filenames_[0].id(), offset}, kSize);
+    VELOX_CHECK(!pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setExclusiveToShared(false);
+    }
+    return pin.entry()->score(accessTime()) ==
+        std::numeric_limits<int32_t>::max();
+  };
+
+  // Everything is admitted until eviction starts.
+  for (int32_t i = 0; i < 4; ++i) {
+    for (int32_t hot = 0; hot < kNumHot; ++hot) {
+      ASSERT_FALSE(load(hot * kSize));
+    }
+  }
+  ASSERT_EQ(cache_->refreshStats().numAdmissionRejects, 0);
+
+  // One-off reads are kept but are evicted before the hot entries.
+  asyncDataCacheHelper_->calibrateThresholds();
+  const uint64_t scanOffset = kNumHot * kSize;
+  for (int32_t i = 0; i < kNumScan; ++i) {
+    ASSERT_TRUE(load(scanOffset + i * kSize));
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numAdmissionRejects, kNumScan);
+  ASSERT_EQ(stats.numNew, kNumHot + kNumScan);
+  ASSERT_EQ(stats.numHit, 3 * kNumHot);
+  ASSERT_NE(
+      stats.toString().find("admission rejects: 100 ssd admission rejects: 0"),
+      std::string::npos);
+
+  // A hit makes a rejected entry regular.
+  ASSERT_FALSE(load(scanOffset));
+  ASSERT_EQ(cache_->refreshStats().numHit, 3 * kNumHot + 1);
+}
+
+TEST_P(AsyncDataCacheTest, ssdAdmissionFilter) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr uint64_t kSsdBytes = 64UL << 20;
+  constexpr int32_t kSize = 4096;
+  AsyncDataCache::Options cacheOptions;
+  cacheOptions.admissionSketchWidth = 1 << 10;
+  initializeCache(kRamBytes, kSsdBytes, 0, false, cacheOptions);
+
+  // An entry accessed once is not saved to SSD.
+  auto pin = cache_->findOrCreate({filenames_[0].id(), 0}, kSize);
+  ASSERT_TRUE(pin.entry()->isExclusive());
+  pin.entry()->setExclusiveToShared();
+  ASSERT_FALSE(pin.entry()->ssdSaveable());
+  ASSERT_EQ(cache_->refreshStats().numSsdAdmissionRejects, 1);
+  pin.clear();
+
+  // An entry accessed again while loading is saved.
+  pin = cache_->findOrCreate({filenames_[0].id(), kSize}, kSize);
+  ASSERT_TRUE(pin.entry()->isExclusive());
+  folly::SemiFuture<bool> wait(false);
+  ASSERT_TRUE(
+      cache_->findOrCreate({filenames_[0].id(), kSize}, kSize, &wait).empty());
+  pin.entry()->setExclusiveToShared();
+  ASSERT_TRUE(pin.entry()->ssdSaveable());
+  ASSERT_EQ(cache_->refreshStats().numSsdAdmissionRejects, 1);
+  pin.clear();
+  waitForSsdWriteToFinish(cache_->ssdCache());
+}
+
+TEST_P(AsyncDataCacheTest, fileResidency) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr uint64_t kSsdBytes = 64UL << 20;
+  constexpr int32_t kSize = 4096;
+  initializeCache(kRamBytes, kSsdBytes);
+  // File 0 has one entry and file 1 has two.
+  for (int32_t file = 0; file < 2; ++file) {
+    for (int32_t i = 0; i <= file; ++i) {
+      auto pin = cache_->findOrCreate(
+          {filenames_[file].id(), static_cast<uint64_t>(i * kSize)}, kSize);
+      ASSERT_TRUE(pin.entry()->isExclusive());
+      pin.entry()->setExclusiveToShared();
+    }
+  }
+  ASSERT_EQ(cache_->fileResidency(filenames_[0].id()).memoryBytes, kSize);
+  ASSERT_EQ(cache_->fileResidency(filenames_[1].id()).memoryBytes, 2 * kSize);
+  ASSERT_EQ(cache_->fileResidency(filenames_[2].id()).memoryBytes, 0);
+  ASSERT_EQ(cache_->fileResidency(filenames_[1].id()).ssdBytes, 0);
+
+  ASSERT_TRUE(cache_->ssdCache()->startWrite());
+  cache_->saveToSsd(true);
+  cache_->ssdCache()->waitForWriteToFinish();
+  ASSERT_EQ(cache_->fileResidency(filenames_[1].id()).ssdBytes, 2 * kSize);
+
+  auto summary = cache_->residencySummary(1);
+  ASSERT_EQ(summary.size(), 1);
+  ASSERT_EQ(summary[0].path, "testing_file_1");
+  ASSERT_EQ(summary[0].residency.memoryBytes, 2 * kSize);
+  ASSERT_EQ(summary[0].residency.ssdBytes, 2 * kSize);
+  ASSERT_EQ(summary[0].serialize()["ssdBytes"].asInt(), 2 * kSize);
+  ASSERT_EQ(cache_->residencySummary(10).size(), 2);
+
+  // Evicted entries stay resident on SSD.
+  cache_->clear();
+  const auto residency = cache_->fileResidency(filenames_[1].id());
+  ASSERT_EQ(residency.memoryBytes, 0);
+  ASSERT_EQ(residency.ssdBytes, 2 * kSize);
+}
+
 TEST_P(AsyncDataCacheTest, shrinkCache) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -154,6 +154,14 @@ class CacheShardTestHelper {
     return entries;
   }
 
+  /// Sets the eviction threshold as if the shard had started evicting.
+  void calibrateThreshold() {
+    std::lock_guard<std::mutex> l(cacheShard_->mutex_);
+    if (!cacheShard_->entries_.empty()) {
+      cacheShard_->calibrateThreshold();
+    }
+  }
+
  private:
   CacheShard* const cacheShard_;
 };
@@ -176,6 +184,12 @@ class AsyncDataCacheTestHelper {
     return totalEntries;
   }
 
+  void calibrateThresholds() {
+    for (const auto& shard : asyncDataCache_->shards_) {
+      CacheShardTestHelper(shard.get()).calibrateThreshold();
+    }
+  }
+
   uint64_t ssdSavable() const {
     return asyncDataCache_->ssdSaveable_;
   }
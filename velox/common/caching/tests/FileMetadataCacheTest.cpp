@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileMetadataCache.h"
+
+#include "gtest/gtest.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+
+using namespace facebook::velox;
+
+namespace facebook::velox::cache {
+namespace {
+
+class FileMetadataCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (auto i = 0; i < 4; ++i) {
+      files_.emplace_back(fileIds(), fmt::format("/file_metadata/{}", i));
+    }
+  }
+
+  FileMetadataCacheKey key(int32_t file, int64_t modificationTime = 1) {
+    return {files_[file].id(), modificationTime};
+  }
+
+  static std::shared_ptr<const void> makeMetadata(int32_t value) {
+    return std::make_shared<const int32_t>(value);
+  }
+
+  std::vector<StringIdLease> files_;
+};
+
+TEST_F(FileMetadataCacheTest, basic) {
+  FileMetadataCache cache(100);
+  EXPECT_EQ(cache.get(key(0)), nullptr);
+  cache.put(key(0), makeMetadata(0), 10);
+  cache.put(key(1), makeMetadata(1), 10);
+  EXPECT_EQ(*cache.get<int32_t>(key(0)), 0);
+  EXPECT_EQ(*cache.get<int32_t>(key(1)), 1);
+
+  // A different modification time is a different version of the file.
+  EXPECT_EQ(cache.get(key(0, 2)), nullptr);
+
+  // An existing entry is not replaced.
+  cache.put(key(0), makeMetadata(5), 10);
+  EXPECT_EQ(*cache.get<int32_t>(key(0)), 0);
+
+  // Entries larger than the cache are not added.
+  cache.put(key(2), makeMetadata(2), 101);
+  EXPECT_EQ(cache.get(key(2)), nullptr);
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 2);
+  EXPECT_EQ(stats.bytes, 20);
+  EXPECT_EQ(stats.numLookups, 6);
+  EXPECT_EQ(stats.numHits, 3);
+  EXPECT_EQ(stats.numEvictions, 0);
+}
+
+TEST_F(FileMetadataCacheTest, eviction) {
+  FileMetadataCache cache(100);
+  cache.put(key(0), makeMetadata(0), 40);
+  cache.put(key(1), makeMetadata(1), 40);
+  // Makes 'key(0)' the most recently used.
+  auto metadata = cache.get<int32_t>(key(0));
+  cache.put(key(2), makeMetadata(2), 40);
+  EXPECT_EQ(cache.get(key(1)), nullptr);
+  EXPECT_NE(cache.get(key(0)), nullptr);
+  EXPECT_NE(cache.get(key(2)), nullptr);
+  EXPECT_EQ(cache.stats().numEvictions, 1);
+
+  // Evicted metadata stays valid for its users.
+  cache.clear();
+  EXPECT_EQ(cache.get(key(0)), nullptr);
+  EXPECT_EQ(*metadata, 0);
+  EXPECT_EQ(cache.stats().bytes, 0);
+
+  cache.put(key(0), makeMetadata(0), 40);
+  cache.put(key(1), makeMetadata(1), 40);
+  EXPECT_EQ(cache.shrink(10), 40);
+  EXPECT_EQ(cache.get(key(0)), nullptr);
+  EXPECT_NE(cache.get(key(1)), nullptr);
+}
+
+TEST_F(FileMetadataCacheTest, removeFileEntries) {
+  FileMetadataCache cache(100);
+  for (auto i = 0; i < 4; ++i) {
+    cache.put(key(i), makeMetadata(i), 10);
+  }
+  cache.removeFileEntries({files_[1].id(), files_[3].id()});
+  EXPECT_NE(cache.get(key(0)), nullptr);
+  EXPECT_EQ(cache.get(key(1)), nullptr);
+  EXPECT_NE(cache.get(key(2)), nullptr);
+  EXPECT_EQ(cache.get(key(3)), nullptr);
+  EXPECT_EQ(cache.stats().bytes, 20);
+}
+
+TEST_F(FileMetadataCacheTest, fileIdLease) {
+  FileMetadataCache cache(100);
+  uint64_t fileNum;
+  {
+    StringIdLease lease(fileIds(), "/file_metadata/lease");
+    fileNum = lease.id();
+    cache.put({fileNum, 1}, makeMetadata(0), 10);
+  }
+  // The cache keeps the file id in use after the last lease is gone.
+  EXPECT_EQ(fileIds().string(fileNum), "/file_metadata/lease");
+  cache.clear();
+  EXPECT_EQ(fileIds().string(fileNum), "");
+}
+
+TEST_F(FileMetadataCacheTest, asyncDataCache) {
+  auto allocator = std::make_shared<memory::MmapAllocator>(
+      memory::MmapAllocator::Options{.capacity = 1024L * 1024L});
+  auto asyncCache = std::make_unique<AsyncDataCache>(allocator.get());
+  EXPECT_EQ(asyncCache->fileMetadataCache(), nullptr);
+  EXPECT_EQ(asyncCache->refreshStats().fileMetadataStats, nullptr);
+
+  AsyncDataCache::Options options;
+  options.maxFileMetadataBytes = 100;
+  asyncCache = std::make_unique<AsyncDataCache>(options, allocator.get());
+  auto* cache = asyncCache->fileMetadataCache();
+  ASSERT_NE(cache, nullptr);
+  EXPECT_EQ(cache->maxBytes(), 100);
+  cache->put(key(0), makeMetadata(0), 10);
+  cache->put(key(1), makeMetadata(1), 10);
+  EXPECT_EQ(asyncCache->refreshStats().fileMetadataStats->numEntries, 2);
+
+  // Files aged out of the data cache are dropped from the metadata cache.
+  folly::F14FastSet<uint64_t> filesRetained;
+  asyncCache->removeFileEntries({files_[0].id()}, filesRetained);
+  EXPECT_EQ(cache->get(key(0)), nullptr);
+  EXPECT_NE(cache->get(key(1)), nullptr);
+
+  asyncCache->clear();
+  EXPECT_EQ(cache->stats().numEntries, 0);
+}
+
+} // namespace
+} // namespace facebook::velox::cache
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include "gtest/gtest.h"
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+uint64_t hashOf(uint64_t key) {
+  return bits::hashMix(key, 0);
+}
+
+TEST(FrequencySketchTest, estimate) {
+  FrequencySketch sketch(1'000, 1'000'000);
+  EXPECT_EQ(sketch.width(), 1'024);
+  EXPECT_EQ(sketch.estimate(hashOf(1)), 0);
+  for (int32_t i = 0; i < 5; ++i) {
+    sketch.increment(hashOf(1));
+  }
+  for (int32_t i = 0; i < 2; ++i) {
+    sketch.increment(hashOf(2));
+  }
+  EXPECT_EQ(sketch.estimate(hashOf(1)), 5);
+  EXPECT_EQ(sketch.estimate(hashOf(2)), 2);
+
+  // Many keys seen once. Collisions may overestimate but never underestimate
+  // and the hot key stays ahead of nearly all of them.
+  int32_t numAboveHot = 0;
+  for (uint64_t key = 100; key < 600; ++key) {
+    sketch.increment(hashOf(key));
+  }
+  for (uint64_t key = 100; key < 600; ++key) {
+    const auto estimate = sketch.estimate(hashOf(key));
+    EXPECT_GE(estimate, 1);
+    numAboveHot += estimate >= 5;
+  }
+  EXPECT_LT(numAboveHot, 5);
+  EXPECT_GE(sketch.estimate(hashOf(1)), 5);
+
+  // Counters saturate.
+  for (int32_t i = 0; i < 100; ++i) {
+    sketch.increment(hashOf(3));
+  }
+  EXPECT_EQ(sketch.estimate(hashOf(3)), FrequencySketch::kMaxCount);
+  EXPECT_EQ(sketch.numAgings(), 0);
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch(64, 20);
+  EXPECT_EQ(sketch.agingWindow(), 20);
+  for (int32_t i = 0; i < 12; ++i) {
+    sketch.increment(hashOf(1));
+  }
+  for (int32_t i = 0; i < 7; ++i) {
+    sketch.increment(hashOf(2));
+  }
+  EXPECT_EQ(sketch.estimate(hashOf(1)), 12);
+  EXPECT_EQ(sketch.estimate(hashOf(2)), 7);
+
+  // The 20th increment halves all counts.
+  sketch.increment(hashOf(2));
+  EXPECT_EQ(sketch.numAgings(), 1);
+  EXPECT_EQ(sketch.estimate(hashOf(1)), 6);
+  EXPECT_EQ(sketch.estimate(hashOf(2)), 4);
+
+  // The default window is 10 times the width.
+  FrequencySketch defaultSketch(100);
+  EXPECT_EQ(defaultSketch.width(), 128);
+  EXPECT_EQ(defaultSketch.agingWindow(), 1'280);
+  VELOX_ASSERT_THROW(FrequencySketch(0), "");
+}
+
+} // namespace
@@ -29,6 +29,8 @@
 #include <gtest/gtest.h>
 #include <re2/re2.h>
 
+#include <random>
+
 using namespace facebook::velox;
 using namespace facebook::velox::cache;
 using namespace facebook::velox::tests::utils;
@@ -74,7 +76,8 @@ class SsdFileTest : public testing::Test {
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
       bool disableFileCow = false,
-      bool enableFaultInjection = false) {
+      bool enableFaultInjection = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_velox_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -88,7 +91,8 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        disableFileCow);
+        disableFileCow,
+        compressionKind);
   }
 
   void initializeSsdFile(
@@ -96,7 +100,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -105,7 +110,8 @@ class SsdFileTest : public testing::Test {
         disableFileCow,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        ssdExecutor());
+        ssdExecutor(),
+        compressionKind);
     ssdFile_ = std::make_unique<SsdFile>(config);
     if (ssdFile_ != nullptr) {
       ssdFileHelper_ =
@@ -172,6 +178,31 @@ class SsdFileTest : public testing::Test {
     }
   }
 
+  static void copyToAllocation(
+      const std::string& data,
+      memory::Allocation& alloc) {
+    size_t offset = 0;
+    for (int32_t i = 0; i < alloc.numRuns() && offset < data.size(); ++i) {
+      const auto run = alloc.runAt(i);
+      const auto bytes = std::min<size_t>(run.numBytes(), data.size() - offset);
+      ::memcpy(run.data<char>(), data.data() + offset, bytes);
+      offset += bytes;
+    }
+  }
+
+  static std::string copyFromAllocation(
+      const memory::Allocation& alloc,
+      size_t size) {
+    std::string data;
+    for (int32_t i = 0; i < alloc.numRuns() && data.size() < size; ++i) {
+      const auto run = alloc.runAt(i);
+      data.append(
+          run.data<char>(),
+          std::min<size_t>(run.numBytes(), size - data.size()));
+    }
+    return data;
+  }
+
   static folly::IOThreadPoolExecutor* ssdExecutor() {
     static std::unique_ptr<folly::IOThreadPoolExecutor> ssdExecutor =
         std::make_unique<folly::IOThreadPoolExecutor>(20);
@@ -691,6 +722,125 @@ TEST_F(SsdFileTest, recoverFromCheckpointWithChecksum) {
   }
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 3 * SsdFile::kRegionSize;
+  constexpr uint64_t kRandomOffset = 100 * kMB;
+  constexpr int32_t kRandomSize = 100'000;
+  FLAGS_velox_ssd_verify_write = true;
+
+  for (const auto kind :
+       {common::CompressionKind_LZ4, common::CompressionKind_ZSTD}) {
+    SCOPED_TRACE(common::compressionKindToString(kind));
+    initializeCache(
+        kSsdSize, checkpointIntervalBytes, true, true, false, false, kind);
+
+    auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+    std::vector<TestEntry> allEntries;
+    for (auto& pin : pins) {
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+    // Random bytes do not compress and are written as is.
+    std::string randomData(kRandomSize, 0);
+    std::mt19937 rng(1);
+    for (auto& c : randomData) {
+      c = static_cast<char>(rng());
+    }
+    pins.push_back(cache_->findOrCreate(
+        RawFileCacheKey{fileName_.id(), kRandomOffset}, kRandomSize, nullptr));
+    ASSERT_TRUE(pins.back().entry()->isExclusive());
+    copyToAllocation(randomData, pins.back().entry()->data());
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+    }
+    pins.clear();
+
+    SsdCacheStats stats;
+    ssdFile_->updateStats(stats);
+    EXPECT_EQ(stats.entriesWritten, allEntries.size() + 1);
+    EXPECT_EQ(stats.entriesCompressed, allEntries.size());
+    EXPECT_LT(stats.compressedBytes, stats.compressionInputBytes);
+    EXPECT_EQ(
+        stats.bytesSavedByCompression,
+        stats.compressionInputBytes - stats.compressedBytes);
+    EXPECT_EQ(stats.bytesCached, stats.bytesWritten);
+    const auto& randomRun = ssdFileHelper_->eEntries().at(
+        FileCacheKey{fileName_, kRandomOffset});
+    EXPECT_EQ(randomRun.compressionKind(), common::CompressionKind_NONE);
+    EXPECT_EQ(randomRun.rawSize(), kRandomSize);
+
+    // The entries are decompressed and checksummed on load.
+    cache_->clear();
+    EXPECT_EQ(checkEntries(allEntries), allEntries.size());
+    pins.push_back(cache_->findOrCreate(
+        RawFileCacheKey{fileName_.id(), kRandomOffset}, kRandomSize, nullptr));
+    std::vector<SsdPin> ssdPins;
+    ssdPins.push_back(
+        ssdFile_->find(RawFileCacheKey{fileName_.id(), kRandomOffset}));
+    ssdFile_->load(ssdPins, pins);
+    EXPECT_EQ(
+        copyFromAllocation(pins.back().entry()->data(), kRandomSize),
+        randomData);
+    pins.clear();
+    ssdPins.clear();
+    SsdCacheStats statsAfterRead;
+    ssdFile_->updateStats(statsAfterRead);
+    EXPECT_EQ(statsAfterRead.readSsdDecompressions, allEntries.size());
+    EXPECT_EQ(statsAfterRead.readSsdCorruptions, 0);
+
+    // The compressed entries are recovered from the checkpoint.
+    ssdFile_->checkpoint(true);
+    initializeSsdFile(
+        kSsdSize, checkpointIntervalBytes, true, true, false, kind);
+    SsdCacheStats statsAfterRecover;
+    ssdFile_->updateStats(statsAfterRecover);
+    EXPECT_EQ(statsAfterRecover.entriesCached, allEntries.size() + 1);
+    EXPECT_EQ(statsAfterRecover.bytesCached, stats.bytesCached);
+    EXPECT_EQ(
+        statsAfterRecover.bytesSavedByCompression,
+        stats.bytesSavedByCompression);
+    cache_->clear();
+    EXPECT_EQ(checkEntries(allEntries), allEntries.size());
+
+    // A file without compression reads the compressed entries of a
+    // checkpoint.
+    ssdFile_->checkpoint(true);
+    initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, true);
+    cache_->clear();
+    EXPECT_EQ(checkEntries(allEntries), allEntries.size());
+
+    cache_->shutdown();
+    memory::MemoryManager::testingSetInstance({});
+  }
+}
+
+TEST_F(SsdFileTest, compressionOfReplacedEntries) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(
+      kSsdSize, 0, false, false, false, false, common::CompressionKind_LZ4);
+
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ssdFile_->write(pins);
+  pins.clear();
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_GT(stats.bytesSavedByCompression, 0);
+
+  // Writing the same entries again replaces their runs. Only the new runs
+  // save space.
+  cache_->clear();
+  pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ssdFile_->write(pins);
+  pins.clear();
+  SsdCacheStats statsAfterReplace;
+  ssdFile_->updateStats(statsAfterReplace);
+  ASSERT_EQ(statsAfterReplace.entriesWritten, 2 * stats.entriesWritten);
+  ASSERT_EQ(
+      statsAfterReplace.bytesSavedByCompression, stats.bytesSavedByCompression);
+}
+
 TEST_F(SsdFileTest, recoverWithEvictedEntries) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -19,6 +19,9 @@
 #include <folly/synchronization/CallOnce.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringFile.h"
+#endif
 
 #include <cstdio>
 #include <filesystem>
@@ -93,7 +96,15 @@ class LocalFileSystem : public FileSystem {
                               std::thread::hardware_concurrency() / 2)),
                       std::make_shared<folly::NamedThreadFactory>(
                           "LocalReadahead"))
-                : nullptr) {}
+                : nullptr) {
+    if (options.ioUringEnabled) {
+#ifdef VELOX_ENABLE_IO_URING
+      ioUring_ = std::make_unique<IoUring>(IoUring::Options{});
+#else
+      VELOX_USER_FAIL("Velox is built without VELOX_ENABLE_IO_URING");
+#endif
+    }
+  }
 
   ~LocalFileSystem() override {
     if (executor_) {
@@ -116,6 +127,12 @@ class LocalFileSystem : public FileSystem {
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
       const FileOptions& options) override {
+#ifdef VELOX_ENABLE_IO_URING
+    if (ioUring_) {
+      return std::make_unique<IoUringReadFile>(
+          extractPath(path), ioUring_.get(), options.bufferIo);
+    }
+#endif
     return std::make_unique<LocalReadFile>(
         extractPath(path), executor_.get(), options.bufferIo);
   }
@@ -123,6 +140,16 @@ class LocalFileSystem : public FileSystem {
   std::unique_ptr<WriteFile> openFileForWrite(
       std::string_view path,
       const FileOptions& options) override {
+#ifdef VELOX_ENABLE_IO_URING
+    if (ioUring_) {
+      return std::make_unique<IoUringWriteFile>(
+          extractPath(path),
+          ioUring_.get(),
+          options.shouldCreateParentDirectories,
+          options.shouldThrowOnFileAlreadyExists,
+          options.bufferIo);
+    }
+#endif
     return std::make_unique<LocalWriteFile>(
         extractPath(path),
         options.shouldCreateParentDirectories,
@@ -251,6 +278,9 @@ class LocalFileSystem : public FileSystem {
 
  private:
   const std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+#ifdef VELOX_ENABLE_IO_URING
+  std::unique_ptr<IoUring> ioUring_;
+#endif
 };
 } // namespace
 
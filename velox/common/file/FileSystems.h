@@ -104,6 +104,12 @@ struct FileSystemOptions {
   /// async read by using a background cpu executor. Some filesystem might has
   /// native async read-ahead support.
   bool readAheadEnabled{false};
+
+  /// Only local file system respects this option. If true, local files are
+  /// read and written through io_uring, which makes asynchronous reads not
+  /// occupy a thread while in flight. Requires Velox to be built with
+  /// VELOX_ENABLE_IO_URING.
+  bool ioUringEnabled{false};
 };
 
 /// Free form statistics for a file system. The keys are arbitrary strings, and
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <folly/futures/Future.h>
+
+namespace facebook::velox {
+namespace {
+
+std::chrono::microseconds elapsedSince(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+uint64_t numBytesToRead(const std::vector<folly::Range<char*>>& buffers) {
+  uint64_t numBytes = 0;
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      numBytes += range.size();
+    }
+  }
+  return numBytes;
+}
+
+void addCounter(filesystems::File::IoStats* stats, std::string_view name) {
+  if (stats != nullptr) {
+    stats->addCounter(std::string(name), RuntimeCounter(1));
+  }
+}
+
+// Private memory for the ranges of one of the reads of a hedged read.
+struct PrivateBuffers {
+  std::vector<char> data;
+  std::vector<folly::Range<char*>> ranges;
+};
+
+std::shared_ptr<PrivateBuffers> makePrivateBuffers(
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t numBytes) {
+  auto privateBuffers = std::make_shared<PrivateBuffers>();
+  privateBuffers->data.resize(numBytes);
+  privateBuffers->ranges.reserve(buffers.size());
+  char* data = privateBuffers->data.data();
+  for (const auto& range : buffers) {
+    if (range.data() == nullptr) {
+      privateBuffers->ranges.push_back(range);
+      continue;
+    }
+    privateBuffers->ranges.emplace_back(data, range.size());
+    data += range.size();
+  }
+  return privateBuffers;
+}
+
+// A read that may be hedged. Shared by its reads and its hedging timer.
+struct HedgedRead {
+  HedgedRead(
+      uint64_t _offset,
+      uint64_t _numBytes,
+      const std::vector<folly::Range<char*>>& _buffers,
+      filesystems::File::IoStats* _stats)
+      : offset(_offset),
+        numBytes(_numBytes),
+        buffers(_buffers),
+        stats(_stats) {}
+
+  const uint64_t offset;
+  const uint64_t numBytes;
+  // The memory of 'buffers' and 'stats' belong to the caller and may be gone
+  // once 'done' is set.
+  const std::vector<folly::Range<char*>> buffers;
+  filesystems::File::IoStats* const stats;
+  const std::chrono::steady_clock::time_point start{
+      std::chrono::steady_clock::now()};
+
+  std::mutex mutex;
+  // Set when 'promise' is fulfilled.
+  bool done{false};
+  // Number of reads issued and not completed.
+  int32_t numPending{0};
+  folly::Promise<uint64_t> promise;
+};
+
+// Invoked when one of the reads of 'hedgedRead' completes. Fulfills the
+// promise with the first read to succeed or with the error if all fail.
+void readDone(
+    HedgedReadPolicy& policy,
+    HedgedRead& hedgedRead,
+    const PrivateBuffers& privateBuffers,
+    bool isHedge,
+    folly::Try<uint64_t>&& bytesRead) {
+  std::lock_guard<std::mutex> l(hedgedRead.mutex);
+  --hedgedRead.numPending;
+  if (hedgedRead.done) {
+    return;
+  }
+  if (bytesRead.hasException()) {
+    // The other read may still succeed.
+    if (hedgedRead.numPending > 0) {
+      return;
+    }
+  } else {
+    // Copies the bytes read, which may be fewer than requested at the end of
+    // the file.
+    const auto& buffers = hedgedRead.buffers;
+    uint64_t bytesLeft = bytesRead.value();
+    for (size_t i = 0; i < buffers.size() && bytesLeft > 0; ++i) {
+      const auto numBytes = std::min<uint64_t>(buffers[i].size(), bytesLeft);
+      if (buffers[i].data() != nullptr) {
+        ::memcpy(
+            buffers[i].data(), privateBuffers.ranges[i].data(), numBytes);
+      }
+      bytesLeft -= numBytes;
+    }
+    policy.recordLatency(elapsedSince(hedgedRead.start));
+    if (isHedge) {
+      policy.recordHedgeWin();
+      addCounter(hedgedRead.stats, HedgedReadFile::kNumHedgedReadWins);
+    }
+  }
+  hedgedRead.done = true;
+  hedgedRead.promise.setTry(std::move(bytesRead));
+}
+
+// Issues a read of 'hedgedRead' into private buffers on 'executor'. The
+// caller has counted the read in 'numPending'.
+void issueRead(
+    const std::shared_ptr<ReadFile>& file,
+    const std::shared_ptr<HedgedReadPolicy>& policy,
+    folly::Executor* executor,
+    const std::shared_ptr<HedgedRead>& hedgedRead,
+    bool isHedge) {
+  auto privateBuffers =
+      makePrivateBuffers(hedgedRead->buffers, hedgedRead->numBytes);
+  folly::via(
+      executor,
+      [file, offset = hedgedRead->offset, privateBuffers]() {
+        return file->preadv(offset, privateBuffers->ranges);
+      })
+      .thenTry([policy, hedgedRead, privateBuffers, isHedge](
+                   folly::Try<uint64_t>&& bytesRead) {
+        readDone(
+            *policy,
+            *hedgedRead,
+            *privateBuffers,
+            isHedge,
+            std::move(bytesRead));
+      });
+}
+
+} // namespace
+
+HedgedReadPolicy::HedgedReadPolicy(const Options& options)
+    : options_(options) {
+  VELOX_CHECK_GT(options_.latencyPercentile, 0);
+  VELOX_CHECK_LE(options_.latencyPercentile, 1);
+  VELOX_CHECK_GT(options_.numLatencySamples, 0);
+  VELOX_CHECK_LE(options_.minLatencySamples, options_.numLatencySamples);
+  VELOX_CHECK_LE(options_.minDelayUs, options_.maxDelayUs);
+  VELOX_CHECK_GE(options_.maxHedgeRatio, 0);
+  latenciesUs_.reserve(options_.numLatencySamples);
+}
+
+std::optional<std::chrono::microseconds> HedgedReadPolicy::startRead(
+    uint64_t numBytes) {
+  ++numReads_;
+  // A read that cannot be hedged is not read into private memory and has no
+  // hedging timer.
+  if (numBytes > options_.maxHedgeBytes || !hasHedgeBudget()) {
+    return std::nullopt;
+  }
+  const auto delayUs = delayUs_.load();
+  return std::chrono::microseconds(
+      delayUs == 0 ? options_.maxDelayUs : delayUs);
+}
+
+void HedgedReadPolicy::recordLatency(std::chrono::microseconds latency) {
+  std::lock_guard<std::mutex> l(mutex_);
+  const uint64_t latencyUs = latency.count();
+  if (latenciesUs_.size() < options_.numLatencySamples) {
+    latenciesUs_.push_back(latencyUs);
+  } else {
+    latenciesUs_[numLatencies_ % options_.numLatencySamples] = latencyUs;
+  }
+  ++numLatencies_;
+  if (numLatencies_ == options_.minLatencySamples ||
+      (numLatencies_ > options_.minLatencySamples &&
+       numLatencies_ % kRecomputeInterval == 0)) {
+    recomputeDelayLocked();
+  }
+}
+
+void HedgedReadPolicy::recomputeDelayLocked() {
+  if (latenciesUs_.empty()) {
+    return;
+  }
+  auto latenciesUs = latenciesUs_;
+  const auto index = std::min<size_t>(
+      latenciesUs.size() - 1,
+      options_.latencyPercentile * latenciesUs.size());
+  std::nth_element(
+      latenciesUs.begin(), latenciesUs.begin() + index, latenciesUs.end());
+  const auto delayUs = std::clamp(
+      latenciesUs[index], options_.minDelayUs, options_.maxDelayUs);
+  // 0 stands for no percentile yet.
+  delayUs_ = std::max<uint64_t>(delayUs, 1);
+}
+
+bool HedgedReadPolicy::tryHedge() {
+  if (!hasHedgeBudget()) {
+    return false;
+  }
+  ++numHedges_;
+  return true;
+}
+
+HedgedReadFile::HedgedReadFile(
+    std::shared_ptr<ReadFile> file,
+    std::shared_ptr<HedgedReadPolicy> policy,
+    folly::Executor* executor)
+    : file_(std::move(file)), policy_(std::move(policy)), executor_(executor) {
+  VELOX_CHECK_NOT_NULL(file_);
+  VELOX_CHECK_NOT_NULL(policy_);
+  VELOX_CHECK_NOT_NULL(executor_);
+}
+
+std::string_view HedgedReadFile::pread(
+    uint64_t offset,
+    uint64_t length,
+    void* buf,
+    filesystems::File::IoStats* stats) const {
+  auto* data = static_cast<char*>(buf);
+  const auto bytesRead =
+      preadv(offset, {folly::Range<char*>(data, length)}, stats);
+  VELOX_CHECK_EQ(
+      bytesRead,
+      length,
+      "pread failure in HedgedReadFile::pread, {} vs {}",
+      bytesRead,
+      length);
+  return {data, length};
+}
+
+uint64_t HedgedReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) const {
+  const auto numBytes = numBytesToRead(buffers);
+  const auto delay = policy_->startRead(numBytes);
+  if (!delay.has_value()) {
+    return file_->preadv(offset, buffers, stats);
+  }
+  return startHedgedRead(offset, numBytes, buffers, stats, *delay).get();
+}
+
+folly::SemiFuture<uint64_t> HedgedReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) const {
+  const auto numBytes = numBytesToRead(buffers);
+  const auto delay = policy_->startRead(numBytes);
+  if (!delay.has_value()) {
+    return folly::makeSemiFutureWith(
+        [&]() { return file_->preadv(offset, buffers, stats); });
+  }
+  return startHedgedRead(offset, numBytes, buffers, stats, *delay);
+}
+
+folly::SemiFuture<uint64_t> HedgedReadFile::startHedgedRead(
+    uint64_t offset,
+    uint64_t numBytes,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats,
+    std::chrono::microseconds delay) const {
+  auto hedgedRead =
+      std::make_shared<HedgedRead>(offset, numBytes, buffers, stats);
+  auto future = hedgedRead->promise.getSemiFuture();
+  hedgedRead->numPending = 1;
+  issueRead(file_, policy_, executor_, hedgedRead, false);
+
+  // The timer only checks the read and never waits on 'executor_'.
+  folly::futures::sleep(delay).toUnsafeFuture().thenValue(
+      [file = file_, policy = policy_, executor = executor_, hedgedRead](
+          folly::Unit) {
+        {
+          std::lock_guard<std::mutex> l(hedgedRead->mutex);
+          if (hedgedRead->done || !policy->tryHedge()) {
+            return;
+          }
+          ++hedgedRead->numPending;
+          addCounter(hedgedRead->stats, kNumHedgedReads);
+        }
+        issueRead(file, policy, executor, hedgedRead, true);
+      });
+  return future;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+/// Decides when the reads of HedgedReadFiles are hedged. Tracks the latencies
+/// of recent reads and limits the number of hedged reads to a fraction of all
+/// reads to cap the extra traffic. Shared by the files of a file system or a
+/// bucket whose latencies are alike. Thread safe.
+class HedgedReadPolicy {
+ public:
+  struct Options {
+    /// A read is hedged when it takes longer than this percentile of the
+    /// latencies of recent reads.
+    double latencyPercentile{0.95};
+
+    /// Number of recent read latencies the percentile is computed over.
+    uint32_t numLatencySamples{1'000};
+
+    /// Number of latencies to record before hedging by the percentile.
+    /// 'maxDelayUs' is the hedging delay until then.
+    uint32_t minLatencySamples{100};
+
+    /// Lower bound on the hedging delay. Avoids doubling the traffic of reads
+    /// that are all fast.
+    uint64_t minDelayUs{5'000};
+
+    /// Upper bound on the hedging delay. A read that is not done by this
+    /// deadline is hedged regardless of the percentile.
+    uint64_t maxDelayUs{2'000'000};
+
+    /// Maximum number of hedged reads as a fraction of all reads.
+    double maxHedgeRatio{0.05};
+
+    /// Reads of more bytes than this are not hedged. A hedged read is read
+    /// into private memory and copied out.
+    uint64_t maxHedgeBytes{16 << 20};
+  };
+
+  explicit HedgedReadPolicy(const Options& options);
+
+  /// Counts a read of 'numBytes'. Returns how long to wait for the read before
+  /// hedging it or std::nullopt if the read is not to be hedged, i.e. it is
+  /// too large or 'maxHedgeRatio' leaves no room for another hedged read.
+  std::optional<std::chrono::microseconds> startRead(uint64_t numBytes);
+
+  /// Records the latency of a read started with a hedging delay.
+  void recordLatency(std::chrono::microseconds latency);
+
+  /// Reserves a hedged read. Returns false if hedging a read now would exceed
+  /// 'maxHedgeRatio'.
+  bool tryHedge();
+
+  /// Invoked when the hedged read of a read returns first.
+  void recordHedgeWin() {
+    ++numHedgeWins_;
+  }
+
+  uint64_t numReads() const {
+    return numReads_;
+  }
+
+  uint64_t numHedges() const {
+    return numHedges_;
+  }
+
+  uint64_t numHedgeWins() const {
+    return numHedgeWins_;
+  }
+
+ private:
+  bool hasHedgeBudget() const {
+    return numHedges_ + 1 <= options_.maxHedgeRatio * numReads_;
+  }
+
+  // Number of new latencies after which the percentile is recomputed.
+  static constexpr uint64_t kRecomputeInterval = 16;
+
+  void recomputeDelayLocked();
+
+  const Options options_;
+
+  std::mutex mutex_;
+  // Ring buffer of the most recent read latencies.
+  std::vector<uint64_t> latenciesUs_;
+  uint64_t numLatencies_{0};
+
+  // The hedging delay by the percentile of 'latenciesUs_'. 0 until
+  // 'minLatencySamples' latencies are recorded.
+  std::atomic_uint64_t delayUs_{0};
+
+  std::atomic_uint64_t numReads_{0};
+  std::atomic_uint64_t numHedges_{0};
+  std::atomic_uint64_t numHedgeWins_{0};
+};
+
+/// Wraps a ReadFile, typically one of an object store, and hedges its slow
+/// reads: if a read does not return within the delay given by 'policy', the
+/// same read is issued again and the first response to succeed is used. The
+/// reads run on 'executor' and no thread waits for the hedging delay.
+///
+/// The reads that 'policy' does not allow to hedge are read from the wrapped
+/// file on the calling thread into the buffers of the caller, also by
+/// preadvAsync(). The others go to private memory so that the loser completes
+/// in the background, and the bytes read by the winner are copied out. The
+/// synchronous reads wait for these on the calling thread, which therefore
+/// must not be a thread of 'executor'.
+///
+/// Hedged reads record "numHedgedReads" and "numHedgedReadWins" in the
+/// IoStats of the read. The reads of the wrapped file do not get the IoStats
+/// when hedging is possible since the losing read may outlive them.
+class HedgedReadFile final : public ReadFile {
+ public:
+  static constexpr std::string_view kNumHedgedReads{"numHedgedReads"};
+  static constexpr std::string_view kNumHedgedReadWins{"numHedgedReadWins"};
+
+  HedgedReadFile(
+      std::shared_ptr<ReadFile> file,
+      std::shared_ptr<HedgedReadPolicy> policy,
+      folly::Executor* executor);
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  bool hasPreadvAsync() const final {
+    return true;
+  }
+
+  bool shouldCoalesce() const final {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const final {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const final {
+    return file_->memoryUsage();
+  }
+
+  uint64_t bytesRead() const final {
+    return file_->bytesRead();
+  }
+
+  void resetBytesRead() final {
+    file_->resetBytesRead();
+  }
+
+  std::string getName() const final {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const final {
+    return file_->getNaturalReadSize();
+  }
+
+ private:
+  // Reads 'numBytes' into 'buffers' on 'executor_' and hedges the read if it
+  // is not done after 'delay'.
+  folly::SemiFuture<uint64_t> startHedgedRead(
+      uint64_t offset,
+      uint64_t numBytes,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats,
+      std::chrono::microseconds delay) const;
+
+  const std::shared_ptr<ReadFile> file_;
+  const std::shared_ptr<HedgedReadPolicy> policy_;
+  folly::Executor* const executor_;
+};
+
+} // namespace facebook::velox
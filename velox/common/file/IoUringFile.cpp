@@ -0,0 +1,715 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringFile.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <folly/portability/SysUio.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Fs.h"
+
+namespace facebook::velox {
+namespace {
+
+// Transfers the bytes of 'request' after the first 'bytesDone' with blocking
+// system calls. Returns the number of bytes transferred, which is less than
+// requested only if a read reaches the end of the file.
+uint64_t finishTransfer(const IoUring::Request& request, uint64_t bytesDone) {
+  std::vector<iovec> iovecs;
+  if (request.buffer != nullptr) {
+    iovecs.push_back({request.buffer->data(), request.length});
+  } else {
+    iovecs = request.iovecs;
+  }
+  size_t first = 0;
+  auto advance = [&](uint64_t bytes) {
+    while (bytes > 0) {
+      const auto consumed = std::min<uint64_t>(bytes, iovecs[first].iov_len);
+      iovecs[first].iov_base =
+          static_cast<char*>(iovecs[first].iov_base) + consumed;
+      iovecs[first].iov_len -= consumed;
+      bytes -= consumed;
+      if (iovecs[first].iov_len == 0) {
+        ++first;
+      }
+    }
+  };
+  advance(bytesDone);
+
+  uint64_t bytesTransferred = 0;
+  while (bytesDone + bytesTransferred < request.length) {
+    const auto offset = request.offset + bytesDone + bytesTransferred;
+    const auto numIovecs = static_cast<int>(iovecs.size() - first);
+    const auto bytes = request.write
+        ? ::pwritev(request.fd, iovecs.data() + first, numIovecs, offset)
+        : ::preadv(request.fd, iovecs.data() + first, numIovecs, offset);
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    VELOX_CHECK_GE(
+        bytes,
+        0,
+        "{} failure at {}: {}",
+        request.write ? "pwritev" : "preadv",
+        offset,
+        folly::errnoStr(errno));
+    if (bytes == 0) {
+      VELOX_CHECK(!request.write, "pwritev wrote no bytes at {}", offset);
+      break;
+    }
+    bytesTransferred += bytes;
+    advance(bytes);
+  }
+  return bytesTransferred;
+}
+
+// Copies the data of 'iovecs' starting at 'iovec' and 'offsetInIovec' into
+// 'destination' and advances the position past the copied bytes.
+void copyFromIovecs(
+    const std::vector<iovec>& iovecs,
+    size_t& iovec,
+    uint64_t& offsetInIovec,
+    char* destination,
+    uint64_t size) {
+  while (size > 0) {
+    VELOX_CHECK_LT(iovec, iovecs.size());
+    const auto& source = iovecs[iovec];
+    const auto bytes = std::min<uint64_t>(size, source.iov_len - offsetInIovec);
+    ::memcpy(
+        destination,
+        static_cast<const char*>(source.iov_base) + offsetInIovec,
+        bytes);
+    destination += bytes;
+    size -= bytes;
+    offsetInIovec += bytes;
+    if (offsetInIovec == source.iov_len) {
+      ++iovec;
+      offsetInIovec = 0;
+    }
+  }
+}
+
+// Records the reads of 'requests' in 'stats'. Done before the requests are
+// submitted since 'stats' need not outlive the reads.
+void recordReads(
+    const std::vector<IoUring::Request>& requests,
+    filesystems::File::IoStats* stats) {
+  if (stats == nullptr) {
+    return;
+  }
+  uint64_t bytes = 0;
+  for (const auto& request : requests) {
+    bytes += request.length;
+  }
+  stats->addCounter(
+      std::string(IoUringReadFile::kNumIoUringReads),
+      RuntimeCounter(requests.size()));
+  stats->addCounter(
+      std::string(IoUringReadFile::kIoUringReadBytes),
+      RuntimeCounter(bytes, RuntimeCounter::Unit::kBytes));
+}
+
+} // namespace
+
+IoUring::Buffer::~Buffer() {
+  if (index_ >= 0) {
+    ioUring_->freeBuffer(*this);
+  } else {
+    std::free(data_);
+  }
+}
+
+IoUring::IoUring(const Options& options) : options_(options) {
+  VELOX_CHECK_GT(options_.queueDepth, 0);
+  VELOX_CHECK_GT(options_.registeredBufferSize, 0);
+  VELOX_CHECK_EQ(options_.registeredBufferSize % kDirectIoAlignment, 0);
+  const auto ret = io_uring_queue_init(options_.queueDepth, &ring_, 0);
+  VELOX_CHECK_EQ(
+      ret, 0, "io_uring_queue_init failure: {}", folly::errnoStr(-ret));
+  registerBuffers();
+  completionThread_ = std::thread([this]() { reapCompletions(); });
+}
+
+IoUring::~IoUring() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stopped_ = true;
+    // A request without user data tells the completion thread to exit once
+    // the requests in flight complete.
+    auto* sqe = nextSqeLocked();
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    submitRingLocked();
+  }
+  completionThread_.join();
+  io_uring_queue_exit(&ring_);
+  std::free(registeredMemory_);
+}
+
+void IoUring::registerBuffers() {
+  const auto numBuffers = options_.numRegisteredBuffers;
+  if (numBuffers == 0) {
+    return;
+  }
+  const auto bufferSize = options_.registeredBufferSize;
+  auto* memory = static_cast<char*>(
+      std::aligned_alloc(kDirectIoAlignment, numBuffers * bufferSize));
+  VELOX_CHECK_NOT_NULL(memory, "Failed to allocate io_uring buffers");
+  std::vector<iovec> iovecs(numBuffers);
+  for (uint32_t i = 0; i < numBuffers; ++i) {
+    iovecs[i] = {memory + i * bufferSize, bufferSize};
+  }
+  const auto ret =
+      io_uring_register_buffers(&ring_, iovecs.data(), iovecs.size());
+  if (ret < 0) {
+    LOG(WARNING) << "io_uring_register_buffers failure, O_DIRECT IO uses "
+                 << "unregistered buffers: " << folly::errnoStr(-ret);
+    std::free(memory);
+    return;
+  }
+  registeredMemory_ = memory;
+  for (auto i = static_cast<int32_t>(numBuffers) - 1; i >= 0; --i) {
+    freeRegisteredBuffers_.push_back(i);
+  }
+}
+
+std::shared_ptr<IoUring::Buffer> IoUring::allocateBuffer(uint64_t size) {
+  if (size <= options_.registeredBufferSize) {
+    std::lock_guard<std::mutex> l(buffersMutex_);
+    if (!freeRegisteredBuffers_.empty()) {
+      const auto index = freeRegisteredBuffers_.back();
+      freeRegisteredBuffers_.pop_back();
+      return std::shared_ptr<Buffer>(new Buffer(
+          this,
+          registeredMemory_ + index * options_.registeredBufferSize,
+          options_.registeredBufferSize,
+          index));
+    }
+  }
+  const auto allocationSize = bits::roundUp(size, kDirectIoAlignment);
+  auto* data = static_cast<char*>(
+      std::aligned_alloc(kDirectIoAlignment, allocationSize));
+  VELOX_CHECK_NOT_NULL(data, "Failed to allocate {} bytes", allocationSize);
+  return std::shared_ptr<Buffer>(new Buffer(this, data, allocationSize, -1));
+}
+
+void IoUring::freeBuffer(const Buffer& buffer) {
+  std::lock_guard<std::mutex> l(buffersMutex_);
+  freeRegisteredBuffers_.push_back(buffer.index());
+}
+
+std::vector<folly::SemiFuture<uint64_t>> IoUring::submit(
+    std::vector<Request> requests) {
+  std::vector<std::unique_ptr<InFlight>> inFlights;
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  inFlights.reserve(requests.size());
+  futures.reserve(requests.size());
+  for (auto& request : requests) {
+    VELOX_CHECK(
+        request.buffer == nullptr || request.length <= request.buffer->size());
+    auto inFlight = std::make_unique<InFlight>();
+    inFlight->request = std::move(request);
+    futures.push_back(inFlight->promise.getSemiFuture());
+    inFlights.push_back(std::move(inFlight));
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!stopped_, "Submit to a stopped io_uring");
+  for (auto& inFlight : inFlights) {
+    prepare(nextSqeLocked(), inFlight.get());
+    ++numInFlight_;
+    // Owned by the completion thread from here on.
+    inFlight.release();
+  }
+  submitRingLocked();
+  return futures;
+}
+
+// static
+void IoUring::prepare(io_uring_sqe* sqe, InFlight* inFlight) {
+  const auto& request = inFlight->request;
+  if (request.buffer != nullptr) {
+    auto* data = request.buffer->data();
+    const auto length = static_cast<unsigned>(request.length);
+    const auto index = request.buffer->index();
+    if (index >= 0) {
+      if (request.write) {
+        io_uring_prep_write_fixed(
+            sqe, request.fd, data, length, request.offset, index);
+      } else {
+        io_uring_prep_read_fixed(
+            sqe, request.fd, data, length, request.offset, index);
+      }
+    } else if (request.write) {
+      io_uring_prep_write(sqe, request.fd, data, length, request.offset);
+    } else {
+      io_uring_prep_read(sqe, request.fd, data, length, request.offset);
+    }
+  } else {
+    const auto numIovecs = static_cast<unsigned>(request.iovecs.size());
+    if (request.write) {
+      io_uring_prep_writev(
+          sqe, request.fd, request.iovecs.data(), numIovecs, request.offset);
+    } else {
+      io_uring_prep_readv(
+          sqe, request.fd, request.iovecs.data(), numIovecs, request.offset);
+    }
+  }
+  io_uring_sqe_set_data(sqe, inFlight);
+}
+
+io_uring_sqe* IoUring::nextSqeLocked() {
+  auto* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    // The submission queue is full. Hand its entries to the kernel.
+    submitRingLocked();
+    sqe = io_uring_get_sqe(&ring_);
+  }
+  VELOX_CHECK_NOT_NULL(sqe);
+  return sqe;
+}
+
+void IoUring::submitRingLocked() {
+  while (io_uring_sq_ready(&ring_) > 0) {
+    const auto ret = io_uring_submit(&ring_);
+    if (ret >= 0) {
+      continue;
+    }
+    // The kernel refuses new requests while the completion thread catches up
+    // with a full completion queue.
+    if (ret == -EINTR || ret == -EAGAIN || ret == -EBUSY) {
+      std::this_thread::yield();
+      continue;
+    }
+    VELOX_FAIL("io_uring_submit failure: {}", folly::errnoStr(-ret));
+  }
+}
+
+void IoUring::reapCompletions() {
+  bool stopping = false;
+  while (!stopping || numInFlight_ > 0) {
+    io_uring_cqe* cqe{nullptr};
+    const auto ret = io_uring_wait_cqe(&ring_, &cqe);
+    if (ret == -EINTR) {
+      continue;
+    }
+    VELOX_CHECK_EQ(
+        ret, 0, "io_uring_wait_cqe failure: {}", folly::errnoStr(-ret));
+    auto* inFlight = static_cast<InFlight*>(io_uring_cqe_get_data(cqe));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(&ring_, cqe);
+    if (inFlight == nullptr) {
+      stopping = true;
+      continue;
+    }
+    complete(inFlight, result);
+  }
+}
+
+void IoUring::complete(InFlight* inFlight, int32_t result) {
+  std::unique_ptr<InFlight> guard(inFlight);
+  const auto& request = inFlight->request;
+  try {
+    VELOX_CHECK_GE(
+        result,
+        0,
+        "io_uring {} failure at {}: {}",
+        request.write ? "write" : "read",
+        request.offset,
+        folly::errnoStr(-result));
+    uint64_t bytes = result;
+    // A transfer can come back short, e.g. when interrupted by a signal. This
+    // is rare, so the completion thread finishes the transfer itself rather
+    // than going through the submission queue, which it must never wait on.
+    if (bytes < request.length && (bytes > 0 || request.write)) {
+      bytes += finishTransfer(request, bytes);
+    }
+    inFlight->promise.setValue(bytes);
+  } catch (const std::exception&) {
+    inFlight->promise.setException(
+        folly::exception_wrapper(std::current_exception()));
+  }
+  --numInFlight_;
+}
+
+IoUringReadFile::IoUringReadFile(
+    std::string_view path,
+    IoUring* ioUring,
+    bool bufferIo)
+    : ioUring_(ioUring), path_(path), directIo_(!bufferIo) {
+  VELOX_CHECK_NOT_NULL(ioUring_);
+  int32_t flags = O_RDONLY;
+  if (directIo_) {
+    flags |= O_DIRECT;
+  }
+  fd_ = open(path_.c_str(), flags);
+  if (fd_ < 0) {
+    if (errno == ENOENT) {
+      VELOX_FILE_NOT_FOUND_ERROR("No such file or directory: {}", path);
+    } else {
+      VELOX_FAIL(
+          "open failure in IoUringReadFile constructor, {} {} {}.",
+          fd_,
+          path,
+          folly::errnoStr(errno));
+    }
+  }
+  const off_t ret = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(
+      ret,
+      0,
+      "fseek failure in IoUringReadFile constructor, {} {} {}.",
+      ret,
+      path,
+      folly::errnoStr(errno));
+  size_ = ret;
+}
+
+IoUringReadFile::~IoUringReadFile() {
+  const int ret = close(fd_);
+  if (ret < 0) {
+    LOG(WARNING) << "close failure in IoUringReadFile destructor: " << ret
+                 << ", " << folly::errnoStr(errno);
+  }
+}
+
+std::string_view IoUringReadFile::pread(
+    uint64_t offset,
+    uint64_t length,
+    void* buf,
+    filesystems::File::IoStats* stats) const {
+  auto* data = static_cast<char*>(buf);
+  const auto bytesRead =
+      preadv(offset, {folly::Range<char*>(data, length)}, stats);
+  VELOX_CHECK_EQ(
+      bytesRead,
+      length,
+      "pread failure in IoUringReadFile::pread, {} vs {}",
+      bytesRead,
+      length);
+  return {data, length};
+}
+
+uint64_t IoUringReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) const {
+  return preadvAsync(offset, buffers, stats).get();
+}
+
+folly::SemiFuture<uint64_t> IoUringReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) const {
+  uint64_t totalBytes = 0;
+  for (const auto& range : buffers) {
+    totalBytes += range.size();
+  }
+  bytesRead_ += totalBytes;
+  if (directIo_) {
+    return preadvDirect(offset, totalBytes, buffers, stats);
+  }
+
+  // Skipped ranges are not read. Each run of ranges to read becomes a request
+  // of at most IOV_MAX iovecs.
+  std::vector<IoUring::Request> requests;
+  uint64_t position = offset;
+  for (const auto& range : buffers) {
+    if (range.data() == nullptr) {
+      position += range.size();
+      continue;
+    }
+    if (requests.empty() ||
+        requests.back().offset + requests.back().length != position ||
+        requests.back().iovecs.size() >= IOV_MAX) {
+      IoUring::Request request;
+      request.fd = fd_;
+      request.offset = position;
+      requests.push_back(std::move(request));
+    }
+    requests.back().iovecs.push_back({range.data(), range.size()});
+    requests.back().length += range.size();
+    position += range.size();
+  }
+  if (requests.empty()) {
+    return folly::makeSemiFuture<uint64_t>(totalBytes);
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  ranges.reserve(requests.size());
+  for (const auto& request : requests) {
+    ranges.emplace_back(request.offset, request.length);
+  }
+  recordReads(requests, stats);
+  auto futures = ioUring_->submit(std::move(requests));
+  return folly::collect(std::move(futures))
+      .deferValue([offset, totalBytes, ranges = std::move(ranges)](
+                      std::vector<uint64_t> bytesRead) {
+        for (size_t i = 0; i < bytesRead.size(); ++i) {
+          if (bytesRead[i] < ranges[i].second) {
+            // The read reached the end of the file.
+            return ranges[i].first + bytesRead[i] - offset;
+          }
+        }
+        return totalBytes;
+      });
+}
+
+folly::SemiFuture<uint64_t> IoUringReadFile::preadvDirect(
+    uint64_t offset,
+    uint64_t totalBytes,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) const {
+  constexpr auto kAlignment = IoUring::kDirectIoAlignment;
+  const uint64_t begin = offset / kAlignment * kAlignment;
+  const uint64_t end = bits::roundUp(offset + totalBytes, kAlignment);
+  const uint64_t unitSize = ioUring_->registeredBufferSize();
+  std::vector<IoUring::Request> requests;
+  std::vector<std::shared_ptr<IoUring::Buffer>> units;
+  for (auto unitOffset = begin; unitOffset < end; unitOffset += unitSize) {
+    IoUring::Request request;
+    request.fd = fd_;
+    request.offset = unitOffset;
+    request.length = std::min(unitSize, end - unitOffset);
+    request.buffer = ioUring_->allocateBuffer(request.length);
+    units.push_back(request.buffer);
+    requests.push_back(std::move(request));
+  }
+  if (requests.empty()) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+
+  recordReads(requests, stats);
+  auto futures = ioUring_->submit(std::move(requests));
+  return folly::collect(std::move(futures))
+      .deferValue([skip = offset - begin,
+                   unitSize,
+                   buffers,
+                   units = std::move(units)](std::vector<uint64_t> bytesRead) {
+        // Bytes read from 'begin' up to the first short read at the end of
+        // the file.
+        uint64_t available = 0;
+        for (const auto bytes : bytesRead) {
+          available += bytes;
+          if (bytes < unitSize) {
+            break;
+          }
+        }
+        uint64_t position = skip;
+        for (const auto& range : buffers) {
+          if (range.data() == nullptr) {
+            position += range.size();
+            continue;
+          }
+          for (uint64_t copied = 0;
+               copied < range.size() && position < available;) {
+            const auto& unit = units[position / unitSize];
+            const auto offsetInUnit = position % unitSize;
+            const auto bytes = std::min(
+                {range.size() - copied,
+                 unitSize - offsetInUnit,
+                 available - position});
+            ::memcpy(range.data() + copied, unit->data() + offsetInUnit, bytes);
+            copied += bytes;
+            position += bytes;
+          }
+          if (position >= available) {
+            break;
+          }
+        }
+        return std::min(position, available) - std::min(skip, available);
+      });
+}
+
+IoUringWriteFile::IoUringWriteFile(
+    std::string_view path,
+    IoUring* ioUring,
+    bool shouldCreateParentDirectories,
+    bool shouldThrowOnFileAlreadyExists,
+    bool bufferIo)
+    : ioUring_(ioUring), path_(path), directIo_(!bufferIo) {
+  VELOX_CHECK_NOT_NULL(ioUring_);
+  const auto dir = fs::path(path_).parent_path();
+  if (shouldCreateParentDirectories && !fs::exists(dir)) {
+    VELOX_CHECK(
+        common::generateFileDirectory(dir.c_str()),
+        "Failed to generate file directory");
+  }
+
+  int32_t flags = O_WRONLY | O_CREAT;
+  if (shouldThrowOnFileAlreadyExists) {
+    flags |= O_EXCL;
+  }
+  if (directIo_) {
+    flags |= O_DIRECT;
+  }
+  fd_ = open(path_.c_str(), flags, S_IRUSR | S_IWUSR);
+  VELOX_CHECK_GE(
+      fd_,
+      0,
+      "Cannot open or create {}. Error: {}",
+      path_,
+      folly::errnoStr(errno));
+
+  const off_t ret = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(
+      ret,
+      0,
+      "fseek failure in IoUringWriteFile constructor, {} {} {}.",
+      ret,
+      path_,
+      folly::errnoStr(errno));
+  size_ = ret;
+}
+
+IoUringWriteFile::~IoUringWriteFile() {
+  try {
+    close();
+  } catch (const std::exception& ex) {
+    // We cannot throw an exception from the destructor. Warn instead.
+    LOG(WARNING) << "close failure in IoUringWriteFile destructor: "
+                 << ex.what();
+  }
+}
+
+void IoUringWriteFile::append(std::string_view data) {
+  std::vector<iovec> iovecs{{const_cast<char*>(data.data()), data.size()}};
+  writeAt(std::move(iovecs), size_, data.size());
+  size_ += data.size();
+}
+
+void IoUringWriteFile::append(std::unique_ptr<folly::IOBuf> data) {
+  std::vector<iovec> iovecs;
+  uint64_t length = 0;
+  for (auto range : *data) {
+    iovecs.push_back({const_cast<uint8_t*>(range.data()), range.size()});
+    length += range.size();
+  }
+  writeAt(std::move(iovecs), size_, length);
+  size_ += length;
+}
+
+void IoUringWriteFile::write(
+    const std::vector<iovec>& iovecs,
+    int64_t offset,
+    int64_t length) {
+  VELOX_CHECK_GE(offset, 0, "Offset cannot be negative.");
+  writeAt(iovecs, offset, length);
+  size_ = std::max<uint64_t>(size_, offset + length);
+}
+
+void IoUringWriteFile::writeAt(
+    std::vector<iovec> iovecs,
+    uint64_t offset,
+    uint64_t length) {
+  VELOX_CHECK(!closed_, "file is closed");
+  if (length == 0) {
+    return;
+  }
+  std::vector<IoUring::Request> requests;
+  if (!directIo_) {
+    for (size_t i = 0; i < iovecs.size(); i += IOV_MAX) {
+      IoUring::Request request;
+      request.write = true;
+      request.fd = fd_;
+      request.offset = requests.empty()
+          ? offset
+          : requests.back().offset + requests.back().length;
+      const auto numIovecs = std::min<size_t>(IOV_MAX, iovecs.size() - i);
+      request.iovecs.assign(
+          iovecs.begin() + i, iovecs.begin() + i + numIovecs);
+      for (const auto& iovec : request.iovecs) {
+        request.length += iovec.iov_len;
+      }
+      requests.push_back(std::move(request));
+    }
+  } else {
+    constexpr auto kAlignment = IoUring::kDirectIoAlignment;
+    VELOX_CHECK_EQ(offset % kAlignment, 0, "Unaligned O_DIRECT write offset");
+    VELOX_CHECK_EQ(length % kAlignment, 0, "Unaligned O_DIRECT write length");
+    const auto unitSize = ioUring_->registeredBufferSize();
+    size_t iovec = 0;
+    uint64_t offsetInIovec = 0;
+    for (uint64_t written = 0; written < length; written += unitSize) {
+      IoUring::Request request;
+      request.write = true;
+      request.fd = fd_;
+      request.offset = offset + written;
+      request.length = std::min(unitSize, length - written);
+      request.buffer = ioUring_->allocateBuffer(request.length);
+      copyFromIovecs(
+          iovecs,
+          iovec,
+          offsetInIovec,
+          request.buffer->data(),
+          request.length);
+      requests.push_back(std::move(request));
+    }
+  }
+
+  auto futures = ioUring_->submit(std::move(requests));
+  const auto bytesWritten = folly::collect(std::move(futures)).get();
+  uint64_t totalBytesWritten = 0;
+  for (const auto bytes : bytesWritten) {
+    totalBytesWritten += bytes;
+  }
+  VELOX_CHECK_EQ(
+      totalBytesWritten,
+      length,
+      "Failure in IoUringWriteFile::write, {} vs {}",
+      totalBytesWritten,
+      length);
+}
+
+void IoUringWriteFile::truncate(int64_t newSize) {
+  VELOX_CHECK(!closed_, "file is closed");
+  VELOX_CHECK_GE(newSize, 0, "New size cannot be negative.");
+  const auto ret = ::ftruncate(fd_, newSize);
+  VELOX_CHECK_EQ(
+      ret,
+      0,
+      "ftruncate failed in IoUringWriteFile::truncate: {}.",
+      folly::errnoStr(errno));
+  size_ = newSize;
+}
+
+void IoUringWriteFile::flush() {
+  VELOX_CHECK(!closed_, "file is closed");
+  const auto ret = ::fsync(fd_);
+  VELOX_CHECK_EQ(
+      ret,
+      0,
+      "fsync failed in IoUringWriteFile::flush: {}.",
+      folly::errnoStr(errno));
+}
+
+void IoUringWriteFile::close() {
+  if (!closed_) {
+    const auto ret = ::close(fd_);
+    VELOX_CHECK_EQ(
+        ret,
+        0,
+        "close failed in IoUringWriteFile::close: {}.",
+        folly::errnoStr(errno));
+    closed_ = true;
+  }
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <liburing.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+/// A Linux io_uring instance shared by the local files of a file system. The
+/// reads and writes of all files go through one submission queue and a
+/// completion thread fulfills the futures of the requests as the kernel
+/// completes them, so that an in-flight IO does not occupy a thread. Thread
+/// safe.
+class IoUring {
+ public:
+  /// Alignment of the file offsets, lengths and memory of O_DIRECT IO.
+  static constexpr uint64_t kDirectIoAlignment = 4096;
+
+  struct Options {
+    /// Number of submission queue entries.
+    uint32_t queueDepth{256};
+
+    /// Number of buffers registered with the kernel for O_DIRECT IO. The
+    /// kernel maps a registered buffer once instead of pinning the user pages
+    /// of every request. Registration is skipped with a warning if the kernel
+    /// refuses it, e.g. because of RLIMIT_MEMLOCK.
+    uint32_t numRegisteredBuffers{16};
+
+    /// Size of each registered buffer. O_DIRECT IO is done in units of at
+    /// most this size.
+    uint64_t registeredBufferSize{1 << 20};
+  };
+
+  /// Memory aligned for O_DIRECT IO. Either one of the registered buffers of
+  /// the ring or a heap allocation if all registered buffers are in use.
+  class Buffer {
+   public:
+    ~Buffer();
+
+    char* data() const {
+      return data_;
+    }
+
+    uint64_t size() const {
+      return size_;
+    }
+
+    /// Index of the buffer in the registered buffers of the ring or -1 if
+    /// the buffer is not registered.
+    int32_t index() const {
+      return index_;
+    }
+
+   private:
+    friend class IoUring;
+
+    Buffer(IoUring* ioUring, char* data, uint64_t size, int32_t index)
+        : ioUring_(ioUring), data_(data), size_(size), index_(index) {}
+
+    IoUring* const ioUring_;
+    char* const data_;
+    const uint64_t size_;
+    const int32_t index_;
+  };
+
+  /// A read or write of a byte range of a file. The memory is given by either
+  /// 'iovecs' or 'buffer'. 'buffer' is kept alive until the request completes
+  /// and a registered 'buffer' is transferred with a fixed buffer opcode.
+  struct Request {
+    bool write{false};
+    int32_t fd{-1};
+    uint64_t offset{0};
+    uint64_t length{0};
+    std::vector<iovec> iovecs;
+    std::shared_ptr<Buffer> buffer;
+  };
+
+  explicit IoUring(const Options& options);
+
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  /// Submits 'requests' to the kernel with one system call and returns a
+  /// future per request for the number of bytes transferred. Short transfers
+  /// are completed for the remainder, so a read returns less than its length
+  /// only at the end of the file.
+  std::vector<folly::SemiFuture<uint64_t>> submit(
+      std::vector<Request> requests);
+
+  /// Returns a buffer of at least 'size' bytes aligned for O_DIRECT IO. Returns
+  /// a registered buffer if 'size' fits and one is free.
+  std::shared_ptr<Buffer> allocateBuffer(uint64_t size);
+
+  uint64_t registeredBufferSize() const {
+    return options_.registeredBufferSize;
+  }
+
+ private:
+  // A submitted request and the promise of its future.
+  struct InFlight {
+    Request request;
+    folly::Promise<uint64_t> promise;
+  };
+
+  void registerBuffers();
+
+  void freeBuffer(const Buffer& buffer);
+
+  // Fills 'sqe' with the transfer of 'inFlight'.
+  static void prepare(io_uring_sqe* sqe, InFlight* inFlight);
+
+  // Returns a free submission queue entry, submitting the queued entries
+  // first if the queue is full.
+  io_uring_sqe* nextSqeLocked();
+
+  // Hands the queued submission queue entries to the kernel.
+  void submitRingLocked();
+
+  // Runs in 'completionThread_' until the destructor submits a request without
+  // user data.
+  void reapCompletions();
+
+  void complete(InFlight* inFlight, int32_t result);
+
+  const Options options_;
+
+  // Serializes the producers of the submission queue. The completion thread
+  // is the only consumer of the completion queue and never takes it.
+  std::mutex mutex_;
+  io_uring ring_;
+  bool stopped_{false};
+  std::atomic_uint64_t numInFlight_{0};
+
+  // Memory of the registered buffers. nullptr if registration failed.
+  char* registeredMemory_{nullptr};
+  std::mutex buffersMutex_;
+  std::vector<int32_t> freeRegisteredBuffers_;
+
+  std::thread completionThread_;
+};
+
+/// A local file read through an IoUring. preadvAsync() submits the reads to
+/// the ring and returns without occupying a thread while they are in flight.
+/// If 'bufferIo' is false the file is opened with O_DIRECT and reads go
+/// through aligned, preferably registered, buffers of the ring from which the
+/// requested ranges are copied out.
+///
+/// Reads record the number of requests submitted to the ring as
+/// "numIoUringReads" and the bytes they read from the file as
+/// "ioUringReadBytes" in their IoStats.
+class IoUringReadFile final : public ReadFile {
+ public:
+  static constexpr std::string_view kNumIoUringReads{"numIoUringReads"};
+  static constexpr std::string_view kIoUringReadBytes{"ioUringReadBytes"};
+
+  IoUringReadFile(std::string_view path, IoUring* ioUring, bool bufferIo);
+
+  ~IoUringReadFile() override;
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  bool hasPreadvAsync() const final {
+    return true;
+  }
+
+  uint64_t size() const final {
+    return size_;
+  }
+
+  uint64_t memoryUsage() const final {
+    return sizeof(*this);
+  }
+
+  bool shouldCoalesce() const final {
+    return false;
+  }
+
+  std::string getName() const final {
+    return path_;
+  }
+
+  uint64_t getNaturalReadSize() const final {
+    return 10 << 20;
+  }
+
+ private:
+  // Reads the ranges of 'buffers' with O_DIRECT into aligned buffers and
+  // copies them out once all reads complete.
+  folly::SemiFuture<uint64_t> preadvDirect(
+      uint64_t offset,
+      uint64_t totalBytes,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats) const;
+
+  IoUring* const ioUring_;
+  const std::string path_;
+  const bool directIo_;
+  int32_t fd_;
+  uint64_t size_;
+};
+
+/// A local file written through an IoUring. If 'bufferIo' is false the file is
+/// opened with O_DIRECT and the data is copied into aligned, preferably
+/// registered, buffers of the ring before it is written. As with
+/// LocalWriteFile, the offsets and lengths of O_DIRECT writes must then be
+/// aligned to IoUring::kDirectIoAlignment.
+class IoUringWriteFile final : public WriteFile {
+ public:
+  IoUringWriteFile(
+      std::string_view path,
+      IoUring* ioUring,
+      bool shouldCreateParentDirectories,
+      bool shouldThrowOnFileAlreadyExists,
+      bool bufferIo);
+
+  ~IoUringWriteFile() override;
+
+  void append(std::string_view data) final;
+
+  void append(std::unique_ptr<folly::IOBuf> data) final;
+
+  void write(const std::vector<iovec>& iovecs, int64_t offset, int64_t length)
+      final;
+
+  void truncate(int64_t newSize) final;
+
+  void flush() final;
+
+  void close() final;
+
+  uint64_t size() const final {
+    return size_;
+  }
+
+  const std::string getName() const final {
+    return path_;
+  }
+
+ private:
+  // Writes 'iovecs' totalling 'length' bytes at 'offset' and waits for the
+  // write to complete.
+  void writeAt(std::vector<iovec> iovecs, uint64_t offset, uint64_t length);
+
+  IoUring* const ioUring_;
+  const std::string path_;
+  const bool directIo_;
+  int32_t fd_{-1};
+  uint64_t size_{0};
+  bool closed_{false};
+};
+
+} // namespace facebook::velox
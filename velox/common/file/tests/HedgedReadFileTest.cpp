@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/tests/FaultyFile.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::tests::utils;
+
+namespace {
+
+class HedgedReadFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    data_.resize(1 << 20);
+    for (size_t i = 0; i < data_.size(); ++i) {
+      data_[i] = static_cast<char>(i * 13 + i / 1'000);
+    }
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  }
+
+  // Returns an in-memory file whose first read sleeps for 'delay' and then
+  // fails if 'failFirstRead' is true.
+  std::shared_ptr<ReadFile> makeFile(
+      std::chrono::milliseconds delay,
+      bool failFirstRead = false) {
+    auto hook = [this, delay, failFirstRead](FaultFileOperation* op) {
+      if (op->type != FaultFileOperation::Type::kReadv) {
+        return;
+      }
+      if (numFileReads_++ == 0) {
+        std::this_thread::sleep_for(delay);
+        VELOX_CHECK(!failFirstRead, "Injected read failure");
+      }
+    };
+    return std::make_shared<FaultyReadFile>(
+        "file", std::make_shared<InMemoryReadFile>(data_), hook, nullptr);
+  }
+
+  static HedgedReadPolicy::Options hedgeAfter(uint64_t delayUs) {
+    HedgedReadPolicy::Options options;
+    options.minLatencySamples = options.numLatencySamples;
+    options.minDelayUs = 0;
+    options.maxDelayUs = delayUs;
+    options.maxHedgeRatio = 1;
+    return options;
+  }
+
+  // Reads two ranges with a gap in between and checks the data.
+  void readAndVerify(
+      HedgedReadFile& file,
+      filesystems::File::IoStats* stats = nullptr) {
+    std::string first(1'000, 0);
+    std::string second(20'000, 0);
+    const uint64_t offset = 1'234;
+    const auto bytesRead = file.preadv(
+        offset,
+        {folly::Range<char*>(first.data(), first.size()),
+         folly::Range<char*>(nullptr, 500),
+         folly::Range<char*>(second.data(), second.size())},
+        stats);
+    EXPECT_EQ(bytesRead, first.size() + 500 + second.size());
+    EXPECT_EQ(first, data_.substr(offset, first.size()));
+    EXPECT_EQ(second, data_.substr(offset + first.size() + 500, second.size()));
+  }
+
+  std::string data_;
+  std::atomic_int32_t numFileReads_{0};
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+};
+
+TEST_F(HedgedReadFileTest, hedgeSlowRead) {
+  auto policy = std::make_shared<HedgedReadPolicy>(hedgeAfter(50'000));
+  HedgedReadFile file(
+      makeFile(std::chrono::milliseconds(500)), policy, executor_.get());
+  filesystems::File::IoStats stats;
+  readAndVerify(file, &stats);
+  EXPECT_EQ(policy->numReads(), 1);
+  EXPECT_EQ(policy->numHedges(), 1);
+  EXPECT_EQ(policy->numHedgeWins(), 1);
+  const auto metrics = stats.stats();
+  EXPECT_EQ(metrics.at(std::string(HedgedReadFile::kNumHedgedReads)).sum, 1);
+  EXPECT_EQ(
+      metrics.at(std::string(HedgedReadFile::kNumHedgedReadWins)).sum, 1);
+
+  // Reads that return within the delay are not hedged.
+  for (int32_t i = 0; i < 10; ++i) {
+    readAndVerify(file);
+  }
+  EXPECT_EQ(policy->numReads(), 11);
+  EXPECT_EQ(policy->numHedges(), 1);
+}
+
+TEST_F(HedgedReadFileTest, hedgeBudget) {
+  auto options = hedgeAfter(1'000);
+  options.maxHedgeRatio = 0;
+  auto policy = std::make_shared<HedgedReadPolicy>(options);
+  HedgedReadFile file(
+      makeFile(std::chrono::milliseconds(100)), policy, executor_.get());
+  filesystems::File::IoStats stats;
+  readAndVerify(file, &stats);
+  EXPECT_EQ(policy->numHedges(), 0);
+  EXPECT_EQ(numFileReads_, 1);
+  EXPECT_TRUE(stats.stats().empty());
+}
+
+TEST_F(HedgedReadFileTest, unhedgedReadsOnCallingThread) {
+  // Queues the tasks without running them.
+  class QueuedExecutor : public folly::Executor {
+   public:
+    void add(folly::Func func) override {
+      tasks.push_back(std::move(func));
+    }
+
+    std::vector<folly::Func> tasks;
+  } executor;
+  auto options = hedgeAfter(1'000);
+  options.maxHedgeRatio = 0;
+  HedgedReadFile file(
+      makeFile(std::chrono::milliseconds(0)),
+      std::make_shared<HedgedReadPolicy>(options),
+      &executor);
+  readAndVerify(file);
+  std::string buffer(100, 0);
+  auto future = file.preadvAsync(
+      10, {folly::Range<char*>(buffer.data(), buffer.size())});
+  ASSERT_TRUE(future.isReady());
+  EXPECT_EQ(std::move(future).get(), buffer.size());
+  EXPECT_EQ(buffer, data_.substr(10, buffer.size()));
+  EXPECT_TRUE(executor.tasks.empty());
+}
+
+TEST_F(HedgedReadFileTest, hedgeShortRead) {
+  auto policy = std::make_shared<HedgedReadPolicy>(hedgeAfter(1'000));
+  HedgedReadFile file(
+      makeFile(std::chrono::milliseconds(100)), policy, executor_.get());
+  // Only the bytes before the end of the file are copied out.
+  std::string buffer(2'000, 'x');
+  const uint64_t offset = data_.size() - 500;
+  EXPECT_EQ(
+      file.preadv(
+          offset, {folly::Range<char*>(buffer.data(), buffer.size())}),
+      500);
+  EXPECT_EQ(policy->numHedgeWins(), 1);
+  EXPECT_EQ(buffer.substr(0, 500), data_.substr(offset));
+  EXPECT_EQ(buffer.substr(500), std::string(1'500, 'x'));
+}
+
+TEST_F(HedgedReadFileTest, hedgeFailedRead) {
+  // The hedged read succeeds while the slow read fails.
+  auto policy = std::make_shared<HedgedReadPolicy>(hedgeAfter(1'000));
+  HedgedReadFile file(
+      makeFile(std::chrono::milliseconds(100), true), policy, executor_.get());
+  readAndVerify(file);
+  EXPECT_EQ(policy->numHedgeWins(), 1);
+
+  // A read that fails before it is hedged fails.
+  numFileReads_ = 0;
+  HedgedReadFile slowHedgeFile(
+      makeFile(std::chrono::milliseconds(0), true),
+      std::make_shared<HedgedReadPolicy>(hedgeAfter(10'000'000)),
+      executor_.get());
+  VELOX_ASSERT_THROW(readAndVerify(slowHedgeFile), "Injected read failure");
+}
+
+TEST_F(HedgedReadFileTest, policy) {
+  HedgedReadPolicy::Options options;
+  options.latencyPercentile = 0.9;
+  options.numLatencySamples = 100;
+  options.minLatencySamples = 100;
+  options.minDelayUs = 5'000;
+  options.maxDelayUs = 1'000'000;
+  options.maxHedgeBytes = 1'000;
+  options.maxHedgeRatio = 1;
+  HedgedReadPolicy policy(options);
+
+  EXPECT_FALSE(policy.startRead(1'001).has_value());
+  // The deadline applies until enough latencies are known.
+  EXPECT_EQ(policy.startRead(1'000)->count(), 1'000'000);
+  for (int32_t i = 1; i <= 100; ++i) {
+    policy.recordLatency(std::chrono::milliseconds(i));
+  }
+  EXPECT_EQ(policy.startRead(1'000)->count(), 91'000);
+  for (int32_t i = 0; i < 100; ++i) {
+    policy.recordLatency(std::chrono::microseconds(10));
+  }
+  EXPECT_EQ(policy.startRead(1'000)->count(), 5'000);
+
+  // At most 'maxHedgeRatio' of the reads are hedged.
+  options.maxHedgeRatio = 0.1;
+  HedgedReadPolicy budgetPolicy(options);
+  int32_t numHedges = 0;
+  int32_t numHedgeable = 0;
+  for (int32_t i = 0; i < 100; ++i) {
+    numHedgeable += budgetPolicy.startRead(100).has_value();
+    numHedges += budgetPolicy.tryHedge();
+  }
+  EXPECT_EQ(numHedges, 10);
+  EXPECT_EQ(budgetPolicy.numHedges(), 10);
+  // Reads are not hedgeable while the hedges use up the budget.
+  EXPECT_EQ(numHedgeable, 10);
+}
+
+} // namespace
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringFile.h"
+
+#include <fcntl.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+class IoUringFileTest : public testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    IoUring::Options options;
+    options.numRegisteredBuffers = 2;
+    options.registeredBufferSize = 64 << 10;
+    ioUring_ = std::make_unique<IoUring>(options);
+    tempDirectory_ = exec::test::TempDirectoryPath::create();
+    if (!bufferIo() && !supportsDirectIo()) {
+      GTEST_SKIP() << "O_DIRECT is not supported";
+    }
+  }
+
+  bool bufferIo() const {
+    return !GetParam();
+  }
+
+  // Returns false if the file system of the temp directory does not support
+  // O_DIRECT, e.g. tmpfs.
+  bool supportsDirectIo() {
+    const auto path = tempDirectory_->getPath() + "/probe";
+    const auto fd =
+        ::open(path.c_str(), O_WRONLY | O_CREAT | O_DIRECT, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      return false;
+    }
+    ::close(fd);
+    ::unlink(path.c_str());
+    return true;
+  }
+
+  // Writes 'size' bytes of a known pattern to 'path' and returns them.
+  std::string writeFile(const std::string& path, uint64_t size) {
+    // O_DIRECT writes whole pages, so the file is padded and truncated after.
+    std::string data(bits::roundUp(size, IoUring::kDirectIoAlignment), 0);
+    for (uint64_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<char>(i * 7 + i / 4096);
+    }
+    IoUringWriteFile file(path, ioUring_.get(), false, true, bufferIo());
+    // Pieces larger than a registered buffer.
+    const uint64_t pieceSize = 24 * IoUring::kDirectIoAlignment;
+    for (uint64_t offset = 0; offset < data.size(); offset += pieceSize) {
+      file.append(std::string_view(data).substr(offset, pieceSize));
+    }
+    file.truncate(size);
+    EXPECT_EQ(file.size(), size);
+    file.close();
+    data.resize(size);
+    return data;
+  }
+
+  std::unique_ptr<IoUring> ioUring_;
+  std::shared_ptr<exec::test::TempDirectoryPath> tempDirectory_;
+};
+
+TEST_P(IoUringFileTest, readWrite) {
+  const auto path = tempDirectory_->getPath() + "/file";
+  // Several registered buffers and a partial last page.
+  const uint64_t size = 10 * IoUring::kDirectIoAlignment * 16 + 1'000;
+  const auto data = writeFile(path, size);
+
+  IoUringReadFile file(path, ioUring_.get(), bufferIo());
+  ASSERT_EQ(file.size(), size);
+  ASSERT_TRUE(file.hasPreadvAsync());
+
+  std::string buffer(100, 0);
+  ASSERT_EQ(file.pread(1'234, 100, buffer.data()), data.substr(1'234, 100));
+
+  // Reads ranges with gaps in between, unaligned and across buffers.
+  std::string first(5'000, 0);
+  std::string second(200'000, 0);
+  std::vector<folly::Range<char*>> ranges = {
+      folly::Range<char*>(first.data(), first.size()),
+      folly::Range<char*>(nullptr, 3'333),
+      folly::Range<char*>(second.data(), second.size())};
+  const uint64_t offset = 17;
+  filesystems::File::IoStats stats;
+  auto future = file.preadvAsync(offset, ranges, &stats);
+  const uint64_t expectedBytes = first.size() + 3'333 + second.size();
+  EXPECT_EQ(std::move(future).get(), expectedBytes);
+  EXPECT_EQ(first, data.substr(offset, first.size()));
+  EXPECT_EQ(second, data.substr(offset + first.size() + 3'333, second.size()));
+  // Buffered reads skip the gap. O_DIRECT reads whole pages in units of a
+  // registered buffer.
+  const auto metrics = stats.stats();
+  const auto& readBytes =
+      metrics.at(std::string(IoUringReadFile::kIoUringReadBytes));
+  const auto& numReads =
+      metrics.at(std::string(IoUringReadFile::kNumIoUringReads));
+  if (bufferIo()) {
+    EXPECT_EQ(readBytes.sum, first.size() + second.size());
+    EXPECT_EQ(numReads.sum, 2);
+  } else {
+    const auto alignedBytes =
+        bits::roundUp(offset + expectedBytes, IoUring::kDirectIoAlignment);
+    EXPECT_EQ(readBytes.sum, alignedBytes);
+    EXPECT_EQ(numReads.sum, bits::divRoundUp(alignedBytes, 64 << 10));
+  }
+
+  // A read past the end of the file returns the bytes up to the end.
+  std::string tail(2'000, 0);
+  EXPECT_EQ(
+      file.preadv(size - 500, {folly::Range<char*>(tail.data(), tail.size())}),
+      500);
+  EXPECT_EQ(tail.substr(0, 500), data.substr(size - 500));
+  VELOX_ASSERT_THROW(
+      file.pread(size - 500, 1'000, tail.data()),
+      "pread failure in IoUringReadFile::pread");
+}
+
+TEST_P(IoUringFileTest, concurrentReads) {
+  const auto path = tempDirectory_->getPath() + "/file";
+  const uint64_t size = 1 << 20;
+  const auto data = writeFile(path, size);
+  IoUringReadFile file(path, ioUring_.get(), bufferIo());
+
+  // More requests in flight than the ring has registered buffers.
+  constexpr int32_t kNumReads = 64;
+  constexpr uint64_t kReadSize = 10'000;
+  std::vector<std::string> buffers(kNumReads, std::string(kReadSize, 0));
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  for (int32_t i = 0; i < kNumReads; ++i) {
+    futures.push_back(file.preadvAsync(
+        i * 15'000,
+        {folly::Range<char*>(buffers[i].data(), buffers[i].size())}));
+  }
+  for (int32_t i = 0; i < kNumReads; ++i) {
+    EXPECT_EQ(std::move(futures[i]).get(), kReadSize);
+    EXPECT_EQ(buffers[i], data.substr(i * 15'000, kReadSize));
+  }
+}
+
+TEST_P(IoUringFileTest, writeAtOffset) {
+  if (!bufferIo()) {
+    GTEST_SKIP() << "O_DIRECT writes must be aligned";
+  }
+  const auto path = tempDirectory_->getPath() + "/file";
+  IoUringWriteFile file(path, ioUring_.get(), false, true, true);
+  std::string first(100, 'a');
+  std::string second(50, 'b');
+  file.write(
+      {{first.data(), first.size()}, {second.data(), second.size()}}, 10, 150);
+  EXPECT_EQ(file.size(), 160);
+  file.truncate(20);
+  EXPECT_EQ(file.size(), 20);
+  file.close();
+  VELOX_ASSERT_THROW(file.append("x"), "file is closed");
+
+  std::unique_ptr<ReadFile> readFile =
+      std::make_unique<IoUringReadFile>(path, ioUring_.get(), true);
+  EXPECT_EQ(readFile->pread(10, 10), std::string(10, 'a'));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    IoUringFileTest,
+    IoUringFileTest,
+    testing::Values(false, true),
+    [](const testing::TestParamInfo<bool>& info) {
+      return info.param ? "directIo" : "bufferedIo";
+    });
+
+} // namespace
@@ -392,7 +392,11 @@ ArbitrationCandidate::ArbitrationCandidate(
       currentCapacity(participant->capacity()),
       reclaimableUsedCapacity(
           freeCapacityOnly ? 0 : participant->reclaimableUsedCapacity()),
-      reclaimableFreeCapacity(participant->reclaimableFreeCapacity()) {}
+      reclaimableFreeCapacity(participant->reclaimableFreeCapacity()),
+      predictedGrowth(std::max<int64_t>(
+          0,
+          static_cast<int64_t>(participant->predictedCapacity()) -
+              currentCapacity)) {}
 
 std::string ArbitrationCandidate::toString() const {
   return fmt::format(
@@ -196,6 +196,28 @@ class ArbitrationParticipant
     return pool_->capacity();
   }
 
+  /// Sets the fingerprint of the query and the predicted peak capacity of its
+  /// memory pool. See MemoryArbitrator::setPoolFingerprint().
+  void setFingerprint(
+      const std::string& fingerprint,
+      uint64_t predictedCapacity) {
+    std::lock_guard<std::mutex> l(stateLock_);
+    fingerprint_ = fingerprint;
+    predictedCapacity_ = predictedCapacity;
+  }
+
+  /// Returns the fingerprint of the query or an empty string if not set.
+  std::string fingerprint() const {
+    std::lock_guard<std::mutex> l(stateLock_);
+    return fingerprint_;
+  }
+
+  /// Returns the predicted peak capacity of the query memory pool or zero if
+  /// there is no prediction.
+  uint64_t predictedCapacity() const {
+    return predictedCapacity_;
+  }
+
   /// Gets the capacity growth targets based on 'requestBytes' and the query
   /// memory pool's current capacity. 'maxGrowBytes' is set to allow fast
   /// exponential growth when the query memory pool is small and switch to the
@@ -336,6 +358,8 @@ class ArbitrationParticipant
 
   mutable std::mutex stateLock_;
   bool aborted_{false};
+  std::string fingerprint_;
+  tsan_atomic<uint64_t> predictedCapacity_{0};
 
   // Points to the current running arbitration operation on this participant.
   ArbitrationOperation* runningOp_{nullptr};
@@ -398,6 +422,9 @@ struct ArbitrationCandidate {
   int64_t currentCapacity{0};
   int64_t reclaimableUsedCapacity{0};
   int64_t reclaimableFreeCapacity{0};
+  /// The capacity the participant is predicted to still grow by from its
+  /// usage history. Zero if there is no prediction.
+  int64_t predictedGrowth{0};
 
   /// If 'freeCapacityOnly' is true, the candidate is only used to reclaim free
   /// capacity so only collects the free capacity stats.
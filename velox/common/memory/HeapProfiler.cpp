@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/HeapProfiler.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Random.h>
+#include <folly/hash/Hash.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/process/StackTrace.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::memory {
+
+thread_local int64_t HeapProfiler::bytesUntilSample_{kNoSampleInterval};
+
+HeapProfiler::HeapProfiler(uint64_t samplingBytes, std::string dumpDirectory)
+    : samplingBytes_(samplingBytes), dumpDirectory_(std::move(dumpDirectory)) {
+  VELOX_CHECK_GT(samplingBytes_, 0);
+}
+
+// static
+uint64_t HeapProfiler::unsampledBytes(uint64_t bytes, uint64_t samplingBytes) {
+  // An allocation of 'bytes' is sampled with probability
+  // 1 - exp(-bytes / samplingBytes).
+  const double probability =
+      1 - std::exp(-static_cast<double>(bytes) / samplingBytes);
+  return probability > 0 ? bytes / probability : 0;
+}
+
+int64_t HeapProfiler::nextSampleInterval() const {
+  // Exponentially distributed intervals sample each byte with the same
+  // probability independent of the allocation sizes.
+  const double uniform = std::max(folly::Random::randDouble01(), 1e-12);
+  return std::max<int64_t>(1, -std::log(uniform) * samplingBytes_);
+}
+
+HeapProfiler::Shard& HeapProfiler::shardOf(uintptr_t address) {
+  return shards_[folly::hash::twang_mix64(address) % kNumShards];
+}
+
+void HeapProfiler::recordAllocation(
+    const void* address,
+    uint64_t bytes,
+    const MemoryPool& pool) {
+  if (address == nullptr) {
+    return;
+  }
+  const auto key = reinterpret_cast<uintptr_t>(address);
+  Sample sample{
+      bytes,
+      process::StackTrace().getStack(),
+      pool.root()->name(),
+      pool.name()};
+  auto& shard = shardOf(key);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  shard.samples.insert_or_assign(key, std::move(sample));
+}
+
+bool HeapProfiler::recordFree(const void* address) {
+  const auto key = reinterpret_cast<uintptr_t>(address);
+  auto& shard = shardOf(key);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  return shard.samples.erase(key) > 0;
+}
+
+size_t HeapProfiler::numSamples() const {
+  size_t numSamples{0};
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    numSamples += shard.samples.size();
+  }
+  return numSamples;
+}
+
+template <typename F>
+void HeapProfiler::forEachSample(const std::string& queryId, F func) const {
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    for (const auto& [_, sample] : shard.samples) {
+      if (queryId.empty() || sample.queryId == queryId) {
+        func(sample);
+      }
+    }
+  }
+}
+
+std::string HeapProfiler::profile(const std::string& queryId) const {
+  struct StackStats {
+    uint64_t count{0};
+    uint64_t bytes{0};
+  };
+  std::map<std::vector<void*>, StackStats> stacks;
+  StackStats total;
+  forEachSample(queryId, [&](const Sample& sample) {
+    auto& stats = stacks[sample.stack];
+    ++stats.count;
+    stats.bytes += sample.bytes;
+    ++total.count;
+    total.bytes += sample.bytes;
+  });
+
+  // The counts are of sampled allocations. pprof scales them by the sampling
+  // rate in the header. Only the allocations in use are known, so they are
+  // reported as the cumulative allocations too.
+  std::string out = fmt::format(
+      "heap profile: {}: {} [{}: {}] @ heap_v2/{}\n",
+      total.count,
+      total.bytes,
+      total.count,
+      total.bytes,
+      samplingBytes_);
+  for (const auto& [stack, stats] : stacks) {
+    out += fmt::format(
+        "{}: {} [{}: {}] @",
+        stats.count,
+        stats.bytes,
+        stats.count,
+        stats.bytes);
+    for (auto* frame : stack) {
+      out += fmt::format(" {}", frame);
+    }
+    out += "\n";
+  }
+
+  // pprof maps the addresses to symbols with the mappings of the process.
+  std::string maps;
+  if (folly::readFile("/proc/self/maps", maps)) {
+    out += "\nMAPPED_LIBRARIES:\n";
+    out += maps;
+  }
+  return out;
+}
+
+std::vector<std::pair<std::string, uint64_t>> HeapProfiler::usageByPool(
+    const std::string& queryId) const {
+  std::unordered_map<std::string, uint64_t> poolBytes;
+  forEachSample(queryId, [&](const Sample& sample) {
+    poolBytes[sample.poolName] += unsampledBytes(sample.bytes, samplingBytes_);
+  });
+  std::vector<std::pair<std::string, uint64_t>> usage(
+      poolBytes.begin(), poolBytes.end());
+  std::sort(usage.begin(), usage.end(), [](const auto& a, const auto& b) {
+    return a.second > b.second;
+  });
+  return usage;
+}
+
+std::string HeapProfiler::dumpProfile(const std::string& queryId) const {
+  if (dumpDirectory_.empty()) {
+    return "";
+  }
+  const auto path = fmt::format(
+      "{}/{}.{}.heap", dumpDirectory_, queryId, getCurrentTimeMs());
+  if (!folly::writeFile(profile(queryId), path.c_str())) {
+    VELOX_MEM_LOG(WARNING) << "Failed to write heap profile of " << queryId
+                           << " to " << path;
+    return "";
+  }
+
+  std::stringstream out;
+  out << "Heap profile of " << queryId << " written to " << path
+      << ", estimated usage by pool:";
+  for (const auto& [poolName, bytes] : usageByPool(queryId)) {
+    out << "\n  " << poolName << ": " << succinctBytes(bytes);
+  }
+  VELOX_MEM_LOG(INFO) << out.str();
+  return path;
+}
+
+} // namespace facebook::velox::memory
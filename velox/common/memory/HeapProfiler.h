@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Likely.h>
+#include <folly/container/F14Map.h>
+#include <array>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace facebook::velox::memory {
+
+class MemoryPool;
+
+/// Samples the allocations from memory pools to attribute the memory in use
+/// to call sites and pools. On average one allocation is sampled per
+/// 'samplingBytes' allocated, with the chance of sampling an allocation
+/// proportional to its size as in jemalloc and tcmalloc heap profiling. A
+/// sampled allocation keeps its stack, its pool and its query, i.e. its root
+/// pool, until it is freed. The pool of an operator identifies the operator.
+///
+/// The sampled allocations in use are written in the legacy heap profile
+/// format understood by pprof, e.g. 'pprof -http=: <binary> <profile>'.
+/// Thread safe.
+class HeapProfiler {
+ public:
+  /// Writes profiles to 'dumpDirectory' on dumpProfile() if not empty.
+  explicit HeapProfiler(uint64_t samplingBytes, std::string dumpDirectory = "");
+
+  uint64_t samplingBytes() const {
+    return samplingBytes_;
+  }
+
+  /// Returns true if the allocation of 'bytes' by the calling thread is to be
+  /// recorded with recordAllocation().
+  bool shouldSample(uint64_t bytes) {
+    if (FOLLY_UNLIKELY(bytesUntilSample_ == kNoSampleInterval)) {
+      // Draws the first interval of the thread like the others, so that the
+      // first allocation of a thread is not always sampled.
+      bytesUntilSample_ = nextSampleInterval();
+    }
+    bytesUntilSample_ -= static_cast<int64_t>(bytes);
+    if (FOLLY_LIKELY(bytesUntilSample_ > 0)) {
+      return false;
+    }
+    bytesUntilSample_ = nextSampleInterval();
+    return true;
+  }
+
+  /// Records the sampled allocation of 'bytes' at 'address' from 'pool' with
+  /// the stack of the calling thread.
+  void recordAllocation(
+      const void* address,
+      uint64_t bytes,
+      const MemoryPool& pool);
+
+  /// Forgets the sampled allocation at 'address'. Returns false if 'address'
+  /// is not sampled.
+  bool recordFree(const void* address);
+
+  /// Returns the number of sampled allocations in use.
+  size_t numSamples() const;
+
+  /// Returns the profile of the sampled allocations in use by the query with
+  /// root pool 'queryId', or by all queries if 'queryId' is empty.
+  std::string profile(const std::string& queryId = "") const;
+
+  /// Returns the estimated bytes in use by each pool of the query with root
+  /// pool 'queryId', largest first.
+  std::vector<std::pair<std::string, uint64_t>> usageByPool(
+      const std::string& queryId) const;
+
+  /// Writes the profile of 'queryId' to a new file in the dump directory and
+  /// logs its usage by pool. Returns the path of the file, or an empty string
+  /// if there is no dump directory.
+  std::string dumpProfile(const std::string& queryId) const;
+
+  /// Returns the estimate of the allocated bytes represented by a sampled
+  /// allocation of 'bytes' with 'samplingBytes'.
+  static uint64_t unsampledBytes(uint64_t bytes, uint64_t samplingBytes);
+
+ private:
+  static constexpr int32_t kNumShards = 32;
+  static constexpr int64_t kNoSampleInterval =
+      std::numeric_limits<int64_t>::min();
+
+  struct Sample {
+    uint64_t bytes;
+    std::vector<void*> stack;
+    std::string queryId;
+    std::string poolName;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    folly::F14FastMap<uintptr_t, Sample> samples;
+  };
+
+  // Returns the number of bytes to the next sampled allocation, drawn from an
+  // exponential distribution with mean 'samplingBytes_'.
+  int64_t nextSampleInterval() const;
+
+  Shard& shardOf(uintptr_t address);
+
+  // Calls 'func' with each sample of 'queryId', or each sample if 'queryId' is
+  // empty, holding the lock of its shard.
+  template <typename F>
+  void forEachSample(const std::string& queryId, F func) const;
+
+  // The bytes the calling thread allocates before its next sampled
+  // allocation, kNoSampleInterval before its first allocation.
+  static thread_local int64_t bytesUntilSample_;
+
+  const uint64_t samplingBytes_;
+  const std::string dumpDirectory_;
+  std::array<Shard, kNumShards> shards_;
+};
+
+} // namespace facebook::velox::memory
@@ -52,6 +52,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numaAware = options.mmapNumaAware;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -96,9 +97,16 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      reservationCacheEnabled_(options.reservationCacheEnabled),
       disableMemoryPoolTracking_(options.disableMemoryPoolTracking),
       getPreferredSize_(options.getPreferredSize),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
+      heapProfiler_(
+          options.heapProfileSamplingBytes > 0
+              ? std::make_unique<HeapProfiler>(
+                    options.heapProfileSamplingBytes,
+                    options.heapProfileDirectory)
+              : nullptr),
       sysRoot_{std::make_shared<MemoryPoolImpl>(
           this,
           std::string(kSysRootName),
@@ -114,6 +122,7 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .debugEnabled = options.debugEnabled,
               .coreOnAllocationFailureEnabled =
                   options.coreOnAllocationFailureEnabled,
+              .reservationCacheEnabled = options.reservationCacheEnabled,
               .getPreferredSize = getPreferredSize_})},
       spillPool_{addLeafPool("__sys_spilling__")},
       cachePool_{addLeafPool("__sys_caching__")},
@@ -249,6 +258,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.reservationCacheEnabled = reservationCacheEnabled_;
   options.getPreferredSize = getPreferredSize_;
 
   auto pool = createRootPool(poolName, reclaimer, options);
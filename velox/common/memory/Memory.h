@@ -37,6 +37,7 @@
 #include "velox/common/base/CheckedArithmetic.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/memory/Allocation.h"
+#include "velox/common/memory/HeapProfiler.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryPool.h"
 
@@ -84,6 +85,22 @@ struct MemoryManagerOptions {
   /// Disables the memory manager's tracking on memory pools.
   bool disableMemoryPoolTracking{false};
 
+  /// If not zero, samples on average one allocation from the memory pools per
+  /// 'heapProfileSamplingBytes' allocated to attribute the memory in use to
+  /// call sites and pools. See HeapProfiler.
+  uint64_t heapProfileSamplingBytes{0};
+
+  /// If not empty and heap profiling is enabled, the heap profile of a query
+  /// is written to this directory when the query fails to grow its memory
+  /// capacity.
+  std::string heapProfileDirectory;
+
+  /// If true, the leaf memory pools keep up to one reservation quantum beyond
+  /// their usage on free and only return it to their parent on a larger free
+  /// or on MemoryPool::release(). This avoids updating the shared ancestor
+  /// pools on each allocation and free around a quantum boundary.
+  bool reservationCacheEnabled{false};
+
   /// ================== 'MemoryAllocator' settings ==================
 
   /// Specifies the max memory allocation capacity in bytes enforced by
@@ -112,6 +129,12 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If true, keeps the memory of MmapAllocator per NUMA node and serves each
+  /// allocation from the node of the calling thread.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool mmapNumaAware{false};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -263,6 +286,12 @@ class MemoryManager {
 
   MemoryArbitrator* arbitrator();
 
+  /// Returns the sampling heap profiler of the memory pools, or nullptr if heap
+  /// profiling is disabled.
+  HeapProfiler* heapProfiler() const {
+    return heapProfiler_.get();
+  }
+
   /// Returns debug string of this memory manager. If 'detail' is true, it
   /// returns the detailed tree memory usage from all the top level root memory
   /// pools.
@@ -312,6 +341,7 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const bool reservationCacheEnabled_;
   const bool disableMemoryPoolTracking_;
   const std::function<size_t(size_t)> getPreferredSize_;
 
@@ -320,6 +350,10 @@ class MemoryManager {
   // the pool from 'pools_'.
   const MemoryPoolImpl::DestructionCallback poolDestructionCb_;
 
+  // Constructed before the memory pools which sample their allocations with
+  // it.
+  const std::unique_ptr<HeapProfiler> heapProfiler_;
+
   const std::shared_ptr<MemoryPool> sysRoot_;
   const std::shared_ptr<MemoryPool> spillPool_;
   const std::shared_ptr<MemoryPool> cachePool_;
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "velox/common/base/AsyncSource.h"
@@ -198,6 +199,24 @@ class MemoryArbitrator {
       bool allowSpill = true,
       bool allowAbort = false) = 0;
 
+  /// Associates the query memory 'pool' with 'fingerprint', which identifies
+  /// the recurring runs of a query with similar memory usage. An arbitrator
+  /// with usage history may grow the capacity of 'pool' up front to the
+  /// predicted usage and records the peak usage of 'pool' on removal. Should
+  /// be called before the query starts to allocate memory.
+  virtual void setPoolFingerprint(
+      MemoryPool* /*unused*/,
+      const std::string& /*unused*/) {}
+
+  /// Returns the predicted peak memory usage of the query with 'fingerprint'
+  /// if the arbitrator keeps usage history and has recorded earlier runs of
+  /// it. An admission control can use this, e.g. to accept the predicted bytes
+  /// from a common::AdmissionController before starting the query.
+  virtual std::optional<uint64_t> predictedUsage(
+      const std::string& /*unused*/) const {
+    return std::nullopt;
+  }
+
   /// The internal execution stats of the memory arbitrator.
   struct Stats {
     /// The number of arbitration requests.
@@ -22,6 +22,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/HeapProfiler.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/testutil/TestValue.h"
 
@@ -162,6 +163,14 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     recordFreeDbg(__VA_ARGS__);        \
   }
+#define HEAP_PROFILE_ALLOC(...)                   \
+  if (FOLLY_UNLIKELY(heapProfiler_ != nullptr)) { \
+    sampleAlloc(__VA_ARGS__);                     \
+  }
+#define HEAP_PROFILE_FREE(...)                    \
+  if (FOLLY_UNLIKELY(heapProfiler_ != nullptr)) { \
+    sampleFree(__VA_ARGS__);                      \
+  }
 #define DEBUG_LEAK_CHECK()             \
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
@@ -228,6 +237,7 @@ MemoryPool::MemoryPool(
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      reservationCacheEnabled_(options.reservationCacheEnabled),
       getPreferredSize_(
           options.getPreferredSize == nullptr
               ? [](size_t size) { return MemoryPool::getPreferredSize(size); }
@@ -437,6 +447,7 @@ MemoryPoolImpl::MemoryPoolImpl(
       manager_{memoryManager},
       allocator_{manager_->allocator()},
       arbitrator_{manager_->arbitrator()},
+      heapProfiler_{manager_->heapProfiler()},
       debugPoolNameRegex_(debugEnabled_ ? *(debugPoolNameRegex().rlock()) : ""),
       reclaimer_(std::move(reclaimer)),
       // The memory manager sets the capacity through grow() according to the
@@ -531,6 +542,7 @@ void* MemoryPoolImpl::allocate(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  HEAP_PROFILE_ALLOC(buffer, size);
   return buffer;
 }
 
@@ -551,6 +563,7 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  HEAP_PROFILE_ALLOC(buffer, size);
   return buffer;
 }
 
@@ -571,6 +584,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  HEAP_PROFILE_ALLOC(newP, newSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -582,6 +596,7 @@ void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const auto alignedSize = sizeAlign(size);
   DEBUG_RECORD_FREE(p, size);
+  HEAP_PROFILE_FREE(p);
   allocator_->freeBytes(p, alignedSize);
   release(alignedSize);
 }
@@ -599,6 +614,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  HEAP_PROFILE_FREE(out);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -619,6 +635,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  HEAP_PROFILE_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -627,6 +644,7 @@ void MemoryPoolImpl::allocateNonContiguous(
 void MemoryPoolImpl::freeNonContiguous(Allocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   DEBUG_RECORD_FREE(allocation);
+  HEAP_PROFILE_FREE(allocation);
   const int64_t freedBytes = allocator_->freeNonContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(freedBytes);
@@ -650,6 +668,7 @@ void MemoryPoolImpl::allocateContiguous(
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  HEAP_PROFILE_FREE(out);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -671,6 +690,7 @@ void MemoryPoolImpl::allocateContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  HEAP_PROFILE_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -680,6 +700,7 @@ void MemoryPoolImpl::freeContiguous(ContiguousAllocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const int64_t bytesToFree = allocation.size();
   DEBUG_RECORD_FREE(allocation);
+  HEAP_PROFILE_FREE(allocation);
   allocator_->freeContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(bytesToFree);
@@ -767,6 +788,7 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
           .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .reservationCacheEnabled = reservationCacheEnabled_,
           .getPreferredSize = getPreferredSize});
 }
 
@@ -880,13 +902,19 @@ void MemoryPoolImpl::growCapacity(MemoryPool* requestor, uint64_t size) {
   VELOX_CHECK(requestor->isLeaf());
   ++numCapacityGrowths_;
 
-  {
+  try {
     MemoryPoolArbitrationSection arbitrationSection(requestor);
     arbitrator_->growCapacity(this, size);
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() == error_code::kMemCapExceeded.c_str()) {
+      maybeDumpHeapProfile();
+    }
+    throw;
   }
   // The memory pool might have been aborted during the time it leaves the
   // arbitration no matter the arbitration succeed or not.
   if (FOLLY_UNLIKELY(aborted())) {
+    maybeDumpHeapProfile();
     // Release the reservation committed by the memory arbitration on success.
     decrementReservation(size);
     VELOX_CHECK_NOT_NULL(abortError());
@@ -946,16 +974,14 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && !reservationCacheEnabled_) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
       minReservationBytes_ = 0;
     } else {
       usedReservationBytes_ -= size;
-      const int64_t newCap =
-          std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = releaseTargetLocked();
     }
     freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
@@ -1330,4 +1356,57 @@ void MemoryPoolImpl::handleAllocationFailure(
 
   VELOX_MEM_ALLOC_ERROR(failureMessage);
 }
+
+void MemoryPoolImpl::sampleAlloc(const void* addr, uint64_t size) {
+  if (addr != nullptr && heapProfiler_->shouldSample(size)) {
+    heapProfiler_->recordAllocation(addr, size, *this);
+    std::lock_guard<std::mutex> l(heapSamplesMutex_);
+    heapSamples_.insert(reinterpret_cast<uint64_t>(addr));
+    ++numHeapSamples_;
+  }
+}
+
+void MemoryPoolImpl::sampleAlloc(const Allocation& allocation) {
+  if (!allocation.empty()) {
+    sampleAlloc(allocation.runAt(0).data(), allocation.byteSize());
+  }
+}
+
+void MemoryPoolImpl::sampleAlloc(const ContiguousAllocation& allocation) {
+  if (!allocation.empty()) {
+    sampleAlloc(allocation.data(), allocation.size());
+  }
+}
+
+void MemoryPoolImpl::sampleFree(const void* addr) {
+  if (numHeapSamples_ == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> l(heapSamplesMutex_);
+    if (heapSamples_.erase(reinterpret_cast<uint64_t>(addr)) == 0) {
+      return;
+    }
+    --numHeapSamples_;
+  }
+  heapProfiler_->recordFree(addr);
+}
+
+void MemoryPoolImpl::sampleFree(const Allocation& allocation) {
+  if (!allocation.empty()) {
+    sampleFree(allocation.runAt(0).data());
+  }
+}
+
+void MemoryPoolImpl::sampleFree(const ContiguousAllocation& allocation) {
+  if (!allocation.empty()) {
+    sampleFree(allocation.data());
+  }
+}
+
+void MemoryPoolImpl::maybeDumpHeapProfile() {
+  if (heapProfiler_ != nullptr) {
+    heapProfiler_->dumpProfile(name_);
+  }
+}
 } // namespace facebook::velox::memory
@@ -19,6 +19,7 @@
 #include <atomic>
 #include <memory>
 #include <optional>
+#include <unordered_set>
 
 #include <fmt/format.h>
 #include "velox/common/base/BitUtil.h"
@@ -38,6 +39,7 @@ class ParallelMemoryReclaimer;
 
 namespace facebook::velox::memory {
 class TestArbitrator;
+class HeapProfiler;
 class MemoryManager;
 
 constexpr int64_t kMaxMemory = std::numeric_limits<int64_t>::max();
@@ -139,6 +141,10 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// failure
     bool coreOnAllocationFailureEnabled{false};
 
+    /// If true, a leaf memory pool keeps up to one reservation quantum beyond
+    /// its usage on free. See MemoryManagerOptions::reservationCacheEnabled.
+    bool reservationCacheEnabled{false};
+
     /// Provides the customized get preferred size function. If not set, uses
     /// the memory pool's default function.
     std::function<size_t(size_t)> getPreferredSize{nullptr};
@@ -339,7 +345,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// If a minimum reservation has been set with maybeReserve(), resets the
   /// minimum reservation. If the current usage is below the minimum
   /// reservation, decreases reservation and usage down to the rounded actual
-  /// usage.
+  /// usage. Also returns the reservation kept by a leaf memory pool with
+  /// 'reservationCacheEnabled' beyond its rounded actual usage.
   virtual void release() = 0;
 
   /// Memory arbitration related interfaces.
@@ -530,6 +537,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const bool reservationCacheEnabled_;
   const std::function<size_t(size_t)> getPreferredSize_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
@@ -876,16 +884,14 @@ class MemoryPoolImpl : public MemoryPool {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && !reservationCacheEnabled_) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
       minReservationBytes_ = 0;
     } else {
       usedReservationBytes_ -= size;
-      const int64_t newCap =
-          std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = releaseTargetLocked();
     }
 
     const int64_t freeable = reservationBytes_ - newQuantized;
@@ -896,6 +902,23 @@ class MemoryPoolImpl : public MemoryPool {
     }
   }
 
+  // Returns the reservation to keep after a free. This is the quantized size
+  // of the used and minimum reservation. With 'reservationCacheEnabled_', the
+  // current reservation is kept if it is at most one quantum above that, so
+  // that allocations and frees around a quantum boundary do not update the
+  // ancestors each time. The whole reservation is returned once nothing is
+  // used so that the leak checks on destruction still hold.
+  FOLLY_ALWAYS_INLINE int64_t releaseTargetLocked() const {
+    const int64_t newCap =
+        std::max(minReservationBytes_, usedReservationBytes_);
+    const int64_t newQuantized = quantizedSize(newCap);
+    if (reservationCacheEnabled_ && newCap > 0 &&
+        reservationBytes_ <= quantizedSize(newQuantized + 1)) {
+      return reservationBytes_;
+    }
+    return newQuantized;
+  }
+
   // Decrements the reservation in 'this' and parents.
   void decrementReservation(uint64_t size) noexcept;
 
@@ -992,9 +1015,29 @@ class MemoryPoolImpl : public MemoryPool {
 
   void handleAllocationFailure(const std::string& failureMessage);
 
+  // Invoked to record a buffer allocation with 'heapProfiler_' if sampled.
+  void sampleAlloc(const void* addr, uint64_t size);
+
+  void sampleAlloc(const Allocation& allocation);
+
+  void sampleAlloc(const ContiguousAllocation& allocation);
+
+  // Invoked to drop a sampled allocation from 'heapProfiler_' on free.
+  void sampleFree(const void* addr);
+
+  void sampleFree(const Allocation& allocation);
+
+  void sampleFree(const ContiguousAllocation& allocation);
+
+  // Writes the heap profile of the query of this root pool if it fails to grow
+  // its capacity.
+  void maybeDumpHeapProfile();
+
   MemoryManager* const manager_;
   MemoryAllocator* const allocator_;
   MemoryArbitrator* const arbitrator_;
+  // Samples the allocations of this pool if heap profiling is enabled.
+  HeapProfiler* const heapProfiler_;
 
   // Regex for filtering on 'name_' when debug mode is enabled. This allows us
   // to only track the callsites of memory allocations for memory pools whose
@@ -1057,6 +1100,18 @@ class MemoryPoolImpl : public MemoryPool {
   // NOTE: this only applies for root memory pool.
   std::atomic_uint64_t numCapacityGrowths_{0};
 
+  // The number of allocations of this pool sampled by 'heapProfiler_' and not
+  // freed yet. Frees look up 'heapSamples_' only if this is not zero.
+  std::atomic_int64_t numHeapSamples_{0};
+
+  // Mutex for 'heapSamples_'.
+  std::mutex heapSamplesMutex_;
+
+  // The addresses of the allocations of this pool sampled by 'heapProfiler_'
+  // and not freed yet. Frees of other addresses do not reach the shared state
+  // of 'heapProfiler_'.
+  std::unordered_set<uint64_t> heapSamples_;
+
   // Mutex for 'debugAllocRecords_'.
   std::mutex debugAllocMutex_;
 
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/MemoryUsageHistory.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::memory {
+
+MemoryUsageHistory::MemoryUsageHistory(size_t maxEntries)
+    : maxEntries_(maxEntries) {
+  VELOX_CHECK_GT(maxEntries_, 0);
+}
+
+void MemoryUsageHistory::record(
+    const std::string& fingerprint,
+    uint64_t peakBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(fingerprint);
+  if (it == entries_.end()) {
+    if (entries_.size() >= maxEntries_) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.push_front(fingerprint);
+    it = entries_.emplace(fingerprint, Entry{}).first;
+  } else {
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  }
+  auto& entry = it->second;
+  entry.lruPosition = lru_.begin();
+  entry.peaks[entry.numRuns % kNumRuns] = peakBytes;
+  ++entry.numRuns;
+}
+
+std::optional<uint64_t> MemoryUsageHistory::predict(
+    const std::string& fingerprint) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(fingerprint);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  const auto& entry = it->second;
+  const auto numPeaks = std::min(entry.numRuns, kNumRuns);
+  return *std::max_element(
+      entry.peaks.begin(), entry.peaks.begin() + numPeaks);
+}
+
+size_t MemoryUsageHistory::numEntries() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.size();
+}
+
+} // namespace facebook::velox::memory
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <array>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace facebook::velox::memory {
+
+/// Remembers the peak memory usage of the recent runs of recurring queries,
+/// keyed by a query fingerprint supplied by the application, to predict the
+/// peak usage of their next run. The history of the least recently recorded
+/// fingerprints is dropped once there are more than 'maxEntries'. Thread
+/// safe.
+class MemoryUsageHistory {
+ public:
+  /// The number of recent runs a prediction is based on.
+  static constexpr int32_t kNumRuns = 4;
+
+  static constexpr size_t kDefaultMaxEntries = 10'000;
+
+  explicit MemoryUsageHistory(size_t maxEntries = kDefaultMaxEntries);
+
+  /// Records 'peakBytes' as the peak memory usage of a finished run of the
+  /// query with 'fingerprint'.
+  void record(const std::string& fingerprint, uint64_t peakBytes);
+
+  /// Returns the predicted peak memory usage of the query with 'fingerprint',
+  /// which is the largest peak of its last 'kNumRuns' runs. Returns
+  /// std::nullopt if no run has been recorded.
+  std::optional<uint64_t> predict(const std::string& fingerprint) const;
+
+  size_t numEntries() const;
+
+ private:
+  struct Entry {
+    // The peaks of the last runs in a circular buffer.
+    std::array<uint64_t, kNumRuns> peaks{};
+    int32_t numRuns{0};
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  const size_t maxEntries_;
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Entry> entries_;
+  // Keys of 'entries_', most recently recorded first.
+  std::list<std::string> lru_;
+};
+
+} // namespace facebook::velox::memory
@@ -28,6 +28,7 @@ MmapAllocator::MmapAllocator(const Options& options)
     : MemoryAllocator(options.largestSizeClass),
       kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
+      numNumaNodes_(options.numaAware ? process::numaNodeCount() : 1),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
           maxMallocBytes_ == 0
@@ -36,16 +37,22 @@ MmapAllocator::MmapAllocator(const Options& options)
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, bindNumaNode(node)));
+    }
   }
 
   if (useMmapArena_) {
     const auto arenaSizeBytes = bits::roundUp(
         AllocationTraits::pageBytes(capacity_) / options.mmapArenaCapacityRatio,
         AllocationTraits::kPageSize);
-    managedArenas_ = std::make_unique<ManagedMmapArenas>(
-        std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes));
+    for (auto node = 0; node < numNumaNodes_; ++node) {
+      managedArenas_.push_back(std::make_unique<ManagedMmapArenas>(
+          std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes),
+          bindNumaNode(node)));
+    }
   }
 }
 
@@ -92,14 +99,15 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
   MachinePageCount newMapsNeeded = 0;
+  const auto numaNode = allocationNumaNode();
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success = sizeClass(numaNode, sizeMix.sizeIndices[i])
+                        .allocate(sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -195,8 +203,8 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(AllocationTraits::pageBytes(
+          sizeClassSizes_[i % sizeClassSizes_.size()]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -251,7 +259,8 @@ bool MmapAllocator::allocateContiguousImpl(
     useHugePages(allocation, false);
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
-      managedArenas_->free(allocation.data(), allocation.maxSize());
+      arenasOf(allocation.data())
+          .free(allocation.data(), allocation.maxSize());
     } else {
       if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
         VELOX_MEM_LOG(ERROR) << "munmap got " << folly::errnoStr(errno)
@@ -326,9 +335,11 @@ bool MmapAllocator::allocateContiguousImpl(
   if (testingHasInjectedFailure(InjectedFailure::kMmap)) {
     data = nullptr;
   } else {
+    const auto numaNode = allocationNumaNode();
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
-      data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
+      data = managedArenas_[numaNode]->allocate(
+          AllocationTraits::pageBytes(maxPages));
     } else {
       data = ::mmap(
           nullptr,
@@ -337,6 +348,10 @@ bool MmapAllocator::allocateContiguousImpl(
           MAP_PRIVATE | MAP_ANONYMOUS,
           -1,
           0);
+      if (data != MAP_FAILED && numNumaNodes_ > 1) {
+        process::bindMemoryToNumaNode(
+            data, AllocationTraits::pageBytes(maxPages), numaNode);
+      }
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -373,7 +388,7 @@ void MmapAllocator::freeContiguousImpl(ContiguousAllocation& allocation) {
   useHugePages(allocation, false);
   if (useMmapArena_) {
     std::lock_guard<std::mutex> l(arenaMutex_);
-    managedArenas_->free(allocation.data(), allocation.maxSize());
+    arenasOf(allocation.data()).free(allocation.data(), allocation.maxSize());
   } else {
     if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
       VELOX_MEM_LOG(ERROR) << "munmap returned " << folly::errnoStr(errno)
@@ -499,17 +514,31 @@ void MmapAllocator::markAllMapped(const Allocation& allocation) {
 
 MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   MachinePageCount numAway = 0;
-  for (int32_t i = sizeClasses_.size() - 1; i >= 0; --i) {
-    numAway += sizeClasses_[i]->adviseAway(target - numAway);
-    if (numAway >= target) {
-      break;
+  // Advises away the largest size classes first, on all nodes.
+  for (int32_t i = sizeClassSizes_.size() - 1; i >= 0 && numAway < target;
+       --i) {
+    for (auto node = 0; node < numNumaNodes_ && numAway < target; ++node) {
+      numAway += sizeClass(node, i).adviseAway(target - numAway);
     }
   }
   numAdvisedPages_ += numAway;
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+ManagedMmapArenas& MmapAllocator::arenasOf(void* address) {
+  for (auto& arenas : managedArenas_) {
+    if (arenas->contains(address)) {
+      return *arenas;
+    }
+  }
+  // Let ManagedMmapArenas::free() report the bad address.
+  return *managedArenas_[0];
+}
+
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -537,6 +566,9 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         folly::errnoStr(errno),
         unitSize_);
   }
+  if (numaNode != process::kNoNumaNode) {
+    process::bindMemoryToNumaNode(ptr, byteSize_, numaNode);
+  }
   address_ = reinterpret_cast<uint8_t*>(ptr);
 }
 
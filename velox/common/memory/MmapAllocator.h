@@ -30,6 +30,7 @@
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryPool.h"
 #include "velox/common/memory/MmapArena.h"
+#include "velox/common/process/Numa.h"
 
 namespace facebook::velox::memory {
 
@@ -66,6 +67,12 @@ class MmapAllocator : public MemoryAllocator {
     /// capacity to single MmapArena capacity ratio.
     int32_t mmapArenaCapacityRatio = 10;
 
+    /// If set true and the machine has more than one NUMA node, the size
+    /// classes and MmapArenas are replicated per NUMA node, each preferably
+    /// backed by the memory of its node, and an allocation is served from the
+    /// node of the calling thread. 'capacity' is shared by all the nodes.
+    bool numaAware = false;
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'capacity' for ad hoc small allocations. And those allocations are
     /// delegated to std::malloc.
@@ -168,7 +175,9 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'numaNode' is not kNoNumaNode, the pages of this size class are
+    // preferably backed by the memory of that NUMA node.
+    SizeClass(size_t capacity, MachinePageCount unitSize, int32_t numaNode);
 
     ~SizeClass();
 
@@ -372,6 +381,25 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node to serve an allocation of the calling thread from.
+  int32_t allocationNumaNode() const {
+    return numNumaNodes_ == 1 ? 0 : process::currentNumaNode() % numNumaNodes_;
+  }
+
+  // Returns the NUMA node to bind new memory of 'numaNode' to.
+  int32_t bindNumaNode(int32_t numaNode) const {
+    return numNumaNodes_ == 1 ? process::kNoNumaNode : numaNode;
+  }
+
+  // Returns the size class with 'sizeIndex' in 'sizeClassSizes_' of
+  // 'numaNode'.
+  SizeClass& sizeClass(int32_t numaNode, int32_t sizeIndex) const {
+    return *sizeClasses_[numaNode * sizeClassSizes_.size() + sizeIndex];
+  }
+
+  // Returns the arenas 'address' was allocated from.
+  ManagedMmapArenas& arenasOf(void* address);
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -379,6 +407,10 @@ class MmapAllocator : public MemoryAllocator {
   // issued for each such allocation.
   const bool useMmapArena_;
 
+  // The number of NUMA nodes with their own size classes and arenas. 1 if not
+  // NUMA aware.
+  const int32_t numNumaNodes_;
+
   // Serializes moving capacity between size classes
   std::mutex sizeClassBalanceMutex_;
 
@@ -408,6 +440,8 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // The size classes of all the NUMA nodes. The size classes of a node are
+  // consecutive and in the order of 'sizeClassSizes_'.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
@@ -417,9 +451,10 @@ class MmapAllocator : public MemoryAllocator {
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
-  // ManagedMmapArenas, to avoid calling mmap on every allocation.
+  // ManagedMmapArenas, to avoid calling mmap on every allocation. There is one
+  // ManagedMmapArenas per NUMA node.
   std::mutex arenaMutex_;
-  std::unique_ptr<ManagedMmapArenas> managedArenas_;
+  std::vector<std::unique_ptr<ManagedMmapArenas>> managedArenas_;
 
   std::shared_ptr<Cache> cache_;
 };
@@ -177,6 +177,14 @@ bool SharedArbitrator::ExtraConfig::globalArbitrationEnabled(
       configs, kGlobalArbitrationEnabled, kDefaultGlobalArbitrationEnabled);
 }
 
+bool SharedArbitrator::ExtraConfig::memoryUsagePredictionEnabled(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<bool>(
+      configs,
+      kMemoryUsagePredictionEnabled,
+      kDefaultMemoryUsagePredictionEnabled);
+}
+
 bool SharedArbitrator::ExtraConfig::checkUsageLeak(
     const std::unordered_map<std::string, std::string>& configs) {
   return getConfig<bool>(configs, kCheckUsageLeak, kDefaultCheckUsageLeak);
@@ -258,6 +266,10 @@ SharedArbitrator::SharedArbitrator(const Config& config)
           ExtraConfig::globalArbitrationAbortTimeRatio(config.extraConfigs)),
       globalArbitrationWithoutSpill_(
           ExtraConfig::globalArbitrationWithoutSpill(config.extraConfigs)),
+      usageHistory_(
+          ExtraConfig::memoryUsagePredictionEnabled(config.extraConfigs)
+              ? std::make_unique<MemoryUsageHistory>()
+              : nullptr),
       freeReservedCapacity_(reservedCapacity_),
       freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
@@ -488,6 +500,16 @@ void SharedArbitrator::addPool(const std::shared_ptr<MemoryPool>& pool) {
 
 void SharedArbitrator::removePool(MemoryPool* pool) {
   VELOX_CHECK_EQ(pool->reservedBytes(), 0);
+  if (usageHistory_ != nullptr) {
+    std::shared_lock guard{participantLock_};
+    auto it = participants_.find(pool->name());
+    VELOX_CHECK(it != participants_.end());
+    const auto fingerprint = it->second->fingerprint();
+    // The peak of an aborted query is not its full usage.
+    if (!fingerprint.empty() && !it->second->aborted()) {
+      usageHistory_->record(fingerprint, pool->peakBytes());
+    }
+  }
   const uint64_t freedBytes = shrinkPool(pool, 0);
   VELOX_CHECK_EQ(pool->capacity(), 0);
   freeCapacity(freedBytes);
@@ -497,6 +519,67 @@ void SharedArbitrator::removePool(MemoryPool* pool) {
   VELOX_CHECK_EQ(ret, 1);
 }
 
+void SharedArbitrator::setPoolFingerprint(
+    MemoryPool* pool,
+    const std::string& fingerprint) {
+  if (usageHistory_ == nullptr || fingerprint.empty()) {
+    return;
+  }
+  checkRunning();
+  std::optional<ScopedArbitrationParticipant> participant;
+  {
+    std::shared_lock guard{participantLock_};
+    auto it = participants_.find(pool->name());
+    if (it == participants_.end()) {
+      return;
+    }
+    participant = it->second->lock();
+  }
+  if (!participant.has_value()) {
+    return;
+  }
+  const auto predictedBytes = usageHistory_->predict(fingerprint);
+  const uint64_t predictedCapacity = std::min(
+      participant.value()->maxCapacity(), predictedBytes.value_or(0));
+  participant.value()->setFingerprint(fingerprint, predictedCapacity);
+
+  const uint64_t capacity = participant.value()->capacity();
+  if (predictedCapacity <= capacity) {
+    return;
+  }
+  // Grows to the predicted capacity from the free capacity only. The growth
+  // is best effort and doesn't reclaim memory from the other queries.
+  std::vector<ContinuePromise> arbitrationWaiters;
+  {
+    std::lock_guard<std::mutex> l(stateMutex_);
+    const uint64_t allocatedBytes = allocateCapacityLocked(
+        participant.value()->id(), 0, predictedCapacity - capacity, 0);
+    if (allocatedBytes > 0) {
+      try {
+        checkedGrow(participant.value(), allocatedBytes, 0);
+      } catch (const VeloxRuntimeError& e) {
+        VELOX_MEM_LOG(ERROR)
+            << "Failed to allocate predicted capacity "
+            << succinctBytes(allocatedBytes)
+            << " for memory pool: " << participant.value()->name() << "\n"
+            << e.what();
+        freeCapacityLocked(allocatedBytes, arbitrationWaiters);
+      }
+    }
+  }
+  for (auto& waiter : arbitrationWaiters) {
+    waiter.setValue();
+  }
+}
+
+std::optional<uint64_t> SharedArbitrator::predictedUsage(
+    const std::string& fingerprint) const {
+  if (usageHistory_ == nullptr) {
+    return std::nullopt;
+  }
+  return usageHistory_->predict(fingerprint);
+}
+
 std::vector<ArbitrationCandidate> SharedArbitrator::getCandidates(
     bool freeCapacityOnly) {
   std::vector<ArbitrationCandidate> candidates;
@@ -531,7 +614,8 @@ void SharedArbitrator::sortCandidatesByReclaimableUsedCapacity(
       candidates.begin(),
       candidates.end(),
       [](const ArbitrationCandidate& lhs, const ArbitrationCandidate& rhs) {
-        return lhs.reclaimableUsedCapacity > rhs.reclaimableUsedCapacity;
+        return lhs.reclaimableUsedCapacity + lhs.predictedGrowth >
+            rhs.reclaimableUsedCapacity + rhs.predictedGrowth;
       });
 
   TestValue::adjust(
@@ -1108,7 +1192,7 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
   for (auto& candidate : candidates) {
     if (candidate.reclaimableUsedCapacity <
         participantConfig_.minReclaimBytes) {
-      break;
+      continue;
     }
     if (failedParticipants.count(candidate.participant->id()) != 0) {
       VELOX_CHECK_EQ(
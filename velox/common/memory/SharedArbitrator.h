@@ -27,6 +27,7 @@
 #include "velox/common/memory/ArbitrationParticipant.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/memory/MemoryUsageHistory.h"
 
 namespace facebook::velox::memory {
 namespace test {
@@ -218,6 +219,17 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     static bool globalArbitrationWithoutSpill(
         const std::unordered_map<std::string, std::string>& configs);
 
+    /// If true, records the peak capacity of the query memory pools with a
+    /// fingerprint set by setPoolFingerprint() on their removal. A query memory
+    /// pool whose fingerprint has history then gets its predicted capacity up
+    /// front from the free capacity, and global arbitration prefers to spill
+    /// the queries predicted to grow the most. See MemoryUsageHistory.
+    static constexpr std::string_view kMemoryUsagePredictionEnabled{
+        "memory-usage-prediction-enabled"};
+    static constexpr bool kDefaultMemoryUsagePredictionEnabled{false};
+    static bool memoryUsagePredictionEnabled(
+        const std::unordered_map<std::string, std::string>& configs);
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -252,6 +264,12 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       bool allowSpill = true,
       bool force = false) override final;
 
+  void setPoolFingerprint(MemoryPool* pool, const std::string& fingerprint)
+      final;
+
+  std::optional<uint64_t> predictedUsage(
+      const std::string& fingerprint) const final;
+
   Stats stats() const final;
 
   std::string kind() const override;
@@ -461,6 +479,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   uint64_t reclaimUsedMemoryBySpill(uint64_t targetBytes);
 
   // Sorts 'candidates' based on reclaimable used capacity in descending order.
+  // The predicted growth of a candidate is added to its reclaimable used
+  // capacity so that a query that is predicted to still grow is spilled before
+  // a query of the same size that is close to its predicted peak.
   static void sortCandidatesByReclaimableUsedCapacity(
       std::vector<ArbitrationCandidate>& candidates);
 
@@ -599,6 +620,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   const uint32_t globalArbitrationMemoryReclaimPct_;
   const double globalArbitrationAbortTimeRatio_;
   const bool globalArbitrationWithoutSpill_;
+  // The peak capacities of past query memory pools by fingerprint. Null if
+  // memory usage prediction is disabled.
+  const std::unique_ptr<MemoryUsageHistory> usageHistory_;
 
   // The executor used to reclaim memory from multiple participants in parallel
   // at the background for global arbitration or external memory reclamation.
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/HeapProfiler.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <thread>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+namespace {
+
+TEST(HeapProfilerTest, disabledByDefault) {
+  MemoryManager manager{};
+  ASSERT_EQ(manager.heapProfiler(), nullptr);
+}
+
+TEST(HeapProfilerTest, unsampledBytes) {
+  // Allocations much larger than the sampling interval are always sampled.
+  ASSERT_EQ(HeapProfiler::unsampledBytes(1UL << 30, 1 << 10), 1UL << 30);
+  // A small allocation stands for about the sampling interval.
+  ASSERT_NEAR(HeapProfiler::unsampledBytes(1, 1 << 20), 1 << 20, 1);
+}
+
+TEST(HeapProfilerTest, firstAllocationOfThread) {
+  // A byte is sampled with a chance of 1 in 2^40. The first allocation of a
+  // thread is as unlikely to be sampled as the others.
+  HeapProfiler profiler(1UL << 40);
+  std::atomic_int32_t numSampled{0};
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 16; ++i) {
+    threads.emplace_back([&]() {
+      if (profiler.shouldSample(1'000)) {
+        ++numSampled;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(numSampled, 0);
+}
+
+TEST(HeapProfilerTest, sampleAllocations) {
+  auto dumpDirectory = exec::test::TempDirectoryPath::create();
+  // Samples every allocation.
+  MemoryManager manager{MemoryManagerOptions{
+      .heapProfileSamplingBytes = 1,
+      .heapProfileDirectory = dumpDirectory->getPath()}};
+  auto* profiler = manager.heapProfiler();
+  ASSERT_NE(profiler, nullptr);
+  auto root = manager.addRootPool("query1");
+  auto leaf = root->addLeafChild("op.1.0.0.HashBuild");
+  auto otherRoot = manager.addRootPool("query2");
+  auto otherLeaf = otherRoot->addLeafChild("op.1.0.0.OrderBy");
+
+  void* first = leaf->allocate(1'000);
+  void* second = leaf->allocate(2'000);
+  void* other = otherLeaf->allocate(3'000);
+  Allocation allocation;
+  leaf->allocateNonContiguous(4, allocation);
+  ASSERT_EQ(profiler->numSamples(), 4);
+
+  const auto usage = profiler->usageByPool("query1");
+  ASSERT_EQ(usage.size(), 1);
+  ASSERT_EQ(usage[0].first, leaf->name());
+  ASSERT_GE(usage[0].second, 3'000 + allocation.byteSize());
+
+  const auto profile = profiler->profile("query1");
+  ASSERT_EQ(
+      profile.find(fmt::format(
+          "heap profile: 3: {} [3: {}] @ heap_v2/1\n",
+          3'000 + allocation.byteSize(),
+          3'000 + allocation.byteSize())),
+      0);
+  ASSERT_NE(profile.find("MAPPED_LIBRARIES:"), std::string::npos);
+
+  leaf->free(first, 1'000);
+  leaf->freeNonContiguous(allocation);
+  ASSERT_EQ(profiler->numSamples(), 2);
+  ASSERT_EQ(profiler->usageByPool("query1")[0].second, 2'000);
+
+  const auto path = profiler->dumpProfile("query1");
+  ASSERT_TRUE(std::filesystem::exists(path));
+
+  leaf->free(second, 2'000);
+  otherLeaf->free(other, 3'000);
+  ASSERT_EQ(profiler->numSamples(), 0);
+  ASSERT_TRUE(profiler->usageByPool("query1").empty());
+}
+
+TEST(HeapProfilerTest, dumpOnCapacityExceeded) {
+  auto dumpDirectory = exec::test::TempDirectoryPath::create();
+  MemoryManager manager{MemoryManagerOptions{
+      .heapProfileSamplingBytes = 1,
+      .heapProfileDirectory = dumpDirectory->getPath()}};
+  auto root = manager.addRootPool("query", 8 << 20);
+  auto leaf = root->addLeafChild("leaf");
+  void* buffer = leaf->allocate(4 << 20);
+  VELOX_ASSERT_THROW(leaf->allocate(8 << 20), "Exceeded memory pool capacity");
+
+  int32_t numProfiles{0};
+  for (const auto& entry :
+       std::filesystem::directory_iterator(dumpDirectory->getPath())) {
+    ASSERT_EQ(entry.path().filename().string().find("query."), 0);
+    ++numProfiles;
+  }
+  ASSERT_EQ(numProfiles, 1);
+  leaf->free(buffer, 4 << 20);
+}
+
+} // namespace
@@ -1747,6 +1747,22 @@ TEST_F(MmapArenaTest, managedMmapArenas) {
   }
 }
 
+TEST_F(MmapArenaTest, managedMmapArenasContains) {
+  ManagedMmapArenas managedArenas(
+      kArenaCapacityBytes, process::currentNumaNode());
+  auto* data = reinterpret_cast<char*>(
+      managedArenas.allocate(kArenaCapacityBytes / 2));
+  ASSERT_TRUE(managedArenas.contains(data));
+  ASSERT_TRUE(managedArenas.contains(data + kArenaCapacityBytes / 2 - 1));
+  const auto* arenaStart =
+      reinterpret_cast<char*>(managedArenas.arenas().begin()->first);
+  ASSERT_FALSE(managedArenas.contains(arenaStart + kArenaCapacityBytes));
+  ASSERT_FALSE(managedArenas.contains(arenaStart - 1));
+  std::vector<char> other(64);
+  ASSERT_FALSE(managedArenas.contains(other.data()));
+  managedArenas.free(data, kArenaCapacityBytes / 2);
+}
+
 TEST_F(MmapArenaTest, managedMmapArenasFree) {
   struct {
     std::vector<uint64_t> allocSizes;
@@ -1974,6 +1990,32 @@ class MmapConfigTest : public testing::Test {
   MemoryAllocator* allocator_;
 };
 
+TEST_F(MmapConfigTest, numaAware) {
+  MmapAllocator::Options options;
+  options.capacity = 256 << 20;
+  options.useMmapArena = true;
+  options.numaAware = true;
+  MmapAllocator allocator(options);
+  ASSERT_TRUE(allocator.checkConsistency());
+
+  Allocation allocation;
+  ASSERT_TRUE(allocator.allocateNonContiguous(1000, allocation));
+  ContiguousAllocation contiguous;
+  ASSERT_TRUE(allocator.allocateContiguous(1000, nullptr, contiguous));
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    auto run = allocation.runAt(i);
+    std::memset(run.data(), 1, run.numBytes());
+  }
+  std::memset(contiguous.data(), 1, contiguous.size());
+  ASSERT_EQ(allocator.numAllocated(), 2000);
+  ASSERT_TRUE(allocator.checkConsistency());
+
+  allocator.freeNonContiguous(allocation);
+  allocator.freeContiguous(contiguous);
+  ASSERT_EQ(allocator.numAllocated(), 0);
+  ASSERT_TRUE(allocator.checkConsistency());
+}
+
 TEST_F(MmapConfigTest, sizeClasses) {
   setupAllocator();
   Allocation result;
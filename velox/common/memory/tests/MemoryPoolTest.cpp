@@ -3517,6 +3517,59 @@ TEST_P(MemoryPoolTest, maybeReserve) {
   ASSERT_EQ(child->stats().numShrinks, 0);
 }
 
+TEST_P(MemoryPoolTest, reservationCache) {
+  constexpr int64_t kMaxSize = 1 << 30; // 1GB
+  setupMemory(
+      {.reservationCacheEnabled = true,
+       .allocatorCapacity = kMaxSize,
+       .arbitratorCapacity = kMaxSize,
+       .extraArbitratorConfigs = {
+           {std::string(SharedArbitrator::ExtraConfig::kReservedCapacity),
+            folly::to<std::string>(kMaxSize / 8) + "B"}}});
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("reservationCache", kMaxSize);
+  auto child = root->addLeafChild("reservationCache", isLeafThreadSafe_);
+
+  void* base = child->allocate(MB);
+  ASSERT_EQ(child->reservedBytes(), MB);
+  ASSERT_EQ(root->reservedBytes(), MB);
+
+  // Allocations and frees across the quantum boundary only update the parent
+  // on the first allocation.
+  for (int i = 0; i < 3; ++i) {
+    void* small = child->allocate(KB);
+    ASSERT_EQ(child->usedBytes(), MB + KB);
+    ASSERT_EQ(child->reservedBytes(), 2 * MB);
+    child->free(small, KB);
+    ASSERT_EQ(child->usedBytes(), MB);
+    ASSERT_EQ(child->reservedBytes(), 2 * MB);
+    ASSERT_EQ(child->releasableReservation(), MB);
+    ASSERT_EQ(root->reservedBytes(), 2 * MB);
+  }
+
+  // A free of more than one quantum returns the reservation to the parent.
+  void* large = child->allocate(2 * MB);
+  ASSERT_EQ(child->reservedBytes(), 3 * MB);
+  ASSERT_EQ(root->reservedBytes(), 3 * MB);
+  child->free(large, 2 * MB);
+  ASSERT_EQ(child->reservedBytes(), MB);
+  ASSERT_EQ(root->reservedBytes(), MB);
+
+  // An explicit release returns the cached reservation.
+  child->free(child->allocate(KB), KB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  child->release();
+  ASSERT_EQ(child->reservedBytes(), MB);
+  ASSERT_EQ(root->reservedBytes(), MB);
+
+  // Nothing is cached once nothing is used.
+  child->free(child->allocate(KB), KB);
+  child->free(base, MB);
+  ASSERT_EQ(child->usedBytes(), 0);
+  ASSERT_EQ(child->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
 TEST_P(MemoryPoolTest, maybeReserveFailWithAbort) {
   constexpr int64_t kMaxSize = 1 * GB; // 1GB
   setupMemory(
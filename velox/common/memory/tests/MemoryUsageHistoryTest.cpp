@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/MemoryUsageHistory.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::memory;
+
+namespace {
+
+TEST(MemoryUsageHistoryTest, predict) {
+  MemoryUsageHistory history;
+  ASSERT_FALSE(history.predict("q1").has_value());
+  history.record("q1", 100);
+  ASSERT_EQ(history.predict("q1").value(), 100);
+  history.record("q1", 50);
+  ASSERT_EQ(history.predict("q1").value(), 100);
+  history.record("q1", 200);
+  ASSERT_EQ(history.predict("q1").value(), 200);
+  ASSERT_FALSE(history.predict("q2").has_value());
+  ASSERT_EQ(history.numEntries(), 1);
+
+  // The peak of the oldest run falls out after 'kNumRuns' newer runs.
+  for (int32_t i = 0; i < MemoryUsageHistory::kNumRuns; ++i) {
+    ASSERT_EQ(history.predict("q1").value(), 200);
+    history.record("q1", 10 + i);
+  }
+  ASSERT_EQ(
+      history.predict("q1").value(), 10 + MemoryUsageHistory::kNumRuns - 1);
+}
+
+TEST(MemoryUsageHistoryTest, evict) {
+  MemoryUsageHistory history(2);
+  history.record("q1", 1);
+  history.record("q2", 2);
+  // Recording 'q1' again makes 'q2' the least recently recorded.
+  history.record("q1", 3);
+  history.record("q3", 4);
+  ASSERT_EQ(history.numEntries(), 2);
+  ASSERT_EQ(history.predict("q1").value(), 3);
+  ASSERT_FALSE(history.predict("q2").has_value());
+  ASSERT_EQ(history.predict("q3").value(), 4);
+}
+
+} // namespace
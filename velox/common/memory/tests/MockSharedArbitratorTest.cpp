@@ -451,7 +451,8 @@ class MockSharedArbitrationTest : public testing::Test {
       bool globalArbitrationWithoutSpill = false,
       // Set the globalArbitrationAbortTimeRatio to be very small so that the
       // query can be aborted sooner and the test would not timeout.
-      double globalArbitrationAbortTimeRatio = 0.005) {
+      double globalArbitrationAbortTimeRatio = 0.005,
+      bool memoryUsagePredictionEnabled = false) {
     MemoryManagerOptions options;
     options.allocatorCapacity = memoryCapacity;
     std::string arbitratorKind = "SHARED";
@@ -488,7 +489,9 @@ class MockSharedArbitrationTest : public testing::Test {
         {std::string(ExtraConfig::kGlobalArbitrationWithoutSpill),
          folly::to<std::string>(globalArbitrationWithoutSpill)},
         {std::string(ExtraConfig::kGlobalArbitrationAbortTimeRatio),
-         folly::to<std::string>(globalArbitrationAbortTimeRatio)}};
+         folly::to<std::string>(globalArbitrationAbortTimeRatio)},
+        {std::string(ExtraConfig::kMemoryUsagePredictionEnabled),
+         folly::to<std::string>(memoryUsagePredictionEnabled)}};
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
@@ -657,6 +660,10 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
       SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
           emptyConfigs),
       SharedArbitrator::ExtraConfig::kDefaultGlobalArbitrationAbortTimeRatio);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::memoryUsagePredictionEnabled(
+          emptyConfigs),
+      SharedArbitrator::ExtraConfig::kDefaultMemoryUsagePredictionEnabled);
 
   // Testing custom values
   std::unordered_map<std::string, std::string> configs;
@@ -686,6 +693,8 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
       SharedArbitrator::ExtraConfig::kGlobalArbitrationWithoutSpill)] = "true";
   configs[std::string(
       SharedArbitrator::ExtraConfig::kGlobalArbitrationAbortTimeRatio)] = "0.8";
+  configs[std::string(
+      SharedArbitrator::ExtraConfig::kMemoryUsagePredictionEnabled)] = "true";
 
   ASSERT_EQ(SharedArbitrator::ExtraConfig::reservedCapacity(configs), 100);
   ASSERT_EQ(
@@ -716,6 +725,8 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
   ASSERT_EQ(
       SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(configs),
       0.8);
+  ASSERT_TRUE(
+      SharedArbitrator::ExtraConfig::memoryUsagePredictionEnabled(configs));
 
   // Testing invalid values
   configs[std::string(SharedArbitrator::ExtraConfig::kReservedCapacity)] =
@@ -2164,6 +2175,57 @@ TEST_F(MockSharedArbitrationTest, singlePoolGrowWithoutArbitration) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, memoryUsagePrediction) {
+  const int64_t memoryCapacity = 512 << 20;
+  const uint64_t peakBytes = 64 << 20;
+  setupMemory(
+      memoryCapacity,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      kMemoryReclaimThreadsHwMultiplier,
+      nullptr,
+      true,
+      5 * 60 * 1'000'000'000UL,
+      false,
+      0.005,
+      true);
+  const std::string fingerprint{"dashboard"};
+  ASSERT_FALSE(arbitrator_->predictedUsage(fingerprint).has_value());
+
+  {
+    auto task = addTask();
+    arbitrator_->setPoolFingerprint(task->pool(), fingerprint);
+    ASSERT_EQ(task->capacity(), 0);
+    task->addMemoryOp()->allocate(peakBytes);
+    ASSERT_GT(arbitrator_->stats().numRequests, 0);
+  }
+  ASSERT_EQ(arbitrator_->predictedUsage(fingerprint).value(), peakBytes);
+
+  // The next run gets its predicted capacity up front and doesn't need any
+  // arbitration to reach it.
+  auto task = addTask();
+  ASSERT_EQ(task->capacity(), 0);
+  arbitrator_->setPoolFingerprint(task->pool(), fingerprint);
+  ASSERT_EQ(task->capacity(), peakBytes);
+  const auto numRequests = arbitrator_->stats().numRequests;
+  task->addMemoryOp()->allocate(peakBytes);
+  ASSERT_EQ(arbitrator_->stats().numRequests, numRequests);
+
+  // A pool without fingerprint is not recorded.
+  auto otherTask = addTask();
+  otherTask->addMemoryOp()->allocate(peakBytes);
+  otherTask.reset();
+  ASSERT_FALSE(arbitrator_->predictedUsage("").has_value());
+}
+
 TEST_F(MockSharedArbitrationTest, maxCapacityReserve) {
   struct {
     uint64_t memCapacity;
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Numa.h"
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+namespace {
+
+// Mirrors MPOL_PREFERRED from <numaif.h>, which comes with libnuma.
+constexpr int kMpolPreferred = 1;
+
+// The largest number of NUMA nodes supported by bindMemoryToNumaNode().
+constexpr int32_t kMaxNumaNodes = 64;
+
+// Parses a Linux CPU or node list like "0-23,48-71".
+std::vector<int32_t> parseList(const std::string& text) {
+  std::vector<int32_t> result;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(text), ranges);
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    folly::StringPiece first;
+    folly::StringPiece last;
+    if (!folly::split('-', range, first, last)) {
+      first = range;
+      last = range;
+    }
+    const auto begin = folly::tryTo<int32_t>(first);
+    const auto end = folly::tryTo<int32_t>(last);
+    if (!begin.hasValue() || !end.hasValue()) {
+      return {};
+    }
+    for (auto i = begin.value(); i <= end.value(); ++i) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+struct NumaTopology {
+  NumaTopology() {
+    std::string text;
+    if (folly::readFile("/sys/devices/system/node/online", text)) {
+      for (auto node : parseList(text)) {
+        std::string cpuList;
+        const auto path =
+            fmt::format("/sys/devices/system/node/node{}/cpulist", node);
+        if (!folly::readFile(path.c_str(), cpuList)) {
+          continue;
+        }
+        if (node >= static_cast<int32_t>(nodeCpus.size())) {
+          nodeCpus.resize(node + 1);
+        }
+        nodeCpus[node] = parseList(cpuList);
+        for (auto cpu : nodeCpus[node]) {
+          if (cpu >= static_cast<int32_t>(cpuToNode.size())) {
+            cpuToNode.resize(cpu + 1, 0);
+          }
+          cpuToNode[cpu] = node;
+        }
+      }
+    }
+    if (nodeCpus.empty()) {
+      nodeCpus.resize(1);
+    }
+  }
+
+  // The CPUs of each NUMA node, indexed by node.
+  std::vector<std::vector<int32_t>> nodeCpus;
+  // The NUMA node of each CPU, indexed by CPU.
+  std::vector<int32_t> cpuToNode;
+};
+
+const NumaTopology& topology() {
+  static const NumaTopology kTopology;
+  return kTopology;
+}
+} // namespace
+
+int32_t numaNodeCount() {
+  return topology().nodeCpus.size();
+}
+
+int32_t currentNumaNode() {
+#ifdef __linux__
+  const auto& cpuToNode = topology().cpuToNode;
+  const auto cpu = ::sched_getcpu();
+  if (cpu >= 0 && cpu < static_cast<int32_t>(cpuToNode.size())) {
+    return cpuToNode[cpu];
+  }
+#endif
+  return 0;
+}
+
+const std::vector<int32_t>& numaNodeCpus(int32_t node) {
+  static const std::vector<int32_t> kEmpty;
+  const auto& nodeCpus = topology().nodeCpus;
+  if (node < 0 || node >= static_cast<int32_t>(nodeCpus.size())) {
+    return kEmpty;
+  }
+  return nodeCpus[node];
+}
+
+bool bindMemoryToNumaNode(void* address, uint64_t bytes, int32_t node) {
+#ifdef __linux__
+  if (node < 0 || node >= kMaxNumaNodes || node >= numaNodeCount()) {
+    return false;
+  }
+  const unsigned long nodeMask = 1UL << node;
+  // The kernel reads 'maxnode' - 1 bits from the mask.
+  if (::syscall(
+          SYS_mbind,
+          address,
+          bytes,
+          kMpolPreferred,
+          &nodeMask,
+          kMaxNumaNodes + 1,
+          0) == 0) {
+    return true;
+  }
+  LOG(WARNING) << "mbind to NUMA node " << node << " failed: "
+               << folly::errnoStr(errno);
+#endif
+  return false;
+}
+
+ScopedNumaNodeAffinity::ScopedNumaNodeAffinity(int32_t node) {
+#ifdef __linux__
+  const auto& cpus = numaNodeCpus(node);
+  if (cpus.empty() || numaNodeCount() == 1) {
+    return;
+  }
+  if (::sched_getaffinity(0, sizeof(savedCpus_), &savedCpus_) != 0) {
+    return;
+  }
+  cpu_set_t nodeCpus;
+  CPU_ZERO(&nodeCpus);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &nodeCpus);
+    }
+  }
+  pinned_ = ::sched_setaffinity(0, sizeof(nodeCpus), &nodeCpus) == 0;
+#endif
+}
+
+ScopedNumaNodeAffinity::~ScopedNumaNodeAffinity() {
+#ifdef __linux__
+  if (pinned_) {
+    ::sched_setaffinity(0, sizeof(savedCpus_), &savedCpus_);
+  }
+#endif
+}
+
+} // namespace facebook::velox::process
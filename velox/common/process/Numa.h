@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace facebook::velox::process {
+
+/// Denotes no particular NUMA node.
+constexpr int32_t kNoNumaNode = -1;
+
+/// Returns the number of NUMA nodes of this machine. Returns 1 if the machine
+/// is not NUMA or its topology cannot be read.
+int32_t numaNodeCount();
+
+/// Returns the NUMA node of the CPU the calling thread is running on. Returns 0
+/// if not known.
+int32_t currentNumaNode();
+
+/// Returns the CPUs of NUMA 'node'. Returns an empty list if 'node' does not
+/// exist or the topology cannot be read.
+const std::vector<int32_t>& numaNodeCpus(int32_t node);
+
+/// Sets the memory policy of the pages in ['address', 'address' + 'bytes') to
+/// prefer NUMA 'node'. The policy applies to the pages faulted in after this
+/// call, so this should be called right after the range is mapped. Pages come
+/// from other nodes if 'node' runs out of memory. Returns false if the policy
+/// could not be set.
+bool bindMemoryToNumaNode(void* address, uint64_t bytes, int32_t node);
+
+/// Restricts the calling thread to the CPUs of NUMA 'node' for the lifetime of
+/// this object and restores the previous CPU affinity on destruction. No-op if
+/// 'node' is kNoNumaNode or not a node of this machine.
+class ScopedNumaNodeAffinity {
+ public:
+  explicit ScopedNumaNodeAffinity(int32_t node);
+
+  ~ScopedNumaNodeAffinity();
+
+  /// True if the calling thread was restricted to the CPUs of the node.
+  bool pinned() const {
+    return pinned_;
+  }
+
+ private:
+  bool pinned_{false};
+#ifdef __linux__
+  cpu_set_t savedCpus_;
+#endif
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Numa.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::process;
+
+TEST(NumaTest, topology) {
+  const auto numNodes = numaNodeCount();
+  ASSERT_GE(numNodes, 1);
+  const auto node = currentNumaNode();
+  ASSERT_GE(node, 0);
+  ASSERT_LT(node, numNodes);
+  ASSERT_TRUE(numaNodeCpus(kNoNumaNode).empty());
+  ASSERT_TRUE(numaNodeCpus(numNodes).empty());
+}
+
+TEST(NumaTest, scopedAffinity) {
+  {
+    ScopedNumaNodeAffinity affinity(kNoNumaNode);
+    ASSERT_FALSE(affinity.pinned());
+  }
+  const auto node = currentNumaNode();
+  {
+    ScopedNumaNodeAffinity affinity(node);
+    if (affinity.pinned()) {
+      ASSERT_EQ(currentNumaNode(), node);
+    }
+  }
+}
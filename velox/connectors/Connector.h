@@ -79,6 +79,22 @@ struct ConnectorSplit : public ISerializable {
 
   virtual ~ConnectorSplit() {}
 
+  /// Returns the size in bytes of the range of the split that can be divided
+  /// into sub-splits with subSplit(), or 0 if the split cannot be divided.
+  virtual uint64_t divisibleSize() const {
+    return 0;
+  }
+
+  /// Returns a split that reads the part of 'this' that starts at 'offset'
+  /// bytes into the range of 'this' and extends for 'length' bytes. Sub-splits
+  /// of non-overlapping ranges that cover divisibleSize() together read the
+  /// same rows as 'this'.
+  virtual std::shared_ptr<ConnectorSplit> subSplit(
+      uint64_t /*offset*/,
+      uint64_t /*length*/) const {
+    VELOX_UNSUPPORTED();
+  }
+
   virtual std::string toString() const {
     return fmt::format(
         "[split: connector id {}, weight {}, cacheable {}]",
@@ -207,6 +223,13 @@ class DataSink {
   /// TODO maybe at some point we want to make it async.
   virtual void appendData(RowVectorPtr input) = 0;
 
+  /// Returns true if the data sink has too much data in flight to accept more
+  /// input and sets 'future' to be realized when it can accept input again.
+  /// The caller should not call appendData() before 'future' is realized.
+  virtual bool isBlocked(ContinueFuture* /*future*/) {
+    return false;
+  }
+
   /// Called after all data has been added via possibly multiple calls to
   /// appendData() This function finishes the data procesing like sort all the
   /// added data and write them to the file writer. The finish might take long
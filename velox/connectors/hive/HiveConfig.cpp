@@ -154,6 +154,13 @@ int32_t HiveConfig::loadQuantum(const config::ConfigBase* session) const {
       kLoadQuantumSession, config_->get<int32_t>(kLoadQuantum, 8 << 20));
 }
 
+int32_t HiveConfig::decodingParallelism(
+    const config::ConfigBase* session) const {
+  return session->get<int32_t>(
+      kDecodingParallelismSession,
+      config_->get<int32_t>(kDecodingParallelism, 0));
+}
+
 int32_t HiveConfig::numCacheFileHandles() const {
   return config_->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
@@ -193,6 +200,15 @@ uint64_t HiveConfig::sortWriterFinishTimeSliceLimitMs(
       config_->get<uint64_t>(kSortWriterFinishTimeSliceLimitMs, 5'000));
 }
 
+uint64_t HiveConfig::writerAsyncFlushMaxPendingBytes(
+    const config::ConfigBase* session) const {
+  return config::toCapacity(
+      session->get<std::string>(
+          kWriterAsyncFlushMaxPendingBytesSession,
+          config_->get<std::string>(kWriterAsyncFlushMaxPendingBytes, "0B")),
+      config::CapacityUnit::BYTE);
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 256UL << 10);
 }
@@ -225,6 +241,20 @@ bool HiveConfig::readStatsBasedFilterReorderDisabled(
       config_->get<bool>(kReadStatsBasedFilterReorderDisabled, false));
 }
 
+bool HiveConfig::filterSelectivitySharingEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kFilterSelectivitySharingEnabledSession,
+      config_->get<bool>(kFilterSelectivitySharingEnabled, false));
+}
+
+uint32_t HiveConfig::combinedSplitPrefetchFiles(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kCombinedSplitPrefetchFilesSession,
+      config_->get<uint32_t>(kCombinedSplitPrefetchFiles, 4));
+}
+
 std::string HiveConfig::hiveLocalDataPath() const {
   return config_->get<std::string>(kLocalDataPath, "");
 }
@@ -117,6 +117,21 @@ class HiveConfig {
   static constexpr const char* kLoadQuantum = "load-quantum";
   static constexpr const char* kLoadQuantumSession = "load-quantum";
 
+  /// Number of threads that decode the columns of a split without filters in
+  /// parallel, after the filter columns have produced the surviving rows.
+  /// Decoding runs on the CPU executor given to the connector, never on its
+  /// IO executor, and the driver thread decodes the columns that no executor
+  /// thread has started on. 0 or 1, or no CPU executor, decodes on the driver
+  /// thread.
+  ///
+  /// The columns decoded in parallel are loaded eagerly instead of as
+  /// LazyVectors. Columns that a downstream filter or join would never load
+  /// are then decoded too, so this pays off for scans whose output is mostly
+  /// consumed.
+  static constexpr const char* kDecodingParallelism = "decoding-parallelism";
+  static constexpr const char* kDecodingParallelismSession =
+      "decoding_parallelism";
+
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
@@ -164,6 +179,15 @@ class HiveConfig {
   static constexpr const char* kSortWriterFinishTimeSliceLimitMsSession =
       "sort_writer_finish_time_slice_limit_ms";
 
+  /// If positive, each file writer of the data sink writes to its file on
+  /// the connector executor, and the data sink blocks the driver while more
+  /// than this many bytes of a file are queued for writing. Zero writes on the
+  /// driver thread.
+  static constexpr const char* kWriterAsyncFlushMaxPendingBytes =
+      "writer-async-flush-max-pending-bytes";
+  static constexpr const char* kWriterAsyncFlushMaxPendingBytesSession =
+      "writer_async_flush_max_pending_bytes";
+
   // The unit for reading timestamps from files.
   static constexpr const char* kReadTimestampUnit =
       "hive.reader.timestamp-unit";
@@ -180,6 +204,20 @@ class HiveConfig {
   static constexpr const char* kReadStatsBasedFilterReorderDisabledSession =
       "stats_based_filter_reorder_disabled";
 
+  /// Seeds the filter order of table scans from the filter selectivity
+  /// observed by earlier scans of the same table in the process.
+  static constexpr const char* kFilterSelectivitySharingEnabled =
+      "filter-selectivity-sharing-enabled";
+  static constexpr const char* kFilterSelectivitySharingEnabledSession =
+      "filter_selectivity_sharing_enabled";
+
+  /// The number of files of a HiveCombinedSplit that are opened and whose
+  /// footers are read in the background ahead of the file being read.
+  static constexpr const char* kCombinedSplitPrefetchFiles =
+      "combined-split-prefetch-files";
+  static constexpr const char* kCombinedSplitPrefetchFilesSession =
+      "combined_split_prefetch_files";
+
   static constexpr const char* kLocalDataPath = "hive_local_data_path";
   static constexpr const char* kLocalFileFormat = "hive_local_file_format";
 
@@ -219,6 +257,8 @@ class HiveConfig {
 
   int32_t loadQuantum(const config::ConfigBase* session) const;
 
+  int32_t decodingParallelism(const config::ConfigBase* session) const;
+
   int32_t numCacheFileHandles() const;
 
   uint64_t fileHandleExpirationDurationMs() const;
@@ -236,6 +276,9 @@ class HiveConfig {
   uint64_t sortWriterFinishTimeSliceLimitMs(
       const config::ConfigBase* session) const;
 
+  uint64_t writerAsyncFlushMaxPendingBytes(
+      const config::ConfigBase* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
@@ -252,6 +295,15 @@ class HiveConfig {
   bool readStatsBasedFilterReorderDisabled(
       const config::ConfigBase* session) const;
 
+  /// Returns true if table scans share the filter selectivity they observe
+  /// through the process wide FilterSelectivityStore.
+  bool filterSelectivitySharingEnabled(
+      const config::ConfigBase* session) const;
+
+  /// Returns the number of files of a HiveCombinedSplit to open ahead of the
+  /// file being read.
+  uint32_t combinedSplitPrefetchFiles(const config::ConfigBase* session) const;
+
   /// Returns the file system path containing local data. If non-empty,
   /// initializes LocalHiveConnectorMetadata to provide metadata for the tables
   /// in the directory.
@@ -42,7 +42,8 @@ hiveConnectorMetadataFactories() {
 HiveConnector::HiveConnector(
     const std::string& id,
     std::shared_ptr<const config::ConfigBase> config,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    folly::Executor* decodeExecutor)
     : Connector(id),
       hiveConfig_(std::make_shared<HiveConfig>(config)),
       fileHandleFactory_(
@@ -51,7 +52,8 @@ HiveConnector::HiveConnector(
                     hiveConfig_->numCacheFileHandles())
               : nullptr,
           std::make_unique<FileHandleGenerator>(config)),
-      executor_(executor) {
+      executor_(executor),
+      decodeExecutor_(decodeExecutor) {
   if (hiveConfig_->isFileHandleCacheEnabled()) {
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with maximum of "
@@ -84,7 +86,8 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       &fileHandleFactory_,
       executor_,
       connectorQueryCtx,
-      hiveConfig_);
+      hiveConfig_,
+      decodeExecutor_);
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
@@ -101,7 +104,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
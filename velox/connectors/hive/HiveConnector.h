@@ -29,10 +29,13 @@ namespace facebook::velox::connector::hive {
 
 class HiveConnector : public Connector {
  public:
+  /// 'executor' is for IO. 'decodeExecutor' decodes the columns of a split in
+  /// parallel, see HiveConfig::kDecodingParallelism.
   HiveConnector(
       const std::string& id,
       std::shared_ptr<const config::ConfigBase> config,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      folly::Executor* decodeExecutor = nullptr);
 
   const std::shared_ptr<const config::ConfigBase>& connectorConfig()
       const override {
@@ -84,6 +87,7 @@ class HiveConnector : public Connector {
   const std::shared_ptr<HiveConfig> hiveConfig_;
   FileHandleFactory fileHandleFactory_;
   folly::Executor* executor_;
+  folly::Executor* decodeExecutor_;
   std::shared_ptr<ConnectorMetadata> metadata_;
 };
 
@@ -101,7 +105,8 @@ class HiveConnectorFactory : public ConnectorFactory {
       std::shared_ptr<const config::ConfigBase> config,
       folly::Executor* ioExecutor = nullptr,
       folly::Executor* cpuExecutor = nullptr) override {
-    return std::make_shared<HiveConnector>(id, config, ioExecutor);
+    return std::make_shared<HiveConnector>(
+        id, config, ioExecutor, cpuExecutor);
   }
 };
 
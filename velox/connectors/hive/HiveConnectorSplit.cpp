@@ -18,6 +18,52 @@
 
 namespace facebook::velox::connector::hive {
 
+uint64_t HiveConnectorSplit::divisibleSize() const {
+  switch (fileFormat) {
+    case dwio::common::FileFormat::DWRF:
+    case dwio::common::FileFormat::ORC:
+    case dwio::common::FileFormat::PARQUET:
+      break;
+    default:
+      return 0;
+  }
+  if (length != std::numeric_limits<uint64_t>::max()) {
+    return length;
+  }
+  if (!properties.has_value() || !properties->fileSize.has_value()) {
+    return 0;
+  }
+  const auto fileSize = static_cast<uint64_t>(properties->fileSize.value());
+  return fileSize > start ? fileSize - start : 0;
+}
+
+std::shared_ptr<ConnectorSplit> HiveConnectorSplit::subSplit(
+    uint64_t offset,
+    uint64_t length) const {
+  const auto size = divisibleSize();
+  VELOX_CHECK_GT(size, 0, "Split is not divisible: {}", toString());
+  VELOX_CHECK_LE(offset, size);
+  VELOX_CHECK_LE(length, size - offset);
+  return std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      filePath,
+      fileFormat,
+      start + offset,
+      length,
+      partitionKeys,
+      tableBucketNumber,
+      customSplitInfo,
+      extraFileInfo,
+      serdeParameters,
+      storageParameters,
+      splitWeight,
+      cacheable,
+      infoColumns,
+      properties,
+      rowIdProperties,
+      bucketConversion);
+}
+
 std::string HiveConnectorSplit::toString() const {
   if (tableBucketNumber.has_value()) {
     return fmt::format(
@@ -228,5 +274,80 @@ std::shared_ptr<HiveConnectorSplit> HiveConnectorSplit::create(
 void HiveConnectorSplit::registerSerDe() {
   auto& registry = DeserializationRegistryForSharedPtr();
   registry.Register("HiveConnectorSplit", HiveConnectorSplit::create);
+  registry.Register("HiveCombinedSplit", HiveCombinedSplit::create);
+}
+
+namespace {
+int64_t sumSplitWeights(
+    const std::vector<std::shared_ptr<HiveConnectorSplit>>& splits) {
+  int64_t weight = 0;
+  for (const auto& split : splits) {
+    weight += split->splitWeight;
+  }
+  return weight;
+}
+
+bool allCacheable(
+    const std::vector<std::shared_ptr<HiveConnectorSplit>>& splits) {
+  for (const auto& split : splits) {
+    if (!split->cacheable) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+HiveCombinedSplit::HiveCombinedSplit(
+    const std::string& connectorId,
+    std::vector<std::shared_ptr<HiveConnectorSplit>> _splits)
+    : ConnectorSplit(
+          connectorId,
+          sumSplitWeights(_splits),
+          allCacheable(_splits)),
+      splits(std::move(_splits)) {
+  VELOX_CHECK(!splits.empty(), "Combined split must have at least one split");
+  for (const auto& split : splits) {
+    VELOX_CHECK_NOT_NULL(split);
+    VELOX_CHECK_EQ(split->connectorId, connectorId);
+    VELOX_CHECK(
+        !split->bucketConversion.has_value(),
+        "Combined split does not support bucket conversion: {}",
+        split->toString());
+    VELOX_CHECK(
+        !split->rowIdProperties.has_value(),
+        "Combined split does not support row id properties: {}",
+        split->toString());
+  }
+}
+
+std::string HiveCombinedSplit::toString() const {
+  return fmt::format(
+      "Hive combined: {} files, first {}",
+      splits.size(),
+      splits.front()->toString());
+}
+
+folly::dynamic HiveCombinedSplit::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "HiveCombinedSplit";
+  obj["connectorId"] = connectorId;
+  folly::dynamic splitsArray = folly::dynamic::array;
+  for (const auto& split : splits) {
+    splitsArray.push_back(split->serialize());
+  }
+  obj["splits"] = splitsArray;
+  return obj;
+}
+
+// static
+std::shared_ptr<HiveCombinedSplit> HiveCombinedSplit::create(
+    const folly::dynamic& obj) {
+  std::vector<std::shared_ptr<HiveConnectorSplit>> splits;
+  for (const auto& splitObj : obj["splits"]) {
+    splits.push_back(HiveConnectorSplit::create(splitObj));
+  }
+  return std::make_shared<HiveCombinedSplit>(
+      obj["connectorId"].asString(), std::move(splits));
 }
 } // namespace facebook::velox::connector::hive
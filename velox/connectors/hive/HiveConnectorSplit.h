@@ -111,6 +111,15 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
         rowIdProperties(_rowIdProperties),
         bucketConversion(_bucketConversion) {}
 
+  /// Returns the length of the byte range of the split for DWRF, ORC and
+  /// Parquet files, whose readers read the stripes or row groups that start in
+  /// the range. Returns 0 for other formats and if the length of the range is
+  /// not known.
+  uint64_t divisibleSize() const override;
+
+  std::shared_ptr<ConnectorSplit> subSplit(uint64_t offset, uint64_t length)
+      const override;
+
   std::string toString() const override;
 
   std::string getFileName() const;
@@ -122,6 +131,26 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   static void registerSerDe();
 };
 
+/// A split that reads the files of several splits, e.g. the many small files of
+/// a streaming ingest partition, one after the other through one
+/// HiveDataSource. Saves the per-split overhead of the table scan and opens
+/// and reads the footers of the next files in the background while a file is
+/// read. The splits must have the same connector id and no bucket conversion
+/// or row id properties.
+struct HiveCombinedSplit : public connector::ConnectorSplit {
+  const std::vector<std::shared_ptr<HiveConnectorSplit>> splits;
+
+  HiveCombinedSplit(
+      const std::string& connectorId,
+      std::vector<std::shared_ptr<HiveConnectorSplit>> splits);
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static std::shared_ptr<HiveCombinedSplit> create(const folly::dynamic& obj);
+};
+
 class HiveConnectorSplitBuilder {
  public:
   explicit HiveConnectorSplitBuilder(std::string filePath)
@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 
+#include "velox/common/caching/FileIds.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
@@ -740,6 +741,93 @@ bool testFilters(
   return true;
 }
 
+bool testFiltersOnAllRows(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  const auto totalRows = reader->numberOfRows();
+  const auto& rowType = reader->rowType();
+  for (const auto& child : scanSpec->children()) {
+    auto* filter = child->filter();
+    if (filter == nullptr) {
+      if (child->hasFilter()) {
+        // Filters on subfields are not tested.
+        return false;
+      }
+      continue;
+    }
+    if (!filter->isDeterministic()) {
+      return false;
+    }
+    const auto& name = child->fieldName();
+    if (auto iter = partitionKeys.find(name); iter != partitionKeys.end()) {
+      if (!iter->second.has_value()) {
+        if (!filter->testNull()) {
+          return false;
+        }
+        continue;
+      }
+      const auto handlesIter = partitionKeysHandle.find(name);
+      VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+      if (!applyPartitionFilter(
+              handlesIter->second->dataType(),
+              iter->second.value(),
+              handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
+              filter)) {
+        return false;
+      }
+      continue;
+    }
+    if (child->columnType() != common::ScanSpec::ColumnType::kRegular) {
+      return false;
+    }
+    const auto fileIndex = rowType->getChildIdxIfExists(name);
+    if (!fileIndex.has_value()) {
+      // Column is missing and read as null.
+      if (!filter->testNull()) {
+        return false;
+      }
+      continue;
+    }
+    const auto& typeWithId = reader->typeWithId()->childAt(*fileIndex);
+    const auto columnStats = reader->aggregateStatistics(typeWithId->id());
+    if (columnStats == nullptr || !totalRows.has_value() ||
+        !columnStats->getNumberOfValues().has_value()) {
+      return false;
+    }
+    const auto numValues = columnStats->getNumberOfValues().value();
+    if (numValues < totalRows.value() && !filter->testNull()) {
+      return false;
+    }
+    if (numValues == 0) {
+      continue;
+    }
+    switch (filter->kind()) {
+      case common::FilterKind::kIsNotNull:
+        break;
+      case common::FilterKind::kBigintRange: {
+        const auto* range = static_cast<const common::BigintRange*>(filter);
+        const auto* intStats =
+            dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+                columnStats.get());
+        if (intStats == nullptr || !intStats->getMinimum().has_value() ||
+            !intStats->getMaximum().has_value() ||
+            intStats->getMinimum().value() < range->lower() ||
+            intStats->getMaximum().value() > range->upper()) {
+          return false;
+        }
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -903,4 +991,47 @@ core::TypedExprPtr extractFiltersFromRemainingFilter(
   }
   return expr;
 }
+
+namespace {
+cache::CacheResidency estimateFileCacheResidency(
+    const HiveConnectorSplit& split,
+    const cache::AsyncDataCache& cache) {
+  const auto fileNum = fileIds().id(split.filePath);
+  if (fileNum == StringIdMap::kNoId) {
+    return {};
+  }
+  auto residency = cache.fileResidency(fileNum);
+  // The cache does not know which bytes of the file a split reads, so the
+  // split is assumed to be a uniform sample of the file.
+  if (split.properties.has_value() && split.properties->fileSize.has_value()) {
+    const uint64_t fileSize = split.properties->fileSize.value();
+    if (fileSize > 0 && split.length < fileSize) {
+      const double fraction = static_cast<double>(split.length) / fileSize;
+      residency.memoryBytes *= fraction;
+      residency.ssdBytes *= fraction;
+    }
+  }
+  residency.memoryBytes = std::min(residency.memoryBytes, split.length);
+  residency.ssdBytes = std::min(residency.ssdBytes, split.length);
+  return residency;
+}
+} // namespace
+
+cache::CacheResidency estimateCacheResidency(
+    const ConnectorSplit& split,
+    const cache::AsyncDataCache& cache) {
+  if (const auto* combinedSplit =
+          dynamic_cast<const HiveCombinedSplit*>(&split)) {
+    cache::CacheResidency residency;
+    for (const auto& fileSplit : combinedSplit->splits) {
+      const auto fileResidency = estimateFileCacheResidency(*fileSplit, cache);
+      residency.memoryBytes += fileResidency.memoryBytes;
+      residency.ssdBytes += fileResidency.ssdBytes;
+    }
+    return residency;
+  }
+  const auto* hiveSplit = dynamic_cast<const HiveConnectorSplit*>(&split);
+  VELOX_CHECK_NOT_NULL(hiveSplit, "Not a Hive split: {}", split.toString());
+  return estimateFileCacheResidency(*hiveSplit, cache);
+}
 } // namespace facebook::velox::connector::hive
@@ -94,6 +94,18 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Returns true if every row of the file read by 'reader' passes the filters in
+/// 'scanSpec', based on the partition key values and the file statistics.
+/// Returns false if some rows may not pass or the statistics cannot tell. Only
+/// IS NOT NULL and integer range filters are tested against the statistics.
+bool testFiltersOnAllRows(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -109,4 +121,12 @@ core::TypedExprPtr extractFiltersFromRemainingFilter(
     common::SubfieldFilters& filters,
     double& sampleRate);
 
+/// Returns the estimated bytes of the data of 'split' that are resident in
+/// the memory and SSD caches of 'cache'. The resident bytes of the file are
+/// prorated to the byte range of the split if the file size is known. Sums
+/// the files of a HiveCombinedSplit.
+cache::CacheResidency estimateCacheResidency(
+    const ConnectorSplit& split,
+    const cache::AsyncDataCache& cache);
+
 } // namespace facebook::velox::connector::hive
@@ -42,6 +42,18 @@ namespace {
   memory::NonReclaimableSectionGuard nonReclaimableGuard( \
       writerInfo_[(index)]->nonReclaimableSectionHolder.get())
 
+// Releases the unused memory reservations of the leaf pools of 'pool'.
+void releaseUnusedReservations(memory::MemoryPool* pool) {
+  if (pool->kind() == memory::MemoryPool::Kind::kLeaf) {
+    pool->release();
+    return;
+  }
+  pool->visitChildren([](memory::MemoryPool* child) {
+    releaseUnusedReservations(child);
+    return true;
+  });
+}
+
 // Returns the type of non-partition data columns.
 RowTypePtr getNonPartitionTypes(
     const std::vector<column_index_t>& dataCols,
@@ -365,7 +377,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* executor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -401,7 +414,11 @@ HiveDataSink::HiveDataSink(
       spillConfig_(connectorQueryCtx->spillConfig()),
       sortWriterFinishTimeSliceLimitMs_(getFinishTimeSliceLimitMsFromHiveConfig(
           hiveConfig_,
-          connectorQueryCtx->sessionProperties())) {
+          connectorQueryCtx->sessionProperties())),
+      executor_(executor),
+      writerAsyncFlushMaxPendingBytes_(
+          hiveConfig_->writerAsyncFlushMaxPendingBytes(
+              connectorQueryCtx->sessionProperties())) {
   if (isBucketed()) {
     VELOX_USER_CHECK_LT(
         bucketCount_, maxBucketCount(), "bucketCount exceeds the limit");
@@ -489,6 +506,18 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   }
 }
 
+bool HiveDataSink::isBlocked(ContinueFuture* future) {
+  if (state_ != State::kRunning) {
+    return false;
+  }
+  for (const auto& info : writerInfo_) {
+    if (info->asyncSink != nullptr && info->asyncSink->isBlocked(future)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto dataInput = makeDataInput(dataChannels_, input);
@@ -794,18 +823,23 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
 
   // Prevents the memory allocation during the writer creation.
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(writerInfo_.size() - 1);
-  auto writer = writerFactory_->createWriter(
-      dwio::common::FileSink::create(
-          writePath,
-          {
-              .bufferWrite = false,
-              .connectorProperties = hiveConfig_->config(),
-              .fileCreateConfig = hiveConfig_->writeFileCreateConfig(),
-              .pool = writerInfo_.back()->sinkPool.get(),
-              .metricLogger = dwio::common::MetricsLog::voidLog(),
-              .stats = ioStats_.back().get(),
-          }),
-      options);
+  auto sink = dwio::common::FileSink::create(
+      writePath,
+      {
+          .bufferWrite = false,
+          .connectorProperties = hiveConfig_->config(),
+          .fileCreateConfig = hiveConfig_->writeFileCreateConfig(),
+          .pool = writerInfo_.back()->sinkPool.get(),
+          .metricLogger = dwio::common::MetricsLog::voidLog(),
+          .stats = ioStats_.back().get(),
+      });
+  if (executor_ != nullptr && writerAsyncFlushMaxPendingBytes_ > 0) {
+    auto asyncSink = std::make_unique<dwio::common::AsyncFileSink>(
+        std::move(sink), executor_, writerAsyncFlushMaxPendingBytes_);
+    writerInfo_.back()->asyncSink = asyncSink.get();
+    sink = std::move(asyncSink);
+  }
+  auto writer = writerFactory_->createWriter(std::move(sink), options);
   writer = maybeCreateBucketSortWriter(std::move(writer));
   writers_.emplace_back(std::move(writer));
   // Extends the buffer used for partition rows calculations.
@@ -1145,7 +1179,15 @@ bool HiveDataSink::WriterReclaimer::reclaimableBytes(
   if (!dataSink_->canReclaim()) {
     return false;
   }
-  return exec::MemoryReclaimer::reclaimableBytes(pool, reclaimableBytes);
+  const auto reclaimable =
+      exec::MemoryReclaimer::reclaimableBytes(pool, reclaimableBytes);
+  if (writerInfo_->asyncSink != nullptr) {
+    // The buffers waiting to be written are freed by the writes, not by
+    // reclaim.
+    reclaimableBytes -= std::min(
+        reclaimableBytes, writerInfo_->asyncSink->pendingBytes());
+  }
+  return reclaimable;
 }
 
 uint64_t HiveDataSink::WriterReclaimer::reclaim(
@@ -1171,8 +1213,17 @@ uint64_t HiveDataSink::WriterReclaimer::reclaim(
   const uint64_t memoryUsageBeforeReclaim = pool->reservedBytes();
   const std::string memoryUsageTreeBeforeReclaim = pool->treeMemoryUsage();
   const auto writtenBytesBeforeReclaim = ioStats_->rawBytesWritten();
-  const auto reclaimedBytes =
+  auto reclaimedBytes =
       exec::MemoryReclaimer::reclaim(pool, targetBytes, maxWaitMs, stats);
+  if (writerInfo_->asyncSink != nullptr) {
+    // The flushed data is freed once written. Reclaim does not wait for the
+    // writes: they run outside of arbitration and their sink may need memory
+    // from the arbitration that would wait for them. The memory the writes
+    // have freed so far is released, the rest is left to a later reclaim.
+    const auto reservedBytes = pool->reservedBytes();
+    releaseUnusedReservations(pool);
+    reclaimedBytes += reservedBytes - pool->reservedBytes();
+  }
   const auto earlyFlushedRawBytes =
       ioStats_->rawBytesWritten() - writtenBytesBeforeReclaim;
   addThreadLocalRuntimeStat(
@@ -20,6 +20,7 @@
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/PartitionIdGenerator.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
@@ -406,6 +407,9 @@ struct HiveWriterInfo {
   const std::shared_ptr<memory::MemoryPool> writerPool;
   const std::shared_ptr<memory::MemoryPool> sinkPool;
   const std::shared_ptr<memory::MemoryPool> sortPool;
+  /// The sink of the file writer if the file is written in the background.
+  /// Owned by the file writer.
+  dwio::common::AsyncFileSink* asyncSink{nullptr};
   int64_t numWrittenRows = 0;
   int64_t inputSizeInBytes = 0;
 };
@@ -472,7 +476,8 @@ class HiveDataSink : public DataSink {
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* executor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -481,6 +486,10 @@ class HiveDataSink : public DataSink {
 
   void appendData(RowVectorPtr input) override;
 
+  /// Returns true if a file writer has more than
+  /// HiveConfig::kWriterAsyncFlushMaxPendingBytes waiting to be written.
+  bool isBlocked(ContinueFuture* future) override;
+
   bool finish() override;
 
   Stats stats() const override;
@@ -623,6 +632,10 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
   const uint64_t sortWriterFinishTimeSliceLimitMs_{0};
+  // Executor for writing the files in the background. Not used if null or if
+  // 'writerAsyncFlushMaxPendingBytes_' is zero.
+  folly::Executor* const executor_;
+  const uint64_t writerAsyncFlushMaxPendingBytes_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
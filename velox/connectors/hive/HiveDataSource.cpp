@@ -65,14 +65,18 @@ HiveDataSource::HiveDataSource(
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
     const ConnectorQueryCtx* connectorQueryCtx,
-    const std::shared_ptr<HiveConfig>& hiveConfig)
+    const std::shared_ptr<HiveConfig>& hiveConfig,
+    folly::Executor* decodeExecutor)
     : fileHandleFactory_(fileHandleFactory),
       executor_(executor),
+      decodeExecutor_(decodeExecutor),
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
       pool_(connectorQueryCtx->memoryPool()),
       outputType_(outputType),
-      expressionEvaluator_(connectorQueryCtx->expressionEvaluator()) {
+      expressionEvaluator_(connectorQueryCtx->expressionEvaluator()),
+      combinedSplitPrefetchFiles_(hiveConfig_->combinedSplitPrefetchFiles(
+          connectorQueryCtx->sessionProperties())) {
   // Column handled keyed on the column alias, the name used in the query.
   for (const auto& [canonicalizedName, columnHandle] : columnHandles) {
     auto handle = std::dynamic_pointer_cast<HiveColumnHandle>(columnHandle);
@@ -95,12 +99,16 @@ HiveDataSource::HiveDataSource(
       case HiveColumnHandle::ColumnType::kRowId:
         specialColumns_.rowId = handle->name();
         break;
+      case HiveColumnHandle::ColumnType::kAggregate:
+        break;
     }
   }
 
   std::vector<std::string> readColumnNames;
-  auto readColumnTypes = outputType_->children();
-  for (const auto& outputName : outputType_->names()) {
+  std::vector<TypePtr> readColumnTypes;
+  std::vector<const HiveColumnHandle*> aggregateHandles;
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    const auto& outputName = outputType_->nameOf(i);
     auto it = columnHandles.find(outputName);
     VELOX_CHECK(
         it != columnHandles.end(),
@@ -108,7 +116,12 @@ HiveDataSource::HiveDataSource(
         outputName);
 
     auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
+    if (handle->columnType() == HiveColumnHandle::ColumnType::kAggregate) {
+      aggregateHandles.push_back(handle);
+      continue;
+    }
     readColumnNames.push_back(handle->name());
+    readColumnTypes.push_back(outputType_->childAt(i));
     for (auto& subfield : handle->requiredSubfields()) {
       VELOX_USER_CHECK_EQ(
           getColumnName(subfield),
@@ -117,6 +130,26 @@ HiveDataSource::HiveDataSource(
       subfields_[handle->name()].push_back(&subfield);
     }
   }
+  if (!aggregateHandles.empty()) {
+    VELOX_USER_CHECK_EQ(
+        aggregateHandles.size(),
+        outputType_->size(),
+        "Aggregate columns cannot be mixed with other output columns");
+    // Read each aggregated column once, for the splits where the aggregates
+    // are computed from the decoded rows.
+    for (const auto* handle : aggregateHandles) {
+      if (!handle->name().empty() &&
+          std::find(
+              readColumnNames.begin(),
+              readColumnNames.end(),
+              handle->name()) == readColumnNames.end()) {
+        readColumnNames.push_back(handle->name());
+        readColumnTypes.push_back(handle->hiveType());
+      }
+    }
+    splitAggregation_ = std::make_unique<SplitAggregation>(
+        outputType_, aggregateHandles, pool_);
+  }
 
   hiveTableHandle_ = std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -202,14 +235,27 @@ HiveDataSource::HiveDataSource(
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
   }
+  if (hiveConfig_->filterSelectivitySharingEnabled(
+          connectorQueryCtx_->sessionProperties()) &&
+      !hiveConfig_->readStatsBasedFilterReorderDisabled(
+          connectorQueryCtx_->sessionProperties())) {
+    selectivityStore_ = &common::FilterSelectivityStore::instance();
+    selectivitySnapshot_ =
+        selectivityStore_->seed(hiveTableHandle_->tableName(), *scanSpec_);
+  }
 
   ioStats_ = std::make_shared<io::IoStatistics>();
   fsStats_ = std::make_shared<filesystems::File::IoStats>();
 }
 
-std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
+HiveDataSource::~HiveDataSource() {
+  waitForCombinedFiles();
+}
+
+std::unique_ptr<SplitReader> HiveDataSource::createSplitReader(
+    const std::shared_ptr<HiveConnectorSplit>& split) {
   return SplitReader::create(
-      split_,
+      split,
       hiveTableHandle_,
       &partitionKeys_,
       connectorQueryCtx_,
@@ -219,7 +265,8 @@ std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
       fsStats_,
       fileHandleFactory_,
       executor_,
-      scanSpec_);
+      scanSpec_,
+      decodeExecutor_);
 }
 
 std::unique_ptr<HivePartitionFunction> HiveDataSource::setupBucketConversion() {
@@ -302,9 +349,66 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK_NULL(
       split_,
       "Previous split has not been processed yet. Call next to process the split.");
-  split_ = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
-  VELOX_CHECK_NOT_NULL(split_, "Wrong type of split");
+  if (auto combinedSplit =
+          std::dynamic_pointer_cast<const HiveCombinedSplit>(split)) {
+    VELOX_CHECK(combinedFiles_.empty());
+    VLOG(1) << "Adding split " << combinedSplit->toString();
+    for (const auto& fileSplit : combinedSplit->splits) {
+      combinedFiles_.push_back({fileSplit});
+    }
+    addNextCombinedFile();
+    return;
+  }
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  VELOX_CHECK_NOT_NULL(hiveSplit, "Wrong type of split");
+  addFileSplit(std::move(hiveSplit), nullptr);
+}
+
+void HiveDataSource::addNextCombinedFile() {
+  VELOX_CHECK(!combinedFiles_.empty());
+  auto file = std::move(combinedFiles_.front());
+  combinedFiles_.pop_front();
+  if (file.opened.valid()) {
+    // Rethrows the error of opening the file, if any.
+    std::move(file.opened).get();
+  }
+  ++numCombinedFiles_;
+  openCombinedFilesAhead();
+  addFileSplit(std::move(file.split), std::move(file.splitReader));
+}
+
+void HiveDataSource::openCombinedFilesAhead() {
+  if (executor_ == nullptr) {
+    return;
+  }
+  const auto numFiles = std::min<size_t>(
+      combinedSplitPrefetchFiles_, combinedFiles_.size());
+  for (size_t i = 0; i < numFiles; ++i) {
+    auto& file = combinedFiles_[i];
+    if (file.splitReader != nullptr) {
+      continue;
+    }
+    file.splitReader = createSplitReader(file.split);
+    file.splitReader->configureReaderOptions(randomSkip_);
+    file.opened = folly::via(executor_, [reader = file.splitReader.get()]() {
+                    reader->openFile();
+                  }).semi();
+  }
+}
+
+void HiveDataSource::waitForCombinedFiles() {
+  for (auto& file : combinedFiles_) {
+    if (file.opened.valid()) {
+      std::move(file.opened).wait();
+      file.opened = folly::SemiFuture<folly::Unit>::makeEmpty();
+    }
+  }
+}
 
+void HiveDataSource::addFileSplit(
+    std::shared_ptr<HiveConnectorSplit> split,
+    std::unique_ptr<SplitReader> splitReader) {
+  split_ = std::move(split);
   VLOG(1) << "Adding split " << split_->toString();
 
   if (splitReader_) {
@@ -320,12 +424,32 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     setupRowIdColumn();
   }
 
-  splitReader_ = createSplitReader();
-  // Split reader subclasses may need to use the reader options in prepareSplit
-  // so we initialize it beforehand.
-  splitReader_->configureReaderOptions(randomSkip_);
+  if (splitReader != nullptr) {
+    splitReader_ = std::move(splitReader);
+  } else {
+    splitReader_ = createSplitReader(split_);
+    // Split reader subclasses may need to use the reader options in
+    // prepareSplit so we initialize it beforehand.
+    splitReader_->configureReaderOptions(randomSkip_);
+  }
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
   readerOutputType_ = splitReader_->readerOutputType();
+  if (splitAggregation_ != nullptr && !splitReader_->emptySplit()) {
+    aggregatedFromStatistics_ = aggregateFromStatistics();
+  }
+}
+
+bool HiveDataSource::aggregateFromStatistics() {
+  const auto* reader = splitReader_->statisticsReader();
+  if (reader == nullptr || remainingFilterExprSet_ != nullptr ||
+      randomSkip_ != nullptr || partitionFunction_ != nullptr ||
+      !splitReader_->testFiltersOnAllRows() ||
+      !splitAggregation_->addStatistics(*reader)) {
+    return false;
+  }
+  ++numAggregatedFromStatistics_;
+  completedRows_ += reader->numberOfRows().value();
+  return true;
 }
 
 vector_size_t HiveDataSource::applyBucketConversion(
@@ -376,17 +500,25 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   TestValue::adjust(
       "facebook::velox::connector::hive::HiveDataSource::next", this);
 
-  if (splitReader_->emptySplit()) {
+  if (splitReader_->emptySplit() || splitAggregationFinished_) {
+    splitAggregationFinished_ = false;
     resetSplit();
-    return nullptr;
+    return finishFile();
+  }
+
+  if (aggregatedFromStatistics_) {
+    aggregatedFromStatistics_ = false;
+    splitAggregationFinished_ = true;
+    return splitAggregation_->finish();
   }
 
   // Bucket conversion or delta update could add extra column to reader output.
-  auto needsExtraColumn = [&] {
-    return output_->asUnchecked<RowVector>()->childrenSize() <
+  // Iceberg equality deletes add columns for a single split.
+  auto columnsChanged = [&] {
+    return output_->asUnchecked<RowVector>()->childrenSize() !=
         readerOutputType_->size();
   };
-  if (!output_ || needsExtraColumn()) {
+  if (!output_ || columnsChanged()) {
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
 
@@ -394,8 +526,13 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   completedRows_ += rowsScanned;
   if (rowsScanned == 0) {
     splitReader_->updateRuntimeStats(runtimeStats_);
+    if (splitAggregation_ != nullptr) {
+      // Return the aggregates of the split and finish it on the next call.
+      splitAggregationFinished_ = true;
+      return splitAggregation_->finish();
+    }
     resetSplit();
-    return nullptr;
+    return finishFile();
   }
 
   VELOX_CHECK(
@@ -441,6 +578,11 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     }
   }
 
+  if (splitAggregation_ != nullptr) {
+    splitAggregation_->addInput(*rowVector, rowsRemaining, remainingIndices);
+    return getEmptyOutput();
+  }
+
   if (outputType_->size() == 0) {
     return exec::wrap(rowsRemaining, remainingIndices, rowVector);
   }
@@ -521,6 +663,14 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeCounter(numBucketConversion_)});
   }
+  if (numAggregatedFromStatistics_ > 0) {
+    res.insert(
+        {"numSplitsAggregatedFromStats",
+         RuntimeCounter(numAggregatedFromStatistics_)});
+  }
+  if (numCombinedFiles_ > 0) {
+    res.insert({"numCombinedSplitFiles", RuntimeCounter(numCombinedFiles_)});
+  }
 
   const auto fsStats = fsStats_->stats();
   for (const auto& storageStats : fsStats) {
@@ -553,6 +703,21 @@ void HiveDataSource::setFromDataSource(
 
   numBucketConversion_ += source->numBucketConversion_;
   partitionFunction_ = std::move(source->partitionFunction_);
+  numAggregatedFromStatistics_ += source->numAggregatedFromStatistics_;
+  numCombinedFiles_ += source->numCombinedFiles_;
+  // The files of a combined split that 'source' opened ahead refer to the
+  // state of 'source'. They are opened again by 'this'.
+  source->waitForCombinedFiles();
+  for (auto& file : source->combinedFiles_) {
+    combinedFiles_.push_back({std::move(file.split)});
+  }
+  source->combinedFiles_.clear();
+  openCombinedFilesAhead();
+  aggregatedFromStatistics_ = source->aggregatedFromStatistics_;
+  if (aggregatedFromStatistics_) {
+    // The aggregates of the split are in 'source'.
+    splitAggregation_ = std::move(source->splitAggregation_);
+  }
 }
 
 int64_t HiveDataSource::estimatedRowSize() {
@@ -584,7 +749,20 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   return rowsRemaining;
 }
 
+RowVectorPtr HiveDataSource::finishFile() {
+  if (combinedFiles_.empty()) {
+    return nullptr;
+  }
+  // Continues with the next file of the combined split.
+  addNextCombinedFile();
+  return getEmptyOutput();
+}
+
 void HiveDataSource::resetSplit() {
+  if (selectivityStore_ != nullptr) {
+    selectivityStore_->record(
+        hiveTableHandle_->tableName(), *scanSpec_, selectivitySnapshot_);
+  }
   split_.reset();
   splitReader_->resetSplit();
   // Keep readers around to hold adaptation.
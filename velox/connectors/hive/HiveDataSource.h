@@ -15,6 +15,10 @@
  */
 #pragma once
 
+#include <deque>
+
+#include <folly/futures/Future.h>
+
 #include "velox/common/base/RandomUtil.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/io/IoStatistics.h"
@@ -23,8 +27,10 @@
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/connectors/hive/SplitAggregation.h"
 #include "velox/connectors/hive/SplitReader.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/dwio/common/FilterSelectivityStore.h"
 #include "velox/dwio/common/Statistics.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
@@ -44,8 +50,14 @@ class HiveDataSource : public DataSource {
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
       const ConnectorQueryCtx* connectorQueryCtx,
-      const std::shared_ptr<HiveConfig>& hiveConfig);
+      const std::shared_ptr<HiveConfig>& hiveConfig,
+      folly::Executor* decodeExecutor = nullptr);
+
+  ~HiveDataSource() override;
 
+  /// Accepts a HiveConnectorSplit or a HiveCombinedSplit. The files of a
+  /// combined split are read one after the other before next() returns
+  /// nullptr.
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
   std::optional<RowVectorPtr> next(uint64_t size, velox::ContinueFuture& future)
@@ -99,10 +111,12 @@ class HiveDataSource : public DataSource {
   }
 
  protected:
-  virtual std::unique_ptr<SplitReader> createSplitReader();
+  virtual std::unique_ptr<SplitReader> createSplitReader(
+      const std::shared_ptr<HiveConnectorSplit>& split);
 
   FileHandleFactory* const fileHandleFactory_;
   folly::Executor* const executor_;
+  folly::Executor* const decodeExecutor_;
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const std::shared_ptr<HiveConfig> hiveConfig_;
   memory::MemoryPool* const pool_;
@@ -134,12 +148,38 @@ class HiveDataSource : public DataSource {
 
   void setupRowIdColumn();
 
+  // Starts reading the file of 'split'. 'splitReader' is the reader of 'split'
+  // if it has been made ahead, with the file opened.
+  void addFileSplit(
+      std::shared_ptr<HiveConnectorSplit> split,
+      std::unique_ptr<SplitReader> splitReader);
+
+  // Starts reading the next file of the current combined split.
+  void addNextCombinedFile();
+
+  // Opens the next files of the current combined split on 'executor_'.
+  void openCombinedFilesAhead();
+
+  // Waits for the files of the current combined split that are being opened
+  // ahead.
+  void waitForCombinedFiles();
+
+  // Adds the aggregates of the current split to 'splitAggregation_' from the
+  // file statistics. Returns false if the statistics do not describe the rows
+  // of the split that pass the filters or cannot answer the aggregates.
+  bool aggregateFromStatistics();
+
   // Evaluates remainingFilter_ on the specified vector. Returns number of rows
   // passed. Populates filterEvalCtx_.selectedIndices and selectedBits if only
   // some rows passed the filter. If none or all rows passed
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Invoked after the file of 'split_' has been read. Starts reading the next
+  // file of the current combined split, if any, and returns an empty batch.
+  // Returns nullptr at the end of the split.
+  RowVectorPtr finishFile();
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
@@ -163,6 +203,11 @@ class HiveDataSource : public DataSource {
       subfields_;
   common::SubfieldFilters filters_;
   std::shared_ptr<common::MetadataFilter> metadataFilter_;
+  // Set if the filter selectivity is shared with other scans of the table.
+  common::FilterSelectivityStore* selectivityStore_{nullptr};
+  // Filter selectivity of 'scanSpec_' last seeded from or recorded into
+  // 'selectivityStore_'.
+  common::FilterSelectivityStore::Snapshot selectivitySnapshot_;
   std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
   RowVectorPtr emptyOutput_;
   dwio::common::RuntimeStatistics runtimeStats_;
@@ -179,6 +224,31 @@ class HiveDataSource : public DataSource {
   std::unique_ptr<HivePartitionFunction> partitionFunction_;
   std::vector<uint32_t> partitions_;
 
+  // Set if the output consists of aggregate columns.
+  std::unique_ptr<SplitAggregation> splitAggregation_;
+  // True if the aggregates of the current split were computed from the file
+  // statistics and are yet to be returned.
+  bool aggregatedFromStatistics_{false};
+  // True if the aggregates of the current split were returned.
+  bool splitAggregationFinished_{false};
+  int64_t numAggregatedFromStatistics_{0};
+
+  // A file of a HiveCombinedSplit that is not read yet.
+  struct CombinedFile {
+    std::shared_ptr<HiveConnectorSplit> split;
+    // The reader of 'split' if it is being opened ahead.
+    std::unique_ptr<SplitReader> splitReader;
+    // Completes when 'splitReader' has opened the file.
+    folly::SemiFuture<folly::Unit> opened{
+        folly::SemiFuture<folly::Unit>::makeEmpty()};
+  };
+
+  // The number of files of a combined split to open ahead.
+  const uint32_t combinedSplitPrefetchFiles_;
+  // The files of the current combined split after the one being read.
+  std::deque<CombinedFile> combinedFiles_;
+  int64_t numCombinedFiles_{0};
+
   // Reusable memory for remaining filter evaluation.
   VectorPtr filterResult_;
   SelectivityVector filterRows_;
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/SplitAggregation.h"
+
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::connector::hive {
+
+namespace {
+
+using AggregateKind = HiveColumnHandle::AggregateKind;
+
+// Integer statistics are exact for these types. Decimals are excluded because
+// their statistics may be stored in other physical types, and floating point
+// statistics do not account for NaN.
+bool hasExactIntegerStatistics(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDecimal();
+    default:
+      return false;
+  }
+}
+
+template <TypeKind Kind>
+void mergeIntegerValue(AggregateKind kind, BaseVector& result, int64_t value) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto* flat = result.asUnchecked<FlatVector<T>>();
+  const auto typedValue = static_cast<T>(value);
+  if (flat->isNullAt(0) ||
+      (kind == AggregateKind::kMin ? typedValue < flat->valueAt(0)
+                                   : typedValue > flat->valueAt(0))) {
+    flat->set(0, typedValue);
+  }
+}
+
+} // namespace
+
+SplitAggregation::SplitAggregation(
+    RowTypePtr outputType,
+    const std::vector<const HiveColumnHandle*>& handles,
+    memory::MemoryPool* pool)
+    : outputType_(std::move(outputType)), pool_(pool) {
+  VELOX_CHECK_EQ(outputType_->size(), handles.size());
+  accumulators_.reserve(handles.size());
+  for (const auto* handle : handles) {
+    VELOX_CHECK(
+        handle->columnType() == HiveColumnHandle::ColumnType::kAggregate);
+    Accumulator accumulator{
+        handle->aggregateKind().value(), handle->name(), handle->hiveType()};
+    if (accumulator.kind == AggregateKind::kMin ||
+        accumulator.kind == AggregateKind::kMax) {
+      accumulator.value = newValue(accumulator.type);
+    }
+    accumulators_.push_back(std::move(accumulator));
+  }
+}
+
+VectorPtr SplitAggregation::newValue(const TypePtr& type) const {
+  auto value = BaseVector::create(type, 1, pool_);
+  value->setNull(0, true);
+  return value;
+}
+
+bool SplitAggregation::computeFromStatistics(
+    const dwio::common::Reader& reader,
+    const Accumulator& accumulator,
+    StatisticsResult& result) const {
+  const auto numRows = reader.numberOfRows().value();
+  if (accumulator.kind == AggregateKind::kCount && accumulator.column.empty()) {
+    result.count = numRows;
+    return true;
+  }
+
+  // A column missing from the file is read as null.
+  uint64_t numValues = 0;
+  const auto& fileType = reader.rowType();
+  const auto fileIndex = fileType->getChildIdxIfExists(accumulator.column);
+  std::unique_ptr<dwio::common::ColumnStatistics> stats;
+  if (fileIndex.has_value()) {
+    stats = reader.aggregateStatistics(
+        reader.typeWithId()->childAt(*fileIndex)->id());
+    if (stats == nullptr || !stats->getNumberOfValues().has_value()) {
+      return false;
+    }
+    numValues = stats->getNumberOfValues().value();
+  }
+
+  switch (accumulator.kind) {
+    case AggregateKind::kCount:
+      result.count = numValues;
+      return true;
+    case AggregateKind::kNullCount:
+      result.count = numRows - numValues;
+      return true;
+    case AggregateKind::kMin:
+    case AggregateKind::kMax: {
+      if (numValues == 0) {
+        return true;
+      }
+      if (!hasExactIntegerStatistics(*accumulator.type) ||
+          fileType->childAt(*fileIndex)->kind() != accumulator.type->kind()) {
+        return false;
+      }
+      const auto* intStats =
+          dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+              stats.get());
+      if (intStats == nullptr) {
+        return false;
+      }
+      result.value = accumulator.kind == AggregateKind::kMin
+          ? intStats->getMinimum()
+          : intStats->getMaximum();
+      return result.value.has_value();
+    }
+  }
+  VELOX_UNREACHABLE();
+}
+
+bool SplitAggregation::addStatistics(const dwio::common::Reader& reader) {
+  if (!reader.numberOfRows().has_value()) {
+    return false;
+  }
+  std::vector<StatisticsResult> results(accumulators_.size());
+  for (auto i = 0; i < accumulators_.size(); ++i) {
+    if (!computeFromStatistics(reader, accumulators_[i], results[i])) {
+      return false;
+    }
+  }
+  for (auto i = 0; i < accumulators_.size(); ++i) {
+    auto& accumulator = accumulators_[i];
+    accumulator.count += results[i].count;
+    if (results[i].value.has_value()) {
+      addValue(accumulator, results[i].value.value());
+    }
+  }
+  return true;
+}
+
+void SplitAggregation::addValue(Accumulator& accumulator, int64_t value) {
+  switch (accumulator.type->kind()) {
+    case TypeKind::TINYINT:
+      mergeIntegerValue<TypeKind::TINYINT>(
+          accumulator.kind, *accumulator.value, value);
+      break;
+    case TypeKind::SMALLINT:
+      mergeIntegerValue<TypeKind::SMALLINT>(
+          accumulator.kind, *accumulator.value, value);
+      break;
+    case TypeKind::INTEGER:
+      mergeIntegerValue<TypeKind::INTEGER>(
+          accumulator.kind, *accumulator.value, value);
+      break;
+    case TypeKind::BIGINT:
+      mergeIntegerValue<TypeKind::BIGINT>(
+          accumulator.kind, *accumulator.value, value);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void SplitAggregation::addInput(
+    const RowVector& input,
+    vector_size_t numRows,
+    const BufferPtr& indices) {
+  const auto* rawIndices =
+      indices != nullptr ? indices->as<vector_size_t>() : nullptr;
+  const auto& inputType = input.type()->asRow();
+  for (auto& accumulator : accumulators_) {
+    if (accumulator.column.empty()) {
+      accumulator.count += numRows;
+      continue;
+    }
+    const auto& column =
+        input.childAt(inputType.getChildIdx(accumulator.column));
+    addInput(accumulator, *column, numRows, rawIndices);
+  }
+}
+
+void SplitAggregation::addInput(
+    Accumulator& accumulator,
+    const BaseVector& input,
+    vector_size_t numRows,
+    const vector_size_t* indices) {
+  decoded_.decode(input);
+  if (accumulator.kind == AggregateKind::kCount ||
+      accumulator.kind == AggregateKind::kNullCount) {
+    int64_t numNulls = 0;
+    if (decoded_.mayHaveNulls()) {
+      for (vector_size_t i = 0; i < numRows; ++i) {
+        numNulls += decoded_.isNullAt(indices ? indices[i] : i);
+      }
+    }
+    accumulator.count += accumulator.kind == AggregateKind::kCount
+        ? numRows - numNulls
+        : numNulls;
+    return;
+  }
+
+  static const CompareFlags kCompareFlags{
+      .nullHandlingMode = CompareFlags::NullHandlingMode::kNullAsValue};
+  const auto* base = decoded_.base();
+  auto& value = accumulator.value;
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    const auto row = indices ? indices[i] : i;
+    if (decoded_.isNullAt(row)) {
+      continue;
+    }
+    const auto baseRow = decoded_.index(row);
+    if (!value->isNullAt(0)) {
+      const auto result =
+          base->compare(value.get(), baseRow, 0, kCompareFlags).value();
+      if (accumulator.kind == AggregateKind::kMin ? result >= 0
+                                                  : result <= 0) {
+        continue;
+      }
+    }
+    value->copy(base, 0, baseRow, 1);
+  }
+}
+
+RowVectorPtr SplitAggregation::finish() {
+  std::vector<VectorPtr> children;
+  children.reserve(accumulators_.size());
+  for (auto& accumulator : accumulators_) {
+    if (accumulator.kind == AggregateKind::kMin ||
+        accumulator.kind == AggregateKind::kMax) {
+      children.push_back(std::move(accumulator.value));
+      accumulator.value = newValue(accumulator.type);
+      continue;
+    }
+    auto count = BaseVector::create<FlatVector<int64_t>>(BIGINT(), 1, pool_);
+    count->set(0, accumulator.count);
+    accumulator.count = 0;
+    children.push_back(std::move(count));
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, nullptr, 1, std::move(children));
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Computes the aggregates of the kAggregate columns of a table scan, one
+/// result row per split. The aggregates of a split are answered from the
+/// statistics of its file when these describe the split and all rows pass the
+/// filters. Otherwise they are computed from the decoded rows that pass the
+/// filters.
+class SplitAggregation {
+ public:
+  /// 'handles' are the column handles of the columns of 'outputType', all of
+  /// type kAggregate.
+  SplitAggregation(
+      RowTypePtr outputType,
+      const std::vector<const HiveColumnHandle*>& handles,
+      memory::MemoryPool* pool);
+
+  /// Adds all rows of the file of 'reader' from its statistics. Returns false
+  /// without adding anything if the statistics cannot answer all aggregates,
+  /// e.g. the file has no statistics or min/max is for a type for which
+  /// statistics are not exact.
+  bool addStatistics(const dwio::common::Reader& reader);
+
+  /// Adds the first 'numRows' rows of 'input' or, if 'indices' is set, the
+  /// rows at 'indices'. 'input' has the aggregated columns by name.
+  void addInput(
+      const RowVector& input,
+      vector_size_t numRows,
+      const BufferPtr& indices);
+
+  /// Returns the aggregates of the rows added since the previous call as a
+  /// single row of the output type and resets the aggregates.
+  RowVectorPtr finish();
+
+ private:
+  struct Accumulator {
+    HiveColumnHandle::AggregateKind kind;
+    // The aggregated column. Empty for count(*).
+    std::string column;
+    // Type of 'column'.
+    TypePtr type;
+    // Result of count and null count.
+    int64_t count{0};
+    // Result of min and max as a single row vector of 'type'. Null until a
+    // non-null value is added.
+    VectorPtr value;
+  };
+
+  // Result of an aggregate computed from file statistics.
+  struct StatisticsResult {
+    int64_t count{0};
+    std::optional<int64_t> value;
+  };
+
+  bool computeFromStatistics(
+      const dwio::common::Reader& reader,
+      const Accumulator& accumulator,
+      StatisticsResult& result) const;
+
+  void addValue(Accumulator& accumulator, int64_t value);
+
+  void addInput(
+      Accumulator& accumulator,
+      const BaseVector& input,
+      vector_size_t numRows,
+      const vector_size_t* indices);
+
+  VectorPtr newValue(const TypePtr& type) const;
+
+  const RowTypePtr outputType_;
+  memory::MemoryPool* const pool_;
+  std::vector<Accumulator> accumulators_;
+  DecodedVector decoded_;
+};
+
+} // namespace facebook::velox::connector::hive
@@ -87,7 +87,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
     const std::shared_ptr<filesystems::File::IoStats>& fsStats,
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec) {
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    folly::Executor* decodeExecutor) {
   //  Create the SplitReader based on hiveSplit->customSplitInfo["table_format"]
   if (hiveSplit->customSplitInfo.count("table_format") > 0 &&
       hiveSplit->customSplitInfo["table_format"] == "hive-iceberg") {
@@ -102,7 +103,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
         fsStats,
         fileHandleFactory,
         executor,
-        scanSpec);
+        scanSpec,
+        decodeExecutor);
   } else {
     return std::unique_ptr<SplitReader>(new SplitReader(
         hiveSplit,
@@ -115,7 +117,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
         fsStats,
         fileHandleFactory,
         executor,
-        scanSpec));
+        scanSpec,
+        decodeExecutor));
   }
 }
 
@@ -131,7 +134,8 @@ SplitReader::SplitReader(
     const std::shared_ptr<filesystems::File::IoStats>& fsStats,
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec)
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    folly::Executor* decodeExecutor)
     : hiveSplit_(hiveSplit),
       hiveTableHandle_(hiveTableHandle),
       partitionKeys_(partitionKeys),
@@ -142,6 +146,7 @@ SplitReader::SplitReader(
       fsStats_(fsStats),
       fileHandleFactory_(fileHandleFactory),
       executor_(executor),
+      decodeExecutor_(decodeExecutor),
       pool_(connectorQueryCtx->memoryPool()),
       scanSpec_(scanSpec),
       baseReaderOpts_(connectorQueryCtx->memoryPool()),
@@ -241,7 +246,15 @@ std::string SplitReader::toString() const {
       static_cast<const void*>(baseRowReader_.get()));
 }
 
+void SplitReader::openFile() {
+  createReader();
+}
+
 void SplitReader::createReader() {
+  if (fileOpened_) {
+    return;
+  }
+  fileOpened_ = true;
   VELOX_CHECK_NE(
       baseReaderOpts_.fileFormat(), dwio::common::FileFormat::UNKNOWN);
 
@@ -269,6 +282,22 @@ void SplitReader::createReader() {
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+  splitCoversFile_ = hiveSplit_->start == 0 &&
+      hiveSplit_->length >= fileHandleCachePtr->file->size();
+  // Parsed footers are cached per version of the file, so the cache is only
+  // used when the split tells the modification time of the file.
+  auto* asyncCache = connectorQueryCtx_->cache();
+  auto* fileMetadataCache =
+      asyncCache != nullptr ? asyncCache->fileMetadataCache() : nullptr;
+  if (fileMetadataCache != nullptr && hiveSplit_->properties.has_value() &&
+      hiveSplit_->properties->modificationTime.has_value()) {
+    baseReaderOpts_.setFileMetadataCache(
+        fileMetadataCache,
+        {fileHandleCachePtr->uuid.id(),
+         hiveSplit_->properties->modificationTime.value()});
+  } else {
+    baseReaderOpts_.setFileMetadataCache(nullptr);
+  }
   auto baseFileInput = createBufferedInput(
       *fileHandleCachePtr,
       baseReaderOpts_,
@@ -288,6 +317,19 @@ RowTypePtr SplitReader::getAdaptedRowType() const {
   return ROW(std::move(columnNames), std::move(columnTypes));
 }
 
+const dwio::common::Reader* SplitReader::statisticsReader() const {
+  return splitCoversFile_ ? baseReader_.get() : nullptr;
+}
+
+bool SplitReader::testFiltersOnAllRows() const {
+  VELOX_CHECK_NOT_NULL(baseReader_);
+  return hive::testFiltersOnAllRows(
+      scanSpec_.get(),
+      baseReader_.get(),
+      hiveSplit_->partitionKeys,
+      *partitionKeys_);
+}
+
 bool SplitReader::filterOnStats(
     dwio::common::RuntimeStatistics& runtimeStats) const {
   if (testFilters(
@@ -330,6 +372,14 @@ void SplitReader::createRowReader(
       hiveConfig_,
       connectorQueryCtx_->sessionProperties(),
       baseRowReaderOpts_);
+  const auto decodingParallelism =
+      hiveConfig_->decodingParallelism(connectorQueryCtx_->sessionProperties());
+  if (decodeExecutor_ != nullptr && decodingParallelism > 1) {
+    // The executor is owned by the connector and outlives the row reader.
+    baseRowReaderOpts_.setDecodingExecutor(std::shared_ptr<folly::Executor>(
+        std::shared_ptr<folly::Executor>(), decodeExecutor_));
+    baseRowReaderOpts_.setDecodingParallelismFactor(decodingParallelism);
+  }
   baseRowReader_ = baseReader_->createRowReader(baseRowReaderOpts_);
 }
 
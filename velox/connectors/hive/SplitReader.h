@@ -66,7 +66,8 @@ class SplitReader {
       const std::shared_ptr<filesystems::File::IoStats>& fsStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      folly::Executor* decodeExecutor = nullptr);
 
   virtual ~SplitReader() = default;
 
@@ -81,6 +82,11 @@ class SplitReader {
       std::shared_ptr<common::MetadataFilter> metadataFilter,
       dwio::common::RuntimeStatistics& runtimeStats);
 
+  /// Opens the file of the split and reads its metadata ahead of
+  /// prepareSplit(), e.g. on an IO executor while another split is read. Uses
+  /// no state that is shared with the other split readers of the data source.
+  void openFile();
+
   virtual uint64_t next(uint64_t size, VectorPtr& output);
 
   void resetFilterCaches();
@@ -101,6 +107,15 @@ class SplitReader {
     return readerOutputType_;
   }
 
+  /// Returns the file reader if the statistics of the file describe the rows of
+  /// the split, i.e. the split covers the whole file and no rows of the file
+  /// are removed by the table format. Returns nullptr otherwise.
+  virtual const dwio::common::Reader* statisticsReader() const;
+
+  /// Returns true if all rows of the split pass the filters in the scan spec,
+  /// based on partition key values and file statistics.
+  bool testFiltersOnAllRows() const;
+
   std::string toString() const;
 
  protected:
@@ -116,10 +131,12 @@ class SplitReader {
       const std::shared_ptr<filesystems::File::IoStats>& fsStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      folly::Executor* decodeExecutor = nullptr);
 
   /// Create the dwio::common::Reader object baseReader_, which will be used to
-  /// read the data file's metadata and schema
+  /// read the data file's metadata and schema. No-op if the file has been
+  /// opened by openFile().
   void createReader();
 
   // Adjust the scan spec according to the current split, then return the
@@ -171,6 +188,8 @@ class SplitReader {
   const std::shared_ptr<filesystems::File::IoStats> fsStats_;
   FileHandleFactory* const fileHandleFactory_;
   folly::Executor* const executor_;
+  // Decodes the columns of a split in parallel. Not used for IO.
+  folly::Executor* const decodeExecutor_;
   memory::MemoryPool* const pool_;
 
   std::shared_ptr<common::ScanSpec> scanSpec_;
@@ -179,6 +198,10 @@ class SplitReader {
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
   bool emptySplit_;
+  // True once createReader() has run.
+  bool fileOpened_{false};
+  // True if the split covers the whole file.
+  bool splitCoversFile_{false};
 };
 
 } // namespace facebook::velox::connector::hive
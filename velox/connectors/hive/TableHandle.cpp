@@ -26,6 +26,17 @@ columnTypeNames() {
       {HiveColumnHandle::ColumnType::kRegular, "Regular"},
       {HiveColumnHandle::ColumnType::kSynthesized, "Synthesized"},
       {HiveColumnHandle::ColumnType::kRowIndex, "RowIndex"},
+      {HiveColumnHandle::ColumnType::kAggregate, "Aggregate"},
+  };
+}
+
+std::unordered_map<HiveColumnHandle::AggregateKind, std::string>
+aggregateKindNames() {
+  return {
+      {HiveColumnHandle::AggregateKind::kCount, "Count"},
+      {HiveColumnHandle::AggregateKind::kMin, "Min"},
+      {HiveColumnHandle::AggregateKind::kMax, "Max"},
+      {HiveColumnHandle::AggregateKind::kNullCount, "NullCount"},
   };
 }
 
@@ -52,6 +63,45 @@ HiveColumnHandle::ColumnType HiveColumnHandle::columnTypeFromName(
   return nameColumnTypes.at(name);
 }
 
+std::string HiveColumnHandle::aggregateKindName(AggregateKind kind) {
+  static const auto kindNames = aggregateKindNames();
+  return kindNames.at(kind);
+}
+
+HiveColumnHandle::AggregateKind HiveColumnHandle::aggregateKindFromName(
+    const std::string& name) {
+  static const auto nameKinds = invertMap(aggregateKindNames());
+  return nameKinds.at(name);
+}
+
+void HiveColumnHandle::checkAggregateTypes() const {
+  switch (aggregateKind_.value()) {
+    case AggregateKind::kCount:
+    case AggregateKind::kNullCount:
+      VELOX_USER_CHECK(
+          dataType_->isBigint(),
+          "{} aggregate must be of type BIGINT: {}",
+          aggregateKindName(aggregateKind_.value()),
+          dataType_->toString());
+      VELOX_USER_CHECK(
+          aggregateKind_ == AggregateKind::kCount || !name_.empty(),
+          "NullCount aggregate requires a column");
+      break;
+    case AggregateKind::kMin:
+    case AggregateKind::kMax:
+      VELOX_USER_CHECK(
+          !name_.empty(),
+          "{} aggregate requires a column",
+          aggregateKindName(aggregateKind_.value()));
+      VELOX_USER_CHECK(
+          dataType_->equivalent(*hiveType_),
+          "data type {} and hive type {} do not match",
+          dataType_->toString(),
+          hiveType_->toString());
+      break;
+  }
+}
+
 folly::dynamic HiveColumnHandle::serialize() const {
   folly::dynamic obj = ColumnHandle::serializeBase("HiveColumnHandle");
   obj["hiveColumnHandleName"] = name_;
@@ -63,6 +113,9 @@ folly::dynamic HiveColumnHandle::serialize() const {
     requiredSubfields.push_back(subfield.toString());
   }
   obj["requiredSubfields"] = requiredSubfields;
+  if (aggregateKind_.has_value()) {
+    obj["aggregateKind"] = aggregateKindName(aggregateKind_.value());
+  }
   return obj;
 }
 
@@ -73,6 +126,10 @@ std::string HiveColumnHandle::toString() const {
       name_,
       columnTypeName(columnType_),
       dataType_->toString());
+  if (aggregateKind_.has_value()) {
+    out << " aggregateKind: " << aggregateKindName(aggregateKind_.value())
+        << ",";
+  }
   out << " requiredSubfields: [";
   for (const auto& subfield : requiredSubfields_) {
     out << " " << subfield.toString();
@@ -94,8 +151,19 @@ ColumnHandlePtr HiveColumnHandle::create(const folly::dynamic& obj) {
     requiredSubfields.emplace_back(s.asString());
   }
 
+  std::optional<AggregateKind> aggregateKind;
+  if (auto it = obj.find("aggregateKind"); it != obj.items().end()) {
+    aggregateKind = aggregateKindFromName(it->second.asString());
+  }
+
   return std::make_shared<HiveColumnHandle>(
-      name, columnType, dataType, hiveType, std::move(requiredSubfields));
+      name,
+      columnType,
+      dataType,
+      hiveType,
+      std::move(requiredSubfields),
+      ColumnParseParameters{},
+      aggregateKind);
 }
 
 void HiveColumnHandle::registerSerDe() {
@@ -33,6 +33,23 @@ class HiveColumnHandle : public ColumnHandle {
     /// Rows numbers are unique within a single file only.
     kRowIndex,
     kRowId,
+    /// An aggregate over all rows of a split that pass the filters, see
+    /// AggregateKind. The data source returns one row per split and the
+    /// output may only contain aggregate columns.
+    kAggregate,
+  };
+
+  /// Aggregates that can be pushed into the scan of a split. The connector
+  /// answers them from file statistics when possible and otherwise computes
+  /// them from the decoded rows. The results are partial: the engine still
+  /// combines the rows produced for the splits, e.g. sums the counts.
+  enum class AggregateKind {
+    /// count(*) if the column name is empty, else count(<column>).
+    kCount,
+    kMin,
+    kMax,
+    /// Number of null values of the column.
+    kNullCount,
   };
 
   struct ColumnParseParameters {
@@ -47,19 +64,33 @@ class HiveColumnHandle : public ColumnHandle {
   /// be the same type, and the table scan needs to do data coercion if needs.
   /// The table writer also needs to respect the type difference when processing
   /// input data such as bucket id calculation.
+  ///
+  /// For kAggregate columns, 'name' is the aggregated column, 'hiveType' its
+  /// type and 'dataType' the type of the aggregate result. 'aggregateKind' is
+  /// set for and only for kAggregate columns.
   HiveColumnHandle(
       const std::string& name,
       ColumnType columnType,
       TypePtr dataType,
       TypePtr hiveType,
       std::vector<common::Subfield> requiredSubfields = {},
-      ColumnParseParameters columnParseParameters = {})
+      ColumnParseParameters columnParseParameters = {},
+      std::optional<AggregateKind> aggregateKind = std::nullopt)
       : name_(name),
         columnType_(columnType),
         dataType_(std::move(dataType)),
         hiveType_(std::move(hiveType)),
         requiredSubfields_(std::move(requiredSubfields)),
-        columnParseParameters_(columnParseParameters) {
+        columnParseParameters_(columnParseParameters),
+        aggregateKind_(aggregateKind) {
+    VELOX_USER_CHECK_EQ(
+        columnType_ == ColumnType::kAggregate,
+        aggregateKind_.has_value(),
+        "Aggregate kind must be set for and only for aggregate columns");
+    if (columnType_ == ColumnType::kAggregate) {
+      checkAggregateTypes();
+      return;
+    }
     VELOX_USER_CHECK(
         dataType_->equivalent(*hiveType_),
         "data type {} and hive type {} do not match",
@@ -105,6 +136,10 @@ class HiveColumnHandle : public ColumnHandle {
     return columnType_ == ColumnType::kPartitionKey;
   }
 
+  const std::optional<AggregateKind>& aggregateKind() const {
+    return aggregateKind_;
+  }
+
   bool isPartitionDateValueDaysSinceEpoch() const {
     return columnParseParameters_.partitionDateValueFormat ==
         ColumnParseParameters::kDaysSinceEpoch;
@@ -121,15 +156,22 @@ class HiveColumnHandle : public ColumnHandle {
   static HiveColumnHandle::ColumnType columnTypeFromName(
       const std::string& name);
 
+  static std::string aggregateKindName(AggregateKind kind);
+
+  static AggregateKind aggregateKindFromName(const std::string& name);
+
   static void registerSerDe();
 
  private:
+  void checkAggregateTypes() const;
+
   const std::string name_;
   const ColumnType columnType_;
   const TypePtr dataType_;
   const TypePtr hiveType_;
   const std::vector<common::Subfield> requiredSubfields_;
   const ColumnParseParameters columnParseParameters_;
+  const std::optional<AggregateKind> aggregateKind_;
 };
 
 class HiveTableHandle : public ConnectorTableHandle {
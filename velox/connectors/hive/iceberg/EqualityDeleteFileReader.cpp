@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+
+// Approximate per key overhead of the hash set and the string.
+constexpr uint64_t kKeyOverhead = 40;
+
+template <TypeKind kind>
+void appendKeyValue(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    std::string& key) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if (decoded.isNullAt(row)) {
+    key.push_back(0);
+    return;
+  }
+  key.push_back(1);
+  const auto value = decoded.valueAt<T>(row);
+  if constexpr (std::is_same_v<T, StringView>) {
+    const uint32_t size = value.size();
+    key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    key.append(value.data(), size);
+  } else {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+// Decodes 'columns' for use by makeKey().
+std::vector<DecodedVector> decodeColumns(
+    const std::vector<VectorPtr>& columns) {
+  std::vector<DecodedVector> decoded(columns.size());
+  for (size_t i = 0; i < columns.size(); ++i) {
+    decoded[i].decode(*BaseVector::loadedVectorShared(columns[i]));
+  }
+  return decoded;
+}
+
+void makeKey(
+    const RowType& keyType,
+    const std::vector<DecodedVector>& columns,
+    vector_size_t row,
+    std::string& key) {
+  key.clear();
+  for (size_t i = 0; i < columns.size(); ++i) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        appendKeyValue, keyType.childAt(i)->kind(), columns[i], row, key);
+  }
+}
+
+} // namespace
+
+EqualityDeleteSet::EqualityDeleteSet(RowTypePtr keyType)
+    : keyType_(std::move(keyType)) {
+  VELOX_CHECK_GT(keyType_->size(), 0, "Equality delete without columns");
+  for (const auto& type : keyType_->children()) {
+    VELOX_USER_CHECK(
+        type->isPrimitiveType() && type->kind() != TypeKind::REAL &&
+            type->kind() != TypeKind::DOUBLE,
+        "Unsupported equality delete column type: {}",
+        type->toString());
+  }
+}
+
+void EqualityDeleteSet::addKeys(const RowVector& keys) {
+  VELOX_CHECK(keys.type()->equivalent(*keyType_));
+  const auto decoded = decodeColumns(keys.children());
+  std::string key;
+  for (vector_size_t row = 0; row < keys.size(); ++row) {
+    makeKey(*keyType_, decoded, row, key);
+    if (keys_.insert(key).second) {
+      bytes_ += key.size() + kKeyOverhead;
+    }
+  }
+}
+
+vector_size_t EqualityDeleteSet::removeDeletedRows(
+    const std::vector<VectorPtr>& keyColumns,
+    vector_size_t size,
+    uint64_t* passed) const {
+  VELOX_CHECK_EQ(keyColumns.size(), keyType_->size());
+  if (keys_.empty()) {
+    return 0;
+  }
+  const auto decoded = decodeColumns(keyColumns);
+  std::string key;
+  vector_size_t numDeleted = 0;
+  bits::forEachSetBit(passed, 0, size, [&](vector_size_t row) {
+    makeKey(*keyType_, decoded, row, key);
+    if (keys_.count(key) > 0) {
+      bits::clearBit(passed, row);
+      ++numDeleted;
+    }
+  });
+  return numDeleted;
+}
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    RowTypePtr keyType,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::shared_ptr<filesystems::File::IoStats>& fsStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile),
+      keyType_(std::move(keyType)),
+      pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+  VELOX_CHECK_EQ(deleteFile_.equalityFieldIds.size(), keyType_->size());
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (column_index_t i = 0; i < keyType_->size(); ++i) {
+    scanSpec->addField(keyType_->nameOf(i), i);
+  }
+
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      hiveConfig,
+      connectorQueryCtx,
+      keyType_,
+      deleteSplit,
+      /*tableParameters=*/{},
+      deleteReaderOpts);
+
+  auto deleteFileHandleCachePtr =
+      fileHandleFactory->generate(deleteFile_.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      fsStats,
+      executor);
+
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      {},
+      scanSpec,
+      nullptr,
+      keyType_,
+      deleteSplit,
+      nullptr,
+      nullptr,
+      deleteRowReaderOpts);
+  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+}
+
+std::shared_ptr<const EqualityDeleteSet>
+EqualityDeleteFileReader::readDeleteSet() {
+  auto deleteSet = std::make_shared<EqualityDeleteSet>(keyType_);
+  VectorPtr output = BaseVector::create(keyType_, 0, pool_);
+  while (deleteRowReader_->next(kBatchRows, output) > 0) {
+    if (output->size() > 0) {
+      deleteSet->addKeys(*output->asChecked<RowVector>());
+    }
+  }
+  return deleteSet;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
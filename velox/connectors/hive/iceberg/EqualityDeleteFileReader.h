@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteCache.h"
+#include "velox/dwio/common/Reader.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// The rows of an Iceberg equality delete file as a set of keys on its
+/// equality columns. A data row is deleted if its values of these columns are
+/// equal to the values of any delete row, where a null is equal to a null.
+/// The keys are kept outside of any memory pool so that the set can outlive
+/// the query that loaded it. Immutable once loaded.
+class EqualityDeleteSet {
+ public:
+  /// 'keyType' has the equality columns in the order of the keys. Only
+  /// columns of primitive types other than REAL and DOUBLE, which Iceberg does
+  /// not allow as equality columns, are supported.
+  explicit EqualityDeleteSet(RowTypePtr keyType);
+
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Adds the rows of 'keys', which is of 'keyType()'.
+  void addKeys(const RowVector& keys);
+
+  /// Clears the bits in 'passed' for the first 'size' rows of 'keyColumns'
+  /// whose values are in the set. 'keyColumns' are the equality columns in the
+  /// order of 'keyType()'. Returns the number of rows cleared.
+  vector_size_t removeDeletedRows(
+      const std::vector<VectorPtr>& keyColumns,
+      vector_size_t size,
+      uint64_t* passed) const;
+
+  size_t numKeys() const {
+    return keys_.size();
+  }
+
+  /// Approximate memory used by the set.
+  uint64_t bytes() const {
+    return bytes_;
+  }
+
+ private:
+  const RowTypePtr keyType_;
+  // Each key is the concatenation of its column values, each preceded by a
+  // null flag byte. A string value is preceded by its length.
+  folly::F14FastSet<std::string> keys_;
+  uint64_t bytes_{0};
+};
+
+using EqualityDeleteSetCache = IcebergDeleteCache<EqualityDeleteSet>;
+
+/// Reads the equality columns of an equality delete file into an
+/// EqualityDeleteSet.
+class EqualityDeleteFileReader {
+ public:
+  /// 'keyType' gives the names and table types of the equality columns of
+  /// 'deleteFile'.
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      RowTypePtr keyType,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::shared_ptr<filesystems::File::IoStats>& fsStats,
+      const std::string& connectorId);
+
+  /// Reads all the rows of the delete file.
+  std::shared_ptr<const EqualityDeleteSet> readDeleteSet();
+
+ private:
+  static constexpr uint64_t kBatchRows = 10'000;
+
+  const IcebergDeleteFile& deleteFile_;
+  const RowTypePtr keyType_;
+  memory::MemoryPool* const pool_;
+  std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
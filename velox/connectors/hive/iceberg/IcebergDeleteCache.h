@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// Process wide cache of the decoded contents of Iceberg delete files. Iceberg
+/// never rewrites a file in place, so the paths of delete files identify their
+/// contents and the splits of a snapshot that apply the same delete files
+/// share one decoded value. The least recently used values are dropped when
+/// their total size exceeds the capacity. 'T' has a 'uint64_t bytes() const'
+/// method. The values are kept outside of any memory pool so that they can
+/// outlive the query that loaded them. Thread safe.
+template <typename T>
+class IcebergDeleteCache {
+ public:
+  static constexpr uint64_t kDefaultMaxBytes = 256 << 20;
+
+  explicit IcebergDeleteCache(uint64_t maxBytes = kDefaultMaxBytes)
+      : maxBytes_(maxBytes) {}
+
+  static IcebergDeleteCache& instance() {
+    static IcebergDeleteCache cache;
+    return cache;
+  }
+
+  /// Returns the value of 'key', calling 'load' to make it if it is not in the
+  /// cache. Concurrent misses on the same key may each call 'load', in which
+  /// case the first value to be added is returned to all.
+  std::shared_ptr<const T> getOrLoad(
+      const std::string& key,
+      const std::function<std::shared_ptr<const T>()>& load) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+        ++numHits_;
+        return it->second.value;
+      }
+    }
+    // Loads outside of the mutex since this reads files.
+    auto value = load();
+    VELOX_CHECK_NOT_NULL(value);
+    std::lock_guard<std::mutex> l(mutex_);
+    ++numLoads_;
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      return it->second.value;
+    }
+    lru_.push_front(key);
+    entries_[key] = Entry{value, lru_.begin()};
+    bytes_ += value->bytes();
+    evictLocked();
+    return value;
+  }
+
+  size_t numEntries() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return entries_.size();
+  }
+
+  uint64_t bytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return bytes_;
+  }
+
+  uint64_t numHits() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numHits_;
+  }
+
+  uint64_t numLoads() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numLoads_;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    entries_.clear();
+    lru_.clear();
+    bytes_ = 0;
+    numHits_ = 0;
+    numLoads_ = 0;
+  }
+
+ private:
+  struct Entry {
+    std::shared_ptr<const T> value;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  void evictLocked() {
+    // Keeps the most recent value even if it alone exceeds the capacity.
+    while (bytes_ > maxBytes_ && lru_.size() > 1) {
+      auto it = entries_.find(lru_.back());
+      VELOX_CHECK(it != entries_.end());
+      bytes_ -= it->second.value->bytes();
+      entries_.erase(it);
+      lru_.pop_back();
+    }
+  }
+
+  const uint64_t maxBytes_;
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Entry> entries_;
+  // Keys of 'entries_', most recently used first.
+  std::list<std::string> lru_;
+  uint64_t bytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numLoads_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -56,6 +56,12 @@ struct HiveIcebergSplit : public connector::hive::HiveConnectorSplit {
       std::vector<IcebergDeleteFile> deletes = {},
       const std::unordered_map<std::string, std::string>& infoColumns = {},
       std::optional<FileProperties> fileProperties = std::nullopt);
+
+  /// Iceberg splits are not divided since positional deletes are applied to
+  /// the rows of the whole split.
+  uint64_t divisibleSize() const override {
+    return 0;
+  }
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
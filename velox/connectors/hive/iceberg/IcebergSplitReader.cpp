@@ -16,6 +16,9 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include <fmt/ranges.h>
+#include <algorithm>
+
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
@@ -36,7 +39,8 @@ IcebergSplitReader::IcebergSplitReader(
     const std::shared_ptr<filesystems::File::IoStats>& fsStats,
     FileHandleFactory* const fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec)
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    folly::Executor* decodeExecutor)
     : SplitReader(
           hiveSplit,
           hiveTableHandle,
@@ -48,11 +52,30 @@ IcebergSplitReader::IcebergSplitReader(
           fsStats,
           fileHandleFactory,
           executor,
-          scanSpec),
+          scanSpec,
+          decodeExecutor),
       baseReadOffset_(0),
       splitOffset_(0),
-      deleteBitmap_(nullptr),
-      deleteBitmapBitOffset_(0) {}
+      deleteBitmap_(nullptr) {}
+
+IcebergSplitReader::~IcebergSplitReader() {
+  if (equalityColumns_.empty()) {
+    return;
+  }
+  // The column readers refer to the children of the ScanSpec.
+  baseRowReader_.reset();
+  for (const auto& column : equalityColumns_) {
+    if (column.created) {
+      scanSpec_->removeChild(column.name);
+      continue;
+    }
+    // The child has a filter that applies to the next splits.
+    auto* child = scanSpec_->childByName(column.name);
+    child->setProjectOut(column.projectOut);
+    child->setChannel(column.channel);
+  }
+  scanSpec_->resetCachedValues(false);
+}
 
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -61,6 +84,9 @@ void IcebergSplitReader::prepareSplit(
   if (emptySplit_) {
     return;
   }
+  std::shared_ptr<const HiveIcebergSplit> icebergSplit =
+      std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
+  prepareEqualityDeletes(icebergSplit->deleteFiles);
   auto rowType = getAdaptedRowType();
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -70,90 +96,233 @@ void IcebergSplitReader::prepareSplit(
 
   createRowReader(std::move(metadataFilter), std::move(rowType));
 
-  std::shared_ptr<const HiveIcebergSplit> icebergSplit =
-      std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
-  positionalDeleteFileReaders_.clear();
+  positionalDeletes_ =
+      loadPositionalDeletes(icebergSplit->deleteFiles, runtimeStats);
+}
 
-  const auto& deleteFiles = icebergSplit->deleteFiles;
+std::shared_ptr<const PositionalDeleteBitmap>
+IcebergSplitReader::loadPositionalDeletes(
+    const std::vector<IcebergDeleteFile>& deleteFiles,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  std::vector<const IcebergDeleteFile*> positionalDeleteFiles;
+  std::vector<std::string> paths;
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
-        positionalDeleteFileReaders_.push_back(
-            std::make_unique<PositionalDeleteFileReader>(
-                deleteFile,
-                hiveSplit_->filePath,
-                fileHandleFactory_,
-                connectorQueryCtx_,
-                executor_,
-                hiveConfig_,
-                ioStats_,
-                fsStats_,
-                runtimeStats,
-                splitOffset_,
-                hiveSplit_->connectorId));
+        positionalDeleteFiles.push_back(&deleteFile);
+        paths.push_back(deleteFile.filePath);
       }
-    } else {
+    } else if (deleteFile.content != FileContent::kEqualityDeletes) {
       VELOX_NYI();
     }
   }
+  if (positionalDeleteFiles.empty()) {
+    return nullptr;
+  }
+
+  // Each commit writes delete files with new paths, so the base file and the
+  // set of delete files identify the deleted positions in a snapshot.
+  std::sort(paths.begin(), paths.end());
+  const auto key =
+      fmt::format("{}\n{}", hiveSplit_->filePath, fmt::join(paths, "\n"));
+  auto deletes = PositionalDeleteBitmapCache::instance().getOrLoad(key, [&]() {
+    std::vector<int64_t> positions;
+    for (const auto* deleteFile : positionalDeleteFiles) {
+      PositionalDeleteFileReader(
+          *deleteFile,
+          hiveSplit_->filePath,
+          fileHandleFactory_,
+          connectorQueryCtx_,
+          executor_,
+          hiveConfig_,
+          ioStats_,
+          fsStats_,
+          runtimeStats,
+          hiveSplit_->connectorId)
+          .readDeletePositions(positions);
+    }
+    return std::make_shared<const PositionalDeleteBitmap>(std::move(positions));
+  });
+  return deletes->numDeleted() > 0 ? deletes : nullptr;
 }
 
-uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
-  Mutation mutation;
-  mutation.randomSkip = baseReaderOpts_.randomSkip().get();
-  mutation.deletedRows = nullptr;
+void IcebergSplitReader::prepareEqualityDeletes(
+    const std::vector<IcebergDeleteFile>& deleteFiles) {
+  equalityDeletes_.clear();
+  removeEqualityColumnsOfEarlierSplit();
+  const auto& tableSchema = hiveTableHandle_->dataColumns()
+      ? hiveTableHandle_->dataColumns()
+      : baseReader_->rowType();
 
-  if (deleteBitmap_ && deleteBitmapBitOffset_ > 0) {
-    // There are unconsumed bits from last batch
-    if (deleteBitmapBitOffset_ < deleteBitmap_->size() * 8) {
-      bits::copyBits(
-          deleteBitmap_->as<uint64_t>(),
-          deleteBitmapBitOffset_,
-          deleteBitmap_->asMutable<uint64_t>(),
-          0,
-          deleteBitmap_->size() * 8 - deleteBitmapBitOffset_);
-
-      uint64_t newBitMapSizeInBytes =
-          deleteBitmap_->size() - deleteBitmapBitOffset_ / 8;
-      if (deleteBitmapBitOffset_ % 8 != 0) {
-        newBitMapSizeInBytes--;
-      }
-      deleteBitmap_->setSize(newBitMapSizeInBytes);
-    } else {
-      // All bits were consumed, reset to 0 for all bits
-      std::memset(
-          (void*)(deleteBitmap_->asMutable<int8_t>()),
-          0L,
-          deleteBitmap_->size());
+  for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.content != FileContent::kEqualityDeletes ||
+        deleteFile.recordCount == 0) {
+      continue;
+    }
+    auto keyType = equalityKeyType(deleteFile, *tableSchema);
+    // The equality columns resolve by field id, so the same file may be read
+    // with other names or types after a schema change.
+    const auto key =
+        fmt::format("{}\n{}", deleteFile.filePath, keyType->toString());
+    auto deleteSet = EqualityDeleteSetCache::instance().getOrLoad(key, [&]() {
+      return EqualityDeleteFileReader(
+                 deleteFile,
+                 keyType,
+                 fileHandleFactory_,
+                 connectorQueryCtx_,
+                 executor_,
+                 hiveConfig_,
+                 ioStats_,
+                 fsStats_,
+                 hiveSplit_->connectorId)
+          .readDeleteSet();
+    });
+    if (deleteSet->numKeys() == 0) {
+      continue;
     }
+    EqualityDelete equalityDelete{deleteSet, {}};
+    for (column_index_t i = 0; i < keyType->size(); ++i) {
+      equalityDelete.channels.push_back(
+          equalityColumnChannel(keyType->nameOf(i), keyType->childAt(i)));
+    }
+    equalityDeletes_.push_back(std::move(equalityDelete));
   }
+}
 
-  if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(size);
-    dwio::common::ensureCapacity<int8_t>(
-        deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool(), true, true);
+RowTypePtr IcebergSplitReader::equalityKeyType(
+    const IcebergDeleteFile& deleteFile,
+    const RowType& tableSchema) const {
+  VELOX_USER_CHECK(
+      !deleteFile.equalityFieldIds.empty(),
+      "Equality delete file {} has no equality field ids",
+      deleteFile.filePath);
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto fieldId : deleteFile.equalityFieldIds) {
+    // Iceberg assigns the field ids of the top level columns from 1 in
+    // table schema order.
+    VELOX_USER_CHECK(
+        fieldId > 0 && fieldId <= tableSchema.size(),
+        "Unsupported equality field id {} of equality delete file {}",
+        fieldId,
+        deleteFile.filePath);
+    names.push_back(tableSchema.nameOf(fieldId - 1));
+    types.push_back(tableSchema.childAt(fieldId - 1));
+  }
+  return ROW(std::move(names), std::move(types));
+}
 
-    for (auto iter = positionalDeleteFileReaders_.begin();
-         iter != positionalDeleteFileReaders_.end();) {
-      (*iter)->readDeletePositions(baseReadOffset_, size, deleteBitmap_);
+column_index_t IcebergSplitReader::equalityColumnChannel(
+    const std::string& name,
+    const TypePtr& type) {
+  if (auto channel = readerOutputType_->getChildIdxIfExists(name)) {
+    return *channel;
+  }
+  // The extra column is read only for the delete and is not part of the output
+  // of the data source, which takes the leading columns.
+  auto names = readerOutputType_->names();
+  auto types = readerOutputType_->children();
+  const column_index_t channel = names.size();
+  names.push_back(name);
+  types.push_back(type);
+  readerOutputType_ = ROW(std::move(names), std::move(types));
+  // A column that is filtered but not projected has a child already.
+  const auto* existing = scanSpec_->childByName(name);
+  EqualityColumn column{
+      name, existing == nullptr, false, common::ScanSpec::kNoChannel};
+  if (existing != nullptr) {
+    column.projectOut = existing->projectOut();
+    column.channel = existing->channel();
+  }
+  scanSpec_->addField(name, channel);
+  equalityColumns_.push_back(std::move(column));
+  return channel;
+}
 
-      if ((*iter)->noMoreData()) {
-        iter = positionalDeleteFileReaders_.erase(iter);
-      } else {
-        ++iter;
-      }
+void IcebergSplitReader::removeEqualityColumnsOfEarlierSplit() {
+  auto isDataSourceColumn = [&](column_index_t channel) {
+    const auto* child =
+        scanSpec_->childByName(readerOutputType_->nameOf(channel));
+    return child != nullptr && child->projectOut() &&
+        child->channel() == channel;
+  };
+  auto numColumns = readerOutputType_->size();
+  while (numColumns > 0 && !isDataSourceColumn(numColumns - 1)) {
+    --numColumns;
+  }
+  if (numColumns == readerOutputType_->size()) {
+    return;
+  }
+  auto names = readerOutputType_->names();
+  auto types = readerOutputType_->children();
+  names.resize(numColumns);
+  types.resize(numColumns);
+  readerOutputType_ = ROW(std::move(names), std::move(types));
+}
+
+void IcebergSplitReader::applyEqualityDeletes(VectorPtr& output) {
+  auto* rowVector = output->asChecked<RowVector>();
+  const auto numRows = rowVector->size();
+  equalityPassed_.resize(bits::nwords(numRows));
+  bits::fillBits(equalityPassed_.data(), 0, numRows, true);
+  vector_size_t numDeleted = 0;
+  std::vector<VectorPtr> keyColumns;
+  for (const auto& equalityDelete : equalityDeletes_) {
+    keyColumns.clear();
+    for (const auto channel : equalityDelete.channels) {
+      keyColumns.push_back(rowVector->childAt(channel));
     }
+    numDeleted += equalityDelete.deleteSet->removeDeletedRows(
+        keyColumns, numRows, equalityPassed_.data());
+  }
+  if (numDeleted == 0) {
+    return;
   }
 
-  mutation.deletedRows = deleteBitmap_ && deleteBitmap_->size() > 0
-      ? deleteBitmap_->as<uint64_t>()
-      : nullptr;
+  const vector_size_t numPassed = numRows - numDeleted;
+  auto indices = allocateIndices(numPassed, pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  bits::forEachSetBit(
+      equalityPassed_.data(), 0, numRows, [&](vector_size_t row) {
+        rawIndices[numIndices++] = row;
+      });
+  std::vector<VectorPtr> children;
+  children.reserve(rowVector->childrenSize());
+  for (const auto& child : rowVector->children()) {
+    children.push_back(
+        BaseVector::wrapInDictionary(nullptr, indices, numPassed, child));
+  }
+  output = std::make_shared<RowVector>(
+      pool_, rowVector->type(), nullptr, numPassed, std::move(children));
+}
+
+uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
+  Mutation mutation;
+  mutation.randomSkip = baseReaderOpts_.randomSkip().get();
+  mutation.deletedRows = nullptr;
+
+  if (positionalDeletes_ != nullptr) {
+    // Whole words since bitmap chunks are copied a word at a time.
+    const auto numBytes = bits::nwords(size) * sizeof(uint64_t);
+    dwio::common::ensureCapacity<int8_t>(
+        deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool());
+    std::memset(deleteBitmap_->asMutable<int8_t>(), 0, numBytes);
+    deleteBitmap_->setSize(numBytes);
+    const int64_t begin = splitOffset_ + baseReadOffset_;
+    if (positionalDeletes_->setDeletedBits(
+            begin, begin + size, deleteBitmap_->asMutable<uint64_t>()) > 0) {
+      mutation.deletedRows = deleteBitmap_->as<uint64_t>();
+    }
+  }
 
   auto rowsScanned = baseRowReader_->next(size, output, &mutation);
   baseReadOffset_ += rowsScanned;
-  deleteBitmapBitOffset_ = rowsScanned;
+  if (!equalityDeletes_.empty() && output->size() > 0) {
+    applyEqualityDeletes(output);
+  }
 
   return rowsScanned;
 }
@@ -18,6 +18,8 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -38,9 +40,13 @@ class IcebergSplitReader : public SplitReader {
       const std::shared_ptr<filesystems::File::IoStats>& fsStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      folly::Executor* decodeExecutor = nullptr);
 
-  ~IcebergSplitReader() override = default;
+  /// Restores the ScanSpec, which is shared with the next split, to its state
+  /// before the columns read only for the equality deletes of the split were
+  /// added.
+  ~IcebergSplitReader() override;
 
   void prepareSplit(
       std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -48,17 +54,78 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  /// Delete files may remove rows of the data file, so its statistics do not
+  /// describe the split.
+  const dwio::common::Reader* statisticsReader() const override {
+    return nullptr;
+  }
+
  private:
+  // An equality delete set that is applied to the output of the base reader.
+  struct EqualityDelete {
+    std::shared_ptr<const EqualityDeleteSet> deleteSet;
+    // Channels of the equality columns in the output of the base reader.
+    std::vector<column_index_t> channels;
+  };
+
+  // Returns the positions of the base file deleted by the positional delete
+  // files in 'deleteFiles', loading them once for all splits of the file.
+  std::shared_ptr<const PositionalDeleteBitmap> loadPositionalDeletes(
+      const std::vector<IcebergDeleteFile>& deleteFiles,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  // Loads the sets of the equality delete files in 'deleteFiles', which are
+  // applied to the output of the base reader by next(). The sets are not
+  // pushed into the ScanSpec as filters, because the filters of the ScanSpec
+  // are moved to the ScanSpec of the next split when it is preloaded.
+  void prepareEqualityDeletes(
+      const std::vector<IcebergDeleteFile>& deleteFiles);
+
+  // Returns the names and types of the equality columns of 'deleteFile'.
+  RowTypePtr equalityKeyType(
+      const IcebergDeleteFile& deleteFile,
+      const RowType& tableSchema) const;
+
+  // Returns the channel of column 'name' in 'readerOutputType_', adding the
+  // column to it and to the ScanSpec for this split if needed.
+  column_index_t equalityColumnChannel(
+      const std::string& name,
+      const TypePtr& type);
+
+  // Removes the trailing columns of 'readerOutputType_' that an earlier split
+  // added for its equality deletes. HiveDataSource passes the reader output
+  // type of the previous split to the next one. The columns of the data source
+  // are projected out by the ScanSpec at their channel, which the earlier
+  // split has restored for the columns it added.
+  void removeEqualityColumnsOfEarlierSplit();
+
+  // Removes the rows of 'output' that match 'equalityDeletes_'.
+  void applyEqualityDeletes(VectorPtr& output);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
   // The file position for the first row in the split
   uint64_t splitOffset_;
-  std::list<std::unique_ptr<PositionalDeleteFileReader>>
-      positionalDeleteFileReaders_;
+  // The deleted positions of the base file, shared with the other splits of
+  // the file. nullptr if there are none.
+  std::shared_ptr<const PositionalDeleteBitmap> positionalDeletes_;
+  // The deleted rows of the current batch.
   BufferPtr deleteBitmap_;
-  // The offset in bits of the deleteBitmap_ starting from where the bits shall
-  // be consumed
-  uint64_t deleteBitmapBitOffset_;
+  // A column of the ScanSpec projected out for the equality deletes of this
+  // split.
+  struct EqualityColumn {
+    std::string name;
+    // True if the ScanSpec child is created for the deletes. Otherwise the
+    // child exists for a filter and gets back 'projectOut' and 'channel'.
+    bool created;
+    bool projectOut;
+    column_index_t channel;
+  };
+
+  std::vector<EqualityDelete> equalityDeletes_;
+  std::vector<EqualityColumn> equalityColumns_;
+  // Bits for the rows of a batch that are not deleted by 'equalityDeletes_'.
+  std::vector<uint64_t> equalityPassed_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
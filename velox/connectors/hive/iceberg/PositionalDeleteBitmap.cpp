@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+PositionalDeleteBitmap::PositionalDeleteBitmap(std::vector<int64_t> positions) {
+  std::sort(positions.begin(), positions.end());
+  positions.erase(
+      std::unique(positions.begin(), positions.end()), positions.end());
+  if (!positions.empty()) {
+    VELOX_CHECK_GE(positions.front(), 0, "Negative deleted row position");
+  }
+  numDeleted_ = positions.size();
+
+  size_t begin = 0;
+  while (begin < positions.size()) {
+    const auto key = positions[begin] >> kChunkShift;
+    auto end = begin + 1;
+    while (end < positions.size() && positions[end] >> kChunkShift == key) {
+      ++end;
+    }
+    auto& chunk = chunks_.emplace_back();
+    chunk.key = key;
+    if (end - begin > kMaxArraySize) {
+      chunk.bits.resize(bits::nwords(kChunkSize));
+      for (auto i = begin; i < end; ++i) {
+        bits::setBit(chunk.bits.data(), positions[i] & (kChunkSize - 1));
+      }
+    } else {
+      chunk.values.reserve(end - begin);
+      for (auto i = begin; i < end; ++i) {
+        chunk.values.push_back(positions[i] & (kChunkSize - 1));
+      }
+    }
+    begin = end;
+  }
+}
+
+std::vector<PositionalDeleteBitmap::Chunk>::const_iterator
+PositionalDeleteBitmap::lowerBound(int64_t key) const {
+  return std::lower_bound(
+      chunks_.begin(), chunks_.end(), key, [](const Chunk& chunk, int64_t key) {
+        return chunk.key < key;
+      });
+}
+
+uint64_t PositionalDeleteBitmap::setDeletedBits(
+    int64_t begin,
+    int64_t end,
+    uint64_t* bits) const {
+  uint64_t numSet = 0;
+  for (auto it = lowerBound(begin >> kChunkShift);
+       it != chunks_.end() && (it->key << kChunkShift) < end;
+       ++it) {
+    const int64_t chunkBegin = it->key << kChunkShift;
+    const auto rangeBegin = std::max(begin, chunkBegin);
+    const auto rangeEnd = std::min(end, chunkBegin + kChunkSize);
+    if (!it->bits.empty()) {
+      bits::copyBits(
+          it->bits.data(),
+          rangeBegin - chunkBegin,
+          bits,
+          rangeBegin - begin,
+          rangeEnd - rangeBegin);
+      numSet += bits::countBits(bits, rangeBegin - begin, rangeEnd - begin);
+      continue;
+    }
+    auto value = std::lower_bound(
+        it->values.begin(),
+        it->values.end(),
+        static_cast<uint16_t>(rangeBegin - chunkBegin));
+    for (; value != it->values.end() && chunkBegin + *value < rangeEnd;
+         ++value) {
+      bits::setBit(bits, chunkBegin + *value - begin);
+      ++numSet;
+    }
+  }
+  return numSet;
+}
+
+bool PositionalDeleteBitmap::isDeleted(int64_t position) const {
+  const auto key = position >> kChunkShift;
+  auto it = lowerBound(key);
+  if (it == chunks_.end() || it->key != key) {
+    return false;
+  }
+  const uint16_t value = position & (kChunkSize - 1);
+  if (!it->bits.empty()) {
+    return bits::isBitSet(it->bits.data(), value);
+  }
+  return std::binary_search(it->values.begin(), it->values.end(), value);
+}
+
+uint64_t PositionalDeleteBitmap::bytes() const {
+  uint64_t bytes = sizeof(*this) + chunks_.capacity() * sizeof(Chunk);
+  for (const auto& chunk : chunks_) {
+    bytes += chunk.values.capacity() * sizeof(uint16_t) +
+        chunk.bits.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
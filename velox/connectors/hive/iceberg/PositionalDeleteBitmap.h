@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "velox/connectors/hive/iceberg/IcebergDeleteCache.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The deleted row positions of a data file, compressed like a roaring
+/// bitmap. The positions are grouped in chunks of 64K rows. A chunk with few
+/// positions keeps their low 16 bits in a sorted array and a chunk with many
+/// keeps a bitmap of 64K bits, so that the size is at most about 2 bytes per
+/// deleted row and 1 bit per row of the data file. Immutable once built.
+class PositionalDeleteBitmap {
+ public:
+  /// 'positions' may be unsorted and have duplicates.
+  explicit PositionalDeleteBitmap(std::vector<int64_t> positions);
+
+  /// Sets bit 'i' of 'bits' for each deleted position 'begin + i' in ['begin',
+  /// 'end'). The bits of 'bits' are expected to be clear. Bitmap chunks are
+  /// copied a word at a time. Returns the number of bits set.
+  uint64_t setDeletedBits(int64_t begin, int64_t end, uint64_t* bits) const;
+
+  bool isDeleted(int64_t position) const;
+
+  /// Number of deleted positions.
+  uint64_t numDeleted() const {
+    return numDeleted_;
+  }
+
+  /// Approximate memory used by the bitmap.
+  uint64_t bytes() const;
+
+ private:
+  static constexpr int32_t kChunkShift = 16;
+  static constexpr int64_t kChunkSize = 1L << kChunkShift;
+  // A chunk with more positions than this is smaller as a bitmap.
+  static constexpr int32_t kMaxArraySize = kChunkSize / 16;
+
+  struct Chunk {
+    // The position of the first row of the chunk divided by 'kChunkSize'.
+    int64_t key;
+    // The sorted low bits of the positions if the chunk is an array.
+    std::vector<uint16_t> values;
+    // 'kChunkSize' bits if the chunk is a bitmap.
+    std::vector<uint64_t> bits;
+  };
+
+  // Returns the first chunk with a key >= 'key'.
+  std::vector<Chunk>::const_iterator lowerBound(int64_t key) const;
+
+  // Sorted by key.
+  std::vector<Chunk> chunks_;
+  uint64_t numDeleted_{0};
+};
+
+using PositionalDeleteBitmapCache = IcebergDeleteCache<PositionalDeleteBitmap>;
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -17,9 +17,11 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -273,6 +275,29 @@ class HiveIcebergTest : public HiveConnectorTestBase {
     return splits;
   }
 
+  /// Writes 'deletes' to an equality delete file on 'equalityFieldIds' and
+  /// adds it to 'deleteFiles'.
+  std::shared_ptr<TempFilePath> writeEqualityDeleteFile(
+      const RowVectorPtr& deletes,
+      const std::vector<int32_t>& equalityFieldIds,
+      std::vector<IcebergDeleteFile>& deleteFiles) {
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(
+        deleteFilePath->getPath(), {deletes}, config_, flushPolicyFactory_);
+    const auto fileSize =
+        filesystems::getFileSystem(deleteFilePath->getPath(), nullptr)
+            ->openFileForRead(deleteFilePath->getPath())
+            ->size();
+    deleteFiles.emplace_back(
+        FileContent::kEqualityDeletes,
+        deleteFilePath->getPath(),
+        fileFomat_,
+        deletes->size(),
+        fileSize,
+        equalityFieldIds);
+    return deleteFilePath;
+  }
+
  private:
   std::map<std::string, std::shared_ptr<TempFilePath>> writeDataFiles(
       std::map<std::string, std::vector<int64_t>> rowGroupSizesForFiles) {
@@ -695,6 +720,21 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
   assertMultipleSplits({1000, 9000, 20000}, 1, 0, 20000, 3);
 }
 
+TEST_F(HiveIcebergTest, positionalDeleteCache) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  auto& cache = PositionalDeleteBitmapCache::instance();
+  cache.clear();
+
+  // The splits of a base file decode its delete files once.
+  assertMultipleSplits({1, 2, 3, 4, 15'000}, 1, 0, rowCount, 3);
+  EXPECT_EQ(cache.numEntries(), 1);
+  EXPECT_EQ(cache.numLoads(), 1);
+
+  assertMultipleSplits({1, 2, 3, 4}, 2, 0);
+  EXPECT_EQ(cache.numEntries(), 3);
+  EXPECT_EQ(cache.numLoads(), 3);
+}
+
 TEST_F(HiveIcebergTest, testPartitionedRead) {
   RowTypePtr rowType{ROW({"c0", "ds"}, {BIGINT(), DateType::get()})};
   std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
@@ -775,4 +815,162 @@ TEST_F(HiveIcebergTest, testPartitionedRead) {
 
   HiveConnectorTestBase::assertQuery(plan, splits, "SELECT 0, '2018-04-06'");
 }
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  auto& cache = EqualityDeleteSetCache::instance();
+  cache.clear();
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto data = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           1'000, [](auto row) { return fmt::format("s{}", row % 10); })});
+  createDuckDbTable({data});
+  auto dataFilePath = TempFilePath::create();
+  writeToFile(dataFilePath->getPath(), {data}, config_, flushPolicyFactory_);
+
+  // Deletes on c0 alone.
+  std::vector<IcebergDeleteFile> singleKeyDeletes;
+  auto singleKeyFile = writeEqualityDeleteFile(
+      makeRowVector(
+          {"c0"},
+          {makeFlatVector<int64_t>(100, [](auto row) { return row * 3; })}),
+      {1},
+      singleKeyDeletes);
+  auto plan = PlanBuilder(pool_.get()).tableScan(rowType).planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      makeIcebergSplits(dataFilePath->getPath(), singleKeyDeletes, {}, 3),
+      "SELECT * FROM tmp WHERE c0 % 3 <> 0 OR c0 >= 300");
+  EXPECT_EQ(cache.numEntries(), 1);
+  EXPECT_EQ(cache.numLoads(), 1);
+  EXPECT_GT(cache.numHits(), 0);
+
+  // Deletes on a column with a filter.
+  plan = PlanBuilder(pool_.get()).tableScan(rowType, {"c0 < 500"}).planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      makeIcebergSplits(dataFilePath->getPath(), singleKeyDeletes),
+      "SELECT * FROM tmp WHERE c0 < 500 AND (c0 % 3 <> 0 OR c0 >= 300)");
+
+  // Deletes on both columns. (6, 's0') matches no row.
+  std::vector<IcebergDeleteFile> deleteFiles = singleKeyDeletes;
+  auto multiKeyFile = writeEqualityDeleteFile(
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<int64_t>({5, 6, 700}),
+           makeFlatVector<std::string>({"s5", "s0", "s0"})}),
+      {1, 2},
+      deleteFiles);
+  plan = PlanBuilder(pool_.get()).tableScan(rowType).planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      makeIcebergSplits(dataFilePath->getPath(), deleteFiles),
+      "SELECT * FROM tmp WHERE (c0 % 3 <> 0 OR c0 >= 300) "
+      "AND c0 NOT IN (5, 700)");
+
+  // The equality columns are read even if not projected.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(ROW({"c1"}, {VARCHAR()}), {}, "", rowType)
+             .planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      makeIcebergSplits(dataFilePath->getPath(), deleteFiles, {}, 2),
+      "SELECT c1 FROM tmp WHERE (c0 % 3 <> 0 OR c0 >= 300) "
+      "AND c0 NOT IN (5, 700)");
+
+  // The equality column has a filter and is not projected. The splits read
+  // one after the other by the same data source all keep the filter.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(ROW({"c1"}, {VARCHAR()}), {"c0 < 500"}, "", rowType)
+             .planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      makeIcebergSplits(dataFilePath->getPath(), singleKeyDeletes, {}, 3),
+      "SELECT c1 FROM tmp WHERE c0 < 500 AND (c0 % 3 <> 0 OR c0 >= 300)",
+      /*numPrefetchSplit=*/0);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesWithPreload) {
+  // Each split has its own data file and equality delete file. The deletes
+  // of one split must not apply to the split preloaded after it.
+  constexpr int32_t kNumFiles = 4;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> data;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  std::vector<std::shared_ptr<ConnectorSplit>> splits;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    data.push_back(makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+         makeFlatVector<std::string>(
+             100, [](auto row) { return fmt::format("s{}", row % 10); })}));
+    auto dataFilePath = TempFilePath::create();
+    writeToFile(
+        dataFilePath->getPath(), {data.back()}, config_, flushPolicyFactory_);
+    filePaths.push_back(dataFilePath);
+
+    // Split i deletes the first 10 * (i + 1) rows of its file. The last split
+    // has no deletes.
+    std::vector<IcebergDeleteFile> deleteFiles;
+    if (i < kNumFiles - 1) {
+      filePaths.push_back(writeEqualityDeleteFile(
+          makeRowVector(
+              {"c0"},
+              {makeFlatVector<int64_t>(
+                  10 * (i + 1), [&](auto row) { return i * 100 + row; })}),
+          {1},
+          deleteFiles));
+    }
+    auto fileSplits = makeIcebergSplits(dataFilePath->getPath(), deleteFiles);
+    splits.insert(splits.end(), fileSplits.begin(), fileSplits.end());
+  }
+  createDuckDbTable(data);
+  const std::string deleted =
+      "c0 BETWEEN 0 AND 9 OR c0 BETWEEN 100 AND 119 OR c0 BETWEEN 200 AND 229";
+
+  auto plan = PlanBuilder(pool_.get()).tableScan(rowType).planNode();
+  auto task = HiveConnectorTestBase::assertQuery(
+      plan,
+      splits,
+      fmt::format("SELECT * FROM tmp WHERE NOT ({})", deleted),
+      /*numPrefetchSplit=*/4);
+  ASSERT_GT(
+      toPlanStats(task->taskStats())
+          .at(plan->id())
+          .customStats.at("preloadedSplits")
+          .sum,
+      0);
+
+  // The equality column is read only for the deletes.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(ROW({"c1"}, {VARCHAR()}), {}, "", rowType)
+             .planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      splits,
+      fmt::format("SELECT c1 FROM tmp WHERE NOT ({})", deleted),
+      /*numPrefetchSplit=*/4);
+}
+
+TEST_F(HiveIcebergTest, equalityDeleteSet) {
+  EqualityDeleteSet deleteSet(ROW({"c0"}, {BIGINT()}));
+  deleteSet.addKeys(*makeRowVector(
+      {"c0"}, {makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 1})}));
+  EXPECT_EQ(deleteSet.numKeys(), 3);
+
+  // Nulls are equal to nulls.
+  std::vector<uint64_t> passed(1, bits::lowMask(5));
+  EXPECT_EQ(
+      deleteSet.removeDeletedRows(
+          {makeNullableFlatVector<int64_t>({1, 2, std::nullopt, 3, 4})},
+          5,
+          passed.data()),
+      3);
+  EXPECT_EQ(passed[0], 0b10010);
+
+  VELOX_ASSERT_THROW(
+      EqualityDeleteSet(ROW({"c0"}, {DOUBLE()})),
+      "Unsupported equality delete column type");
+}
 } // namespace facebook::velox::connector::hive::iceberg
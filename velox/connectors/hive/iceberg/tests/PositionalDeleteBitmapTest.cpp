@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
+
+#include <random>
+#include <set>
+
+#include "gtest/gtest.h"
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+
+// Checks setDeletedBits() and isDeleted() over ['begin', 'end') against
+// 'expected'.
+void checkRange(
+    const PositionalDeleteBitmap& bitmap,
+    const std::set<int64_t>& expected,
+    int64_t begin,
+    int64_t end) {
+  std::vector<uint64_t> bits(bits::nwords(end - begin));
+  const auto numSet = bitmap.setDeletedBits(begin, end, bits.data());
+  uint64_t numExpected = 0;
+  for (auto position = begin; position < end; ++position) {
+    const bool deleted = expected.count(position) > 0;
+    numExpected += deleted;
+    ASSERT_EQ(bits::isBitSet(bits.data(), position - begin), deleted)
+        << position;
+    ASSERT_EQ(bitmap.isDeleted(position), deleted) << position;
+  }
+  EXPECT_EQ(numSet, numExpected);
+}
+
+TEST(PositionalDeleteBitmapTest, sparseAndDense) {
+  std::mt19937 rng(1);
+  std::vector<int64_t> positions;
+  // Sparse in the first 64K rows, dense in the next and a few far away.
+  for (int64_t i = 0; i < 1'000; ++i) {
+    positions.push_back(rng() % 65'536);
+  }
+  for (int64_t i = 0; i < 30'000; ++i) {
+    positions.push_back(65'536 + rng() % 65'536);
+  }
+  positions.push_back(10'000'000'000);
+  positions.push_back(10'000'000'001);
+  positions.push_back(5);
+  positions.push_back(5);
+  const std::set<int64_t> expected(positions.begin(), positions.end());
+
+  PositionalDeleteBitmap bitmap(positions);
+  EXPECT_EQ(bitmap.numDeleted(), expected.size());
+  // About 2 bytes per sparse position and 8KB for the dense chunk.
+  EXPECT_LT(bitmap.bytes(), 2 * 1'000 + 8'192 + 1'000);
+
+  checkRange(bitmap, expected, 0, 200'000);
+  checkRange(bitmap, expected, 65'000, 66'000);
+  checkRange(bitmap, expected, 65'537, 65'537 + 1'111);
+  checkRange(bitmap, expected, 9'999'999'990, 10'000'000'010);
+  checkRange(bitmap, expected, 300'000, 300'100);
+}
+
+TEST(PositionalDeleteBitmapTest, empty) {
+  PositionalDeleteBitmap bitmap(std::vector<int64_t>{});
+  EXPECT_EQ(bitmap.numDeleted(), 0);
+  checkRange(bitmap, {}, 0, 1'000);
+  VELOX_ASSERT_THROW(
+      PositionalDeleteBitmap(std::vector<int64_t>{-1, 2}),
+      "Negative deleted row position");
+}
+
+TEST(PositionalDeleteBitmapTest, cache) {
+  PositionalDeleteBitmapCache cache(1'000);
+  int32_t numLoads = 0;
+  auto load = [&](std::vector<int64_t> positions) {
+    return [&numLoads, positions]() {
+      ++numLoads;
+      return std::make_shared<const PositionalDeleteBitmap>(positions);
+    };
+  };
+  auto first = cache.getOrLoad("a", load({1, 2, 3}));
+  EXPECT_EQ(cache.getOrLoad("a", load({})), first);
+  EXPECT_EQ(numLoads, 1);
+  EXPECT_EQ(cache.numHits(), 1);
+
+  // Each bitmap is about 100 bytes, so the least recently used are dropped.
+  for (int32_t i = 0; i < 20; ++i) {
+    cache.getOrLoad(fmt::format("b{}", i), load({i}));
+  }
+  EXPECT_LE(cache.bytes(), 1'000);
+  EXPECT_LT(cache.numEntries(), 21);
+  cache.getOrLoad("a", load({1, 2, 3}));
+  EXPECT_EQ(numLoads, 22);
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive::iceberg
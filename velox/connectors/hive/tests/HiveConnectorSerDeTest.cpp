@@ -15,6 +15,7 @@
  */
 
 #include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -172,6 +173,16 @@ TEST_F(HiveConnectorSerDeTest, hiveColumnHandle) {
 
     testSerde(*columnHandle);
   }
+
+  HiveColumnHandle aggregateHandle(
+      "c0",
+      HiveColumnHandle::ColumnType::kAggregate,
+      BIGINT(),
+      VARCHAR(),
+      {},
+      {},
+      HiveColumnHandle::AggregateKind::kNullCount);
+  testSerde(aggregateHandle);
 }
 
 TEST_F(HiveConnectorSerDeTest, locationHandle) {
@@ -302,5 +313,41 @@ TEST_F(HiveConnectorSerDeTest, hiveConnectorSplit) {
   testSerde(split3);
 }
 
+TEST_F(HiveConnectorSerDeTest, hiveCombinedSplit) {
+  const auto connectorId = "testSerde";
+  std::vector<std::shared_ptr<HiveConnectorSplit>> splits;
+  for (auto i = 0; i < 3; ++i) {
+    splits.push_back(std::make_shared<HiveConnectorSplit>(
+        connectorId,
+        fmt::format("/testSerde/p{}", i),
+        dwio::common::FileFormat::DWRF,
+        0,
+        100,
+        std::unordered_map<std::string, std::optional<std::string>>{
+            {"p", std::to_string(i)}},
+        std::nullopt,
+        std::unordered_map<std::string, std::string>{},
+        nullptr,
+        std::unordered_map<std::string, std::string>{},
+        std::unordered_map<std::string, std::string>{},
+        10 + i));
+  }
+  HiveCombinedSplit split(connectorId, splits);
+  ASSERT_EQ(split.splitWeight, 33);
+  const auto clone = ISerializable::deserialize<HiveCombinedSplit>(
+      split.serialize());
+  ASSERT_EQ(clone->toString(), split.toString());
+  ASSERT_EQ(clone->splitWeight, split.splitWeight);
+  ASSERT_EQ(clone->splits.size(), splits.size());
+  for (size_t i = 0; i < splits.size(); ++i) {
+    ASSERT_EQ(clone->splits[i]->toString(), splits[i]->toString());
+    ASSERT_EQ(clone->splits[i]->partitionKeys, splits[i]->partitionKeys);
+  }
+
+  VELOX_ASSERT_THROW(
+      HiveCombinedSplit(connectorId, {}),
+      "Combined split must have at least one split");
+}
+
 } // namespace
 } // namespace facebook::velox::connector::hive::test
@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include <gtest/gtest.h>
+#include "velox/common/caching/FileIds.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/TableHandle.h"
@@ -337,6 +338,58 @@ TEST_F(HiveConnectorUtilTest, cacheRetention) {
   }
 }
 
+TEST_F(HiveConnectorUtilTest, estimateCacheResidency) {
+  constexpr int32_t kSize = 1 << 20;
+  const std::string path = "/tmp/estimateCacheResidency";
+  StringIdLease fileNum(fileIds(), path);
+  for (auto i = 0; i < 4; ++i) {
+    auto pin = asyncDataCache_->findOrCreate(
+        {fileNum.id(), static_cast<uint64_t>(i * kSize)}, kSize);
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    pin.entry()->setExclusiveToShared();
+  }
+
+  auto wholeFile = hive::HiveConnectorSplitBuilder(path).build();
+  ASSERT_EQ(
+      hive::estimateCacheResidency(*wholeFile, *asyncDataCache_).memoryBytes,
+      4 * kSize);
+
+  // A quarter of the file has a quarter of the resident bytes.
+  FileProperties properties;
+  properties.fileSize = 16 * kSize;
+  auto quarter = hive::HiveConnectorSplitBuilder(path)
+                     .start(kSize)
+                     .length(4 * kSize)
+                     .fileProperties(properties)
+                     .build();
+  ASSERT_EQ(
+      hive::estimateCacheResidency(*quarter, *asyncDataCache_).memoryBytes,
+      kSize);
+
+  // The estimate of a range is at most its length.
+  auto small = hive::HiveConnectorSplitBuilder(path).length(1'000).build();
+  ASSERT_EQ(
+      hive::estimateCacheResidency(*small, *asyncDataCache_).memoryBytes,
+      1'000);
+
+  auto uncached =
+      hive::HiveConnectorSplitBuilder("/tmp/estimateCacheResidency.uncached")
+          .build();
+  ASSERT_EQ(
+      hive::estimateCacheResidency(*uncached, *asyncDataCache_).memoryBytes,
+      0);
+
+  hive::HiveCombinedSplit combined(
+      wholeFile->connectorId, {wholeFile, quarter, uncached});
+  ASSERT_EQ(
+      hive::estimateCacheResidency(combined, *asyncDataCache_).memoryBytes,
+      5 * kSize);
+  asyncDataCache_->clear();
+  ASSERT_EQ(
+      hive::estimateCacheResidency(*wholeFile, *asyncDataCache_).memoryBytes,
+      0);
+}
+
 TEST_F(HiveConnectorUtilTest, configureRowReaderOptions) {
   auto split =
       std::make_shared<hive::HiveConnectorSplit>("", "", FileFormat::UNKNOWN);
@@ -177,7 +177,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
           bucketProperty = nullptr,
       const std::shared_ptr<dwio::common::WriterOptions>& writerOptions =
           nullptr,
-      const bool ensureFiles = false) {
+      const bool ensureFiles = false,
+      folly::Executor* executor = nullptr) {
     return std::make_shared<HiveDataSink>(
         rowType,
         createHiveInsertTableHandle(
@@ -190,7 +191,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
             ensureFiles),
         connectorQueryCtx_.get(),
         CommitStrategy::kNoCommit,
-        connectorConfig_);
+        connectorConfig_,
+        executor);
   }
 
   std::vector<std::string> listFiles(const std::string& dirPath) {
@@ -959,6 +961,75 @@ TEST_F(HiveDataSinkTest, memoryReclaimAfterClose) {
   }
 }
 
+TEST_F(HiveDataSinkTest, memoryReclaimWithAsyncWrites) {
+  const auto vectors = createVectors(500, 10);
+  connectorConfig_ = std::make_shared<HiveConfig>(
+      std::make_shared<config::ConfigBase>(
+          std::unordered_map<std::string, std::string>{
+              {"file_writer_flush_threshold_bytes", "0"},
+              {"hive.orc.writer.stripe-max-size", "1GB"},
+              {"hive.orc.writer.dictionary-max-memory", "1GB"},
+              {HiveConfig::kWriterAsyncFlushMaxPendingBytes, "1GB"}}));
+  const auto spillDirectory = TempDirectoryPath::create();
+  const auto spillConfig = getSpillConfig(spillDirectory->getPath(), 0);
+  setConnectorQueryContext(std::make_unique<connector::ConnectorQueryCtx>(
+      opPool_.get(),
+      connectorPool_.get(),
+      connectorSessionProperties_.get(),
+      spillConfig.get(),
+      common::PrefixSortConfig(),
+      nullptr,
+      nullptr,
+      "query.HiveDataSinkTest",
+      "task.HiveDataSinkTest",
+      "planNodeId.HiveDataSinkTest",
+      0,
+      ""));
+
+  // Queues the writes until the test runs them.
+  class QueuedExecutor : public folly::Executor {
+   public:
+    void add(folly::Func func) override {
+      tasks.push_back(std::move(func));
+    }
+
+    std::vector<folly::Func> tasks;
+  } executor;
+  const auto outputDirectory = TempDirectoryPath::create();
+  auto dataSink = createDataSink(
+      rowType_,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {},
+      nullptr,
+      nullptr,
+      false,
+      &executor);
+  ASSERT_TRUE(dataSink->canReclaim());
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+
+  // Reclaim flushes the file writer and does not wait for the writes.
+  memory::MemoryReclaimer::Stats stats;
+  root_->reclaim(1L << 30, 0, stats);
+  ASSERT_EQ(executor.tasks.size(), 1);
+  // The flushed data waiting to be written is not reclaimable.
+  const auto reservedBytes = root_->reservedBytes();
+  ASSERT_LT(root_->reclaimableBytes().value(), reservedBytes);
+
+  // A later reclaim releases the memory of the written data.
+  for (auto& task : executor.tasks) {
+    task();
+  }
+  executor.tasks.clear();
+  root_->reclaim(1L << 30, 0, stats);
+  ASSERT_LT(root_->reservedBytes(), reservedBytes);
+
+  ASSERT_TRUE(dataSink->finish());
+  ASSERT_EQ(dataSink->close().size(), 1);
+}
+
 DEBUG_ONLY_TEST_F(HiveDataSinkTest, sortWriterAbortDuringFinish) {
   const auto outputDirectory = TempDirectoryPath::create();
   const int32_t numBuckets = 4;
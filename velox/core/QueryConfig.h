@@ -36,6 +36,14 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// Identifies the recurring runs of a query with similar memory usage, e.g.
+  /// a hash of the normalized plan of a dashboard query. If set, the memory
+  /// arbitrator may grow the query memory pool up front to the peak usage
+  /// recorded for the earlier runs. See
+  /// memory::MemoryArbitrator::setPoolFingerprint().
+  static constexpr const char* kQueryMemoryFingerprint =
+      "query_memory_fingerprint";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -103,6 +111,18 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangePartitionCount =
       "max_local_exchange_partition_count";
 
+  /// If true, a round robin local exchange sends its data to the consumers
+  /// that last ran on the NUMA node of the producer if there are any. A
+  /// consumer that buffers more than its share of the local exchange buffer is
+  /// skipped.
+  static constexpr const char* kNumaLocalExchangeEnabled =
+      "numa_local_exchange_enabled";
+
+  /// If not negative, the drivers of the query only run on the CPUs of this
+  /// NUMA node. Combined with a NUMA aware MmapAllocator, this keeps the memory
+  /// of the query local to the node.
+  static constexpr const char* kDriverNumaNode = "driver_numa_node";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
@@ -134,6 +154,18 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If greater than 0, hash aggregations keep the variable length state of
+  /// their accumulators in an allocator of their own and rebuild it compactly
+  /// when at least this fraction of the allocator is free, before growing
+  /// memory or spilling.
+  static constexpr const char* kAggregationCompactionFragmentationRatio =
+      "aggregation_compaction_fragmentation_ratio";
+
+  /// The minimum free accumulator memory for hash aggregations to rebuild
+  /// their accumulators. See 'kAggregationCompactionFragmentationRatio'.
+  static constexpr const char* kAggregationCompactionMinBytes =
+      "aggregation_compaction_min_bytes";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -500,6 +532,14 @@ class QueryConfig {
   static constexpr const char* kTableScanScaleUpMemoryUsageRatio =
       "table_scan_scale_up_memory_usage_ratio";
 
+  /// If non-zero, table scan splits whose byte range is larger than this are
+  /// divided into chunks of about this many bytes, e.g. a few stripes or row
+  /// groups each, that are read one at a time. The scan drivers of the same
+  /// plan node that run out of splits steal the unread chunks of the splits
+  /// other drivers are reading. 0 disables dividing splits.
+  static constexpr const char* kTableScanSplitChunkBytes =
+      "table_scan_split_chunk_bytes";
+
   /// Specifies the shuffle compression kind which is defined by
   /// CompressionKind. If it is CompressionKind_NONE, then no compression.
   static constexpr const char* kShuffleCompressionKind =
@@ -551,6 +591,10 @@ class QueryConfig {
         config::CapacityUnit::BYTE);
   }
 
+  std::string queryMemoryFingerprint() const {
+    return get<std::string>(kQueryMemoryFingerprint, "");
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -569,6 +613,15 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  double aggregationCompactionFragmentationRatio() const {
+    return get<double>(kAggregationCompactionFragmentationRatio, 0);
+  }
+
+  uint64_t aggregationCompactionMinBytes() const {
+    static constexpr uint64_t kDefault = 8UL << 20;
+    return get<uint64_t>(kAggregationCompactionMinBytes, kDefault);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -608,6 +661,14 @@ class QueryConfig {
     return get<uint32_t>(kMaxLocalExchangePartitionCount, kDefault);
   }
 
+  bool numaLocalExchangeEnabled() const {
+    return get<bool>(kNumaLocalExchangeEnabled, false);
+  }
+
+  int32_t driverNumaNode() const {
+    return get<int32_t>(kDriverNumaNode, -1);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
@@ -941,6 +1002,10 @@ class QueryConfig {
     return get<double>(kTableScanScaleUpMemoryUsageRatio, 0.7);
   }
 
+  uint64_t tableScanSplitChunkBytes() const {
+    return get<uint64_t>(kTableScanSplitChunkBytes, 0);
+  }
+
   uint32_t indexLookupJoinMaxPrefetchBatches() const {
     return get<uint32_t>(kIndexLookupJoinMaxPrefetchBatches, 0);
   }
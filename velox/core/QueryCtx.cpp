@@ -60,6 +60,11 @@ QueryCtx::QueryCtx(
       pool_(std::move(pool)),
       queryConfig_{std::move(queryConfig)} {
   initPool(queryId);
+  const auto fingerprint = queryConfig_.queryMemoryFingerprint();
+  if (!fingerprint.empty()) {
+    memory::memoryManager()->arbitrator()->setPoolFingerprint(
+        pool_.get(), fingerprint);
+  }
 }
 
 /*static*/ std::string QueryCtx::generatePoolName(const std::string& queryId) {
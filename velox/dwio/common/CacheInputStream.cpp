@@ -282,11 +282,11 @@ bool CacheInputStream::loadFromSsd(
     return false;
   }
 
-  if (ssdPin.run().size() < entry.size()) {
+  if (ssdPin.run().rawSize() < entry.size()) {
     LOG(INFO) << fmt::format(
         "IOERR: Ssd entry for {} shorter than requested {}",
         entry.toString(),
-        ssdPin.run().size());
+        ssdPin.run().rawSize());
     return false;
   }
 
@@ -194,9 +194,10 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
       }
       if (ssdFile != nullptr) {
         part->ssdPin = ssdFile->find(part->key);
-        if (!part->ssdPin.empty() && part->ssdPin.run().size() < part->size) {
+        if (!part->ssdPin.empty() &&
+            part->ssdPin.run().rawSize() < part->size) {
           LOG(INFO) << "IOERR: Ignoring SSD shorter than requested: "
-                    << part->ssdPin.run().size() << " vs " << part->size;
+                    << part->ssdPin.run().rawSize() << " vs " << part->size;
           part->ssdPin.clear();
         }
         if (!part->ssdPin.empty()) {
@@ -299,7 +299,13 @@ class ColumnVisitor {
     if (filter_.testLength(length)) {
       return std::nullopt;
     }
+    return processFailed(atEnd);
+  }
 
+  // Records that the value at the current row fails a deterministic filter,
+  // e.g. based on its length or raw bytes, without materializing the value.
+  // Returns the number of rows to skip like processLength().
+  FOLLY_ALWAYS_INLINE vector_size_t processFailed(bool& atEnd) {
     filterFailed();
 
     if (++rowIndex_ >= numRows_) {
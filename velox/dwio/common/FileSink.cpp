@@ -183,6 +183,129 @@ void MemorySink::write(std::vector<DataBuffer<char>>& buffers) {
   });
 }
 
+AsyncFileSink::AsyncFileSink(
+    std::unique_ptr<FileSink> sink,
+    folly::Executor* executor,
+    uint64_t maxPendingBytes)
+    : FileSink{sink->name(), {.metricLogger = sink->metricsLog()}},
+      sink_{std::move(sink)},
+      executor_{executor},
+      maxPendingBytes_{maxPendingBytes} {
+  VELOX_CHECK_NOT_NULL(executor_);
+}
+
+AsyncFileSink::~AsyncFileSink() {
+  destroy();
+}
+
+void AsyncFileSink::write(std::vector<DataBuffer<char>>& buffers) {
+  DWIO_ENSURE(!isClosed(), "Cannot write to closed sink.");
+  checkError();
+  uint64_t bytes = 0;
+  for (const auto& buffer : buffers) {
+    bytes += buffer.size();
+  }
+  if (bytes == 0) {
+    buffers.clear();
+    return;
+  }
+  bool schedule;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    queue_.push_back(std::move(buffers));
+    pendingBytes_ += bytes;
+    schedule = !draining_;
+    draining_ = true;
+  }
+  buffers.clear();
+  size_ += bytes;
+  if (schedule) {
+    executor_->add([this]() { drain(); });
+  }
+}
+
+void AsyncFileSink::drain() {
+  for (;;) {
+    std::vector<DataBuffer<char>> buffers;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (queue_.empty()) {
+        draining_ = false;
+        drained_.notify_all();
+        return;
+      }
+      buffers = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    uint64_t bytes = 0;
+    for (const auto& buffer : buffers) {
+      bytes += buffer.size();
+    }
+    std::exception_ptr error;
+    try {
+      sink_->write(buffers);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    // Frees the buffers before they stop counting as pending.
+    buffers.clear();
+    std::vector<ContinuePromise> promises;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      pendingBytes_ -= bytes;
+      if (error != nullptr) {
+        if (error_ == nullptr) {
+          error_ = error;
+        }
+        // Drops the writes after a failed one.
+        for (const auto& queued : queue_) {
+          for (const auto& buffer : queued) {
+            pendingBytes_ -= buffer.size();
+          }
+        }
+        queue_.clear();
+      }
+      if (pendingBytes_ <= maxPendingBytes_ || error_ != nullptr) {
+        promises = std::move(promises_);
+        promises_.clear();
+      }
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  }
+}
+
+bool AsyncFileSink::isBlocked(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (pendingBytes_ <= maxPendingBytes_ || error_ != nullptr) {
+    return false;
+  }
+  promises_.emplace_back("AsyncFileSink::isBlocked");
+  *future = promises_.back().getSemiFuture();
+  return true;
+}
+
+void AsyncFileSink::waitForWrites() {
+  std::unique_lock<std::mutex> l(mutex_);
+  drained_.wait(l, [&]() { return !draining_; });
+}
+
+void AsyncFileSink::checkError() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void AsyncFileSink::doClose() {
+  // The queued buffers may be allocated from pools owned by the caller, so
+  // the writes must be done before returning.
+  waitForWrites();
+  sink_->close();
+  checkError();
+}
+
 VELOX_REGISTER_DATA_SINK_METHOD_DEFINITION(LocalFileSink, localFileSink);
 
 void registerFileSinks() {
@@ -16,10 +16,15 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
 #include "velox/common/config/Config.h"
 #include "velox/common/file/File.h"
+#include "velox/common/future/VeloxPromise.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/dwio/common/Closeable.h"
 #include "velox/dwio/common/DataBuffer.h"
@@ -201,6 +206,68 @@ class MemorySink : public FileSink {
   DataBuffer<char> data_;
 };
 
+/// Writes to another sink on an executor so that the caller can encode the
+/// next data while the previous data is being written. The buffers are
+/// written in order, one write at a time. write() never waits: the caller
+/// applies backpressure with isBlocked(). An error from the other sink is
+/// rethrown by the next write() or close(). close() waits for the pending
+/// writes and then closes the other sink.
+class AsyncFileSink : public FileSink {
+ public:
+  /// 'maxPendingBytes' is the number of bytes queued or being written above
+  /// which isBlocked() returns true.
+  AsyncFileSink(
+      std::unique_ptr<FileSink> sink,
+      folly::Executor* executor,
+      uint64_t maxPendingBytes);
+
+  ~AsyncFileSink() override;
+
+  bool isBuffered() const override {
+    return sink_->isBuffered();
+  }
+
+  using FileSink::write;
+
+  /// Queues 'buffers' for writing and clears 'buffers'.
+  void write(std::vector<DataBuffer<char>>& buffers) override;
+
+  /// Returns true if more than 'maxPendingBytes' are pending and sets
+  /// 'future' to be realized when the pending bytes fall to the limit or the
+  /// writes fail.
+  bool isBlocked(ContinueFuture* future);
+
+  uint64_t pendingBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return pendingBytes_;
+  }
+
+  /// Waits for the queued buffers to be written and freed.
+  void waitForWrites();
+
+ protected:
+  void doClose() override;
+
+ private:
+  // Writes the queued buffers until the queue is empty. Runs on 'executor_'.
+  void drain();
+
+  void checkError() const;
+
+  const std::unique_ptr<FileSink> sink_;
+  folly::Executor* const executor_;
+  const uint64_t maxPendingBytes_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable drained_;
+  std::deque<std::vector<DataBuffer<char>>> queue_;
+  uint64_t pendingBytes_{0};
+  // True while drain() is scheduled or running.
+  bool draining_{false};
+  std::exception_ptr error_;
+  std::vector<ContinuePromise> promises_;
+};
+
 void registerFileSinks();
 
 } // namespace facebook::velox::dwio::common
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FilterSelectivityStore.h"
+
+#include <fmt/format.h>
+
+namespace facebook::velox::common {
+namespace {
+
+// Returns 'info' with at most 'maxNumIn' input rows and the same ratios.
+SelectivityInfo scaleDown(const SelectivityInfo& info, uint64_t maxNumIn) {
+  if (info.numIn() <= maxNumIn) {
+    return info;
+  }
+  const double scale = static_cast<double>(maxNumIn) / info.numIn();
+  return SelectivityInfo(
+      maxNumIn, info.numOut() * scale, info.timeClocks() * scale);
+}
+
+} // namespace
+
+FilterSelectivityStore& FilterSelectivityStore::instance() {
+  static FilterSelectivityStore store;
+  return store;
+}
+
+std::string FilterSelectivityStore::makeKey(
+    const std::string& table,
+    const std::string& column,
+    const Filter& filter) {
+  // Filters with many values print long strings, so only their hash is kept.
+  return fmt::format(
+      "{}.{}#{:x}",
+      table,
+      column,
+      std::hash<std::string>{}(filter.toString()));
+}
+
+std::vector<ScanSpec*> FilterSelectivityStore::filteredChildren(
+    const ScanSpec& scanSpec) {
+  std::vector<ScanSpec*> children;
+  for (const auto& child : scanSpec.children()) {
+    // Filters on constants are evaluated once per split and not timed.
+    if (child->filter() != nullptr && !child->isConstant()) {
+      children.push_back(child.get());
+    }
+  }
+  return children;
+}
+
+FilterSelectivityStore::Snapshot FilterSelectivityStore::seed(
+    const std::string& table,
+    ScanSpec& scanSpec) {
+  const auto children = filteredChildren(scanSpec);
+  Snapshot snapshot;
+  for (auto* child : children) {
+    auto& childSnapshot = snapshot[child->fieldName()];
+    childSnapshot.filter = child->filter();
+    childSnapshot.key = makeKey(table, child->fieldName(), *child->filter());
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto* child : children) {
+      auto it = entries_.find(snapshot[child->fieldName()].key);
+      if (it != entries_.end()) {
+        child->selectivity() = scaleDown(it->second, kMaxSeedNumIn);
+      }
+    }
+  }
+  for (auto* child : children) {
+    snapshot[child->fieldName()].selectivity = child->selectivity();
+  }
+  return snapshot;
+}
+
+void FilterSelectivityStore::record(
+    const std::string& table,
+    ScanSpec& scanSpec,
+    Snapshot& snapshot) {
+  std::vector<std::pair<std::string, SelectivityInfo>> deltas;
+  for (auto* child : filteredChildren(scanSpec)) {
+    auto& childSnapshot = snapshot[child->fieldName()];
+    if (childSnapshot.filter != child->filter()) {
+      childSnapshot.filter = child->filter();
+      childSnapshot.key = makeKey(table, child->fieldName(), *child->filter());
+    }
+    const auto& current = child->selectivity();
+    if (current.numIn() <= childSnapshot.selectivity.numIn()) {
+      continue;
+    }
+    deltas.emplace_back(childSnapshot.key, current - childSnapshot.selectivity);
+    childSnapshot.selectivity = current;
+  }
+  if (deltas.empty()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& [key, delta] : deltas) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      if (entries_.size() >= maxEntries_) {
+        // Starts over rather than tracking recency. Histories are rebuilt
+        // quickly by the running scans.
+        entries_.clear();
+      }
+      it = entries_.emplace(std::move(key), SelectivityInfo()).first;
+    }
+    auto& info = it->second;
+    info += delta;
+    if (info.numIn() > kMaxNumIn) {
+      info = SelectivityInfo(
+          info.numIn() / 2, info.numOut() / 2, info.timeClocks() / 2);
+    }
+  }
+}
+
+std::optional<SelectivityInfo> FilterSelectivityStore::get(
+    const std::string& table,
+    const std::string& column,
+    const Filter& filter) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(makeKey(table, column, filter));
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+size_t FilterSelectivityStore::size() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.size();
+}
+
+void FilterSelectivityStore::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+}
+
+} // namespace facebook::velox::common
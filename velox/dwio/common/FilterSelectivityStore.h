@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/SelectivityInfo.h"
+#include "velox/dwio/common/ScanSpec.h"
+
+namespace facebook::velox::common {
+
+/// History of the selectivity and cost of the filters of table scans, keyed
+/// on table, column and filter. A ScanSpec learns the order of its filters
+/// from the SelectivityInfo of its children, which starts empty for each new
+/// scan. Seeding the SelectivityInfo from this store lets scans that run
+/// for only a few short splits start with the order learned by earlier scans
+/// of the same table, in the same or in previous queries.
+///
+/// The counts of a filter are halved once they exceed kMaxNumIn input rows so
+/// that recent observations dominate. A scan is seeded with at most
+/// kMaxSeedNumIn input rows of history, about a split's worth, so that its own
+/// adaptation still reacts to the data it reads. Thread safe.
+class FilterSelectivityStore {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 100'000;
+  static constexpr uint64_t kMaxNumIn = 1'000'000'000;
+  static constexpr uint64_t kMaxSeedNumIn = 1'000'000;
+
+  /// A filtered top-level child of a ScanSpec as last seeded or recorded.
+  struct ChildSnapshot {
+    /// The filter the key of the history is made of. A dynamic filter
+    /// replaces the filter of the child and so the key.
+    const Filter* filter{nullptr};
+    std::string key;
+    SelectivityInfo selectivity;
+  };
+
+  /// The filtered top-level children of a ScanSpec keyed on field name. Kept
+  /// by the scan so that the keys are made once, outside of the lock of the
+  /// store.
+  using Snapshot = folly::F14FastMap<std::string, ChildSnapshot>;
+
+  explicit FilterSelectivityStore(size_t maxEntries = kDefaultMaxEntries)
+      : maxEntries_(maxEntries) {}
+
+  /// Returns the process wide store.
+  static FilterSelectivityStore& instance();
+
+  /// Sets the selectivity of the filtered top-level children of 'scanSpec'
+  /// that have a history under 'table' to the history scaled down to
+  /// kMaxSeedNumIn input rows. Returns the filtered children after seeding,
+  /// to be passed to record().
+  Snapshot seed(const std::string& table, ScanSpec& scanSpec);
+
+  /// Adds to the history under 'table' what the filtered top-level children
+  /// of 'scanSpec' observed since 'snapshot' was taken, and updates
+  /// 'snapshot'.
+  void
+  record(const std::string& table, ScanSpec& scanSpec, Snapshot& snapshot);
+
+  std::optional<SelectivityInfo> get(
+      const std::string& table,
+      const std::string& column,
+      const Filter& filter) const;
+
+  size_t size() const;
+
+  void clear();
+
+ private:
+  static std::string makeKey(
+      const std::string& table,
+      const std::string& column,
+      const Filter& filter);
+
+  // Returns the children of 'scanSpec' whose selectivity is learned.
+  static std::vector<ScanSpec*> filteredChildren(const ScanSpec& scanSpec);
+
+  const size_t maxEntries_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, SelectivityInfo> entries_;
+};
+
+} // namespace facebook::velox::common
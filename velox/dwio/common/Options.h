@@ -22,6 +22,7 @@
 #include <folly/Executor.h>
 #include "velox/common/base/RandomUtil.h"
 #include "velox/common/base/SpillConfig.h"
+#include "velox/common/caching/FileMetadataCache.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/io/Options.h"
@@ -512,6 +513,17 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the cache of parsed file footers and the key of the file in it. The
+  /// reader looks up its footer in 'cache' before reading it from the file.
+  /// Pass nullptr to not use a cache.
+  ReaderOptions& setFileMetadataCache(
+      cache::FileMetadataCache* cache,
+      const cache::FileMetadataCacheKey& key = {}) {
+    fileMetadataCache_ = cache;
+    fileMetadataCacheKey_ = key;
+    return *this;
+  }
+
   /// Gets the desired tail location.
   uint64_t tailLocation() const {
     return tailLocation_;
@@ -559,6 +571,14 @@ class ReaderOptions : public io::ReaderOptions {
     return adjustTimestampToTimezone_;
   }
 
+  cache::FileMetadataCache* fileMetadataCache() const {
+    return fileMetadataCache_;
+  }
+
+  const cache::FileMetadataCacheKey& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
+
   bool fileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase_;
   }
@@ -615,6 +635,8 @@ class ReaderOptions : public io::ReaderOptions {
   const tz::TimeZone* sessionTimezone_{nullptr};
   bool adjustTimestampToTimezone_{false};
   bool selectiveNimbleReaderEnabled_{false};
+  cache::FileMetadataCache* fileMetadataCache_{nullptr};
+  cache::FileMetadataCacheKey fileMetadataCacheKey_;
 };
 
 struct WriterOptions {
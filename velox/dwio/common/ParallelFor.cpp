@@ -15,6 +15,11 @@
  */
 
 #include "velox/dwio/common/ParallelFor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/dwio/common/ExecutorBarrier.h"
 
@@ -108,4 +113,60 @@ void ParallelFor::execute(std::function<void(size_t)> func) {
   }
 }
 
+void ParallelFor::executeSharingWork(const std::function<void(size_t)>& func) {
+  if (ranges_.size() <= 1) {
+    execute(func);
+    return;
+  }
+  VELOX_CHECK(
+      executor_,
+      "Executor wasn't provided so we shouldn't have more than 1 range");
+  // Outlives the call in the tasks that start after all ranges are taken.
+  // These do not touch 'this' or 'func'.
+  struct State {
+    explicit State(size_t _numRanges) : numRanges(_numRanges) {}
+
+    const size_t numRanges;
+    std::atomic_size_t nextRange{0};
+    std::mutex mutex;
+    std::condition_variable allDone;
+    size_t numDone{0};
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<State>(ranges_.size());
+  auto runRanges = [this, state, &func]() {
+    for (;;) {
+      const size_t r = state->nextRange++;
+      if (r >= state->numRanges) {
+        return;
+      }
+      std::exception_ptr error;
+      try {
+        for (size_t i = ranges_[r].first; i < ranges_[r].second; ++i) {
+          func(i);
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> l(state->mutex);
+      if (error != nullptr && state->error == nullptr) {
+        state->error = error;
+      }
+      if (++state->numDone == state->numRanges) {
+        state->allDone.notify_all();
+      }
+    }
+  };
+  for (size_t r = 1; r < ranges_.size(); ++r) {
+    executor_->add(runRanges);
+  }
+  runRanges();
+  std::unique_lock<std::mutex> l(state->mutex);
+  state->allDone.wait(
+      l, [&]() { return state->numDone == state->numRanges; });
+  if (state->error != nullptr) {
+    std::rethrow_exception(state->error);
+  }
+}
+
 } // namespace facebook::velox::dwio::common
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 #include "folly/Executor.h"
 
@@ -51,6 +52,13 @@ class ParallelFor {
 
   void execute(std::function<void(size_t)> func);
 
+  /// Like execute() but the ranges are taken by whichever thread is free,
+  /// including the calling thread. The calling thread runs the ranges whose
+  /// tasks have not started on the executor and then waits only for the
+  /// ranges in progress. It so never waits for tasks queued behind itself,
+  /// e.g. if the executor also runs the caller.
+  void executeSharingWork(const std::function<void(size_t)>& func);
+
  private:
   std::shared_ptr<folly::Executor> owned_;
   folly::Executor::KeepAlive<> executor_;
@@ -187,6 +187,17 @@ class Reader {
   virtual std::unique_ptr<ColumnStatistics> columnStatistics(
       uint32_t index) const = 0;
 
+  /**
+   * Get statistics for a specified column to answer aggregates from file
+   * metadata. Unlike columnStatistics(), these are not used to skip files.
+   * @param index column index
+   * @return column statistics, defaults to columnStatistics()
+   */
+  virtual std::unique_ptr<ColumnStatistics> aggregateStatistics(
+      uint32_t index) const {
+    return columnStatistics(index);
+  }
+
   /**
    * Get the file schema.
    * @return file schema
@@ -29,9 +29,27 @@ ScanSpec* ScanSpec::getOrCreateChild(const std::string& name) {
   this->children_.push_back(std::make_unique<ScanSpec>(name));
   auto* child = this->children_.back().get();
   this->childByFieldName_[child->fieldName()] = child;
+  {
+    // A child added after the first read must be seen by the next reader.
+    std::lock_guard<std::mutex> l(mutex_);
+    stableChildren_.clear();
+  }
   return child;
 }
 
+void ScanSpec::removeChild(const std::string& name) {
+  auto it = childByFieldName_.find(name);
+  VELOX_CHECK(it != childByFieldName_.end(), "No child {}", name);
+  auto* child = it->second;
+  childByFieldName_.erase(it);
+  children_.erase(std::find_if(
+      children_.begin(), children_.end(), [&](const auto& candidate) {
+        return candidate.get() == child;
+      }));
+  std::lock_guard<std::mutex> l(mutex_);
+  stableChildren_.clear();
+}
+
 ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
   auto* container = this;
   const auto& path = subfield.path();
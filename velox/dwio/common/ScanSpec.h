@@ -200,6 +200,9 @@ class ScanSpec {
   /// any intermediate level.
   ScanSpec* getOrCreateChild(const std::string& name);
 
+  /// Removes the child 'name'. No reader may refer to the child.
+  void removeChild(const std::string& name);
+
   // Returns the ScanSpec corresponding to 'subfield'. Creates it if
   // needed, including any intermediate levels. This is used at
   // TableScan initialization to create the ScanSpec tree that
@@ -15,6 +15,8 @@
  */
 
 #pragma once
+#include <folly/Executor.h>
+
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/RawVector.h"
 #include "velox/common/process/ProcessBase.h"
@@ -495,6 +497,14 @@ class SelectiveColumnReader {
     VELOX_UNREACHABLE("Only struct reader supports this method");
   }
 
+  /// Lets a struct reader decode its non-filter children on 'executor' with
+  /// up to 'parallelismFactor' threads, see SelectiveStructColumnReaderBase.
+  virtual void setDecodingExecutor(
+      folly::Executor* /*executor*/,
+      size_t /*parallelismFactor*/) {
+    VELOX_UNREACHABLE("Only struct reader supports this method");
+  }
+
  protected:
   template <typename T>
   void prepareRead(
@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -360,6 +361,8 @@ void SelectiveStructColumnReaderBase::read(
 
   const auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
+  const bool parallel = parallelDecoding();
+  deferredChildren_.clear();
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     const auto& childSpec = childSpecs[i];
     VELOX_TRACE_HISTORY_PUSH("read %s", childSpec->fieldName().c_str());
@@ -384,7 +387,7 @@ void SelectiveStructColumnReaderBase::read(
 
     const auto fieldIndex = childSpec->subscript();
     auto* reader = children_.at(fieldIndex);
-    if (reader->isTopLevel() && childSpec->projectOut() &&
+    if (!parallel && reader->isTopLevel() && childSpec->projectOut() &&
         !childSpec->hasFilter()) {
       // Will make a LazyVector.
       continue;
@@ -407,11 +410,28 @@ void SelectiveStructColumnReaderBase::read(
       if (activeRows.empty()) {
         break;
       }
+    } else if (parallel) {
+      deferredChildren_.push_back(reader);
     } else {
       reader->read(offset, activeRows, structNulls);
     }
   }
 
+  if (!deferredChildren_.empty() && !activeRows.empty()) {
+    // The children are independent of each other and are decoded only for
+    // the rows that passed all filters. The driver thread takes back the
+    // children whose tasks have not started, so that it does not wait for an
+    // executor that is busy, e.g. with drivers.
+    ParallelFor(
+        decodingExecutor_,
+        0,
+        deferredChildren_.size(),
+        decodingParallelismFactor_)
+        .executeSharingWork([&](size_t i) {
+          deferredChildren_[i]->read(offset, activeRows, structNulls);
+        });
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -543,7 +563,8 @@ void SelectiveStructColumnReaderBase::getValues(
       continue;
     }
 
-    if (childSpec->hasFilter() || !children_[index]->isTopLevel()) {
+    if (childSpec->hasFilter() || !children_[index]->isTopLevel() ||
+        parallelDecoding()) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
@@ -102,6 +102,18 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     currentRowNumber_ = value;
   }
 
+  /// When set with a parallelism factor above 1, the children without filters
+  /// are read after all filters have been evaluated, in parallel on
+  /// 'executor'. These children are then materialized in getValues() instead
+  /// of being returned as LazyVectors, so that wide scans with few splits per
+  /// node can use more cores. The columns a consumer would not have loaded
+  /// are then decoded too.
+  void setDecodingExecutor(folly::Executor* executor, size_t parallelismFactor)
+      final {
+    decodingExecutor_ = executor;
+    decodingParallelismFactor_ = parallelismFactor;
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -141,6 +153,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
  private:
   void fillOutputRowsFromMutation(vector_size_t size);
 
+  bool parallelDecoding() const {
+    return decodingExecutor_ != nullptr && decodingParallelismFactor_ > 1;
+  }
+
   /// Records the number of nulls added by 'this' between the end position of
   /// each child reader and the end of the range of 'read(). This must be done
   /// also if a child is not read so that we know how much to skip when seeking
@@ -180,6 +196,13 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // After read() call mutation_ could go out of scope.  Need to keep this
   // around for lazy columns.
   bool hasDeletion_ = false;
+
+  folly::Executor* decodingExecutor_ = nullptr;
+  size_t decodingParallelismFactor_ = 0;
+
+  // Children without filters whose read is deferred until the filters of the
+  // current read() are evaluated. Only used with parallel decoding.
+  std::vector<SelectiveColumnReader*> deferredChildren_;
 };
 
 class SelectiveStructColumnReader : public SelectiveStructColumnReaderBase {
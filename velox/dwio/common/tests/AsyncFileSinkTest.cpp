@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileSink.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+// Fails the writes after the first 'numGoodWrites'.
+class FailingSink : public FileSink {
+ public:
+  explicit FailingSink(int32_t numGoodWrites)
+      : FileSink{"failing", {}}, numGoodWrites_{numGoodWrites} {}
+
+  ~FailingSink() override {
+    destroy();
+  }
+
+  using FileSink::write;
+
+  void write(std::vector<DataBuffer<char>>& buffers) override {
+    VELOX_CHECK_GT(numGoodWrites_, 0, "Injected write error");
+    --numGoodWrites_;
+    buffers.clear();
+  }
+
+ private:
+  int32_t numGoodWrites_;
+};
+
+class AsyncFileSinkTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::vector<DataBuffer<char>> makeBuffers(const std::string& data) {
+    std::vector<DataBuffer<char>> buffers;
+    buffers.emplace_back(*pool_);
+    buffers.back().append(0, data.data(), data.size());
+    return buffers;
+  }
+
+  std::shared_ptr<velox::memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+};
+} // namespace
+
+TEST_F(AsyncFileSinkTest, write) {
+  folly::CPUThreadPoolExecutor executor(2);
+  auto memorySink = std::make_unique<MemorySink>(
+      1024, FileSink::Options{.pool = pool_.get()});
+  auto* memorySinkPtr = memorySink.get();
+  AsyncFileSink sink(std::move(memorySink), &executor, 1 << 20);
+  ASSERT_TRUE(sink.isBuffered());
+
+  std::string expected;
+  for (int32_t i = 0; i < 100; ++i) {
+    const auto data = fmt::format("{:05}", i);
+    auto buffers = makeBuffers(data);
+    sink.write(buffers);
+    ASSERT_TRUE(buffers.empty());
+    expected += data;
+  }
+  ASSERT_EQ(sink.size(), expected.size());
+  sink.close();
+  ASSERT_EQ(sink.pendingBytes(), 0);
+  ASSERT_EQ(
+      std::string(memorySinkPtr->data(), memorySinkPtr->size()), expected);
+}
+
+TEST_F(AsyncFileSinkTest, backpressure) {
+  folly::ManualExecutor executor;
+  auto memorySink = std::make_unique<MemorySink>(
+      1024, FileSink::Options{.pool = pool_.get()});
+  AsyncFileSink sink(std::move(memorySink), &executor, 10);
+
+  ContinueFuture future;
+  ASSERT_FALSE(sink.isBlocked(&future));
+  auto buffers = makeBuffers("0123456789");
+  sink.write(buffers);
+  ASSERT_EQ(sink.pendingBytes(), 10);
+  ASSERT_FALSE(sink.isBlocked(&future));
+  buffers = makeBuffers("abcdefghij");
+  sink.write(buffers);
+  ASSERT_EQ(sink.pendingBytes(), 20);
+  ASSERT_TRUE(sink.isBlocked(&future));
+  ASSERT_FALSE(future.isReady());
+
+  executor.drain();
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(sink.pendingBytes(), 0);
+  ASSERT_FALSE(sink.isBlocked(&future));
+  sink.close();
+}
+
+TEST_F(AsyncFileSinkTest, writeError) {
+  folly::ManualExecutor executor;
+  AsyncFileSink sink(std::make_unique<FailingSink>(1), &executor, 1);
+  for (int32_t i = 0; i < 3; ++i) {
+    auto buffers = makeBuffers("0123456789");
+    sink.write(buffers);
+  }
+  ContinueFuture future;
+  ASSERT_TRUE(sink.isBlocked(&future));
+
+  executor.drain();
+  // The writes after the failed one are dropped and the waiters are woken.
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(sink.pendingBytes(), 0);
+  ASSERT_FALSE(sink.isBlocked(&future));
+  auto buffers = makeBuffers("0123456789");
+  VELOX_ASSERT_THROW(sink.write(buffers), "Injected write error");
+  VELOX_ASSERT_THROW(sink.close(), "Injected write error");
+}
+} // namespace facebook::velox::dwio::common
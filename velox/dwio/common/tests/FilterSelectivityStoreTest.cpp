@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FilterSelectivityStore.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::common {
+namespace {
+
+// Makes a scan spec with filters on 'c0' and 'c1' and no filter on 'c2'.
+std::unique_ptr<ScanSpec> makeScanSpec() {
+  auto scanSpec = std::make_unique<ScanSpec>("root");
+  scanSpec->addField("c0", 0)->setFilter(
+      std::make_unique<BigintRange>(0, 10, false));
+  scanSpec->addField("c1", 1)->setFilter(
+      std::make_unique<BigintRange>(0, 100, false));
+  scanSpec->addField("c2", 2);
+  return scanSpec;
+}
+
+TEST(FilterSelectivityStoreTest, seedAndRecord) {
+  FilterSelectivityStore store;
+  auto scanSpec = makeScanSpec();
+  auto* c0 = scanSpec->childByName("c0");
+  auto snapshot = store.seed("t", *scanSpec);
+  EXPECT_EQ(snapshot.size(), 2);
+  EXPECT_EQ(c0->selectivity().numIn(), 0);
+
+  c0->selectivity() = SelectivityInfo(100, 10, 1'000);
+  store.record("t", *scanSpec, snapshot);
+  // 'c1' has not seen any rows.
+  EXPECT_EQ(store.size(), 1);
+  // Only rows seen since the previous record are added.
+  store.record("t", *scanSpec, snapshot);
+  c0->selectivity() = SelectivityInfo(150, 20, 1'500);
+  store.record("t", *scanSpec, snapshot);
+  auto info = store.get("t", "c0", *c0->filter());
+  ASSERT_TRUE(info.has_value());
+  EXPECT_EQ(info->numIn(), 150);
+  EXPECT_EQ(info->numOut(), 20);
+  EXPECT_EQ(info->timeClocks(), 1'500);
+
+  // A new scan of the table starts with the history and adds to it.
+  auto otherScanSpec = makeScanSpec();
+  auto* otherC0 = otherScanSpec->childByName("c0");
+  auto otherSnapshot = store.seed("t", *otherScanSpec);
+  EXPECT_EQ(otherC0->selectivity().numIn(), 150);
+  EXPECT_EQ(otherScanSpec->childByName("c1")->selectivity().numIn(), 0);
+  otherC0->selectivity() = SelectivityInfo(160, 21, 1'600);
+  store.record("t", *otherScanSpec, otherSnapshot);
+  EXPECT_EQ(store.get("t", "c0", *c0->filter())->numIn(), 160);
+
+  // Other tables and filters have their own history.
+  EXPECT_FALSE(store.get("u", "c0", *c0->filter()).has_value());
+  EXPECT_FALSE(store.get("t", "c0", BigintRange(0, 11, false)).has_value());
+
+  store.clear();
+  EXPECT_EQ(store.size(), 0);
+}
+
+TEST(FilterSelectivityStoreTest, decay) {
+  FilterSelectivityStore store;
+  auto scanSpec = makeScanSpec();
+  auto* c0 = scanSpec->childByName("c0");
+  auto snapshot = store.seed("t", *scanSpec);
+  c0->selectivity() =
+      SelectivityInfo(FilterSelectivityStore::kMaxNumIn + 2, 100, 1'000);
+  store.record("t", *scanSpec, snapshot);
+  auto info = store.get("t", "c0", *c0->filter());
+  EXPECT_EQ(info->numIn(), FilterSelectivityStore::kMaxNumIn / 2 + 1);
+  EXPECT_EQ(info->numOut(), 50);
+  EXPECT_EQ(info->timeClocks(), 500);
+}
+
+// Returns the position of 'name' among the children of 'scanSpec'.
+size_t childPosition(const ScanSpec& scanSpec, const std::string& name) {
+  const auto& children = scanSpec.children();
+  for (size_t i = 0; i < children.size(); ++i) {
+    if (children[i]->fieldName() == name) {
+      return i;
+    }
+  }
+  VELOX_FAIL("No child {}", name);
+}
+
+TEST(FilterSelectivityStoreTest, localAdaptation) {
+  constexpr uint64_t kHistoryRows = 500'000'000;
+  FilterSelectivityStore store;
+  {
+    // A long history in which c0 drops rows faster than c1.
+    auto scanSpec = makeScanSpec();
+    auto snapshot = store.seed("t", *scanSpec);
+    scanSpec->childByName("c0")->selectivity() =
+        SelectivityInfo(kHistoryRows, kHistoryRows / 10, kHistoryRows);
+    scanSpec->childByName("c1")->selectivity() =
+        SelectivityInfo(kHistoryRows, kHistoryRows / 2, 4 * kHistoryRows);
+    store.record("t", *scanSpec, snapshot);
+  }
+
+  auto scanSpec = makeScanSpec();
+  auto* c0 = scanSpec->childByName("c0");
+  auto* c1 = scanSpec->childByName("c1");
+  auto snapshot = store.seed("t", *scanSpec);
+  // The history is scaled down to a split's worth of rows.
+  EXPECT_EQ(c0->selectivity().numIn(), FilterSelectivityStore::kMaxSeedNumIn);
+  EXPECT_EQ(
+      snapshot.at("c0").selectivity.numIn(),
+      FilterSelectivityStore::kMaxSeedNumIn);
+  scanSpec->newRead();
+  EXPECT_LT(childPosition(*scanSpec, "c0"), childPosition(*scanSpec, "c1"));
+
+  // In the data of this scan c1 drops all rows and c0 none. The scan flips
+  // the order of the filters.
+  constexpr uint64_t kSplitRows = 10'000'000;
+  c0->selectivity() += SelectivityInfo(kSplitRows, kSplitRows, 10 * kSplitRows);
+  c1->selectivity() += SelectivityInfo(kSplitRows, 0, kSplitRows);
+  scanSpec->newRead();
+  EXPECT_LT(childPosition(*scanSpec, "c1"), childPosition(*scanSpec, "c0"));
+
+  // Only the rows of this scan are added to the history.
+  store.record("t", *scanSpec, snapshot);
+  EXPECT_EQ(
+      store.get("t", "c0", *c0->filter())->numIn(), kHistoryRows + kSplitRows);
+}
+
+TEST(FilterSelectivityStoreTest, dynamicFilter) {
+  FilterSelectivityStore store;
+  auto scanSpec = makeScanSpec();
+  auto* c0 = scanSpec->childByName("c0");
+  auto snapshot = store.seed("t", *scanSpec);
+  c0->selectivity() = SelectivityInfo(100, 10, 1'000);
+  store.record("t", *scanSpec, snapshot);
+
+  // The rows seen after the filter changes are recorded under the new filter.
+  c0->setFilter(std::make_unique<BigintRange>(0, 5, false));
+  c0->selectivity() = SelectivityInfo(150, 11, 1'500);
+  store.record("t", *scanSpec, snapshot);
+  EXPECT_EQ(store.get("t", "c0", BigintRange(0, 10, false))->numIn(), 100);
+  EXPECT_EQ(store.get("t", "c0", *c0->filter())->numIn(), 50);
+}
+
+TEST(FilterSelectivityStoreTest, maxEntries) {
+  FilterSelectivityStore store(1);
+  auto scanSpec = makeScanSpec();
+  auto snapshot = store.seed("t", *scanSpec);
+  scanSpec->childByName("c0")->selectivity() = SelectivityInfo(10, 1, 10);
+  scanSpec->childByName("c1")->selectivity() = SelectivityInfo(10, 1, 10);
+  store.record("t", *scanSpec, snapshot);
+  EXPECT_EQ(store.size(), 1);
+}
+
+} // namespace
+} // namespace facebook::velox::common
@@ -20,6 +20,7 @@
 #include "folly/executors/InlineExecutor.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "velox/common/base/Exceptions.h"
 #include "velox/common/base/VeloxException.h"
 
 using namespace ::testing;
@@ -150,3 +151,37 @@ TEST(ParallelForTest, CanOwnExecutor) {
     EXPECT_EQ(indexInvoked[i], 1);
   }
 }
+
+TEST(ParallelForTest, executeSharingWork) {
+  // An executor that never runs its tasks, like one whose threads all wait
+  // for the caller.
+  class StalledExecutor : public folly::Executor {
+   public:
+    void add(folly::Func func) override {
+      tasks.push_back(std::move(func));
+    }
+
+    std::vector<folly::Func> tasks;
+  } stalledExecutor;
+  folly::CPUThreadPoolExecutor threadPool(4);
+  for (folly::Executor* executor :
+       std::vector<folly::Executor*>{&stalledExecutor, &threadPool}) {
+    std::vector<std::atomic<size_t>> indexInvoked(100);
+    ParallelFor(executor, 0, indexInvoked.size(), 8)
+        .executeSharingWork([&](size_t i) { ++indexInvoked[i]; });
+    for (const auto& count : indexInvoked) {
+      EXPECT_EQ(count, 1);
+    }
+  }
+  EXPECT_EQ(stalledExecutor.tasks.size(), 7);
+  // The tasks that start late find no work.
+  for (auto& task : stalledExecutor.tasks) {
+    task();
+  }
+
+  EXPECT_THROW(
+      ParallelFor(&threadPool, 0, 100, 8).executeSharingWork([](size_t i) {
+        VELOX_CHECK_NE(i, 50);
+      }),
+      facebook::velox::VeloxRuntimeError);
+}
@@ -15,9 +15,17 @@
  */
 
 #include "velox/dwio/dwrf/common/RLEv2.h"
+
+#include <folly/lang/Bits.h>
+
+#include "velox/dwio/common/BitPackDecoder.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 
+#if XSIMD_WITH_AVX2
+#include <immintrin.h>
+#endif
+
 namespace facebook::velox::dwrf {
 
 using memory::MemoryPool;
@@ -107,6 +115,206 @@ inline uint32_t getClosestFixedBits(uint32_t n) {
   }
 }
 
+namespace {
+
+inline uint64_t loadBigEndian(const char* input) {
+  return folly::Endian::big(folly::loadUnaligned<uint64_t>(input));
+}
+
+#if XSIMD_WITH_AVX2
+// Unpacks groups of 8 values of 'kWidth' <= 16 bits packed most significant
+// bit first from the start of 'input', which has 'numBytes' readable bytes. A
+// group takes 'kWidth' bytes. Returns the number of values unpacked.
+template <int32_t kWidth>
+uint64_t unpackGroupsAvx2(
+    const char* input,
+    uint64_t numBytes,
+    uint64_t numValues,
+    int64_t* result) {
+  static_assert(kWidth <= 16);
+  // Leaves room for the 8 byte loads.
+  const uint64_t numGroups = numBytes < 16
+      ? 0
+      : std::min(numValues / 8, (numBytes - 16) / kWidth + 1);
+  auto* output = reinterpret_cast<__m256i*>(result);
+  for (uint64_t i = 0; i < numGroups; ++i, input += kWidth, output += 2) {
+    if constexpr (kWidth <= 8) {
+      const auto word = loadBigEndian(input) >> (64 - 8 * kWidth);
+      // Byte 'i' gets value 'i' after the byte swap.
+      const auto bytes = _mm_cvtsi64_si128(__builtin_bswap64(
+          _pdep_u64(word, dwio::common::kPdepMask8[kWidth])));
+      _mm256_storeu_si256(output, _mm256_cvtepu8_epi64(bytes));
+      _mm256_storeu_si256(
+          output + 1, _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 4)));
+    } else {
+      // Each half of the group has 4 values in 'kHalfBits' bits.
+      constexpr int32_t kHalfBits = 4 * kWidth;
+      const auto first = loadBigEndian(input) >> (64 - kHalfBits);
+      const auto second =
+          (loadBigEndian(input + kHalfBits / 8) << (kHalfBits % 8)) >>
+          (64 - kHalfBits);
+      // The 16 bit lanes have the values of a half in reverse order.
+      const auto firstLanes = _mm256_cvtepu16_epi64(_mm_cvtsi64_si128(
+          _pdep_u64(first, dwio::common::kPdepMask16[kWidth])));
+      const auto secondLanes = _mm256_cvtepu16_epi64(_mm_cvtsi64_si128(
+          _pdep_u64(second, dwio::common::kPdepMask16[kWidth])));
+      _mm256_storeu_si256(output, _mm256_permute4x64_epi64(firstLanes, 0x1b));
+      _mm256_storeu_si256(
+          output + 1, _mm256_permute4x64_epi64(secondLanes, 0x1b));
+    }
+  }
+  return numGroups * 8;
+}
+#endif
+
+// Unpacks 'numValues' values of 'kWidth' bits packed most significant bit
+// first, starting at bit 'firstBit' of 'input', which has 'numBytes' readable
+// bytes. Each value is extracted from an 8 byte load at its first byte, so
+// the loop has no data dependent branches.
+template <int32_t kWidth>
+void unpackBigEndian(
+    const char* input,
+    uint64_t numBytes,
+    uint64_t firstBit,
+    uint64_t numValues,
+    int64_t* result) {
+  static_assert(kWidth % 8 == 0 || kWidth <= 57);
+  if constexpr (kWidth % 8 == 0) {
+    VELOX_DCHECK_EQ(firstBit, 0);
+  }
+  uint64_t i = 0;
+#if XSIMD_WITH_AVX2
+  if constexpr (kWidth <= 16) {
+    if (firstBit == 0) {
+      i = unpackGroupsAvx2<kWidth>(input, numBytes, numValues, result);
+    }
+  }
+#endif
+  // The values that can be read with an 8 byte load inside 'input'.
+  const uint64_t numFast = numBytes * 8 < 64 + firstBit
+      ? 0
+      : std::min(numValues, ((numBytes - 8) * 8 - firstBit) / kWidth + 1);
+  for (; i < numFast; ++i) {
+    const auto bit = firstBit + i * kWidth;
+    const auto word = loadBigEndian(input + bit / 8);
+    result[i] = static_cast<int64_t>((word << (bit % 8)) >> (64 - kWidth));
+  }
+  for (; i < numValues; ++i) {
+    const auto bit = firstBit + i * kWidth;
+    char bytes[8] = {};
+    ::memcpy(bytes, input + bit / 8, std::min<uint64_t>(8, numBytes - bit / 8));
+    const auto word = loadBigEndian(bytes);
+    result[i] = static_cast<int64_t>((word << (bit % 8)) >> (64 - kWidth));
+  }
+}
+
+// Dispatches to unpackBigEndian() for the bit widths used by RLEv2.
+void unpackBigEndian(
+    uint32_t bitWidth,
+    const char* input,
+    uint64_t numBytes,
+    uint64_t firstBit,
+    uint64_t numValues,
+    int64_t* result) {
+  switch (bitWidth) {
+#define VELOX_UNPACK_CASE(width)                                          \
+  case width:                                                             \
+    unpackBigEndian<width>(input, numBytes, firstBit, numValues, result); \
+    return;
+    VELOX_UNPACK_CASE(1)
+    VELOX_UNPACK_CASE(2)
+    VELOX_UNPACK_CASE(3)
+    VELOX_UNPACK_CASE(4)
+    VELOX_UNPACK_CASE(5)
+    VELOX_UNPACK_CASE(6)
+    VELOX_UNPACK_CASE(7)
+    VELOX_UNPACK_CASE(8)
+    VELOX_UNPACK_CASE(9)
+    VELOX_UNPACK_CASE(10)
+    VELOX_UNPACK_CASE(11)
+    VELOX_UNPACK_CASE(12)
+    VELOX_UNPACK_CASE(13)
+    VELOX_UNPACK_CASE(14)
+    VELOX_UNPACK_CASE(15)
+    VELOX_UNPACK_CASE(16)
+    VELOX_UNPACK_CASE(17)
+    VELOX_UNPACK_CASE(18)
+    VELOX_UNPACK_CASE(19)
+    VELOX_UNPACK_CASE(20)
+    VELOX_UNPACK_CASE(21)
+    VELOX_UNPACK_CASE(22)
+    VELOX_UNPACK_CASE(23)
+    VELOX_UNPACK_CASE(24)
+    VELOX_UNPACK_CASE(26)
+    VELOX_UNPACK_CASE(28)
+    VELOX_UNPACK_CASE(30)
+    VELOX_UNPACK_CASE(32)
+    VELOX_UNPACK_CASE(40)
+    VELOX_UNPACK_CASE(48)
+    VELOX_UNPACK_CASE(56)
+    VELOX_UNPACK_CASE(64)
+#undef VELOX_UNPACK_CASE
+    default:
+      VELOX_FAIL("Unsupported RLEv2 bit width: {}", bitWidth);
+  }
+}
+
+} // namespace
+
+template <bool isSigned>
+bool RleDecoderV2<isSigned>::unpackFromBuffer(
+    int64_t* data,
+    uint64_t numValues,
+    uint32_t bitWidth) {
+  auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart_;
+  const auto* bufferEnd = dwio::common::IntDecoder<isSigned>::bufferEnd_;
+  // Starts at the unread bits of 'curByte_'.
+  const char* input = bitsLeft_ > 0 ? bufferStart - 1 : bufferStart;
+  const uint64_t firstBit = bitsLeft_ > 0 ? 8 - bitsLeft_ : 0;
+  const uint64_t endBit = firstBit + numValues * bitWidth;
+  const uint64_t numBytes = bufferEnd - input;
+  if (bits::divRoundUp(endBit, 8) > numBytes) {
+    return false;
+  }
+  VELOX_DCHECK(bitsLeft_ == 0 || static_cast<uint8_t>(*input) == curByte_);
+  unpackBigEndian(bitWidth, input, numBytes, firstBit, numValues, data);
+  bufferStart = input + endBit / 8;
+  bitsLeft_ = 0;
+  if (endBit % 8 != 0) {
+    curByte_ = readByte();
+    bitsLeft_ = 8 - endBit % 8;
+  }
+  return true;
+}
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::skipBits(uint64_t numBits) {
+  if (numBits <= bitsLeft_) {
+    bitsLeft_ -= numBits;
+    return;
+  }
+  numBits -= bitsLeft_;
+  bitsLeft_ = 0;
+  auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart_;
+  auto& bufferEnd = dwio::common::IntDecoder<isSigned>::bufferEnd_;
+  const uint64_t numBytes = numBits / 8;
+  const uint64_t numBuffered = bufferEnd - bufferStart;
+  if (numBytes <= numBuffered) {
+    bufferStart += numBytes;
+  } else {
+    VELOX_CHECK(
+        dwio::common::IntDecoder<isSigned>::inputStream_->SkipInt64(
+            numBytes - numBuffered),
+        "bad skip in RleDecoderV2::skipBits, ",
+        dwio::common::IntDecoder<isSigned>::inputStream_->getName());
+    bufferStart = bufferEnd;
+  }
+  if (numBits % 8 != 0) {
+    curByte_ = readByte();
+    bitsLeft_ = 8 - numBits % 8;
+  }
+}
+
 template <bool isSigned>
 int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   int64_t ret = 0, val;
@@ -173,16 +381,27 @@ template void RleDecoderV2<false>::seekToRowGroup(
 
 template <bool isSigned>
 void RleDecoderV2<isSigned>::skipPending() {
-  // simple for now, until perf tests indicate something encoding specific is
-  // needed
   constexpr int64_t N = 64;
   int64_t dummy[N];
   auto numValues = this->pendingSkip_;
   this->pendingSkip_ = 0;
   while (numValues) {
-    uint64_t nRead = std::min(N, numValues);
-    doNext(dummy, nRead, nullptr);
-    numValues -= nRead;
+    if (runRead_ == runLength_) {
+      resetRun();
+      if (type_ == DIRECT) {
+        readDirectHeader();
+      }
+    }
+    if (type_ == DIRECT) {
+      // The values of a DIRECT run are skipped without decoding.
+      const auto numSkipped =
+          std::min<uint64_t>(runLength_ - runRead_, numValues);
+      skipBits(numSkipped * bitSize_);
+      runRead_ += numSkipped;
+      numValues -= numSkipped;
+      continue;
+    }
+    numValues -= nextInRun(dummy, 0, std::min(N, numValues), nullptr);
   }
 }
 
@@ -217,24 +436,7 @@ void RleDecoderV2<isSigned>::doNext(
       resetRun();
     }
 
-    uint64_t offset = nRead, length = numValues - nRead;
-
-    switch (type_) {
-      case SHORT_REPEAT:
-        nRead += nextShortRepeats(data, offset, length, nulls);
-        break;
-      case DIRECT:
-        nRead += nextDirect(data, offset, length, nulls);
-        break;
-      case PATCHED_BASE:
-        nRead += nextPatched(data, offset, length, nulls);
-        break;
-      case DELTA:
-        nRead += nextDelta(data, offset, length, nulls);
-        break;
-      default:
-        VELOX_FAIL("unknown encoding: {}", static_cast<int>(type_));
-    }
+    nRead += nextInRun(data, nRead, numValues - nRead, nulls);
   }
 }
 
@@ -302,6 +504,40 @@ template uint64_t RleDecoderV2<false>::nextShortRepeats(
     uint64_t numValues,
     const uint64_t* nulls);
 
+template <bool isSigned>
+uint64_t RleDecoderV2<isSigned>::nextInRun(
+    int64_t* data,
+    uint64_t offset,
+    uint64_t numValues,
+    const uint64_t* nulls) {
+  switch (type_) {
+    case SHORT_REPEAT:
+      return nextShortRepeats(data, offset, numValues, nulls);
+    case DIRECT:
+      return nextDirect(data, offset, numValues, nulls);
+    case PATCHED_BASE:
+      return nextPatched(data, offset, numValues, nulls);
+    case DELTA:
+      return nextDelta(data, offset, numValues, nulls);
+    default:
+      VELOX_FAIL("unknown encoding: {}", static_cast<int>(type_));
+  }
+}
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::readDirectHeader() {
+  // extract the number of fixed bits
+  unsigned char fbo = (firstByte_ >> 1) & 0x1f;
+  bitSize_ = decodeBitWidth(fbo);
+
+  // extract the run length
+  runLength_ = static_cast<uint64_t>(firstByte_ & 0x01) << 8;
+  runLength_ |= readByte();
+  // runs are one off
+  runLength_ += 1;
+  runRead_ = 0;
+}
+
 template <bool isSigned>
 uint64_t RleDecoderV2<isSigned>::nextDirect(
     int64_t* data,
@@ -309,16 +545,7 @@ uint64_t RleDecoderV2<isSigned>::nextDirect(
     uint64_t numValues,
     const uint64_t* nulls) {
   if (runRead_ == runLength_) {
-    // extract the number of fixed bits
-    unsigned char fbo = (firstByte_ >> 1) & 0x1f;
-    bitSize_ = decodeBitWidth(fbo);
-
-    // extract the run length
-    runLength_ = static_cast<uint64_t>(firstByte_ & 0x01) << 8;
-    runLength_ |= readByte();
-    // runs are one off
-    runLength_ += 1;
-    runRead_ = 0;
+    readDirectHeader();
   }
 
   uint64_t nRead = std::min(runLength_ - runRead_, numValues);
@@ -427,42 +654,41 @@ uint64_t RleDecoderV2<isSigned>::nextPatched(
     // any remaining bits are thrown out
     resetReadLongs();
 
-    // apply the patch directly when decoding the packed data
+    // Applies the patches to the whole run up front so that the values are
+    // then copied without per value checks.
     patchMask_ = ((static_cast<int64_t>(1) << patchBitSize_) - 1);
-
     adjustGapAndPatch();
+    for (uint64_t pos = actualGap_; pos < runLength_;) {
+      unpacked_[pos] |= curPatch_ << bitSize_;
+      if (++patchIdx_ == unpackedPatch_.size()) {
+        break;
+      }
+      adjustGapAndPatch();
+      // next gap is relative to the current gap
+      pos += actualGap_;
+    }
+    auto* values = unpacked_.data();
+    for (uint64_t i = 0; i < runLength_; ++i) {
+      values[i] += base_;
+    }
   }
 
   uint64_t nRead = std::min(runLength_ - runRead_, numValues);
 
-  for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
-    // skip null positions
-    if (nulls && bits::isBitNull(nulls, pos)) {
-      continue;
-    }
-    if (static_cast<int64_t>(unpackedIdx_) != actualGap_) {
-      // no patching required. add base to unpacked value to get final value
-      data[pos] = base_ + unpacked_[unpackedIdx_];
-    } else {
-      // extract the patch value
-      int64_t patchedVal = unpacked_[unpackedIdx_] | (curPatch_ << bitSize_);
-
-      // add base to patched value
-      data[pos] = base_ + patchedVal;
-
-      // increment the patch to point to next entry in patch list
-      ++patchIdx_;
-
-      if (patchIdx_ < unpackedPatch_.size()) {
-        adjustGapAndPatch();
-
-        // next gap is relative to the current gap
-        actualGap_ += unpackedIdx_;
+  if (nulls) {
+    for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
+      if (!bits::isBitNull(nulls, pos)) {
+        data[pos] = unpacked_[unpackedIdx_++];
+        ++runRead_;
       }
     }
-
-    ++runRead_;
-    ++unpackedIdx_;
+  } else {
+    std::copy(
+        unpacked_.data() + unpackedIdx_,
+        unpacked_.data() + unpackedIdx_ + nRead,
+        data + offset);
+    unpackedIdx_ += nRead;
+    runRead_ += nRead;
   }
 
   return nRead;
@@ -598,24 +824,8 @@ int64_t RleDecoderV2<isSigned>::readValue() {
     resetRun();
   }
 
-  uint64_t nRead = 0;
   int64_t value = 0;
-  switch (type_) {
-    case SHORT_REPEAT:
-      nRead = nextShortRepeats(&value, 0, 1, nullptr);
-      break;
-    case DIRECT:
-      nRead = nextDirect(&value, 0, 1, nullptr);
-      break;
-    case PATCHED_BASE:
-      nRead = nextPatched(&value, 0, 1, nullptr);
-      break;
-    case DELTA:
-      nRead = nextDelta(&value, 0, 1, nullptr);
-      break;
-    default:
-      VELOX_FAIL("unknown encoding: {}", static_cast<int>(type_));
-  }
+  const auto nRead = nextInRun(&value, 0, 1, nullptr);
   VELOX_CHECK_EQ(nRead, (uint64_t)1);
   return value;
 }
@@ -19,6 +19,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -62,6 +63,11 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     skipPending();
+    if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
+
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
 
@@ -100,6 +106,101 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  // Number of rows decoded at a time by bulkScan().
+  static constexpr int32_t kBulkScanBatch = 1024;
+
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        auto innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
+             !hasFilter &&
+            !hasHook >
+                (nulls,
+                 rowsAsRange,
+                 *innerVector,
+                 *outerVector,
+                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                 tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          this->template skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        this->template skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Decodes the values from the first to the last of 'nonNullRows' in
+  // batches of up to 'kBulkScanBatch' rows and passes the values at
+  // 'nonNullRows' to the visitor a batch at a time. The rows between batches
+  // are skipped without decoding where the run encoding allows.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    const auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    const auto* rows = visitor.rows();
+    const auto numRows = visitor.numRows();
+    auto* values = visitor.rawValues(numRows);
+    auto* filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    int32_t rowIndex = 0;
+    int32_t currentRow = 0;
+    int64_t decoded[kBulkScanBatch];
+    while (rowIndex < numRows) {
+      if (rows[rowIndex] > currentRow) {
+        this->template skip<false>(rows[rowIndex] - currentRow, 0, nullptr);
+        currentRow = rows[rowIndex];
+      }
+      const auto* batchEnd = std::lower_bound(
+          rows + rowIndex, rows + numRows, currentRow + kBulkScanBatch);
+      const int32_t end = batchEnd - rows;
+      const auto numDecoded = rows[end - 1] - currentRow + 1;
+      doNext(decoded, numDecoded, nullptr);
+      auto* input = values + numValues;
+      for (auto i = rowIndex; i < end; ++i) {
+        input[i - rowIndex] = static_cast<typename Visitor::DataType>(
+            decoded[rows[i] - currentRow]);
+      }
+      visitor.template processRun<hasFilter, hasHook, scatter>(
+          input, end - rowIndex, scatterRows, filterHits, values, numValues);
+      currentRow += numDecoded;
+      rowIndex = end;
+    }
+    visitor.setNumValues(hasFilter ? numValues : numAllRows);
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap_ = static_cast<uint64_t>(unpackedPatch_[patchIdx_]) >> patchBitSize_;
@@ -154,15 +255,41 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
   int64_t readLongBE(uint64_t bsz);
+
+  // Unpacks 'numValues' values of 'bitWidth' bits to 'data' if the current
+  // buffer has all of their bits. Returns false if it does not.
+  bool unpackFromBuffer(int64_t* data, uint64_t numValues, uint32_t bitWidth);
+
+  // Skips 'numBits' bits of bit packed values.
+  void skipBits(uint64_t numBits);
+
   uint64_t readLongs(
       int64_t* data,
       uint64_t offset,
       uint64_t len,
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
-    uint64_t ret = 0;
+    if (nulls == nullptr) {
+      if (len > 0 && unpackFromBuffer(data + offset, len, fb)) {
+        return len;
+      }
+    } else {
+      const auto numNonNulls = bits::countNonNulls(nulls, offset, offset + len);
+      if (numNonNulls > 0 &&
+          unpackFromBuffer(data + offset, numNonNulls, fb)) {
+        // Moves the values to their non-null positions, last first.
+        auto source = offset + numNonNulls;
+        for (auto i = offset + len; i > offset && source > offset;) {
+          --i;
+          if (!bits::isBitNull(nulls, i)) {
+            data[i] = data[--source];
+          }
+        }
+        return numNonNulls;
+      }
+    }
 
-    // TODO: unroll to improve performance
+    uint64_t ret = 0;
     for (uint64_t i = offset; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
@@ -212,6 +339,17 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t numValues,
       const uint64_t* nulls);
 
+  // Reads up to 'numValues' values of the current run, whose header byte has
+  // been read.
+  uint64_t nextInRun(
+      int64_t* data,
+      uint64_t offset,
+      uint64_t numValues,
+      const uint64_t* nulls);
+
+  // Reads the header of a DIRECT run after its first byte.
+  void readDirectHeader();
+
   int64_t readValue();
 
   void doNext(
@@ -227,7 +365,9 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   int64_t firstValue_; // Used by SHORT_REPEAT and DELTA
   int64_t prevValue_; // Used by DELTA
   uint32_t bitSize_; // Used by DIRECT, PATCHED_BASE and DELTA
-  uint32_t bitsLeft_; // Used by anything that uses readLongs
+  // Used by anything that uses readLongs. When 'bitsLeft_' > 0, 'curByte_' is
+  // the byte before 'bufferStart_'.
+  uint32_t bitsLeft_;
   uint32_t curByte_; // Used by anything that uses readLongs
   uint32_t patchBitSize_; // Used by PATCHED_BASE
   uint64_t unpackedIdx_; // Used by PATCHED_BASE
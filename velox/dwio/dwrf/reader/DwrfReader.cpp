@@ -169,6 +169,9 @@ void DwrfUnit::ensureDecoders() {
         flatMapContext,
         /*isRoot=*/true);
     selectiveColumnReader_->setIsTopLevel();
+    selectiveColumnReader_->setDecodingExecutor(
+        options_.decodingExecutor().get(),
+        options_.decodingParallelismFactor());
   } else {
     auto requestedType = columnSelector_->getSchemaWithId();
     auto factory = &ColumnReaderFactory::defaultFactory();
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -33,6 +34,7 @@
 #include "velox/type/fbhive/HiveTypeParser.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace ::testing;
 using namespace facebook::velox::common::testutil;
@@ -2134,4 +2136,66 @@ DEBUG_ONLY_TEST_F(E2EWriterTest, memoryReclaimThreshold) {
     writer->close();
   }
 }
+
+TEST_F(E2EWriterTest, parallelEncoding) {
+  const auto type = ROW(
+      {{"int_val", INTEGER()},
+       {"bigint_val", BIGINT()},
+       {"string_val", VARCHAR()},
+       {"array_val", ARRAY(VARCHAR())},
+       {"map_val", MAP(BIGINT(), VARCHAR())},
+       {"struct_val", ROW({{"a", INTEGER()}, {"b", VARCHAR()}})}});
+
+  VectorFuzzer fuzzer(
+      {.vectorSize = 1'000, .nullRatio = 0.1}, leafPool_.get(), 123);
+  std::vector<VectorPtr> vectors;
+  for (int i = 0; i < 12; ++i) {
+    vectors.push_back(fuzzer.fuzzInputRow(type));
+  }
+
+  const auto writeFile = [&](std::shared_ptr<folly::Executor> executor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::COMPRESSION, common::CompressionKind_ZSTD);
+    // Small blocks compress many times per column and batch.
+    config->set<uint64_t>(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1024);
+    config->set<uint64_t>(dwrf::Config::COMPRESSION_BLOCK_SIZE_MIN, 1024);
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    options.encodingParallelismFactor = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (size_t i = 0; i < vectors.size(); ++i) {
+      writer.write(vectors[i]);
+      if (i % 4 == 3) {
+        writer.flush();
+      }
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto serialFile = writeFile(nullptr);
+  const auto parallelFile =
+      writeFile(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  ASSERT_EQ(serialFile, parallelFile);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(parallelFile),
+          readerOpts.memoryPool()));
+  ASSERT_EQ(reader->getNumberOfStripes(), 3);
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  VectorPtr batch = BaseVector::create(type, 0, leafPool_.get());
+  for (const auto& vector : vectors) {
+    ASSERT_GT(rowReader->next(vector->size(), batch), 0);
+    assertEqualVectors(vector, batch);
+  }
+}
 } // namespace
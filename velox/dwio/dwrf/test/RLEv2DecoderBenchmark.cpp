@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <random>
+
+#include "velox/common/base/Nulls.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+constexpr int32_t kNumValues = 1'000'000;
+constexpr int32_t kRunLength = 512;
+constexpr int32_t kBatchSize = 1'000;
+
+uint32_t encodeBitWidth(uint32_t bitWidth) {
+  if (bitWidth <= 24) {
+    return bitWidth - 1;
+  }
+  if (bitWidth <= 32) {
+    return 24 + (bitWidth - 26) / 2;
+  }
+  return 28 + (bitWidth - 40) / 8;
+}
+
+// Appends 'value' in 'bitWidth' bits, most significant bit first.
+void appendBits(
+    uint64_t value,
+    uint32_t bitWidth,
+    uint64_t& numBits,
+    std::vector<unsigned char>& bytes) {
+  for (int32_t bit = bitWidth - 1; bit >= 0; --bit, ++numBits) {
+    if (numBits % 8 == 0) {
+      bytes.push_back(0);
+    }
+    bytes.back() |= ((value >> bit) & 1) << (7 - numBits % 8);
+  }
+}
+
+// Returns 'kNumValues' random values of 'bitWidth' bits in DIRECT runs.
+std::vector<unsigned char> makeDirect(uint32_t bitWidth) {
+  std::mt19937_64 rng(1);
+  std::vector<unsigned char> bytes;
+  for (int32_t run = 0; run < kNumValues / kRunLength; ++run) {
+    bytes.push_back(
+        0x40 | (encodeBitWidth(bitWidth) << 1) | ((kRunLength - 1) >> 8));
+    bytes.push_back((kRunLength - 1) & 0xff);
+    uint64_t numBits = 0;
+    for (int32_t i = 0; i < kRunLength; ++i) {
+      appendBits(rng() & ((1UL << bitWidth) - 1), bitWidth, numBits, bytes);
+    }
+  }
+  return bytes;
+}
+
+// Returns 'kNumValues' random values of 'bitWidth' bits in PATCHED_BASE runs
+// with a base of -1000 and 16 patches of 8 bits per run.
+std::vector<unsigned char> makePatched(uint32_t bitWidth) {
+  constexpr uint32_t kPatchWidth = 8;
+  constexpr uint32_t kGapWidth = 8;
+  constexpr int32_t kNumPatches = 16;
+  std::mt19937_64 rng(1);
+  std::vector<unsigned char> bytes;
+  for (int32_t run = 0; run < kNumValues / kRunLength; ++run) {
+    bytes.push_back(
+        0x80 | (encodeBitWidth(bitWidth) << 1) | ((kRunLength - 1) >> 8));
+    bytes.push_back((kRunLength - 1) & 0xff);
+    // A 2 byte base and the patch width.
+    bytes.push_back((1 << 5) | encodeBitWidth(kPatchWidth));
+    bytes.push_back(((kGapWidth - 1) << 5) | kNumPatches);
+    // -1000 in sign and magnitude.
+    bytes.push_back(0x83);
+    bytes.push_back(0xe8);
+    uint64_t numBits = 0;
+    for (int32_t i = 0; i < kRunLength; ++i) {
+      appendBits(rng() & ((1UL << bitWidth) - 1), bitWidth, numBits, bytes);
+    }
+    numBits = 0;
+    for (int32_t i = 0; i < kNumPatches; ++i) {
+      const uint64_t gap = i == 0 ? 0 : kRunLength / kNumPatches;
+      appendBits(
+          (gap << kPatchWidth) | (1 + rng() % 255),
+          kPatchWidth + kGapWidth,
+          numBits,
+          bytes);
+    }
+  }
+  return bytes;
+}
+
+const std::vector<unsigned char>& directData(uint32_t bitWidth) {
+  static std::unordered_map<uint32_t, std::vector<unsigned char>> data;
+  auto& bytes = data[bitWidth];
+  if (bytes.empty()) {
+    bytes = makeDirect(bitWidth);
+  }
+  return bytes;
+}
+
+const std::vector<unsigned char>& patchedData(uint32_t bitWidth) {
+  static std::unordered_map<uint32_t, std::vector<unsigned char>> data;
+  auto& bytes = data[bitWidth];
+  if (bytes.empty()) {
+    bytes = makePatched(bitWidth);
+  }
+  return bytes;
+}
+
+// Reads batches of 'kBatchSize' values, skipping 'numSkipped' values after
+// each batch.
+int64_t decode(
+    const std::vector<unsigned char>& bytes,
+    int32_t numSkipped,
+    bool withNulls) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto decoder = createRleDecoder<false>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          bytes.data(), bytes.size()),
+      RleVersion_2,
+      *pool,
+      true,
+      dwio::common::INT_BYTE_SIZE);
+  std::vector<int64_t> values(kBatchSize);
+  // Every fourth row is null.
+  std::vector<uint64_t> nulls(bits::nwords(kBatchSize), ~0UL);
+  for (int32_t i = 0; i < kBatchSize; i += 4) {
+    bits::setNull(nulls.data(), i);
+  }
+  int64_t sum = 0;
+  int32_t numRead = 0;
+  while (numRead + kBatchSize + numSkipped <= kNumValues) {
+    decoder->next(
+        values.data(), kBatchSize, withNulls ? nulls.data() : nullptr);
+    sum += values[kBatchSize - 1];
+    numRead += withNulls ? kBatchSize * 3 / 4 : kBatchSize;
+    if (numSkipped > 0) {
+      decoder->skip(numSkipped);
+      numRead += numSkipped;
+    }
+  }
+  return sum;
+}
+
+void direct(uint32_t, uint32_t bitWidth) {
+  const std::vector<unsigned char>* bytes;
+  BENCHMARK_SUSPEND {
+    bytes = &directData(bitWidth);
+  }
+  folly::doNotOptimizeAway(decode(*bytes, 0, false));
+}
+
+void directWithNulls(uint32_t, uint32_t bitWidth) {
+  const std::vector<unsigned char>* bytes;
+  BENCHMARK_SUSPEND {
+    bytes = &directData(bitWidth);
+  }
+  folly::doNotOptimizeAway(decode(*bytes, 0, true));
+}
+
+void directSkip(uint32_t, uint32_t bitWidth) {
+  const std::vector<unsigned char>* bytes;
+  BENCHMARK_SUSPEND {
+    bytes = &directData(bitWidth);
+  }
+  folly::doNotOptimizeAway(decode(*bytes, 9 * kBatchSize, false));
+}
+
+void patched(uint32_t, uint32_t bitWidth) {
+  const std::vector<unsigned char>* bytes;
+  BENCHMARK_SUSPEND {
+    bytes = &patchedData(bitWidth);
+  }
+  folly::doNotOptimizeAway(decode(*bytes, 0, false));
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(direct, 1, 1);
+BENCHMARK_NAMED_PARAM(direct, 4, 4);
+BENCHMARK_NAMED_PARAM(direct, 7, 7);
+BENCHMARK_NAMED_PARAM(direct, 11, 11);
+BENCHMARK_NAMED_PARAM(direct, 16, 16);
+BENCHMARK_NAMED_PARAM(direct, 17, 17);
+BENCHMARK_NAMED_PARAM(direct, 24, 24);
+BENCHMARK_NAMED_PARAM(direct, 32, 32);
+BENCHMARK_NAMED_PARAM(direct, 48, 48);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(directWithNulls, 7, 7);
+BENCHMARK_NAMED_PARAM(directWithNulls, 17, 17);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(directSkip, 7, 7);
+BENCHMARK_NAMED_PARAM(directSkip, 17, 17);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(patched, 7, 7);
+BENCHMARK_NAMED_PARAM(patched, 17, 17);
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  folly::runBenchmarks();
+  return 0;
+}
@@ -15,6 +15,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <random>
 
 #include "velox/common/base/Nulls.h"
 #include "velox/dwio/common/IntDecoder.h"
@@ -673,6 +674,85 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+// Appends a DIRECT run of unsigned 'values' of 'bitWidth' bits to 'bytes'.
+void appendDirectRun(
+    const std::vector<uint64_t>& values,
+    uint32_t bitWidth,
+    std::vector<unsigned char>& bytes) {
+  uint32_t encodedWidth;
+  if (bitWidth <= 24) {
+    encodedWidth = bitWidth - 1;
+  } else if (bitWidth <= 32) {
+    encodedWidth = 24 + (bitWidth - 26) / 2;
+  } else {
+    encodedWidth = 28 + (bitWidth - 40) / 8;
+  }
+  const auto length = values.size() - 1;
+  bytes.push_back(0x40 | (encodedWidth << 1) | (length >> 8));
+  bytes.push_back(length & 0xff);
+  uint64_t numBits = 0;
+  for (auto value : values) {
+    for (int32_t bit = bitWidth - 1; bit >= 0; --bit, ++numBits) {
+      if (numBits % 8 == 0) {
+        bytes.push_back(0);
+      }
+      bytes.back() |= ((value >> bit) & 1) << (7 - numBits % 8);
+    }
+  }
+}
+
+TEST_F(RLEv2Test, directBitWidths) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  std::mt19937_64 rng(1);
+  std::vector<unsigned char> bytes;
+  std::vector<int64_t> expected;
+  for (uint32_t bitWidth :
+       {1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+        17, 18, 19, 20, 21, 22, 23, 24, 26, 28, 30, 32, 40, 48, 56, 64}) {
+    std::vector<uint64_t> values(100 + bitWidth * 5);
+    for (auto& value : values) {
+      value = bitWidth == 64 ? rng() : rng() & ((1UL << bitWidth) - 1);
+      expected.push_back(static_cast<int64_t>(value));
+    }
+    appendDirectRun(values, bitWidth, bytes);
+  }
+
+  // Small blocks make the runs span input buffers.
+  for (uint64_t blockSize : {7, 64, 0}) {
+    SCOPED_TRACE(fmt::format("blockSize {}", blockSize));
+    auto rle = createRleDecoder<false>(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            bytes.data(), bytes.size(), blockSize),
+        RleVersion_2,
+        *pool,
+        true /* doesn't matter */,
+        dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+    // Reads, reads with nulls and skips batches of varying sizes.
+    std::vector<int64_t> data(64);
+    std::vector<uint64_t> nulls(1);
+    size_t row = 0;
+    for (int32_t step = 0; row < expected.size(); ++step) {
+      const auto numRows =
+          std::min<size_t>(1 + step * 7 % 61, expected.size() - row);
+      if (step % 3 == 0) {
+        rle->skip(numRows);
+        row += numRows;
+        continue;
+      }
+      const bool withNulls = step % 3 == 2;
+      for (size_t i = 0; i < numRows; ++i) {
+        bits::setNull(nulls.data(), i, withNulls && i % 3 == 1);
+      }
+      rle->next(data.data(), numRows, withNulls ? nulls.data() : nullptr);
+      for (size_t i = 0; i < numRows; ++i) {
+        if (!bits::isBitNull(nulls.data(), i)) {
+          ASSERT_EQ(data[i], expected[row++]) << "at " << row;
+        }
+      }
+    }
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
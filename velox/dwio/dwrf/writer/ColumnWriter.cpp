@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,7 +36,8 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  auto localSelected = context_.getLocalSelectivityVector(slice->size());
+  auto& selected = localSelected.get();
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -1727,28 +1729,88 @@ class StructColumnWriter : public BaseColumnWriter {
 
   void flush(
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
-      std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
-    BaseColumnWriter::flush(encodingFactory, encodingOverride);
-    for (auto& c : children_) {
-      c->flush(encodingFactory);
-    }
-  }
+      std::function<void(proto::ColumnEncoding&)> encodingOverride) override;
+
+  /// Makes the root writer encode its children on the encoding executor of
+  /// the context, if any. Called once the children are created.
+  void prepareParallelEncoding();
 
  private:
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  // Set for the root if its children are encoded in parallel.
+  std::unique_ptr<dwio::common::ParallelFor> parallelForOnChildren_;
 };
 
+void StructColumnWriter::prepareParallelEncoding() {
+  VELOX_CHECK(isRoot());
+  const auto parallelismFactor = context_.encodingParallelismFactor();
+  if (parallelismFactor <= 1 || children_.size() <= 1) {
+    return;
+  }
+  for (const auto& child : children_) {
+    if (child->isFlatMap()) {
+      return;
+    }
+  }
+  parallelForOnChildren_ = std::make_unique<dwio::common::ParallelFor>(
+      context_.encodingExecutor(), 0, children_.size(), parallelismFactor);
+}
+
+void StructColumnWriter::flush(
+    std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
+    std::function<void(proto::ColumnEncoding&)> encodingOverride) {
+  BaseColumnWriter::flush(encodingFactory, encodingOverride);
+  if (parallelForOnChildren_ == nullptr) {
+    for (auto& c : children_) {
+      c->flush(encodingFactory);
+    }
+    return;
+  }
+  // The children flush their encoders and compress their streams in
+  // parallel. Their encodings are collected per child and added to the footer
+  // in the order of a serial flush so that the output does not depend on the
+  // scheduling.
+  std::vector<std::vector<
+      std::pair<uint32_t, std::unique_ptr<proto::ColumnEncoding>>>>
+      childEncodings(children_.size());
+  parallelForOnChildren_->execute([&](size_t i) {
+    auto& encodings = childEncodings[i];
+    children_[i]->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
+      return *encodings
+                  .emplace_back(
+                      nodeId, std::make_unique<proto::ColumnEncoding>())
+                  .second;
+    });
+  });
+  for (const auto& encodings : childEncodings) {
+    for (const auto& [nodeId, encoding] : encodings) {
+      encodingFactory(nodeId).CopyFrom(*encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (parallelForOnChildren_ != nullptr) {
+      std::vector<uint64_t> childRawSizes(children_.size());
+      parallelForOnChildren_->execute([&](size_t i) {
+        childRawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+      });
+      for (auto childRawSize : childRawSizes) {
+        rawSize += childRawSize;
+      }
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
@@ -2185,6 +2247,9 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
       for (int32_t i = 0; i < type.size(); ++i) {
         ret->children_.push_back(create(context, *type.childAt(i), sequence));
       }
+      if (ret->isRoot()) {
+        ret->prepareParallelEncoding();
+      }
       return ret;
     }
     case TypeKind::MAP: {
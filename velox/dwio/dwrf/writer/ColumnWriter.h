@@ -147,6 +147,12 @@ class BaseColumnWriter : public ColumnWriter {
     return type_;
   }
 
+  /// True for writers of flat maps. These create column writers while
+  /// writing and are not encoded in parallel with other columns.
+  virtual bool isFlatMap() const {
+    return false;
+  }
+
   static std::unique_ptr<BaseColumnWriter> create(
       WriterContext& context,
       const dwio::common::TypeWithId& type,
@@ -273,6 +273,10 @@ class FlatMapColumnWriter : public BaseColumnWriter {
 
   void reset() override;
 
+  bool isFlatMap() const override {
+    return true;
+  }
+
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
                               statsFactory) const override;
 
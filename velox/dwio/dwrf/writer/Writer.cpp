@@ -183,6 +183,8 @@ Writer::Writer(
       "Unexpected memory usage on dwrf writer construction");
   setMemoryReclaimers(pool);
   writerBase_->initBuffers();
+  context.setEncodingExecutor(
+      options.encodingExecutor, options.encodingParallelismFactor);
 
   context.buildPhysicalSizeAggregators(*schema_);
   if (options.flushPolicyFactory == nullptr) {
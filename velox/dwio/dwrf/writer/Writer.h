@@ -45,6 +45,13 @@ struct WriterOptions : public dwio::common::WriterOptions {
   const tz::TimeZone* sessionTimezone{nullptr};
   bool adjustTimestampToTimezone{false};
   DwrfFormat format{DwrfFormat::kDwrf};
+  /// If set with a parallelism factor above 1, the top level columns of each
+  /// write batch are encoded and compressed in parallel on this executor and
+  /// the calling thread, as are their streams at stripe flush. The output is
+  /// the same as with serial encoding. Not used with flat maps or
+  /// encryption.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 
   void processConfigs(
       const config::ConfigBase& connectorConfig,
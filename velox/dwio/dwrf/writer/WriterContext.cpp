@@ -95,11 +95,34 @@ void WriterContext::validateConfigs() const {
 }
 
 void WriterContext::initBuffer() {
-  VELOX_CHECK_NULL(compressionBuffer_);
+  VELOX_CHECK(compressionBuffers_.empty());
   if (compression_ != common::CompressionKind_NONE) {
-    compressionBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
+    compressionBuffers_.push_back(
+        std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE));
+  }
+}
+
+std::unique_ptr<dwio::common::DataBuffer<char>> WriterContext::getBuffer(
+    uint64_t size) {
+  std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(
+        !compressionBuffers_.empty() || encodingParallelismFactor() > 1,
+        "No free compression buffer");
+    if (!compressionBuffers_.empty()) {
+      buffer = std::move(compressionBuffers_.back());
+      compressionBuffers_.pop_back();
+    }
+  }
+  if (buffer == nullptr) {
+    // Allocates outside of the mutex since this may trigger arbitration.
+    buffer = std::make_unique<dwio::common::DataBuffer<char>>(
         *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
   }
+  VELOX_CHECK_GE(buffer->size(), size);
+  return buffer;
 }
 
 memory::MemoryPool& WriterContext::getMemoryPool(
@@ -158,13 +181,14 @@ int64_t WriterContext::releaseMemoryReservation() {
 }
 
 void WriterContext::abort() {
-  compressionBuffer_.reset();
+  compressionBuffers_.clear();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
   decodedVectorPool_.clear();
   decodedVectorPool_.shrink_to_fit();
-  selectivityVector_.reset();
+  selectivityVectorPool_.clear();
+  selectivityVectorPool_.shrink_to_fit();
   releaseMemoryReservation();
 }
 } // namespace facebook::velox::dwrf
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -73,23 +75,25 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(
-        !hasStream(stream), "Stream already exists: {}", stream.toString());
-
-    streams_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(stream),
-        std::forward_as_tuple(
-            getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
-            compressionBlockSize(),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
-    auto& holder = streams_.at(stream);
+    DataBufferHolder* holder;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      auto [it, inserted] = streams_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(stream),
+          std::forward_as_tuple(
+              getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
+              compressionBlockSize(),
+              getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
+              getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
+      VELOX_CHECK(inserted, "Stream already exists: {}", stream.toString());
+      holder = &it->second;
+    }
     auto encrypter = handler_->isEncrypted(stream.encodingKey().node())
         ? std::addressof(
               handler_->getEncryptionProvider(stream.encodingKey().node()))
         : nullptr;
-    return newStream(compression_, holder, encrypter);
+    return newStream(compression_, *holder, encrypter);
   }
 
   std::unique_ptr<DataBufferHolder> newDataBufferHolder(
@@ -145,9 +149,10 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(hasStream(stream));
-    auto& collector = streams_.at(stream);
-    collector.suppress();
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = streams_.find(stream);
+    VELOX_CHECK(it != streams_.end());
+    it->second.suppress();
   }
 
   bool isStreamPaged(uint32_t nodeId) const {
@@ -256,18 +261,16 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns a free compression buffer. A new buffer is allocated when all
+  /// buffers are in use by columns compressing in parallel.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
-      uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
-  }
+      uint64_t size) override;
 
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+    std::lock_guard<std::mutex> l(mutex_);
+    compressionBuffers_.push_back(std::move(buffer));
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -582,19 +585,65 @@ class WriterContext : public CompressionBufferPool {
     return LocalDecodedVector{*this};
   }
 
-  SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
-    if (FOLLY_UNLIKELY(selectivityVector_ == nullptr)) {
-      selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
-    } else {
-      selectivityVector_->resize(size);
+  class LocalSelectivityVector {
+   public:
+    LocalSelectivityVector(WriterContext& context, vector_size_t size)
+        : context_(context), vector_(context_.getSelectivityVector()) {
+      vector_->resize(size);
+    }
+
+    LocalSelectivityVector(LocalSelectivityVector&& other) noexcept
+        : context_{other.context_}, vector_{std::move(other.vector_)} {}
+
+    LocalSelectivityVector& operator=(LocalSelectivityVector&& other) =
+        delete;
+
+    ~LocalSelectivityVector() {
+      if (vector_) {
+        context_.releaseSelectivityVector(std::move(vector_));
+      }
+    }
+
+    SelectivityVector& get() {
+      return *vector_;
     }
-    return *selectivityVector_;
+
+   private:
+    WriterContext& context_;
+    std::unique_ptr<velox::SelectivityVector> vector_;
+  };
+
+  LocalSelectivityVector getLocalSelectivityVector(vector_size_t size) {
+    return LocalSelectivityVector{*this, size};
+  }
+
+  /// Sets the executor on which the root column writer encodes its children
+  /// in parallel. Must be called before the column writers are created.
+  /// 'parallelismFactor' is the number of threads, including the calling
+  /// thread. Parallel encoding is disabled if the executor is null, if the
+  /// factor is at most 1 or if the file is encrypted.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  const std::shared_ptr<folly::Executor>& encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingExecutor_ == nullptr || handler_->isEncrypted()
+        ? 0
+        : encodingParallelismFactor_;
   }
 
   void abort();
 
   dwio::common::DataBuffer<char>* testingCompressionBuffer() const {
-    return compressionBuffer_.get();
+    return compressionBuffers_.empty() ? nullptr
+                                       : compressionBuffers_.front().get();
   }
 
   const tz::TimeZone* sessionTimezone() const {
@@ -609,6 +658,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(mutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -618,9 +668,26 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
+  std::unique_ptr<velox::SelectivityVector> getSelectivityVector() {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (selectivityVectorPool_.empty()) {
+      return std::make_unique<velox::SelectivityVector>();
+    }
+    auto vector = std::move(selectivityVectorPool_.back());
+    selectivityVectorPool_.pop_back();
+    return vector;
+  }
+
+  void releaseSelectivityVector(
+      std::unique_ptr<velox::SelectivityVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
+    selectivityVectorPool_.push_back(std::move(vector));
+  }
+
   const std::shared_ptr<const Config> config_;
   const std::shared_ptr<memory::MemoryPool> pool_;
   const std::shared_ptr<memory::MemoryPool> dictionaryPool_;
@@ -658,11 +725,21 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
-  std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelismFactor_{0};
+
+  // Serializes the access of column writers encoding in parallel to
+  // 'streams_' and the pools below.
+  mutable std::mutex mutex_;
+  // Free compression buffers. There is one per column writer compressing at
+  // the same time.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      compressionBuffers_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
-  // Reusable SelectivityVector
-  std::unique_ptr<velox::SelectivityVector> selectivityVector_;
+  // A pool of reusable SelectivityVectors.
+  std::vector<std::unique_ptr<velox::SelectivityVector>>
+      selectivityVectorPool_;
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
@@ -0,0 +1,1041 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/json/reader/JsonReader.h"
+
+#include <cctype>
+
+#include <folly/Conv.h>
+
+#include "velox/common/encode/Base64.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::json {
+
+using dwio::common::Mutation;
+using dwio::common::RowReaderOptions;
+
+namespace {
+
+using JsonType = simdjson::ondemand::json_type;
+
+constexpr char kNewLine = '\n';
+
+void checkJson(simdjson::error_code error) {
+  if (error != simdjson::SUCCESS) {
+    VELOX_USER_FAIL(
+        "Malformed JSON record: {}", simdjson::error_message(error));
+  }
+}
+
+void checkSupportedType(const std::string& name, const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return;
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+    case TypeKind::ROW:
+      for (auto i = 0; i < type->size(); ++i) {
+        checkSupportedType(name, type->childAt(i));
+      }
+      return;
+    case TypeKind::BIGINT:
+      if (!type->isDecimal()) {
+        return;
+      }
+      [[fallthrough]];
+    default:
+      VELOX_NYI(
+          "Column {} of type {} is not supported yet in JsonReader",
+          name,
+          type->toString());
+  }
+}
+
+// True if the line has only white space, e.g. the carriage return of a
+// Windows line end. Such lines are not records.
+bool isBlank(const char* data, int32_t size) {
+  for (int32_t i = 0; i < size; ++i) {
+    const char c = data[i];
+    if (c != ' ' && c != '\t' && c != '\r') {
+      return false;
+    }
+  }
+  return true;
+}
+
+BufferPtr buildNulls(
+    const std::vector<bool>& nulls,
+    memory::MemoryPool& pool) {
+  BufferPtr result;
+  for (vector_size_t i = 0; i < nulls.size(); ++i) {
+    if (nulls[i]) {
+      if (result == nullptr) {
+        result = allocateNulls(nulls.size(), &pool);
+      }
+      bits::setNull(result->asMutable<uint64_t>(), i);
+    }
+  }
+  return result;
+}
+
+BufferPtr buildIndices(
+    const std::vector<vector_size_t>& values,
+    memory::MemoryPool& pool) {
+  auto result = allocateIndices(values.size(), &pool);
+  if (!values.empty()) {
+    std::memcpy(
+        result->asMutable<vector_size_t>(),
+        values.data(),
+        values.size() * sizeof(vector_size_t));
+  }
+  return result;
+}
+
+} // namespace
+
+namespace detail {
+
+// Accumulates the values of a column or nested field of consecutive records.
+class ColumnBuilder {
+ public:
+  ColumnBuilder(TypePtr type, memory::MemoryPool& pool)
+      : type_(std::move(type)), pool_(pool) {}
+
+  virtual ~ColumnBuilder() = default;
+
+  // Appends 'value'. Nulls and values that cannot be converted to the type of
+  // the column are appended as null.
+  virtual void append(simdjson::ondemand::value& value) = 0;
+
+  // Appends a value given as text. Used for map keys.
+  virtual void appendText(std::string_view text) = 0;
+
+  virtual void appendNull() = 0;
+
+  virtual bool isNullAt(vector_size_t index) const = 0;
+
+  // Returns true if the value at 'index' passes 'filter'. Only supported for
+  // scalar types.
+  virtual bool testFilter(const common::Filter& filter, vector_size_t index)
+      const {
+    VELOX_UNSUPPORTED("Filter on {} while parsing JSON", type_->toString());
+  }
+
+  // Drops the values at and after 'size'.
+  virtual void truncate(vector_size_t size) = 0;
+
+  vector_size_t size() const {
+    return size_;
+  }
+
+  // Returns the appended values and resets the builder.
+  virtual VectorPtr finish() = 0;
+
+ protected:
+  const TypePtr type_;
+  memory::MemoryPool& pool_;
+  vector_size_t size_{0};
+};
+
+std::unique_ptr<ColumnBuilder> createBuilder(
+    const TypePtr& type,
+    const common::ScanSpec* spec,
+    memory::MemoryPool& pool);
+
+namespace {
+
+template <TypeKind kKind>
+class ScalarBuilder : public ColumnBuilder {
+ public:
+  using T = typename TypeTraits<kKind>::NativeType;
+
+  ScalarBuilder(TypePtr type, memory::MemoryPool& pool)
+      : ColumnBuilder(std::move(type), pool) {
+    reset();
+  }
+
+  void append(simdjson::ondemand::value& value) override {
+    const auto index = reserve();
+    if (!parse(value, index)) {
+      flat_->setNull(index, true);
+    }
+  }
+
+  void appendText(std::string_view text) override {
+    const auto index = reserve();
+    if (!parseText(text, index)) {
+      flat_->setNull(index, true);
+    }
+  }
+
+  void appendNull() override {
+    flat_->setNull(reserve(), true);
+  }
+
+  bool isNullAt(vector_size_t index) const override {
+    return flat_->isNullAt(index);
+  }
+
+  bool testFilter(const common::Filter& filter, vector_size_t index)
+      const override {
+    if (flat_->isNullAt(index)) {
+      return filter.testNull();
+    }
+    return applyFilter(filter, flat_->valueAtFast(index));
+  }
+
+  void truncate(vector_size_t size) override {
+    size_ = std::min(size_, size);
+  }
+
+  VectorPtr finish() override {
+    vector_->resize(size_);
+    auto result = std::move(vector_);
+    reset();
+    return result;
+  }
+
+ private:
+  static constexpr vector_size_t kInitialCapacity = 16;
+
+  void reset() {
+    vector_ = BaseVector::create(type_, kInitialCapacity, &pool_);
+    flat_ = vector_->asUnchecked<FlatVector<T>>();
+    size_ = 0;
+  }
+
+  vector_size_t reserve() {
+    if (size_ == vector_->size()) {
+      vector_->resize(2 * size_);
+    }
+    // A truncated value may have left a null at this position.
+    flat_->setNull(size_, false);
+    return size_++;
+  }
+
+  bool parse(simdjson::ondemand::value& value, vector_size_t index) {
+    JsonType type;
+    checkJson(value.type().get(type));
+    if (type == JsonType::null) {
+      return false;
+    }
+    if (type == JsonType::string) {
+      std::string_view text;
+      checkJson(value.get_string().get(text));
+      return parseText(text, index);
+    }
+    if constexpr (kKind == TypeKind::BOOLEAN) {
+      bool result;
+      if (type != JsonType::boolean || value.get_bool().get(result)) {
+        return false;
+      }
+      flat_->set(index, result);
+      return true;
+    } else if constexpr (
+        kKind == TypeKind::TINYINT || kKind == TypeKind::SMALLINT ||
+        kKind == TypeKind::INTEGER || kKind == TypeKind::BIGINT) {
+      // Date columns take the number of days since the epoch.
+      int64_t result;
+      if (type != JsonType::number || value.get_int64().get(result) ||
+          result < std::numeric_limits<T>::min() ||
+          result > std::numeric_limits<T>::max()) {
+        return false;
+      }
+      flat_->set(index, static_cast<T>(result));
+      return true;
+    } else if constexpr (kKind == TypeKind::REAL || kKind == TypeKind::DOUBLE) {
+      double result;
+      if (type != JsonType::number || value.get_double().get(result)) {
+        return false;
+      }
+      flat_->set(index, static_cast<T>(result));
+      return true;
+    } else if constexpr (kKind == TypeKind::VARCHAR) {
+      // Numbers, booleans and nested values are read as their JSON text.
+      std::string_view text;
+      if (type == JsonType::object || type == JsonType::array) {
+        checkJson(value.raw_json().get(text));
+      } else {
+        text = value.raw_json_token();
+        while (!text.empty() &&
+               std::isspace(static_cast<unsigned char>(text.back()))) {
+          text.remove_suffix(1);
+        }
+      }
+      flat_->set(index, StringView(text.data(), text.size()));
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  bool parseText(std::string_view text, vector_size_t index) {
+    if constexpr (kKind == TypeKind::VARCHAR) {
+      flat_->set(index, StringView(text.data(), text.size()));
+      return true;
+    } else if constexpr (kKind == TypeKind::VARBINARY) {
+      const auto decoded = encoding::Base64::decode(
+          folly::StringPiece(text.data(), text.size()));
+      flat_->set(index, StringView(decoded));
+      return true;
+    } else if constexpr (kKind == TypeKind::BOOLEAN) {
+      if (text.size() == 4 && strncasecmp(text.data(), "true", 4) == 0) {
+        flat_->set(index, true);
+        return true;
+      }
+      if (text.size() == 5 && strncasecmp(text.data(), "false", 5) == 0) {
+        flat_->set(index, false);
+        return true;
+      }
+      return false;
+    } else if constexpr (kKind == TypeKind::TIMESTAMP) {
+      auto timestamp = util::fromTimestampString(
+          text.data(), text.size(), util::TimestampParseMode::kPrestoCast);
+      if (timestamp.hasError()) {
+        return false;
+      }
+      flat_->set(index, timestamp.value());
+      return true;
+    } else if constexpr (
+        kKind == TypeKind::TINYINT || kKind == TypeKind::SMALLINT ||
+        kKind == TypeKind::INTEGER || kKind == TypeKind::BIGINT ||
+        kKind == TypeKind::REAL || kKind == TypeKind::DOUBLE) {
+      if constexpr (kKind == TypeKind::INTEGER) {
+        if (type_->isDate()) {
+          auto days = util::fromDateString(
+              text.data(), text.size(), util::ParseMode::kPrestoCast);
+          if (days.hasError()) {
+            return false;
+          }
+          flat_->set(index, days.value());
+          return true;
+        }
+      }
+      auto result =
+          folly::tryTo<T>(folly::StringPiece(text.data(), text.size()));
+      if (result.hasError()) {
+        return false;
+      }
+      flat_->set(index, result.value());
+      return true;
+    } else {
+      VELOX_UNREACHABLE("Unexpected type {} in JsonReader", kKind);
+    }
+  }
+
+  VectorPtr vector_;
+  FlatVector<T>* flat_;
+};
+
+class ArrayBuilder : public ColumnBuilder {
+ public:
+  ArrayBuilder(
+      TypePtr type,
+      const common::ScanSpec* spec,
+      memory::MemoryPool& pool)
+      : ColumnBuilder(std::move(type), pool),
+        elements_(createBuilder(
+            type_->childAt(0),
+            spec ? spec->childByName(common::ScanSpec::kArrayElementsFieldName)
+                 : nullptr,
+            pool)) {}
+
+  void append(simdjson::ondemand::value& value) override {
+    JsonType type;
+    checkJson(value.type().get(type));
+    if (type != JsonType::array) {
+      appendNull();
+      return;
+    }
+    simdjson::ondemand::array array;
+    checkJson(value.get_array().get(array));
+    const auto offset = elements_->size();
+    for (auto result : array) {
+      simdjson::ondemand::value element;
+      checkJson(result.get(element));
+      elements_->append(element);
+    }
+    appendEntry(offset, false);
+  }
+
+  void appendText(std::string_view /*text*/) override {
+    appendNull();
+  }
+
+  void appendNull() override {
+    appendEntry(elements_->size(), true);
+  }
+
+  bool isNullAt(vector_size_t index) const override {
+    return nulls_[index];
+  }
+
+  void truncate(vector_size_t size) override {
+    if (size >= size_) {
+      return;
+    }
+    elements_->truncate(offsets_[size]);
+    offsets_.resize(size);
+    sizes_.resize(size);
+    nulls_.resize(size);
+    size_ = size;
+  }
+
+  VectorPtr finish() override {
+    auto result = std::make_shared<ArrayVector>(
+        &pool_,
+        type_,
+        buildNulls(nulls_, pool_),
+        size_,
+        buildIndices(offsets_, pool_),
+        buildIndices(sizes_, pool_),
+        elements_->finish());
+    offsets_.clear();
+    sizes_.clear();
+    nulls_.clear();
+    size_ = 0;
+    return result;
+  }
+
+ private:
+  void appendEntry(vector_size_t offset, bool isNull) {
+    offsets_.push_back(offset);
+    sizes_.push_back(elements_->size() - offset);
+    nulls_.push_back(isNull);
+    ++size_;
+  }
+
+  const std::unique_ptr<ColumnBuilder> elements_;
+  std::vector<vector_size_t> offsets_;
+  std::vector<vector_size_t> sizes_;
+  std::vector<bool> nulls_;
+};
+
+class MapBuilder : public ColumnBuilder {
+ public:
+  MapBuilder(
+      TypePtr type,
+      const common::ScanSpec* spec,
+      memory::MemoryPool& pool)
+      : ColumnBuilder(std::move(type), pool),
+        keys_(createBuilder(
+            type_->childAt(0),
+            spec ? spec->childByName(common::ScanSpec::kMapKeysFieldName)
+                 : nullptr,
+            pool)),
+        values_(createBuilder(
+            type_->childAt(1),
+            spec ? spec->childByName(common::ScanSpec::kMapValuesFieldName)
+                 : nullptr,
+            pool)) {}
+
+  void append(simdjson::ondemand::value& value) override {
+    JsonType type;
+    checkJson(value.type().get(type));
+    if (type != JsonType::object) {
+      appendNull();
+      return;
+    }
+    simdjson::ondemand::object object;
+    checkJson(value.get_object().get(object));
+    const auto offset = keys_->size();
+    for (auto result : object) {
+      simdjson::ondemand::field field;
+      checkJson(result.get(field));
+      std::string_view key;
+      checkJson(field.unescaped_key().get(key));
+      const auto index = keys_->size();
+      keys_->appendText(key);
+      if (keys_->isNullAt(index)) {
+        // Map keys cannot be null. Entries whose key does not convert to the
+        // key type are dropped.
+        keys_->truncate(index);
+        continue;
+      }
+      values_->append(field.value());
+    }
+    appendEntry(offset, false);
+  }
+
+  void appendText(std::string_view /*text*/) override {
+    appendNull();
+  }
+
+  void appendNull() override {
+    appendEntry(keys_->size(), true);
+  }
+
+  bool isNullAt(vector_size_t index) const override {
+    return nulls_[index];
+  }
+
+  void truncate(vector_size_t size) override {
+    if (size >= size_) {
+      return;
+    }
+    keys_->truncate(offsets_[size]);
+    values_->truncate(offsets_[size]);
+    offsets_.resize(size);
+    sizes_.resize(size);
+    nulls_.resize(size);
+    size_ = size;
+  }
+
+  VectorPtr finish() override {
+    auto result = std::make_shared<MapVector>(
+        &pool_,
+        type_,
+        buildNulls(nulls_, pool_),
+        size_,
+        buildIndices(offsets_, pool_),
+        buildIndices(sizes_, pool_),
+        keys_->finish(),
+        values_->finish());
+    offsets_.clear();
+    sizes_.clear();
+    nulls_.clear();
+    size_ = 0;
+    return result;
+  }
+
+ private:
+  void appendEntry(vector_size_t offset, bool isNull) {
+    offsets_.push_back(offset);
+    sizes_.push_back(keys_->size() - offset);
+    nulls_.push_back(isNull);
+    ++size_;
+  }
+
+  const std::unique_ptr<ColumnBuilder> keys_;
+  const std::unique_ptr<ColumnBuilder> values_;
+  std::vector<vector_size_t> offsets_;
+  std::vector<vector_size_t> sizes_;
+  std::vector<bool> nulls_;
+};
+
+// Builds the fields of a struct that are referenced by its scan spec. The
+// other fields are returned as nulls without being parsed. A scan spec without
+// children selects all fields.
+class RowBuilder : public ColumnBuilder {
+ public:
+  RowBuilder(
+      TypePtr type,
+      const common::ScanSpec* spec,
+      memory::MemoryPool& pool)
+      : ColumnBuilder(std::move(type), pool) {
+    const auto& rowType = type_->asRow();
+    const bool allChildren = spec == nullptr || spec->children().empty();
+    children_.resize(rowType.size());
+    childSeen_.resize(rowType.size());
+    for (auto i = 0; i < rowType.size(); ++i) {
+      const auto* childSpec =
+          spec ? spec->childByName(rowType.nameOf(i)) : nullptr;
+      if (!allChildren && childSpec == nullptr) {
+        continue;
+      }
+      children_[i] = createBuilder(rowType.childAt(i), childSpec, pool);
+      childIndices_.emplace(rowType.nameOf(i), i);
+    }
+  }
+
+  void append(simdjson::ondemand::value& value) override {
+    JsonType type;
+    checkJson(value.type().get(type));
+    if (type != JsonType::object) {
+      appendNull();
+      return;
+    }
+    simdjson::ondemand::object object;
+    checkJson(value.get_object().get(object));
+    std::fill(childSeen_.begin(), childSeen_.end(), false);
+    for (auto result : object) {
+      simdjson::ondemand::field field;
+      checkJson(result.get(field));
+      std::string_view key;
+      checkJson(field.unescaped_key().get(key));
+      auto it = childIndices_.find(key);
+      if (it == childIndices_.end() || childSeen_[it->second]) {
+        continue;
+      }
+      childSeen_[it->second] = true;
+      children_[it->second]->append(field.value());
+    }
+    for (auto i = 0; i < children_.size(); ++i) {
+      if (children_[i] != nullptr && !childSeen_[i]) {
+        children_[i]->appendNull();
+      }
+    }
+    nulls_.push_back(false);
+    ++size_;
+  }
+
+  void appendText(std::string_view /*text*/) override {
+    appendNull();
+  }
+
+  void appendNull() override {
+    for (auto& child : children_) {
+      if (child != nullptr) {
+        child->appendNull();
+      }
+    }
+    nulls_.push_back(true);
+    ++size_;
+  }
+
+  bool isNullAt(vector_size_t index) const override {
+    return nulls_[index];
+  }
+
+  void truncate(vector_size_t size) override {
+    if (size >= size_) {
+      return;
+    }
+    for (auto& child : children_) {
+      if (child != nullptr) {
+        child->truncate(size);
+      }
+    }
+    nulls_.resize(size);
+    size_ = size;
+  }
+
+  VectorPtr finish() override {
+    std::vector<VectorPtr> children(children_.size());
+    for (auto i = 0; i < children_.size(); ++i) {
+      children[i] = children_[i] != nullptr
+          ? children_[i]->finish()
+          : BaseVector::createNullConstant(type_->childAt(i), size_, &pool_);
+    }
+    auto result = std::make_shared<RowVector>(
+        &pool_, type_, buildNulls(nulls_, pool_), size_, std::move(children));
+    nulls_.clear();
+    size_ = 0;
+    return result;
+  }
+
+ private:
+  std::vector<std::unique_ptr<ColumnBuilder>> children_;
+  folly::F14FastMap<std::string, int32_t> childIndices_;
+  std::vector<bool> childSeen_;
+  std::vector<bool> nulls_;
+};
+
+template <TypeKind kKind>
+std::unique_ptr<ColumnBuilder> createScalarBuilder(
+    const TypePtr& type,
+    memory::MemoryPool& pool) {
+  return std::make_unique<ScalarBuilder<kKind>>(type, pool);
+}
+
+} // namespace
+
+std::unique_ptr<ColumnBuilder> createBuilder(
+    const TypePtr& type,
+    const common::ScanSpec* spec,
+    memory::MemoryPool& pool) {
+  switch (type->kind()) {
+    case TypeKind::ARRAY:
+      return std::make_unique<ArrayBuilder>(type, spec, pool);
+    case TypeKind::MAP:
+      return std::make_unique<MapBuilder>(type, spec, pool);
+    case TypeKind::ROW:
+      return std::make_unique<RowBuilder>(type, spec, pool);
+    default:
+      return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          createScalarBuilder, type->kind(), type, pool);
+  }
+}
+
+} // namespace detail
+
+JsonRowReader::JsonRowReader(
+    std::shared_ptr<dwio::common::BufferedInput> input,
+    RowTypePtr fileType,
+    memory::MemoryPool& pool,
+    const RowReaderOptions& options)
+    : input_(std::move(input)),
+      fileType_(std::move(fileType)),
+      pool_(pool),
+      options_(options),
+      scanSpec_(options_.scanSpec()) {
+  VELOX_CHECK(
+      !options_.rowNumberColumnInfo().has_value(),
+      "Row number column is not supported by JsonReader");
+  if (!scanSpec_) {
+    scanSpec_ = std::make_shared<common::ScanSpec>("root");
+    scanSpec_->addAllChildFields(*fileType_);
+  }
+  for (const auto& child : scanSpec_->children()) {
+    if (child->isConstant()) {
+      continue;
+    }
+    VELOX_CHECK(
+        child->columnType() == common::ScanSpec::ColumnType::kRegular,
+        "Column {} of non-regular column type is not supported by JsonReader",
+        child->fieldName());
+    const auto index = fileType_->getChildIdxIfExists(child->fieldName());
+    VELOX_CHECK(
+        index.has_value(),
+        "Column {} is not in the JSON file schema {}",
+        child->fieldName(),
+        fileType_->toString());
+    const auto& type = fileType_->childAt(index.value());
+    checkSupportedType(child->fieldName(), type);
+    Column column;
+    column.spec = child.get();
+    column.builder = detail::createBuilder(type, child.get(), pool_);
+    if (type->isPrimitiveType()) {
+      column.filter = child->filter();
+    } else {
+      column.hasVectorFilter = child->hasFilter();
+    }
+    columnIndices_.emplace(child->fieldName(), columns_.size());
+    columns_.push_back(std::move(column));
+  }
+  columnSeen_.resize(columns_.size());
+}
+
+JsonRowReader::~JsonRowReader() = default;
+
+int64_t JsonRowReader::nextRowNumber() {
+  return atEnd_ ? kAtEnd : rowsRead_;
+}
+
+int64_t JsonRowReader::nextReadSize(uint64_t size) {
+  return atEnd_ ? kAtEnd : size;
+}
+
+std::optional<size_t> JsonRowReader::estimatedRowSize() const {
+  if (rowsRead_ == 0) {
+    return std::nullopt;
+  }
+  return bytesRead_ / rowsRead_;
+}
+
+void JsonRowReader::initialize() {
+  initialized_ = true;
+  const uint64_t fileLength = input_->getReadFile()->size();
+  const uint64_t splitStart = options_.offset();
+  splitEnd_ = std::min(options_.limit(), fileLength);
+  if (splitStart >= splitEnd_) {
+    atEnd_ = true;
+    return;
+  }
+  // A split that starts inside the file begins after the first new line at
+  // or after 'splitStart' - 1, see TextRowReader.
+  const uint64_t readStart = splitStart == 0 ? 0 : splitStart - 1;
+  stream_ = input_->read(
+      readStart, fileLength - readStart, dwio::common::LogType::STREAM);
+  dataFileOffset_ = readStart;
+  if (splitStart > 0) {
+    if (!skipLine()) {
+      atEnd_ = true;
+    }
+    return;
+  }
+  for (uint64_t i = 0; i < options_.skipRows(); ++i) {
+    if (!skipLine()) {
+      atEnd_ = true;
+      return;
+    }
+  }
+}
+
+bool JsonRowReader::readMore() {
+  if (streamAtEnd_) {
+    return false;
+  }
+  const void* chunk;
+  int32_t size;
+  if (!stream_->Next(&chunk, &size)) {
+    streamAtEnd_ = true;
+    return false;
+  }
+  bytesRead_ += size;
+  const int32_t newSize = dataSize_ + size;
+  // simdjson may read up to SIMDJSON_PADDING bytes past the end of a record.
+  const int64_t required = newSize + SIMDJSON_PADDING;
+  if (data_ == nullptr || data_->capacity() < required) {
+    const int64_t capacity = std::max<int64_t>(
+        required, data_ == nullptr ? 0 : 2 * data_->capacity());
+    auto newData = AlignedBuffer::allocate<char>(capacity, &pool_);
+    if (dataSize_ > 0) {
+      std::memcpy(newData->asMutable<char>(), data_->as<char>(), dataSize_);
+    }
+    data_ = std::move(newData);
+  }
+  std::memcpy(data_->asMutable<char>() + dataSize_, chunk, size);
+  dataSize_ = newSize;
+  data_->setSize(dataSize_);
+  return true;
+}
+
+void JsonRowReader::consume(int32_t offset) {
+  VELOX_DCHECK_LE(offset, dataSize_);
+  const int32_t remaining = dataSize_ - offset;
+  dataFileOffset_ += offset;
+  if (data_ == nullptr) {
+    return;
+  }
+  // Values are copied out of 'data_' while parsing, so the buffer is never
+  // shared with returned vectors.
+  if (remaining > 0 && offset > 0) {
+    std::memmove(
+        data_->asMutable<char>(), data_->as<char>() + offset, remaining);
+  }
+  dataSize_ = remaining;
+  data_->setSize(dataSize_);
+}
+
+int32_t JsonRowReader::findLineEnd(int32_t begin) {
+  int32_t searchFrom = begin;
+  for (;;) {
+    if (dataSize_ > searchFrom) {
+      const char* data = data_->as<char>();
+      const auto* found = static_cast<const char*>(
+          std::memchr(data + searchFrom, kNewLine, dataSize_ - searchFrom));
+      if (found != nullptr) {
+        return found - data;
+      }
+    }
+    searchFrom = dataSize_;
+    if (!readMore()) {
+      return dataSize_;
+    }
+  }
+}
+
+bool JsonRowReader::skipLine() {
+  const auto end = findLineEnd(0);
+  if (end == dataSize_) {
+    consume(dataSize_);
+    return false;
+  }
+  consume(end + 1);
+  return true;
+}
+
+bool JsonRowReader::parseRecord(int32_t begin, int32_t end) {
+  if (columns_.empty()) {
+    return true;
+  }
+  const char* data = data_->as<char>() + begin;
+  simdjson::ondemand::document document;
+  checkJson(parser_.iterate(data, end - begin, data_->capacity() - begin)
+                .get(document));
+  simdjson::ondemand::object object;
+  checkJson(document.get_object().get(object));
+  std::fill(columnSeen_.begin(), columnSeen_.end(), false);
+  bool passed = true;
+  for (auto result : object) {
+    simdjson::ondemand::field field;
+    checkJson(result.get(field));
+    std::string_view key;
+    checkJson(field.unescaped_key().get(key));
+    auto it = columnIndices_.find(key);
+    if (it == columnIndices_.end() || columnSeen_[it->second]) {
+      continue;
+    }
+    columnSeen_[it->second] = true;
+    auto& column = columns_[it->second];
+    column.builder->append(field.value());
+    if (column.filter != nullptr &&
+        !column.builder->testFilter(*column.filter, numBuilt_)) {
+      // The remaining keys of the record are not parsed.
+      passed = false;
+      break;
+    }
+  }
+  for (auto i = 0; passed && i < columns_.size(); ++i) {
+    if (columnSeen_[i]) {
+      continue;
+    }
+    columns_[i].builder->appendNull();
+    if (columns_[i].filter != nullptr && !columns_[i].filter->testNull()) {
+      passed = false;
+    }
+  }
+  if (!passed) {
+    for (auto& column : columns_) {
+      column.builder->truncate(numBuilt_);
+    }
+    return false;
+  }
+  ++numBuilt_;
+  return true;
+}
+
+uint64_t JsonRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const Mutation* mutation) {
+  VELOX_CHECK_GT(size, 0);
+  if (!initialized_) {
+    initialize();
+  }
+  if (atEnd_) {
+    return 0;
+  }
+  const vector_size_t maxRows =
+      std::min<uint64_t>(size, std::numeric_limits<vector_size_t>::max());
+  vector_size_t numRows = 0;
+  int32_t lineBegin = 0;
+  while (numRows < maxRows) {
+    if (dataFileOffset_ + lineBegin >= splitEnd_) {
+      // Lines starting at or after the end of the split belong to the next
+      // split.
+      atEnd_ = true;
+      break;
+    }
+    const auto lineEnd = findLineEnd(lineBegin);
+    if (lineBegin == lineEnd && lineEnd == dataSize_) {
+      atEnd_ = true;
+      break;
+    }
+    if (!isBlank(data_->as<char>() + lineBegin, lineEnd - lineBegin)) {
+      const auto row = numRows++;
+      const bool deleted = mutation != nullptr &&
+          ((mutation->deletedRows != nullptr &&
+            bits::isBitSet(mutation->deletedRows, row)) ||
+           (mutation->randomSkip != nullptr &&
+            !mutation->randomSkip->testOne()));
+      if (!deleted) {
+        parseRecord(lineBegin, lineEnd);
+      }
+    }
+    if (lineEnd == dataSize_) {
+      // Last line of the file without a trailing new line.
+      lineBegin = dataSize_;
+      atEnd_ = true;
+      break;
+    }
+    lineBegin = lineEnd + 1;
+  }
+  consume(lineBegin);
+  if (numRows == 0) {
+    atEnd_ = true;
+    return 0;
+  }
+
+  std::vector<VectorPtr> columns(columns_.size());
+  for (auto i = 0; i < columns_.size(); ++i) {
+    columns[i] = columns_[i].builder->finish();
+  }
+  vector_size_t numPassed = numBuilt_;
+  numBuilt_ = 0;
+
+  // Filters on nested fields are applied to the materialized columns.
+  BufferPtr indices;
+  if (numPassed > 0) {
+    std::vector<uint64_t> passed(bits::nwords(numPassed), -1);
+    bool hasVectorFilter = false;
+    for (auto i = 0; i < columns_.size(); ++i) {
+      if (columns_[i].hasVectorFilter) {
+        columns_[i].spec->applyFilter(*columns[i], passed.data());
+        hasVectorFilter = true;
+      }
+    }
+    const auto numSelected =
+        hasVectorFilter ? bits::countBits(passed.data(), 0, numPassed)
+                        : numPassed;
+    if (numSelected < numPassed) {
+      indices = allocateIndices(numSelected, &pool_);
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      vector_size_t j = 0;
+      bits::forEachSetBit(passed.data(), 0, numPassed, [&](auto row) {
+        rawIndices[j++] = row;
+      });
+      numPassed = numSelected;
+    }
+  }
+
+  const auto& children = scanSpec_->children();
+  column_index_t numColumns = 0;
+  for (auto& child : children) {
+    if (child->projectOut()) {
+      numColumns = std::max(numColumns, child->channel() + 1);
+    }
+  }
+  std::vector<std::string> names(numColumns);
+  std::vector<TypePtr> types(numColumns);
+  std::vector<VectorPtr> outputs(numColumns);
+  for (auto& child : children) {
+    if (!child->projectOut()) {
+      continue;
+    }
+    const auto channel = child->channel();
+    names[channel] = child->fieldName();
+    if (child->isConstant()) {
+      types[channel] = child->constantValue()->type();
+      if (numPassed > 0) {
+        outputs[channel] = BaseVector::wrapInConstant(
+            numPassed, 0, child->constantValue());
+      }
+      continue;
+    }
+    auto& column = columns[columnIndices_.at(child->fieldName())];
+    types[channel] = column->type();
+    if (numPassed == 0) {
+      continue;
+    }
+    outputs[channel] = indices == nullptr
+        ? std::move(column)
+        : BaseVector::wrapInDictionary(
+              nullptr, indices, numPassed, std::move(column));
+  }
+
+  auto rowType = ROW(std::move(names), std::move(types));
+  if (numPassed == 0) {
+    result = RowVector::createEmpty(rowType, &pool_);
+  } else {
+    result = std::make_shared<RowVector>(
+        &pool_, rowType, nullptr, numPassed, std::move(outputs));
+  }
+  rowsRead_ += numRows;
+  return numRows;
+}
+
+JsonReader::JsonReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : input_(std::move(input)),
+      options_(options),
+      fileType_(options_.fileSchema()),
+      typeWithId_([&]() {
+        VELOX_USER_CHECK_NOT_NULL(
+            fileType_, "JsonReader requires the file schema to be set");
+        return dwio::common::TypeWithId::create(fileType_);
+      }()) {}
+
+std::unique_ptr<dwio::common::RowReader> JsonReader::createRowReader(
+    const RowReaderOptions& options) const {
+  return std::make_unique<JsonRowReader>(
+      input_, fileType_, options_.memoryPool(), options);
+}
+
+} // namespace facebook::velox::json
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/functions/prestosql/json/SIMDJsonWrapper.h"
+
+namespace facebook::velox::json {
+
+namespace detail {
+class ColumnBuilder;
+} // namespace detail
+
+/// Implements the RowReader interface for newline delimited JSON files, where
+/// each line holds one JSON object. Top level keys of the objects are matched
+/// to the columns of the file schema by name. Keys that are not in the schema
+/// are skipped and columns missing from an object are null.
+///
+/// A split covers the lines whose first byte lies in [offset, offset + length)
+/// of the row reader options, as in TextRowReader. Each line is parsed with
+/// the simdjson On Demand API, so only the values of the columns and nested
+/// fields referenced by the ScanSpec are materialized. Filters on top level
+/// scalar columns are evaluated as soon as the value is parsed and the rest of
+/// a record that fails them is not looked at.
+class JsonRowReader : public dwio::common::RowReader {
+ public:
+  JsonRowReader(
+      std::shared_ptr<dwio::common::BufferedInput> input,
+      RowTypePtr fileType,
+      memory::MemoryPool& pool,
+      const dwio::common::RowReaderOptions& options);
+
+  ~JsonRowReader() override;
+
+  /// Returns the number of records read from the split so far. Row numbers
+  /// are relative to the start of the split.
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  uint64_t next(
+      uint64_t size,
+      velox::VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& stats) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override;
+
+ private:
+  // A file column referenced by the scan spec.
+  struct Column {
+    const common::ScanSpec* spec;
+    std::unique_ptr<detail::ColumnBuilder> builder;
+    // Filter evaluated while parsing, set for scalar columns with a filter.
+    const common::Filter* filter{nullptr};
+    // True if the filters of the column can only be evaluated on the
+    // materialized vector, e.g. filters on nested fields.
+    bool hasVectorFilter{false};
+  };
+
+  // Opens the stream and positions it at the first line of the split.
+  void initialize();
+
+  // Appends the next chunk of the stream to 'data_'. Returns false at end of
+  // file.
+  bool readMore();
+
+  // Drops the bytes before 'offset' in 'data_'.
+  void consume(int32_t offset);
+
+  // Skips to the byte after the next new line. Returns false if the end of
+  // file is reached first.
+  bool skipLine();
+
+  // Finds the end of the line starting at 'begin', reading more data as
+  // needed. Returns the offset of the new line or 'dataSize_' at end of file.
+  int32_t findLineEnd(int32_t begin);
+
+  // Parses the record in [begin, end) of 'data_' into the column builders.
+  // Returns false and leaves the builders unchanged if the record does not
+  // pass the filters.
+  bool parseRecord(int32_t begin, int32_t end);
+
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const RowTypePtr fileType_;
+  memory::MemoryPool& pool_;
+  const dwio::common::RowReaderOptions options_;
+  std::shared_ptr<common::ScanSpec> scanSpec_;
+
+  std::vector<Column> columns_;
+  // Maps the top level keys of the records to indices in 'columns_'.
+  folly::F14FastMap<std::string, int32_t> columnIndices_;
+  // Marks the columns seen in the record being parsed. The first occurrence
+  // of a duplicate key wins.
+  std::vector<bool> columnSeen_;
+  // Number of records in the builders.
+  vector_size_t numBuilt_{0};
+
+  simdjson::ondemand::parser parser_;
+  std::unique_ptr<dwio::common::SeekableInputStream> stream_;
+  bool initialized_{false};
+  bool streamAtEnd_{false};
+  bool atEnd_{false};
+
+  // File offset one past the last byte a line of this split may start at.
+  uint64_t splitEnd_{0};
+  // Unconsumed bytes read from 'stream_', starting at a line boundary. The
+  // buffer always has SIMDJSON_PADDING bytes of capacity past 'dataSize_'.
+  BufferPtr data_;
+  int32_t dataSize_{0};
+  // File offset of the first byte of 'data_'.
+  uint64_t dataFileOffset_{0};
+
+  uint64_t rowsRead_{0};
+  uint64_t bytesRead_{0};
+};
+
+/// Implements the Reader interface for newline delimited JSON files. JSON
+/// files carry no schema, so the file schema must be set in the ReaderOptions.
+class JsonReader : public dwio::common::Reader {
+ public:
+  JsonReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  ~JsonReader() override = default;
+
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const RowTypePtr& rowType() const override {
+    return fileType_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const dwio::common::ReaderOptions options_;
+  const RowTypePtr fileType_;
+  const std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+};
+
+class JsonReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  JsonReaderFactory() : ReaderFactory(dwio::common::FileFormat::JSON) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<JsonReader>(std::move(input), options);
+  }
+};
+
+} // namespace facebook::velox::json
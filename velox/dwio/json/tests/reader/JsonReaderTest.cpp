@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/json/reader/JsonReader.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::json {
+namespace {
+
+class JsonReaderTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      const std::string& data,
+      const RowTypePtr& schema) {
+    dwio::common::ReaderOptions options(pool());
+    options.setFileSchema(schema);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), *pool());
+    return JsonReaderFactory().createReader(std::move(input), options);
+  }
+
+  // Reads all rows of the range [offset, offset + length) in batches of
+  // 'batchSize'.
+  RowVectorPtr read(
+      dwio::common::Reader& reader,
+      std::shared_ptr<common::ScanSpec> scanSpec,
+      uint64_t offset = 0,
+      uint64_t length = std::numeric_limits<uint64_t>::max(),
+      uint64_t batchSize = 1'000) {
+    dwio::common::RowReaderOptions options;
+    options.setScanSpec(std::move(scanSpec));
+    options.range(offset, length);
+    auto rowReader = reader.createRowReader(options);
+    RowVectorPtr result;
+    VectorPtr batch;
+    while (rowReader->next(batchSize, batch) > 0) {
+      if (result == nullptr) {
+        result = std::dynamic_pointer_cast<RowVector>(
+            BaseVector::create(batch->type(), 0, pool()));
+      }
+      result->append(batch.get());
+    }
+    EXPECT_EQ(rowReader->nextRowNumber(), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+
+  static std::shared_ptr<common::ScanSpec> makeScanSpec(const RowType& type) {
+    auto scanSpec = std::make_shared<common::ScanSpec>("root");
+    scanSpec->addAllChildFields(type);
+    return scanSpec;
+  }
+};
+
+TEST_F(JsonReaderTest, types) {
+  auto schema = ROW(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6"},
+      {BOOLEAN(),
+       SMALLINT(),
+       BIGINT(),
+       DOUBLE(),
+       VARCHAR(),
+       DATE(),
+       TIMESTAMP()});
+  auto reader = createReader(
+      R"({"c0": true, "c1": 1, "c2": 10000000000, "c3": 1.5, "c4": "hello",)"
+      R"( "c5": "2024-01-31", "c6": "2024-01-31 01:02:03.004"})"
+      "\n"
+      R"({"c6": null, "c4": 12.50, "c3": "NaN", "c1": 70000, "c0": "FALSE",)"
+      R"( "c2": "42", "c5": 3, "extra": {"a": [1, 2]}})"
+      "\r\n"
+      "\n"
+      R"({"c4": {"a": [1, "x"]}, "c2": 1.5, "c0": 1})",
+      schema);
+  auto result = read(*reader, makeScanSpec(*schema));
+  auto expected = makeRowVector(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6"},
+      {
+          makeNullableFlatVector<bool>({true, false, std::nullopt}),
+          makeNullableFlatVector<int16_t>({1, std::nullopt, std::nullopt}),
+          makeNullableFlatVector<int64_t>({10'000'000'000, 42, std::nullopt}),
+          makeNullableFlatVector<double>(
+              {1.5, std::numeric_limits<double>::quiet_NaN(), std::nullopt}),
+          makeNullableFlatVector<std::string>(
+              {"hello", "12.50", R"({"a": [1, "x"]})"}),
+          makeNullableFlatVector<int32_t>({19'753, 3, std::nullopt}, DATE()),
+          makeNullableFlatVector<Timestamp>(
+              {Timestamp(1'706'662'923, 4'000'000),
+               std::nullopt,
+               std::nullopt}),
+      });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(JsonReaderTest, complexTypes) {
+  auto schema = ROW(
+      {"a", "m", "s"},
+      {ARRAY(BIGINT()),
+       MAP(VARCHAR(), DOUBLE()),
+       ROW({"x", "y"}, {BIGINT(), ARRAY(VARCHAR())})});
+  auto reader = createReader(
+      R"({"a": [1, null, 3], "m": {"k1": 1.5, "k2": null}, )"
+      R"("s": {"y": ["p", "q"], "x": 7}})"
+      "\n"
+      R"({"a": null, "m": [], "s": {"x": 8}})"
+      "\n"
+      R"({"a": [], "m": {}, "s": null})"
+      "\n",
+      schema);
+  auto result = read(*reader, makeScanSpec(*schema));
+  auto expected = makeRowVector(
+      {"a", "m", "s"},
+      {
+          makeNullableArrayVector<int64_t>(
+              {{{1, std::nullopt, 3}}, std::nullopt, {{}}}),
+          makeNullableMapVector<std::string, double>(
+              {{{{"k1", 1.5}, {"k2", std::nullopt}}},
+               std::nullopt,
+               {{}}}),
+          makeRowVector(
+              {"x", "y"},
+              {makeNullableFlatVector<int64_t>({7, 8, std::nullopt}),
+               makeNullableArrayVector<std::string>(
+                   {{{"p", "q"}}, std::nullopt, std::nullopt})},
+              [](auto row) { return row == 2; }),
+      });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(JsonReaderTest, nestedSubfieldPruning) {
+  auto schema =
+      ROW({"s"}, {ROW({"x", "y", "z"}, {BIGINT(), VARCHAR(), BIGINT()})});
+  auto reader = createReader(
+      R"({"s": {"x": 1, "y": "a", "z": 10}})"
+      "\n"
+      R"({"s": {"x": 2, "y": "b", "z": 20}})"
+      "\n"
+      R"({"s": {"x": 3, "y": "c", "z": 30}})"
+      "\n",
+      schema);
+
+  // Only s.x and s.z are read. The filter on s.z is applied after parsing.
+  auto scanSpec = std::make_shared<common::ScanSpec>("root");
+  auto* s = scanSpec->addField("s", 0);
+  s->addField("x", 0);
+  s->addField("z", 2)->setFilter(
+      std::make_unique<common::BigintRange>(15, 100, false));
+  auto result = read(*reader, scanSpec);
+
+  auto expected = makeRowVector(
+      {"s"},
+      {makeRowVector(
+          {"x", "y", "z"},
+          {makeFlatVector<int64_t>({2, 3}),
+           makeNullConstant(TypeKind::VARCHAR, 2),
+           makeFlatVector<int64_t>({20, 30})})});
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(JsonReaderTest, filterAndProjection) {
+  auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), BIGINT()});
+  std::string data;
+  for (auto i = 0; i < 1'000; ++i) {
+    // Vary the key order so that the filter column is not always first.
+    if (i % 2 == 0) {
+      data += fmt::format(
+          R"({{"c0": {}, "c1": "s{}", "c2": {}}})"
+          "\n",
+          i,
+          i,
+          i * 2);
+    } else {
+      data += fmt::format(
+          R"({{"c2": {}, "c1": "s{}", "c0": {}}})"
+          "\n",
+          i * 2,
+          i,
+          i);
+    }
+  }
+  auto reader = createReader(data, schema);
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("root");
+  scanSpec->addField("c1", 0);
+  auto* c0 = scanSpec->getOrCreateChild("c0");
+  c0->setFilter(std::make_unique<common::BigintRange>(100, 199, false));
+  c0->setProjectOut(false);
+  auto result = read(*reader, scanSpec, 0, data.size(), 64);
+
+  auto expected = makeRowVector(
+      {"c1"},
+      {makeFlatVector<std::string>(
+          100, [](auto row) { return fmt::format("s{}", row + 100); })});
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(JsonReaderTest, missingFilterColumn) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto reader = createReader(
+      R"({"c1": 1})"
+      "\n"
+      R"({"c0": 5, "c1": 2})"
+      "\n",
+      schema);
+  auto scanSpec = makeScanSpec(*schema);
+  scanSpec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(0, 10, false));
+  auto result = read(*reader, scanSpec);
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>({5}), makeFlatVector<int64_t>({2})});
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(JsonReaderTest, splits) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::string data;
+  for (auto i = 0; i < 200; ++i) {
+    data += fmt::format(
+        R"({{"c0": {}, "c1": "{}"}})"
+        "\n",
+        i,
+        std::string(i % 13, 'x'));
+  }
+  // No trailing new line after the last record.
+  data.pop_back();
+  auto reader = createReader(data, schema);
+  auto expected = read(*reader, makeScanSpec(*schema));
+  ASSERT_EQ(expected->size(), 200);
+
+  // Every split point must yield each record exactly once.
+  for (auto splitPoint = 0; splitPoint <= data.size(); ++splitPoint) {
+    auto first = read(*reader, makeScanSpec(*schema), 0, splitPoint, 17);
+    auto second = read(
+        *reader,
+        makeScanSpec(*schema),
+        splitPoint,
+        data.size() - splitPoint,
+        17);
+    auto combined = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::create(expected->type(), 0, pool()));
+    if (first) {
+      combined->append(first.get());
+    }
+    if (second) {
+      combined->append(second.get());
+    }
+    test::assertEqualVectors(expected, combined);
+  }
+}
+
+TEST_F(JsonReaderTest, malformed) {
+  auto schema = ROW({"c0"}, {BIGINT()});
+  auto reader = createReader("{\"c0\": 1}\n[1, 2]\n", schema);
+  VELOX_ASSERT_THROW(
+      read(*reader, makeScanSpec(*schema)), "Malformed JSON record");
+}
+
+} // namespace
+} // namespace facebook::velox::json
@@ -18,6 +18,7 @@
 
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/common/OnDemandUnitLoader.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -59,7 +60,7 @@ class ReaderBase {
     return fileLength_;
   }
 
-  thrift::FileMetaData& thriftFileMetaData() const {
+  const thrift::FileMetaData& thriftFileMetaData() const {
     return *fileMetaData_;
   }
 
@@ -67,6 +68,12 @@ class ReaderBase {
     return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_.get()));
   }
 
+  /// Returns the file metadata for modification, or nullptr if it is shared
+  /// with other readers through the file metadata cache.
+  thrift::FileMetaData* mutableThriftFileMetaData() const {
+    return ownedFileMetaData_.get();
+  }
+
   const std::shared_ptr<const RowType>& schema() const {
     return schema_;
   }
@@ -94,20 +101,43 @@ class ReaderBase {
       int32_t currentGroup,
       StructColumnReader& reader);
 
+  /// Drops the buffered data of the row group at 'rowGroupIndex'.
+  void unloadRowGroup(uint32_t rowGroupIndex);
+
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row group.
   int64_t rowGroupUncompressedSize(
       int32_t rowGroupIndex,
       const dwio::common::TypeWithId& type) const;
 
+  /// Returns the number of bytes read from the file for the columns in 'type'
+  /// and its children in row group.
+  int64_t rowGroupIoSize(
+      int32_t rowGroupIndex,
+      const dwio::common::TypeWithId& type) const;
+
   /// Checks whether the specific row group has been loaded and
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
+  /// Returns the statistics of the whole file for the top-level primitive
+  /// column with id 'nodeId', merged from the statistics of its row groups.
+  /// Returns nullptr if the column is nested or a row group lacks statistics
+  /// for it. Only integer columns get a merged minimum and maximum.
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t nodeId) const;
+
  private:
-  // Reads and parses file footer.
+  // Reads and parses file footer or gets it from the file metadata cache.
   void loadFileMetaData();
 
+  // Reads and parses file footer. Returns the size of the serialized footer.
+  uint32_t readFileMetaData();
+
+  // Returns the estimated memory held by 'fileMetaData_'. 'footerLength' is
+  // the size of the serialized footer.
+  uint64_t fileMetaDataBytes(uint32_t footerLength) const;
+
   void initializeSchema();
 
   void initializeVersion();
@@ -139,7 +169,10 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
+  // Same as 'fileMetaData_' if it is not shared through the file metadata
+  // cache.
+  std::shared_ptr<thrift::FileMetaData> ownedFileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -168,6 +201,27 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* metadataCache = options_.fileMetadataCache();
+  const auto& cacheKey = options_.fileMetadataCacheKey();
+  if (metadataCache == nullptr || cacheKey.fileNum == StringIdMap::kNoId) {
+    readFileMetaData();
+    return;
+  }
+  if (auto cached = metadataCache->get<thrift::FileMetaData>(cacheKey)) {
+    fileMetaData_ = std::move(cached);
+    if (fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_)) {
+      // Small files are read in one piece as when reading the footer.
+      input_->loadCompleteFile();
+    }
+  } else {
+    const auto footerLength = readFileMetaData();
+    metadataCache->put(
+        cacheKey, fileMetaData_, fileMetaDataBytes(footerLength));
+    ownedFileMetaData_.reset();
+  }
+}
+
+uint32_t ReaderBase::readFileMetaData() {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -214,8 +268,22 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  ownedFileMetaData_ = std::make_shared<thrift::FileMetaData>();
+  ownedFileMetaData_->read(thriftProtocol.get());
+  fileMetaData_ = ownedFileMetaData_;
+  return footerLength;
+}
+
+uint64_t ReaderBase::fileMetaDataBytes(uint32_t footerLength) const {
+  // The fixed size parts of the thrift objects plus the serialized size as an
+  // estimate of the strings and statistics they reference.
+  uint64_t bytes = sizeof(thrift::FileMetaData) + footerLength +
+      fileMetaData_->schema.size() * sizeof(thrift::SchemaElement);
+  for (const auto& rowGroup : fileMetaData_->row_groups) {
+    bytes += sizeof(thrift::RowGroup) +
+        rowGroup.columns.size() * sizeof(thrift::ColumnChunk);
+  }
+  return bytes;
 }
 
 void ReaderBase::initializeSchema() {
@@ -889,10 +957,10 @@ void ReaderBase::scheduleRowGroups(
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
     }
   }
+}
 
-  if (currentGroup >= 1) {
-    inputs_.erase(rowGroupIds[currentGroup - 1]);
-  }
+void ReaderBase::unloadRowGroup(uint32_t rowGroupIndex) {
+  inputs_.erase(rowGroupIndex);
 }
 
 int64_t ReaderBase::rowGroupUncompressedSize(
@@ -913,10 +981,179 @@ int64_t ReaderBase::rowGroupUncompressedSize(
   return sum;
 }
 
+int64_t ReaderBase::rowGroupIoSize(
+    int32_t rowGroupIndex,
+    const dwio::common::TypeWithId& type) const {
+  if (type.column() != ParquetTypeWithId::kNonLeaf) {
+    VELOX_CHECK_LT(rowGroupIndex, fileMetaData_->row_groups.size());
+    VELOX_CHECK_LT(
+        type.column(), fileMetaData_->row_groups[rowGroupIndex].columns.size());
+    const auto& metaData = fileMetaData_->row_groups[rowGroupIndex]
+                               .columns[type.column()]
+                               .meta_data;
+    // Same as the read size of the column chunk in ParquetData.
+    return metaData.codec == thrift::CompressionCodec::UNCOMPRESSED
+        ? metaData.total_uncompressed_size
+        : metaData.total_compressed_size;
+  }
+  int64_t sum = 0;
+  for (auto child : type.getChildren()) {
+    sum += rowGroupIoSize(rowGroupIndex, *child);
+  }
+  return sum;
+}
+
 bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return inputs_.count(rowGroupIndex) != 0;
 }
 
+std::unique_ptr<dwio::common::ColumnStatistics> ReaderBase::columnStatistics(
+    uint32_t nodeId) const {
+  const dwio::common::TypeWithId* column = nullptr;
+  for (const auto& child : schemaWithId_->getChildren()) {
+    if (child->id() == nodeId) {
+      column = child.get();
+      break;
+    }
+  }
+  if (column == nullptr || column->column() == ParquetTypeWithId::kNonLeaf) {
+    return nullptr;
+  }
+  const auto& type = column->type();
+  bool isInteger = false;
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      // Decimal statistics may be stored in other physical types.
+      isInteger = !type->isDecimal();
+      break;
+    default:
+      break;
+  }
+
+  uint64_t numValues = 0;
+  std::optional<int64_t> min;
+  std::optional<int64_t> max;
+  bool hasMinMax = isInteger;
+  auto metaData = fileMetaData();
+  for (auto i = 0; i < metaData.numRowGroups(); ++i) {
+    auto rowGroup = metaData.rowGroup(i);
+    // Columns of row groups outside of the read range may have been dropped.
+    if (static_cast<int>(column->column()) >= rowGroup.numColumns()) {
+      return nullptr;
+    }
+    auto columnChunk = rowGroup.columnChunk(column->column());
+    if (!columnChunk.hasStatistics()) {
+      return nullptr;
+    }
+    auto stats = columnChunk.getColumnStatistics(type, rowGroup.numRows());
+    if (!stats->getNumberOfValues().has_value()) {
+      return nullptr;
+    }
+    numValues += stats->getNumberOfValues().value();
+    if (!hasMinMax || stats->getNumberOfValues().value() == 0) {
+      continue;
+    }
+    auto* intStats =
+        dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+            stats.get());
+    if (intStats == nullptr || !intStats->getMinimum().has_value() ||
+        !intStats->getMaximum().has_value()) {
+      hasMinMax = false;
+      continue;
+    }
+    min = min.has_value() ? std::min(*min, *intStats->getMinimum())
+                          : *intStats->getMinimum();
+    max = max.has_value() ? std::max(*max, *intStats->getMaximum())
+                          : *intStats->getMaximum();
+  }
+  const bool hasNull =
+      numValues < static_cast<uint64_t>(fileMetaData_->num_rows);
+  if (!isInteger) {
+    return std::make_unique<dwio::common::ColumnStatistics>(
+        numValues, hasNull, std::nullopt, std::nullopt);
+  }
+  if (!hasMinMax) {
+    min.reset();
+    max.reset();
+  }
+  return std::make_unique<dwio::common::IntegerColumnStatistics>(
+      numValues, hasNull, std::nullopt, std::nullopt, min, max, std::nullopt);
+}
+
+namespace {
+
+// A row group of a ParquetRowReader. Loading a row group enqueues the column
+// chunks of the row group and starts loading them, together with the chunks of
+// the prefetchRowGroups() row groups that follow it in 'rowGroupIds'. With
+// asynchronous loading in BufferedInput the I/O for the following row groups
+// overlaps with decoding the current one.
+class ParquetUnit : public dwio::common::LoadUnit {
+ public:
+  ParquetUnit(
+      ReaderBase& readerBase,
+      StructColumnReader& columnReader,
+      const common::ScanSpec& scanSpec,
+      const std::vector<uint32_t>& rowGroupIds,
+      uint32_t unitIndex)
+      : readerBase_{readerBase},
+        columnReader_{columnReader},
+        scanSpec_{scanSpec},
+        rowGroupIds_{rowGroupIds},
+        unitIndex_{unitIndex} {}
+
+  ~ParquetUnit() override = default;
+
+  void load() override {
+    readerBase_.scheduleRowGroups(rowGroupIds_, unitIndex_, columnReader_);
+  }
+
+  void unload() override {
+    readerBase_.unloadRowGroup(rowGroupIndex());
+  }
+
+  uint64_t getNumRows() override {
+    return readerBase_.thriftFileMetaData()
+        .row_groups[rowGroupIndex()]
+        .num_rows;
+  }
+
+  uint64_t getIoSize() override {
+    if (ioSize_.has_value()) {
+      return ioSize_.value();
+    }
+    // Counts the top level columns the scan reads from the file.
+    const auto& schema = *readerBase_.schema();
+    const auto& schemaWithId = *readerBase_.schemaWithId();
+    uint64_t ioSize = 0;
+    for (auto i = 0; i < schema.size(); ++i) {
+      auto* childSpec = scanSpec_.childByName(schema.nameOf(i));
+      if (childSpec && !childSpec->isConstant()) {
+        ioSize += readerBase_.rowGroupIoSize(
+            rowGroupIndex(), *schemaWithId.childAt(i));
+      }
+    }
+    ioSize_ = ioSize;
+    return ioSize;
+  }
+
+ private:
+  uint32_t rowGroupIndex() const {
+    return rowGroupIds_[unitIndex_];
+  }
+
+  ReaderBase& readerBase_;
+  StructColumnReader& columnReader_;
+  const common::ScanSpec& scanSpec_;
+  const std::vector<uint32_t>& rowGroupIds_;
+  const uint32_t unitIndex_;
+  std::optional<uint64_t> ioSize_;
+};
+
+} // namespace
+
 class ParquetRowReader::Impl {
  public:
   Impl(
@@ -961,8 +1198,12 @@ class ParquetRowReader::Impl {
         params,
         *options_.scanSpec());
     columnReader_->setIsTopLevel();
+    columnReader_->setDecodingExecutor(
+        options_.decodingExecutor().get(),
+        options_.decodingParallelismFactor());
 
     filterRowGroups();
+    unitLoader_ = createUnitLoader();
     if (!rowGroupIds_.empty()) {
       // schedule prefetch of first row group right after reading the metadata.
       // This is usually on a split preload thread before the split goes to
@@ -981,6 +1222,7 @@ class ParquetRowReader::Impl {
       metadataFilter->eval(res.metadataFilterResults, res.filterResult);
     }
 
+    auto* mutableFileMetaData = readerBase_->mutableThriftFileMetaData();
     uint64_t rowNumber = 0;
     for (auto i = 0; i < rowGroups_.size(); i++) {
       VELOX_CHECK_GT(rowGroups_[i].columns.size(), 0);
@@ -1002,17 +1244,38 @@ class ParquetRowReader::Impl {
       if (rowGroupInRange && !isExcluded && !isEmpty) {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
-      } else if (i != 0) {
+      } else if (i != 0 && mutableFileMetaData != nullptr) {
         // Clear the metadata of row groups that are not read. This helps reduce
         // the memory consumption. ColumnChunks consume the most memory.
-        // Skip the 0th RowGroup as it is used by estimatedRowSize().
-        rowGroups_[i].columns.clear();
+        // Skip the 0th RowGroup as it is used by estimatedRowSize(). Metadata
+        // shared through the file metadata cache is used by other readers.
+        mutableFileMetaData->row_groups[i].columns.clear();
       }
 
       rowNumber += rowGroups_[i].num_rows;
     }
   }
 
+  std::unique_ptr<dwio::common::UnitLoader> createUnitLoader() {
+    std::vector<std::unique_ptr<dwio::common::LoadUnit>> loadUnits;
+    loadUnits.reserve(rowGroupIds_.size());
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      loadUnits.push_back(std::make_unique<ParquetUnit>(
+          *readerBase_,
+          static_cast<StructColumnReader&>(*columnReader_),
+          *options_.scanSpec(),
+          rowGroupIds_,
+          i));
+    }
+    auto unitLoaderFactory = options_.unitLoaderFactory();
+    if (!unitLoaderFactory) {
+      unitLoaderFactory =
+          std::make_shared<dwio::common::OnDemandUnitLoaderFactory>(
+              options_.blockedOnIoCallback());
+    }
+    return unitLoaderFactory->create(std::move(loadUnits), 0);
+  }
+
   int64_t nextRowNumber() {
     if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
         !advanceToNextRowGroup()) {
@@ -1038,6 +1301,8 @@ class ParquetRowReader::Impl {
       return 0;
     }
     VELOX_DCHECK_GT(rowsToRead, 0);
+    unitLoader_->onRead(
+        nextRowGroupIdsIdx_ - 1, currentRowInGroup_, rowsToRead);
     columnReader_->setCurrentRowNumber(nextRowNumber());
     if (!options_.rowNumberColumnInfo().has_value()) {
       columnReader_->next(rowsToRead, result, mutation);
@@ -1082,10 +1347,9 @@ class ParquetRowReader::Impl {
     }
 
     auto nextRowGroupIndex = rowGroupIds_[nextRowGroupIdsIdx_];
-    readerBase_->scheduleRowGroups(
-        rowGroupIds_,
-        nextRowGroupIdsIdx_,
-        static_cast<StructColumnReader&>(*columnReader_));
+    // Unloads the previous row group and loads this one, together with the
+    // row groups to prefetch.
+    unitLoader_->getLoadedUnit(nextRowGroupIdsIdx_);
     currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
     rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
     currentRowInGroup_ = 0;
@@ -1099,7 +1363,7 @@ class ParquetRowReader::Impl {
   const dwio::common::RowReaderOptions options_;
 
   // All row groups from file metadata.
-  std::vector<thrift::RowGroup>& rowGroups_;
+  const std::vector<thrift::RowGroup>& rowGroups_;
   // Indices of row groups where stats match filters.
   std::vector<uint32_t> rowGroupIds_;
   std::vector<uint64_t> firstRowOfRowGroup_;
@@ -1109,6 +1373,9 @@ class ParquetRowReader::Impl {
   uint64_t currentRowInGroup_;
 
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
+  // Loads the row groups in 'rowGroupIds_'. Declared after the members the
+  // load units refer to.
+  std::unique_ptr<dwio::common::UnitLoader> unitLoader_;
 
   TypePtr requestedType_;
   ParquetStatsContext parquetStatsContext_;
@@ -1167,6 +1434,11 @@ std::optional<uint64_t> ParquetReader::numberOfRows() const {
   return readerBase_->thriftFileMetaData().num_rows;
 }
 
+std::unique_ptr<dwio::common::ColumnStatistics>
+ParquetReader::aggregateStatistics(uint32_t index) const {
+  return readerBase_->columnStatistics(index);
+}
+
 const velox::RowTypePtr& ParquetReader::rowType() const {
   return readerBase_->schema();
 }
@@ -96,6 +96,11 @@ class ParquetReader : public dwio::common::Reader {
     return nullptr;
   }
 
+  /// Returns the file level statistics of a top-level primitive column merged
+  /// from its row group statistics, or nullptr for nested columns.
+  std::unique_ptr<dwio::common::ColumnStatistics> aggregateStatistics(
+      uint32_t index) const override;
+
   const velox::RowTypePtr& rowType() const override;
 
   const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
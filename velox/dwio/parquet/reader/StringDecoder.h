@@ -16,6 +16,12 @@
 
 #pragma once
 
+#include <cstring>
+#include <string>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/type/Filter.h"
+
 namespace facebook::velox::parquet {
 
 class StringDecoder {
@@ -35,6 +41,10 @@ class StringDecoder {
     if (hasNulls) {
       numValues = bits::countNonNulls(nulls, current, current + numValues);
     }
+    if (fixedLength_ > 0) {
+      bufferStart_ += numValues * fixedLength_;
+      return;
+    }
     for (auto i = 0; i < numValues; ++i) {
       bufferStart_ += lengthAt(bufferStart_) + sizeof(int32_t);
     }
@@ -42,6 +52,15 @@ class StringDecoder {
 
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    using TFilter = typename Visitor::FilterType;
+    // Range and IN filters are checked on the length and on the common prefix
+    // of the passing values before the value is materialized.
+    constexpr bool kPrefilter = TFilter::deterministic &&
+        (std::is_same_v<TFilter, common::BytesRange> ||
+         std::is_same_v<TFilter, common::BytesValues>);
+    if constexpr (kPrefilter) {
+      setPrefix(visitor.filter());
+    }
     int32_t current = visitor.start();
     int32_t numValues = 0;
     skip<hasNulls>(current, 0, nulls);
@@ -67,8 +86,12 @@ class StringDecoder {
         }
 
         // We are at a non-null value on a row to visit.
-        toSkip = visitor.process(
-            fixedLength_ > 0 ? readFixedString() : readString(), atEnd);
+        if constexpr (kPrefilter) {
+          toSkip = prefilterAndProcess(visitor, atEnd);
+        } else {
+          toSkip = visitor.process(
+              fixedLength_ > 0 ? readFixedString() : readString(), atEnd);
+        }
       }
       ++current;
       ++numValues;
@@ -87,6 +110,78 @@ class StringDecoder {
   }
 
  private:
+  // Sets 'prefix_' to the longest prefix shared by all values that pass
+  // 'filter'. A value between two bounds starts with their common prefix. The
+  // values of an IN filter are between its smallest and largest value.
+  template <typename TFilter>
+  void setPrefix(const TFilter& filter) {
+    std::string_view prefix;
+    if constexpr (std::is_same_v<TFilter, common::BytesRange>) {
+      if (!filter.lowerUnbounded() && !filter.upperUnbounded()) {
+        prefix = commonPrefix(filter.lower(), filter.upper());
+      }
+    } else {
+      prefix = commonPrefix(filter.lower(), filter.upper());
+    }
+    prefixSize_ = prefix.size();
+    // memEqualUnsafe() may read past the end of the prefix.
+    prefix_.resize(prefixSize_ + simd::kPadding);
+    std::memcpy(prefix_.data(), prefix.data(), prefixSize_);
+  }
+
+  static std::string_view commonPrefix(
+      std::string_view left,
+      std::string_view right) {
+    size_t size = 0;
+    const auto maxSize = std::min(left.size(), right.size());
+    while (size < maxSize && left[size] == right[size]) {
+      ++size;
+    }
+    return left.substr(0, size);
+  }
+
+  // True if the 'length' bytes at 'value' start with 'prefix_'.
+  bool hasPrefix(const char* value, int32_t length) const {
+    if (length < prefixSize_) {
+      return false;
+    }
+    if (prefixSize_ == 0) {
+      return true;
+    }
+    if (value + prefixSize_ <= lastSafeWord_) {
+      return simd::memEqualUnsafe(value, prefix_.data(), prefixSize_);
+    }
+    return std::memcmp(value, prefix_.data(), prefixSize_) == 0;
+  }
+
+  // Processes the value at 'bufferStart_'. A value whose length fails the
+  // filter or that does not start with 'prefix_' is skipped without being
+  // materialized.
+  template <typename Visitor>
+  FOLLY_ALWAYS_INLINE int32_t prefilterAndProcess(
+      Visitor& visitor,
+      bool& atEnd) {
+    int32_t length;
+    const char* value;
+    if (fixedLength_ > 0) {
+      length = fixedLength_;
+      value = bufferStart_;
+    } else {
+      length = lengthAt(bufferStart_);
+      value = bufferStart_ + sizeof(int32_t);
+    }
+    auto toSkip = visitor.processLength(length, atEnd);
+    if (!toSkip.has_value() && !hasPrefix(value, length)) {
+      toSkip = visitor.processFailed(atEnd);
+    }
+    if (toSkip.has_value()) {
+      bufferStart_ = value + length;
+      return toSkip.value();
+    }
+    return visitor.process(
+        fixedLength_ > 0 ? readFixedString() : readString(), atEnd);
+  }
+
   int32_t lengthAt(const char* buffer) {
     return *reinterpret_cast<const int32_t*>(buffer);
   }
@@ -106,6 +201,10 @@ class StringDecoder {
   const char* bufferEnd_;
   const char* const lastSafeWord_;
   const int fixedLength_;
+
+  // Prefix of all values passing the filter, padded for SIMD loads.
+  std::string prefix_;
+  int32_t prefixSize_{0};
 };
 
 } // namespace facebook::velox::parquet
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include "velox/common/caching/FileIds.h"
+#include "velox/dwio/common/OnDemandUnitLoader.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -1130,6 +1132,143 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+namespace {
+
+// Records the load units and the calls to the UnitLoader and loads units on
+// demand.
+class RecordingUnitLoaderFactory : public UnitLoaderFactory {
+ public:
+  std::unique_ptr<UnitLoader> create(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override {
+    numRows.clear();
+    ioSizes.clear();
+    for (auto& unit : loadUnits) {
+      numRows.push_back(unit->getNumRows());
+      ioSizes.push_back(unit->getIoSize());
+    }
+    return std::make_unique<Loader>(
+        *this,
+        OnDemandUnitLoaderFactory(nullptr).create(
+            std::move(loadUnits), rowsToSkip));
+  }
+
+  std::vector<int64_t> numRows;
+  std::vector<uint64_t> ioSizes;
+  std::vector<uint32_t> loadedUnits;
+  int64_t rowsRead{0};
+
+ private:
+  class Loader : public UnitLoader {
+   public:
+    Loader(
+        RecordingUnitLoaderFactory& factory,
+        std::unique_ptr<UnitLoader> loader)
+        : factory_{factory}, loader_{std::move(loader)} {}
+
+    LoadUnit& getLoadedUnit(uint32_t unit) override {
+      factory_.loadedUnits.push_back(unit);
+      return loader_->getLoadedUnit(unit);
+    }
+
+    void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t rowCount)
+        override {
+      factory_.rowsRead += rowCount;
+      loader_->onRead(unit, rowOffsetInUnit, rowCount);
+    }
+
+    void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+      loader_->onSeek(unit, rowOffsetInUnit);
+    }
+
+   private:
+    RecordingUnitLoaderFactory& factory_;
+    const std::unique_ptr<UnitLoader> loader_;
+  };
+};
+
+} // namespace
+
+TEST_F(ParquetReaderTest, unitLoader) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+  const int numRowGroups = 4;
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setFilePreloadThreshold(0);
+  readerOptions.setPrefetchRowGroups(1);
+  auto reader = createReader(sample, readerOptions);
+
+  auto factory = std::make_shared<RecordingUnitLoaderFactory>();
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+  rowReaderOpts.setUnitLoaderFactory(factory);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto parquetRowReader = dynamic_cast<ParquetRowReader*>(rowReader.get());
+
+  // Each row group is a unit and the first one is loaded with the reader.
+  ASSERT_EQ(factory->numRows.size(), numRowGroups);
+  int64_t totalRows = 0;
+  for (auto i = 0; i < numRowGroups; ++i) {
+    EXPECT_EQ(
+        factory->numRows[i], reader->fileMetaData().rowGroup(i).numRows());
+    EXPECT_GT(factory->ioSizes[i], 0UL);
+    totalRows += factory->numRows[i];
+  }
+  EXPECT_EQ(factory->loadedUnits, std::vector<uint32_t>{0});
+  EXPECT_TRUE(parquetRowReader->isRowGroupBuffered(0));
+  EXPECT_TRUE(parquetRowReader->isRowGroupBuffered(1));
+  EXPECT_FALSE(parquetRowReader->isRowGroupBuffered(2));
+
+  auto result = BaseVector::create(rowType, 1, pool_.get());
+  while (rowReader->next(1'000, result) > 0) {
+  }
+  EXPECT_EQ(factory->loadedUnits, (std::vector<uint32_t>{0, 1, 2, 3}));
+  EXPECT_EQ(factory->rowsRead, totalRows);
+  for (auto i = 0; i < numRowGroups - 1; ++i) {
+    EXPECT_FALSE(parquetRowReader->isRowGroupBuffered(i));
+  }
+}
+
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  // sample.parquet holds 20 rows in two row groups at offsets 153 and 614.
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  cache::FileMetadataCache metadataCache(1 << 20);
+  StringIdLease fileId(fileIds(), sample);
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setFileMetadataCache(&metadataCache, {fileId.id(), 1});
+
+  auto read = [&](uint64_t offset, uint64_t length, int32_t numRows) {
+    auto reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), 20ULL);
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    rowReaderOpts.range(offset, length);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto expected = makeRowVector({
+        makeFlatVector<int64_t>(numRows, [](auto row) { return row + 1; }),
+        makeFlatVector<double>(numRows, [](auto row) { return row + 1; }),
+    });
+    assertReadWithReaderAndExpected(
+        sampleSchema(), *rowReader, expected, *leafPool_);
+  };
+
+  read(0, std::numeric_limits<uint64_t>::max(), 20);
+  EXPECT_EQ(metadataCache.stats().numEntries, 1);
+  EXPECT_EQ(metadataCache.stats().numHits, 0);
+
+  // Reading the first row group only must not modify the cached metadata.
+  read(0, 500, 10);
+  read(0, std::numeric_limits<uint64_t>::max(), 20);
+  EXPECT_EQ(metadataCache.stats().numHits, 2);
+
+  // A new version of the file is read from the file.
+  readerOptions.setFileMetadataCache(&metadataCache, {fileId.id(), 2});
+  read(0, std::numeric_limits<uint64_t>::max(), 20);
+  EXPECT_EQ(metadataCache.stats().numEntries, 2);
+  EXPECT_EQ(metadataCache.stats().numHits, 2);
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <folly/Conv.h>
+#include <xsimd/xsimd.hpp>
+
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::text {
+
+/// Finds the positions of field delimiters, row delimiters and escape
+/// characters in a byte buffer. A full SIMD register of bytes is compared
+/// against the special characters at a time and the resulting bit mask is
+/// consumed one set bit per call to next(), so that runs of plain text are
+/// skipped without touching individual bytes.
+class DelimiterScanner {
+ public:
+  DelimiterScanner(
+      char fieldDelim,
+      char rowDelim,
+      char escapeChar,
+      bool escaped)
+      : fieldDelim_(fieldDelim),
+        rowDelim_(rowDelim),
+        escapeChar_(escapeChar),
+        escaped_(escaped) {}
+
+  /// Starts scanning 'size' bytes at 'data' from 'offset'.
+  void reset(const char* data, int32_t size, int32_t offset) {
+    data_ = data;
+    size_ = size;
+    seek(offset);
+  }
+
+  /// Continues scanning over a grown or relocated buffer. Positions already
+  /// returned stay valid since they are offsets from the start of 'data'.
+  void extend(const char* data, int32_t size) {
+    data_ = data;
+    size_ = size;
+  }
+
+  /// Discards the pending matches and resumes scanning at 'offset'.
+  void seek(int32_t offset) {
+    mask_ = 0;
+    blockStart_ = offset;
+    nextBlock_ = offset;
+  }
+
+  /// Returns the offset of the next special character or -1 if there is none
+  /// before the end of the buffer. A later call after extend() resumes where
+  /// the previous scan stopped.
+  int32_t next() {
+    for (;;) {
+      if (mask_ != 0) {
+        const auto bit = __builtin_ctzll(mask_);
+        mask_ &= mask_ - 1;
+        return blockStart_ + bit;
+      }
+      if (nextBlock_ >= size_) {
+        return -1;
+      }
+      loadBlock();
+    }
+  }
+
+  /// Excludes the byte at 'offset' from the matches. Used to skip the
+  /// character following an escape character.
+  void skip(int32_t offset) {
+    if (offset < nextBlock_) {
+      const auto bit = offset - blockStart_;
+      mask_ &= ~(1ULL << bit);
+    } else if (offset == nextBlock_) {
+      nextBlock_ = offset + 1;
+    }
+  }
+
+ private:
+  using Batch = xsimd::batch<int8_t>;
+  static_assert(Batch::size <= 64);
+  // The bit mask of a batch as an unsigned word of at least Batch::size bits.
+  // The mask of up to 32 lanes comes as an int, which must not be sign
+  // extended into the upper bits of 'mask_'.
+  using BatchMask =
+      std::conditional_t<(Batch::size <= 32), uint32_t, uint64_t>;
+
+  void loadBlock() {
+    blockStart_ = nextBlock_;
+    if (blockStart_ + static_cast<int32_t>(Batch::size) <= size_) {
+      const auto bytes = Batch::load_unaligned(
+          reinterpret_cast<const int8_t*>(data_ + blockStart_));
+      auto matches = (bytes == Batch(static_cast<int8_t>(fieldDelim_))) |
+          (bytes == Batch(static_cast<int8_t>(rowDelim_)));
+      if (escaped_) {
+        matches = matches | (bytes == Batch(static_cast<int8_t>(escapeChar_)));
+      }
+      mask_ = static_cast<BatchMask>(simd::toBitMask(matches));
+      nextBlock_ = blockStart_ + Batch::size;
+      return;
+    }
+    mask_ = 0;
+    for (auto i = blockStart_; i < size_; ++i) {
+      const char c = data_[i];
+      if (c == fieldDelim_ || c == rowDelim_ ||
+          (escaped_ && c == escapeChar_)) {
+        mask_ |= 1ULL << (i - blockStart_);
+      }
+    }
+    nextBlock_ = size_;
+  }
+
+  const char fieldDelim_;
+  const char rowDelim_;
+  const char escapeChar_;
+  const bool escaped_;
+
+  const char* data_{nullptr};
+  int32_t size_{0};
+  // Offset of the bytes described by 'mask_'.
+  int32_t blockStart_{0};
+  // Offset of the first byte not yet loaded into 'mask_'.
+  int32_t nextBlock_{0};
+  // Bit i is set if the byte at 'blockStart_' + i is a special character.
+  uint64_t mask_{0};
+};
+
+namespace detail {
+
+// True if all 8 bytes of 'chunk' are ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+      0x3333333333333333ULL;
+}
+
+// Returns the value of 8 ASCII digits loaded little endian in 'chunk'.
+inline uint64_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FFULL;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030ULL;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >>
+      32;
+}
+
+} // namespace detail
+
+/// Parses the decimal integer in 'size' bytes at 'data' into 'result'. A
+/// leading '+' or '-' is accepted. Returns false if the text is not an integer
+/// or does not fit in T. Digits are consumed 8 at a time with SWAR arithmetic.
+template <typename T>
+inline bool parseInteger(const char* data, int32_t size, T& result) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  if (size <= 0) {
+    return false;
+  }
+  bool negative = false;
+  int32_t i = 0;
+  if (data[0] == '-' || data[0] == '+') {
+    negative = data[0] == '-';
+    i = 1;
+    if (size == 1) {
+      return false;
+    }
+  }
+  // Skip leading zeros so that the digit count below bounds the magnitude.
+  while (i < size - 1 && data[i] == '0') {
+    ++i;
+  }
+  // A uint64_t holds any 19 digit number.
+  if (size - i > 19) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data + i, sizeof(chunk));
+    if (!detail::isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + detail::parseEightDigits(chunk);
+  }
+  for (; i < size; ++i) {
+    const uint8_t digit = data[i] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  constexpr auto kMax = static_cast<uint64_t>(std::numeric_limits<T>::max());
+  if (negative) {
+    if (value > kMax + 1) {
+      return false;
+    }
+    result = static_cast<T>(0 - value);
+  } else {
+    if (value > kMax) {
+      return false;
+    }
+    result = static_cast<T>(value);
+  }
+  return true;
+}
+
+/// Parses 'true' or 'false' in any case. Returns false for any other text.
+inline bool parseBoolean(const char* data, int32_t size, bool& result) {
+  if (size == 4 && strncasecmp(data, "true", 4) == 0) {
+    result = true;
+    return true;
+  }
+  if (size == 5 && strncasecmp(data, "false", 5) == 0) {
+    result = false;
+    return true;
+  }
+  return false;
+}
+
+/// Parses a floating point number, including 'NaN' and 'Infinity' as written
+/// by TextWriter. Returns false if the text is not a number.
+template <typename T>
+inline bool parseFloatingPoint(const char* data, int32_t size, T& result) {
+  static_assert(std::is_floating_point_v<T>);
+  auto parsed = folly::tryTo<T>(folly::StringPiece(data, size));
+  if (parsed.hasError()) {
+    return false;
+  }
+  result = parsed.value();
+  return true;
+}
+
+} // namespace facebook::velox::text
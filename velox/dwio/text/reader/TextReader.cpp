@@ -0,0 +1,641 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include "velox/common/encode/Base64.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+
+using dwio::common::Mutation;
+using dwio::common::RowReaderOptions;
+
+namespace {
+
+// Hive text files always separate rows by a new line. A carriage return
+// before the new line is not part of the row.
+constexpr char kRowDelimiter = '\n';
+constexpr char kCarriageReturn = '\r';
+
+void checkSupportedType(const std::string& name, const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return;
+    case TypeKind::BIGINT:
+      if (!type->isDecimal()) {
+        return;
+      }
+      [[fallthrough]];
+    default:
+      VELOX_NYI(
+          "Column {} of type {} is not supported yet in TextReader",
+          name,
+          type->toString());
+  }
+}
+
+template <TypeKind kKind>
+bool parseValue(
+    const Type& type,
+    const char* data,
+    int32_t size,
+    typename TypeTraits<kKind>::NativeType& value) {
+  if constexpr (kKind == TypeKind::BOOLEAN) {
+    return parseBoolean(data, size, value);
+  } else if constexpr (kKind == TypeKind::INTEGER) {
+    if (type.isDate()) {
+      auto days =
+          util::fromDateString(data, size, util::ParseMode::kPrestoCast);
+      if (days.hasError()) {
+        return false;
+      }
+      value = days.value();
+      return true;
+    }
+    return parseInteger(data, size, value);
+  } else if constexpr (
+      kKind == TypeKind::TINYINT || kKind == TypeKind::SMALLINT ||
+      kKind == TypeKind::BIGINT) {
+    return parseInteger(data, size, value);
+  } else if constexpr (kKind == TypeKind::REAL || kKind == TypeKind::DOUBLE) {
+    return parseFloatingPoint(data, size, value);
+  } else if constexpr (kKind == TypeKind::TIMESTAMP) {
+    auto timestamp = util::fromTimestampString(
+        data, size, util::TimestampParseMode::kPrestoCast);
+    if (timestamp.hasError()) {
+      return false;
+    }
+    value = timestamp.value();
+    return true;
+  } else {
+    VELOX_UNREACHABLE("Unexpected type {} in TextReader", kKind);
+  }
+}
+
+// Removes the escape characters of an escaped field. The character after an
+// escape character is taken literally.
+std::string unescape(const char* data, int32_t size, char escapeChar) {
+  std::string result;
+  result.reserve(size);
+  for (int32_t i = 0; i < size; ++i) {
+    if (data[i] == escapeChar && i + 1 < size) {
+      ++i;
+    }
+    result.push_back(data[i]);
+  }
+  return result;
+}
+
+} // namespace
+
+TextRowReader::TextRowReader(
+    std::shared_ptr<dwio::common::BufferedInput> input,
+    RowTypePtr fileType,
+    const dwio::common::SerDeOptions& serDeOptions,
+    memory::MemoryPool& pool,
+    const RowReaderOptions& options)
+    : input_(std::move(input)),
+      fileType_(std::move(fileType)),
+      serDeOptions_(serDeOptions),
+      pool_(pool),
+      options_(options),
+      scanSpec_(options_.scanSpec()),
+      scanner_(
+          static_cast<char>(serDeOptions_.separators[0]),
+          kRowDelimiter,
+          static_cast<char>(serDeOptions_.escapeChar),
+          serDeOptions_.isEscaped) {
+  VELOX_CHECK(
+      !options_.rowNumberColumnInfo().has_value(),
+      "Row number column is not supported by TextReader");
+  if (!scanSpec_) {
+    scanSpec_ = std::make_shared<common::ScanSpec>("root");
+    scanSpec_->addAllChildFields(*fileType_);
+  }
+  for (const auto& child : scanSpec_->children()) {
+    if (child->isConstant()) {
+      continue;
+    }
+    VELOX_CHECK(
+        child->columnType() == common::ScanSpec::ColumnType::kRegular,
+        "Column {} of non-regular column type is not supported by TextReader",
+        child->fieldName());
+    const auto index = fileType_->getChildIdxIfExists(child->fieldName());
+    VELOX_CHECK(
+        index.has_value(),
+        "Column {} is not in the text file schema {}",
+        child->fieldName(),
+        fileType_->toString());
+    checkSupportedType(child->fieldName(), fileType_->childAt(index.value()));
+    numTrackedFields_ =
+        std::max<int32_t>(numTrackedFields_, index.value() + 1);
+  }
+}
+
+int64_t TextRowReader::nextRowNumber() {
+  return atEnd_ ? kAtEnd : rowsRead_;
+}
+
+int64_t TextRowReader::nextReadSize(uint64_t size) {
+  return atEnd_ ? kAtEnd : size;
+}
+
+std::optional<size_t> TextRowReader::estimatedRowSize() const {
+  if (rowsRead_ == 0) {
+    return std::nullopt;
+  }
+  return bytesRead_ / rowsRead_;
+}
+
+void TextRowReader::initialize() {
+  initialized_ = true;
+  const uint64_t fileLength = input_->getReadFile()->size();
+  const uint64_t splitStart = options_.offset();
+  splitEnd_ = std::min(options_.limit(), fileLength);
+  if (splitStart >= splitEnd_) {
+    atEnd_ = true;
+    return;
+  }
+  // A split that starts inside the file begins after the first row delimiter
+  // at or after 'splitStart' - 1. A row starting exactly at 'splitStart' thus
+  // belongs to this split and the row that the previous split ends with is
+  // skipped.
+  const uint64_t readStart = splitStart == 0 ? 0 : splitStart - 1;
+  stream_ = input_->read(
+      readStart, fileLength - readStart, dwio::common::LogType::STREAM);
+  dataFileOffset_ = readStart;
+  if (splitStart > 0) {
+    if (!skipRow()) {
+      atEnd_ = true;
+    }
+    return;
+  }
+  // Header rows are only at the start of the file.
+  for (uint64_t i = 0; i < options_.skipRows(); ++i) {
+    if (!skipRow()) {
+      atEnd_ = true;
+      return;
+    }
+  }
+}
+
+bool TextRowReader::readMore() {
+  if (streamAtEnd_) {
+    return false;
+  }
+  const void* chunk;
+  int32_t size;
+  if (!stream_->Next(&chunk, &size)) {
+    streamAtEnd_ = true;
+    return false;
+  }
+  bytesRead_ += size;
+  const int32_t newSize = dataSize_ + size;
+  if (data_ == nullptr || data_->capacity() < newSize) {
+    const int64_t capacity = std::max<int64_t>(
+        newSize, data_ == nullptr ? 0 : 2 * data_->capacity());
+    auto newData = AlignedBuffer::allocate<char>(capacity, &pool_);
+    if (dataSize_ > 0) {
+      std::memcpy(newData->asMutable<char>(), data_->as<char>(), dataSize_);
+    }
+    data_ = std::move(newData);
+  }
+  std::memcpy(data_->asMutable<char>() + dataSize_, chunk, size);
+  dataSize_ = newSize;
+  data_->setSize(dataSize_);
+  return true;
+}
+
+void TextRowReader::consume(int32_t offset) {
+  VELOX_DCHECK_LE(offset, dataSize_);
+  const int32_t remaining = dataSize_ - offset;
+  dataFileOffset_ += offset;
+  if (data_ == nullptr) {
+    return;
+  }
+  if (data_->refCount() > 1) {
+    // The consumed rows are referenced by returned string vectors. Move the
+    // rest to a new buffer.
+    auto newData = AlignedBuffer::allocate<char>(
+        std::max<int64_t>(remaining, data_->capacity()), &pool_);
+    std::memcpy(
+        newData->asMutable<char>(), data_->as<char>() + offset, remaining);
+    data_ = std::move(newData);
+  } else if (remaining > 0 && offset > 0) {
+    std::memmove(
+        data_->asMutable<char>(), data_->as<char>() + offset, remaining);
+  }
+  dataSize_ = remaining;
+  data_->setSize(dataSize_);
+}
+
+bool TextRowReader::skipRow() {
+  int32_t searchFrom = 0;
+  for (;;) {
+    if (dataSize_ > searchFrom) {
+      const char* data = data_->as<char>();
+      const auto* found = static_cast<const char*>(std::memchr(
+          data + searchFrom, kRowDelimiter, dataSize_ - searchFrom));
+      if (found != nullptr) {
+        consume(found - data + 1);
+        return true;
+      }
+    }
+    searchFrom = dataSize_;
+    if (!readMore()) {
+      consume(dataSize_);
+      return false;
+    }
+  }
+}
+
+vector_size_t TextRowReader::tokenize(vector_size_t maxRows) {
+  const int32_t lastField = static_cast<int32_t>(fileType_->size()) - 1;
+  const bool lastColumnTakesRest = serDeOptions_.lastColumnTakesRest;
+  const char fieldDelim = static_cast<char>(serDeOptions_.separators[0]);
+  const char escapeChar = static_cast<char>(serDeOptions_.escapeChar);
+  vector_size_t numRows = 0;
+  int32_t rowStart = 0;
+  batchEnd_ = 0;
+  scanner_.reset(data_ ? data_->as<char>() : nullptr, dataSize_, 0);
+
+  // Moves the scanner to the row delimiter after 'offset' once the fields
+  // that are read have been found. The row delimiter is never escaped.
+  const auto skipToRowEnd = [&](int32_t offset) {
+    const char* data = data_->as<char>();
+    const auto* found = offset < dataSize_
+        ? static_cast<const char*>(
+              std::memchr(data + offset, kRowDelimiter, dataSize_ - offset))
+        : nullptr;
+    scanner_.seek(found == nullptr ? dataSize_ : found - data);
+  };
+
+  while (numRows < maxRows) {
+    if (dataFileOffset_ + rowStart >= splitEnd_) {
+      // Rows starting at or after the end of the split belong to the next
+      // split.
+      atEnd_ = true;
+      break;
+    }
+    const int32_t base = numRows * numTrackedFields_;
+    if (numTrackedFields_ > 0) {
+      fieldBegins_.resize(base + numTrackedFields_);
+      fieldEnds_.resize(base + numTrackedFields_);
+      fieldBegins_[base] = rowStart;
+    } else if (rowStart < dataSize_) {
+      skipToRowEnd(rowStart);
+    }
+    int32_t field = 0;
+    int32_t rowEnd;
+    for (;;) {
+      const auto pos = scanner_.next();
+      if (pos < 0) {
+        if (readMore()) {
+          scanner_.extend(data_->as<char>(), dataSize_);
+          continue;
+        }
+        rowEnd = dataSize_;
+        break;
+      }
+      const char c = data_->as<char>()[pos];
+      if (c == kRowDelimiter) {
+        rowEnd = pos;
+        break;
+      }
+      if (c == fieldDelim) {
+        if (lastColumnTakesRest && field == lastField) {
+          continue;
+        }
+        if (field < numTrackedFields_) {
+          fieldEnds_[base + field] = pos;
+          if (field + 1 < numTrackedFields_) {
+            fieldBegins_[base + field + 1] = pos + 1;
+          }
+        }
+        if (++field >= numTrackedFields_) {
+          skipToRowEnd(pos + 1);
+        }
+        continue;
+      }
+      VELOX_DCHECK_EQ(c, escapeChar);
+      if (pos + 1 == dataSize_ && readMore()) {
+        scanner_.extend(data_->as<char>(), dataSize_);
+      }
+      if (pos + 1 < dataSize_ && data_->as<char>()[pos + 1] != kRowDelimiter) {
+        scanner_.skip(pos + 1);
+      }
+    }
+    if (rowEnd == rowStart && rowEnd == dataSize_) {
+      // No bytes after the last row delimiter of the file.
+      atEnd_ = true;
+      break;
+    }
+    finishRow(numRows, field, rowEnd);
+    ++numRows;
+    if (rowEnd == dataSize_) {
+      // Last row of the file without a trailing row delimiter.
+      rowStart = dataSize_;
+      atEnd_ = true;
+      break;
+    }
+    rowStart = rowEnd + 1;
+  }
+  batchEnd_ = rowStart;
+  return numRows;
+}
+
+void TextRowReader::finishRow(
+    vector_size_t row,
+    int32_t numFields,
+    int32_t end) {
+  if (numFields >= numTrackedFields_) {
+    return;
+  }
+  const int32_t base = row * numTrackedFields_;
+  if (end > fieldBegins_[base + numFields] &&
+      data_->as<char>()[end - 1] == kCarriageReturn) {
+    --end;
+  }
+  fieldEnds_[base + numFields] = end;
+  // Fields missing from the end of the row are null.
+  for (auto i = numFields + 1; i < numTrackedFields_; ++i) {
+    fieldBegins_[base + i] = -1;
+  }
+}
+
+bool TextRowReader::isNullField(int32_t begin, int32_t end) const {
+  const auto& nullString = serDeOptions_.nullString;
+  return end - begin == nullString.size() &&
+      std::memcmp(data_->as<char>() + begin, nullString.data(), end - begin) ==
+      0;
+}
+
+template <TypeKind kKind>
+void TextRowReader::readColumnTyped(
+    const TypePtr& type,
+    int32_t field,
+    const uint64_t* rows,
+    vector_size_t numRows,
+    bool compact,
+    VectorPtr& result) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  const vector_size_t size =
+      compact ? bits::countBits(rows, 0, numRows) : numRows;
+  result = BaseVector::create(type, size, &pool_);
+  auto* flat = result->asUnchecked<FlatVector<T>>();
+  const char* data = data_->as<char>();
+  const bool escaped = serDeOptions_.isEscaped;
+  const char escapeChar = static_cast<char>(serDeOptions_.escapeChar);
+  bool sharesData = false;
+
+  const auto readValue = [&](vector_size_t row, vector_size_t index) {
+    const auto begin = fieldBegins_[row * numTrackedFields_ + field];
+    if (begin < 0) {
+      flat->setNull(index, true);
+      return;
+    }
+    const auto end = fieldEnds_[row * numTrackedFields_ + field];
+    if (isNullField(begin, end)) {
+      flat->setNull(index, true);
+      return;
+    }
+    const char* value = data + begin;
+    const int32_t length = end - begin;
+    if constexpr (kKind == TypeKind::VARCHAR) {
+      if (escaped && std::memchr(value, escapeChar, length) != nullptr) {
+        const auto unescaped = unescape(value, length, escapeChar);
+        flat->set(index, StringView(unescaped));
+      } else {
+        flat->setNoCopy(index, StringView(value, length));
+        sharesData = true;
+      }
+    } else if constexpr (kKind == TypeKind::VARBINARY) {
+      const auto decoded =
+          encoding::Base64::decode(folly::StringPiece(value, length));
+      flat->set(index, StringView(decoded));
+    } else {
+      T parsed;
+      if (parseValue<kKind>(*type, value, length, parsed)) {
+        flat->set(index, parsed);
+      } else {
+        // Values that do not parse as the column type are read as null.
+        flat->setNull(index, true);
+      }
+    }
+  };
+
+  if (compact) {
+    vector_size_t index = 0;
+    bits::forEachSetBit(
+        rows, 0, numRows, [&](auto row) { readValue(row, index++); });
+  } else {
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      if (bits::isBitSet(rows, row)) {
+        readValue(row, row);
+      } else {
+        flat->setNull(row, true);
+      }
+    }
+  }
+  if constexpr (std::is_same_v<T, StringView>) {
+    if (sharesData) {
+      flat->addStringBuffer(data_);
+    }
+  }
+}
+
+void TextRowReader::readColumn(
+    const TypePtr& type,
+    int32_t field,
+    const uint64_t* rows,
+    vector_size_t numRows,
+    bool compact,
+    VectorPtr& result) {
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      readColumnTyped,
+      type->kind(),
+      type,
+      field,
+      rows,
+      numRows,
+      compact,
+      result);
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const Mutation* mutation) {
+  VELOX_CHECK_GT(size, 0);
+  if (!initialized_) {
+    initialize();
+  }
+  if (atEnd_) {
+    return 0;
+  }
+  const auto numRows = tokenize(std::min<uint64_t>(
+      size, std::numeric_limits<vector_size_t>::max()));
+  if (numRows == 0) {
+    atEnd_ = true;
+    return 0;
+  }
+  scanSpec_->newRead();
+
+  std::vector<uint64_t> passed(bits::nwords(numRows), -1);
+  if (mutation) {
+    if (mutation->deletedRows) {
+      bits::andWithNegatedBits(
+          passed.data(), mutation->deletedRows, 0, numRows);
+    }
+    if (mutation->randomSkip) {
+      bits::forEachSetBit(passed.data(), 0, numRows, [&](auto i) {
+        if (!mutation->randomSkip->testOne()) {
+          bits::clearBit(passed.data(), i);
+        }
+      });
+    }
+  }
+
+  // Columns with filters are parsed first, in the adaptive order of the scan
+  // spec, each only for the rows that passed the previous filters.
+  const auto& children = scanSpec_->children();
+  std::vector<VectorPtr> columns(children.size());
+  for (auto i = 0; i < children.size(); ++i) {
+    auto& child = children[i];
+    if (child->isConstant() || child->filter() == nullptr) {
+      continue;
+    }
+    const auto numIn = bits::countBits(passed.data(), 0, numRows);
+    if (numIn == 0) {
+      break;
+    }
+    SelectivityTimer timer(child->selectivity(), numIn);
+    const auto index = fileType_->getChildIdx(child->fieldName());
+    readColumn(
+        fileType_->childAt(index),
+        index,
+        passed.data(),
+        numRows,
+        false,
+        columns[i]);
+    child->applyFilter(*columns[i], passed.data());
+    child->selectivity().addOutput(
+        bits::countBits(passed.data(), 0, numRows));
+  }
+
+  const auto numPassed = bits::countBits(passed.data(), 0, numRows);
+  column_index_t numColumns = 0;
+  for (auto& child : children) {
+    if (child->projectOut()) {
+      numColumns = std::max(numColumns, child->channel() + 1);
+    }
+  }
+  std::vector<std::string> names(numColumns);
+  std::vector<TypePtr> types(numColumns);
+  std::vector<VectorPtr> outputs(numColumns);
+  BufferPtr indices;
+  for (auto i = 0; i < children.size(); ++i) {
+    auto& child = children[i];
+    if (!child->projectOut()) {
+      continue;
+    }
+    const auto channel = child->channel();
+    names[channel] = child->fieldName();
+    if (child->isConstant()) {
+      types[channel] = child->constantValue()->type();
+      if (numPassed > 0) {
+        outputs[channel] = BaseVector::wrapInConstant(
+            numPassed, 0, child->constantValue());
+      }
+      continue;
+    }
+    const auto index = fileType_->getChildIdx(child->fieldName());
+    types[channel] = fileType_->childAt(index);
+    if (numPassed == 0) {
+      continue;
+    }
+    if (columns[i] == nullptr) {
+      // Columns without filters are parsed only for the passing rows.
+      readColumn(
+          types[channel],
+          index,
+          passed.data(),
+          numRows,
+          true,
+          outputs[channel]);
+      continue;
+    }
+    if (numPassed == numRows) {
+      outputs[channel] = std::move(columns[i]);
+      continue;
+    }
+    if (indices == nullptr) {
+      indices = allocateIndices(numPassed, &pool_);
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      vector_size_t j = 0;
+      bits::forEachSetBit(passed.data(), 0, numRows, [&](auto row) {
+        rawIndices[j++] = row;
+      });
+    }
+    outputs[channel] = BaseVector::wrapInDictionary(
+        nullptr, indices, numPassed, std::move(columns[i]));
+  }
+
+  auto rowType = ROW(std::move(names), std::move(types));
+  if (numPassed == 0) {
+    result = RowVector::createEmpty(rowType, &pool_);
+  } else {
+    result = std::make_shared<RowVector>(
+        &pool_, rowType, nullptr, numPassed, std::move(outputs));
+  }
+  consume(batchEnd_);
+  rowsRead_ += numRows;
+  return numRows;
+}
+
+TextReader::TextReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : input_(std::move(input)),
+      options_(options),
+      fileType_(options_.fileSchema()),
+      typeWithId_([&]() {
+        VELOX_USER_CHECK_NOT_NULL(
+            fileType_, "TextReader requires the file schema to be set");
+        return dwio::common::TypeWithId::create(fileType_);
+      }()) {}
+
+std::unique_ptr<dwio::common::RowReader> TextReader::createRowReader(
+    const RowReaderOptions& options) const {
+  return std::make_unique<TextRowReader>(
+      input_,
+      fileType_,
+      options_.serDeOptions(),
+      options_.memoryPool(),
+      options);
+}
+
+} // namespace facebook::velox::text
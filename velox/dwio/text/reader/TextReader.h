@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/text/reader/TextParser.h"
+
+namespace facebook::velox::text {
+
+/// Implements the RowReader interface for delimited text files. A split covers
+/// the rows whose first byte lies in [offset, offset + length) of the row
+/// reader options. The last row of a split is read to its end even if it
+/// extends past the split, and a split that does not start at the beginning of
+/// the file skips the partial row it starts in, so that adjacent splits read
+/// every row exactly once.
+///
+/// Only the columns referenced by the ScanSpec are parsed. Columns with filters
+/// are parsed first and the remaining columns are parsed only for the rows
+/// that passed the filters.
+class TextRowReader : public dwio::common::RowReader {
+ public:
+  TextRowReader(
+      std::shared_ptr<dwio::common::BufferedInput> input,
+      RowTypePtr fileType,
+      const dwio::common::SerDeOptions& serDeOptions,
+      memory::MemoryPool& pool,
+      const dwio::common::RowReaderOptions& options);
+
+  ~TextRowReader() override = default;
+
+  /// Returns the number of rows read from the split so far. Row numbers are
+  /// relative to the start of the split since the number of rows before a
+  /// split in a text file is not known.
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  uint64_t next(
+      uint64_t size,
+      velox::VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& stats) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override;
+
+ private:
+  // Opens the stream and positions it at the first row of the split.
+  void initialize();
+
+  // Appends the next chunk of the stream to 'data_'. Returns false at end of
+  // file.
+  bool readMore();
+
+  // Drops the rows before 'offset' in 'data_'.
+  void consume(int32_t offset);
+
+  // Skips to the byte after the next row delimiter. Returns false if the end
+  // of file is reached first.
+  bool skipRow();
+
+  // Finds the field boundaries of up to 'maxRows' rows at the start of
+  // 'data_'. Returns the number of complete rows found and sets 'batchEnd_'.
+  vector_size_t tokenize(vector_size_t maxRows);
+
+  // Records the end of the current row at 'end' for a row with 'numFields'
+  // delimited fields seen so far.
+  void finishRow(vector_size_t row, int32_t numFields, int32_t end);
+
+  // Parses the field 'field' of the rows set in 'rows' into 'result'. If
+  // 'compact' is true, the values of the selected rows are written
+  // consecutively, otherwise rows not in 'rows' are set to null.
+  void readColumn(
+      const TypePtr& type,
+      int32_t field,
+      const uint64_t* rows,
+      vector_size_t numRows,
+      bool compact,
+      VectorPtr& result);
+
+  template <TypeKind kKind>
+  void readColumnTyped(
+      const TypePtr& type,
+      int32_t field,
+      const uint64_t* rows,
+      vector_size_t numRows,
+      bool compact,
+      VectorPtr& result);
+
+  bool isNullField(int32_t begin, int32_t end) const;
+
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const RowTypePtr fileType_;
+  const dwio::common::SerDeOptions serDeOptions_;
+  memory::MemoryPool& pool_;
+  const dwio::common::RowReaderOptions options_;
+  std::shared_ptr<common::ScanSpec> scanSpec_;
+
+  // Number of leading fields of each row whose boundaries are recorded. This
+  // is one past the last file column referenced by the scan spec.
+  int32_t numTrackedFields_{0};
+
+  DelimiterScanner scanner_;
+  std::unique_ptr<dwio::common::SeekableInputStream> stream_;
+  bool initialized_{false};
+  bool streamAtEnd_{false};
+  bool atEnd_{false};
+
+  // File offset one past the last byte a row of this split may start at.
+  uint64_t splitEnd_{0};
+  // Unconsumed bytes read from 'stream_', starting at a row boundary.
+  BufferPtr data_;
+  int32_t dataSize_{0};
+  // File offset of the first byte of 'data_'.
+  uint64_t dataFileOffset_{0};
+  // Offset in 'data_' after the last row returned by tokenize().
+  int32_t batchEnd_{0};
+
+  // Begin and end offsets in 'data_' of the tracked fields of each tokenized
+  // row, 'numTrackedFields_' entries per row. A begin of -1 denotes a field
+  // missing from the row.
+  std::vector<int32_t> fieldBegins_;
+  std::vector<int32_t> fieldEnds_;
+
+  uint64_t rowsRead_{0};
+  uint64_t bytesRead_{0};
+};
+
+/// Implements the Reader interface for delimited text files such as Hive text
+/// tables. Text files carry no schema, so the file schema must be set in the
+/// ReaderOptions. Delimiters, escaping and the null string are taken from the
+/// SerDeOptions.
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  ~TextReader() override = default;
+
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const RowTypePtr& rowType() const override {
+    return fileType_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const dwio::common::ReaderOptions options_;
+  const RowTypePtr fileType_;
+  const std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+};
+
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  TextReaderFactory() : ReaderFactory(dwio::common::FileFormat::TEXT) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(std::move(input), options);
+  }
+};
+
+} // namespace facebook::velox::text
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/file/File.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::text {
+namespace {
+
+class TextReaderTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      const std::string& data,
+      const RowTypePtr& schema,
+      const dwio::common::SerDeOptions& serDeOptions = {}) {
+    dwio::common::ReaderOptions options(pool());
+    options.setFileSchema(schema);
+    options.setSerDeOptions(serDeOptions);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), *pool());
+    return TextReaderFactory().createReader(std::move(input), options);
+  }
+
+  // Reads all rows of the range [offset, offset + length) in batches of
+  // 'batchSize'.
+  RowVectorPtr read(
+      dwio::common::Reader& reader,
+      std::shared_ptr<common::ScanSpec> scanSpec,
+      uint64_t offset = 0,
+      uint64_t length = std::numeric_limits<uint64_t>::max(),
+      uint64_t batchSize = 1'000,
+      uint64_t skipRows = 0) {
+    dwio::common::RowReaderOptions options;
+    options.setScanSpec(std::move(scanSpec));
+    options.range(offset, length);
+    options.setSkipRows(skipRows);
+    auto rowReader = reader.createRowReader(options);
+    RowVectorPtr result;
+    VectorPtr batch;
+    while (rowReader->next(batchSize, batch) > 0) {
+      if (result == nullptr) {
+        result = std::dynamic_pointer_cast<RowVector>(
+            BaseVector::create(batch->type(), 0, pool()));
+      }
+      result->append(batch.get());
+    }
+    EXPECT_EQ(rowReader->nextRowNumber(), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+
+  static std::shared_ptr<common::ScanSpec> makeScanSpec(const RowType& type) {
+    auto scanSpec = std::make_shared<common::ScanSpec>("root");
+    scanSpec->addAllChildFields(type);
+    return scanSpec;
+  }
+};
+
+TEST_F(TextReaderTest, delimiterScanner) {
+  std::string data(100, 'a');
+  data[3] = '\x01';
+  data[40] = '\n';
+  data[41] = '\x01';
+  data[97] = '\\';
+  DelimiterScanner scanner('\x01', '\n', '\\', true);
+  scanner.reset(data.data(), data.size(), 0);
+  EXPECT_EQ(scanner.next(), 3);
+  EXPECT_EQ(scanner.next(), 40);
+  scanner.skip(41);
+  EXPECT_EQ(scanner.next(), 97);
+  EXPECT_EQ(scanner.next(), -1);
+
+  data.append("\x01\x01");
+  scanner.extend(data.data(), data.size());
+  EXPECT_EQ(scanner.next(), 100);
+  scanner.seek(0);
+  EXPECT_EQ(scanner.next(), 3);
+
+  // A delimiter in every lane of the widest register, including the lanes
+  // above 32 and the sign bit of a 32 lane mask.
+  std::string delimiters(130, '\n');
+  scanner.reset(delimiters.data(), delimiters.size(), 0);
+  for (int32_t i = 0; i < delimiters.size(); ++i) {
+    ASSERT_EQ(scanner.next(), i);
+  }
+  EXPECT_EQ(scanner.next(), -1);
+}
+
+TEST_F(TextReaderTest, parseInteger) {
+  int64_t bigint;
+  EXPECT_TRUE(parseInteger<int64_t>("1234567890123", 13, bigint));
+  EXPECT_EQ(bigint, 1234567890123);
+  EXPECT_TRUE(parseInteger<int64_t>("-9223372036854775808", 20, bigint));
+  EXPECT_EQ(bigint, std::numeric_limits<int64_t>::min());
+  EXPECT_TRUE(parseInteger<int64_t>("+0000000000000000000042", 23, bigint));
+  EXPECT_EQ(bigint, 42);
+  EXPECT_FALSE(parseInteger<int64_t>("9223372036854775808", 19, bigint));
+  EXPECT_FALSE(parseInteger<int64_t>("12345678a", 9, bigint));
+  EXPECT_FALSE(parseInteger<int64_t>("1.5", 3, bigint));
+  EXPECT_FALSE(parseInteger<int64_t>("-", 1, bigint));
+  EXPECT_FALSE(parseInteger<int64_t>("", 0, bigint));
+
+  int8_t tinyint;
+  EXPECT_TRUE(parseInteger<int8_t>("-128", 4, tinyint));
+  EXPECT_EQ(tinyint, -128);
+  EXPECT_FALSE(parseInteger<int8_t>("128", 3, tinyint));
+}
+
+TEST_F(TextReaderTest, types) {
+  auto schema = ROW(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7"},
+      {BOOLEAN(),
+       SMALLINT(),
+       BIGINT(),
+       DOUBLE(),
+       VARCHAR(),
+       DATE(),
+       TIMESTAMP(),
+       VARBINARY()});
+  auto reader = createReader(
+      "true\x01"
+      "1\x01"
+      "10000000000\x01"
+      "1.5\x01"
+      "hello\x01"
+      "2024-01-31\x01"
+      "2024-01-31 01:02:03.004\x01"
+      "aGVsbG8=\n"
+      "FALSE\x01"
+      "x\x01\\N\x01"
+      "NaN\x01\x01"
+      "bad\x01\r\n"
+      "\x01"
+      "70000\n",
+      schema);
+  auto result = read(*reader, makeScanSpec(*schema));
+  auto expected = makeRowVector(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7"},
+      {
+          makeNullableFlatVector<bool>({true, false, std::nullopt}),
+          makeNullableFlatVector<int16_t>({1, std::nullopt, std::nullopt}),
+          makeNullableFlatVector<int64_t>(
+              {10'000'000'000, std::nullopt, std::nullopt}),
+          makeNullableFlatVector<double>(
+              {1.5, std::numeric_limits<double>::quiet_NaN(), std::nullopt}),
+          makeNullableFlatVector<std::string>({"hello", "", std::nullopt}),
+          makeNullableFlatVector<int32_t>(
+              {19'753, std::nullopt, std::nullopt}, DATE()),
+          makeNullableFlatVector<Timestamp>(
+              {Timestamp(1'706'662'923, 4'000'000),
+               std::nullopt,
+               std::nullopt}),
+          makeNullableFlatVector<std::string>(
+              {"hello", std::nullopt, std::nullopt}, VARBINARY()),
+      });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, filterAndProjection) {
+  auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), BIGINT()});
+  std::string data;
+  for (auto i = 0; i < 1'000; ++i) {
+    data += fmt::format("{}\x01s{}\x01{}\n", i, i, i * 2);
+  }
+  auto reader = createReader(data, schema);
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("root");
+  scanSpec->addField("c1", 0);
+  auto* c0 = scanSpec->getOrCreateChild("c0");
+  c0->setFilter(std::make_unique<common::BigintRange>(100, 199, false));
+  c0->setProjectOut(false);
+  auto result = read(*reader, scanSpec, 0, data.size(), 64);
+
+  auto expected = makeRowVector(
+      {"c1"},
+      {makeFlatVector<std::string>(
+          100, [](auto row) { return fmt::format("s{}", row + 100); })});
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, countOnly) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  std::string data;
+  for (auto i = 0; i < 500; ++i) {
+    data += fmt::format("{}\x01{}\n", i, i);
+  }
+  auto reader = createReader(data, schema);
+  auto result = read(
+      *reader,
+      std::make_shared<common::ScanSpec>("root"),
+      0,
+      data.size(),
+      7);
+  EXPECT_EQ(result->size(), 500);
+  EXPECT_EQ(result->childrenSize(), 0);
+}
+
+TEST_F(TextReaderTest, splits) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::string data;
+  for (auto i = 0; i < 200; ++i) {
+    data += fmt::format("{}\x01{}\n", i, std::string(i % 13, 'x'));
+  }
+  // No trailing row delimiter on the last row.
+  data.pop_back();
+  auto reader = createReader(data, schema);
+  auto expected = read(*reader, makeScanSpec(*schema));
+  ASSERT_EQ(expected->size(), 200);
+
+  // Every split point must yield each row exactly once.
+  for (auto splitPoint = 0; splitPoint <= data.size(); ++splitPoint) {
+    auto first = read(*reader, makeScanSpec(*schema), 0, splitPoint, 17);
+    auto second = read(
+        *reader,
+        makeScanSpec(*schema),
+        splitPoint,
+        data.size() - splitPoint,
+        17);
+    auto combined = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::create(expected->type(), 0, pool()));
+    if (first) {
+      combined->append(first.get());
+    }
+    if (second) {
+      combined->append(second.get());
+    }
+    test::assertEqualVectors(expected, combined);
+  }
+}
+
+TEST_F(TextReaderTest, skipHeader) {
+  auto schema = ROW({"c0"}, {VARCHAR()});
+  auto reader = createReader("name\nfirst\nsecond", schema);
+  auto result = read(
+      *reader,
+      makeScanSpec(*schema),
+      0,
+      std::numeric_limits<uint64_t>::max(),
+      1'000,
+      1);
+  test::assertEqualVectors(
+      makeRowVector({"c0"}, {makeFlatVector<std::string>({"first", "second"})}),
+      result);
+}
+
+TEST_F(TextReaderTest, customDelimiterAndEscape) {
+  auto schema = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+  dwio::common::SerDeOptions serDeOptions(',', '\2', '\3', '\\', true);
+  serDeOptions.nullString = "NULL";
+  auto reader =
+      createReader("a\\,b,1\nNULL,2\nc\\\\,3\n", schema, serDeOptions);
+  auto result = read(*reader, makeScanSpec(*schema));
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {makeNullableFlatVector<std::string>({"a,b", std::nullopt, "c\\"}),
+       makeFlatVector<int64_t>({1, 2, 3})});
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, lastColumnTakesRest) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  dwio::common::SerDeOptions serDeOptions(',');
+  serDeOptions.lastColumnTakesRest = true;
+  auto reader = createReader("1,a,b,c\n2,d\n", schema, serDeOptions);
+  auto result = read(*reader, makeScanSpec(*schema));
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>({1, 2}),
+       makeFlatVector<std::string>({"a,b,c", "d"})});
+  test::assertEqualVectors(expected, result);
+}
+
+} // namespace
+} // namespace facebook::velox::text
@@ -273,6 +273,14 @@ class Aggregate {
     }
   }
 
+  // Clears the null flags of 'groups'. Must be called before initializing
+  // destroyed groups again with initializeNewGroups().
+  void clearNulls(folly::Range<char**> groups) {
+    for (auto* group : groups) {
+      clearNull(group);
+    }
+  }
+
   // Clears state between reuses, e.g. this is called before reusing
   // the aggregation operator's state after flushing a partial
   // aggregation.
@@ -16,6 +16,7 @@
 
 #include "velox/exec/Driver.h"
 
+#include "velox/common/process/Numa.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/exec/Task.h"
 
@@ -768,6 +769,8 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
+  process::ScopedNumaNodeAffinity numaNodeAffinity(
+      self->driverCtx()->queryConfig().driverNumaNode());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
   auto reason = self->runInternal(self, blockingState, nullResult);
@@ -72,6 +72,9 @@ GroupingSet::GroupingSet(
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
+      compactionFragmentationRatio_(
+          queryConfig_.aggregationCompactionFragmentationRatio()),
+      compactionMinBytes_(queryConfig_.aggregationCompactionMinBytes()),
       pool_(*operatorCtx->pool()),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
@@ -330,7 +333,7 @@ void initializeAggregates(
   int i = 0;
   for (auto& aggregate : aggregates) {
     auto& function = aggregate.function;
-    function->setAllocator(&rows.stringAllocator());
+    function->setAllocator(&rows.accumulatorAllocator());
     if (excludeToIntermediate && function->supportsToIntermediate()) {
       continue;
     }
@@ -381,6 +384,17 @@ void GroupingSet::createHashTable() {
   }
 
   RowContainer& rows = *table_->rows();
+  // Sorted and distinct aggregations keep their inputs in the string allocator
+  // and cannot be rebuilt from intermediate results, so only plain aggregates
+  // get an allocator of their own.
+  if (compactionFragmentationRatio_ > 0 && !isPartial_ &&
+      sortedAggregations_ == nullptr &&
+      std::none_of(
+          aggregates_.begin(), aggregates_.end(), [](const auto& aggregate) {
+            return aggregate.distinct;
+          })) {
+    rows.setSeparateAccumulatorAllocator();
+  }
   initializeAggregates(aggregates_, rows, false);
 
   auto numColumns = rows.keyTypes().size() + aggregates_.size();
@@ -869,7 +883,7 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
   auto* rows = table_->rows();
   auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
   const auto outOfLineBytes =
-      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
+      rows->variableLengthRetainedBytes() - outOfLineFreeBytes;
   const int64_t flatBytes = input->estimateFlatSize();
 
   // Test-only spill path.
@@ -911,6 +925,14 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
     }
   }
 
+  // Rebuilding fragmented accumulators may free enough memory to take the
+  // input without growing the reservation. This is not a reclaimable section,
+  // so the rebuild must not grow the reservation either.
+  if (compactAccumulators(/*withinReservation=*/true) > 0 &&
+      pool_.availableReservation() > 2 * incrementBytes) {
+    return;
+  }
+
   // Check if we can increase reservation. The increment is the larger of twice
   // the maximum increment from this input and 'spillableReservationGrowthPct_'
   // of the current memory usage.
@@ -1031,7 +1053,7 @@ void GroupingSet::spill() {
   // allocate/deallocate memory during spilling it can lead to concurrency bugs.
   // Freeze the HashStringAllocator to make it effectively immutable and
   // guarantee we don't accidentally enter an unsafe situation.
-  rows->stringAllocator().freezeAndExecute([&]() { inputSpiller_->spill(); });
+  rows->freezeAllocatorsAndExecute([&]() { inputSpiller_->spill(); });
   if (isDistinct() && numDistinctSpillFilesPerPartition_.empty()) {
     size_t totalNumDistinctSpilledFiles{0};
     numDistinctSpillFilesPerPartition_.resize(
@@ -1068,7 +1090,7 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
   // allocate/deallocate memory during spilling it can lead to concurrency bugs.
   // Freeze the HashStringAllocator to make it effectively immutable and
   // guarantee we don't accidentally enter an unsafe situation.
-  rows->stringAllocator().freezeAndExecute(
+  rows->freezeAllocatorsAndExecute(
       [&]() { outputSpiller_->spill(rowIterator); });
   table_->clear(/*freeTable=*/true);
 }
@@ -1480,6 +1502,84 @@ std::optional<int64_t> GroupingSet::estimateOutputRowSize() const {
   return table_->rows()->estimateRowSize();
 }
 
+uint64_t GroupingSet::compactAccumulators(bool withinReservation) {
+  if (table_ == nullptr ||
+      !table_->rows()->hasSeparateAccumulatorAllocator()) {
+    return 0;
+  }
+  auto* rows = table_->rows();
+  auto& allocator = rows->accumulatorAllocator();
+  const uint64_t retainedBytes = allocator.retainedSize();
+  const uint64_t freeBytes = allocator.freeSpace();
+  if (freeBytes < compactionMinBytes_ ||
+      freeBytes < compactionFragmentationRatio_ * retainedBytes) {
+    return 0;
+  }
+  // The accumulators are copied out before 'allocator' is cleared, so the
+  // rebuild temporarily needs about as much memory as they use.
+  if (withinReservation &&
+      pool_.availableReservation() < retainedBytes - freeBytes) {
+    return 0;
+  }
+
+  const auto numRows = rows->numRows();
+  std::vector<char*> groups(numRows);
+  RowContainerIterator iter;
+  VELOX_CHECK_EQ(
+      rows->listRows(&iter, numRows, RowContainer::kUnlimited, groups.data()),
+      numRows);
+
+  // The row sizes would double count the rebuilt accumulators. Keep the sizes
+  // from before, which stay a valid cap.
+  std::vector<uint32_t> rowSizes;
+  if (rows->rowSizeOffset() != 0) {
+    rowSizes.reserve(numRows);
+    for (auto* group : groups) {
+      rowSizes.push_back(rows->variableRowSize(group));
+    }
+  }
+
+  std::vector<VectorPtr> accumulators(aggregates_.size());
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& function = aggregates_[i].function;
+    if (!function->accumulatorUsesExternalMemory()) {
+      continue;
+    }
+    accumulators[i] =
+        BaseVector::create(aggregates_[i].intermediateType, numRows, &pool_);
+    function->extractAccumulators(groups.data(), numRows, &accumulators[i]);
+    function->destroy(folly::Range<char**>(groups.data(), numRows));
+    // The groups are initialized again below.
+    function->clearNulls(folly::Range<char**>(groups.data(), numRows));
+  }
+  allocator.clear();
+
+  std::vector<vector_size_t> indices(numRows);
+  std::iota(indices.begin(), indices.end(), 0);
+  const SelectivityVector allRows(numRows);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (accumulators[i] == nullptr) {
+      continue;
+    }
+    auto& function = aggregates_[i].function;
+    function->initializeNewGroups(
+        groups.data(),
+        folly::Range<const vector_size_t*>(indices.data(), numRows));
+    function->addIntermediateResults(
+        groups.data(), allRows, {accumulators[i]}, /*mayPushdown=*/false);
+    accumulators[i].reset();
+  }
+
+  for (auto i = 0; i < rowSizes.size(); ++i) {
+    rows->variableRowSize(groups[i]) = rowSizes[i];
+  }
+
+  const auto releasedBytes =
+      retainedBytes - std::min(retainedBytes, allocator.retainedSize());
+  compactedAccumulatorBytes_ += releasedBytes;
+  return releasedBytes;
+}
+
 AggregationInputSpiller::AggregationInputSpiller(
     RowContainer* container,
     RowTypePtr rowType,
@@ -154,6 +154,19 @@ class GroupingSet {
 
   std::optional<int64_t> estimateOutputRowSize() const;
 
+  /// Rebuilds the variable length state of the accumulators in a fresh
+  /// allocator if it is kept apart from the grouping keys and at least
+  /// 'aggregation_compaction_fragmentation_ratio' of it, and no less than
+  /// 'aggregation_compaction_min_bytes', is free. If 'withinReservation' is
+  /// true, compacts only if the available reservation of the pool covers the
+  /// memory needed while rebuilding. Returns the number of bytes released.
+  uint64_t compactAccumulators(bool withinReservation);
+
+  /// Returns the number of bytes released by compactAccumulators() so far.
+  uint64_t compactedAccumulatorBytes() const {
+    return compactedAccumulatorBytes_;
+  }
+
  private:
   bool isDistinct() const {
     return aggregates_.empty();
@@ -334,6 +347,11 @@ class GroupingSet {
   HashStringAllocator stringAllocator_;
   memory::AllocationPool rows_;
   const bool isAdaptive_;
+  // See QueryConfig::kAggregationCompactionFragmentationRatio.
+  const double compactionFragmentationRatio_;
+  // See QueryConfig::kAggregationCompactionMinBytes.
+  const uint64_t compactionMinBytes_;
+  uint64_t compactedAccumulatorBytes_{0};
 
   bool noMoreInput_{false};
 
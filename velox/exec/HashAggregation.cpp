@@ -242,6 +242,10 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (const auto compactedBytes = groupingSet_->compactedAccumulatorBytes()) {
+    runtimeStats[kCompactedAccumulatorBytes] =
+        RuntimeMetric(compactedBytes, RuntimeCounter::Unit::kBytes);
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -478,8 +482,16 @@ void HashAggregation::reclaim(
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
   } else {
-    // TODO: support fine-grain disk spilling based on 'targetBytes' after
-    // having row container memory compaction support later.
+    // Rebuilding fragmented accumulators within the existing reservation may
+    // free enough memory to avoid spilling.
+    // TODO: support fine-grain disk spilling based on 'targetBytes'.
+    // A 'targetBytes' of 0 asks to reclaim all memory, which needs a spill.
+    if (targetBytes != 0 &&
+        groupingSet_->compactAccumulators(/*withinReservation=*/true) >=
+            targetBytes) {
+      pool()->release();
+      return;
+    }
     groupingSet_->spill();
   }
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
@@ -27,6 +27,11 @@ class HashAggregation : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::AggregationNode>& aggregationNode);
 
+  /// Runtime stat: the bytes released by rebuilding fragmented accumulators.
+  /// See QueryConfig::kAggregationCompactionFragmentationRatio.
+  static inline const std::string kCompactedAccumulatorBytes{
+      "compactedAccumulatorBytes"};
+
   void initialize() override;
 
   void addInput(RowVectorPtr input) override;
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/LocalPartition.h"
+#include "velox/exec/RoundRobinPartitionFunction.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -111,6 +112,7 @@ BlockingReason LocalExchangeQueue::enqueue(
       return true;
     }
     queue.emplace(std::move(input), inputBytes);
+    bufferedBytes_ += inputBytes;
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -166,6 +168,7 @@ BlockingReason LocalExchangeQueue::next(
 
     std::tie(*data, size) = std::move(queue.front());
     queue.pop();
+    bufferedBytes_ -= size;
 
     memoryPromises = memoryManager_->decreaseMemoryUsage(size);
 
@@ -208,6 +211,7 @@ void LocalExchangeQueue::close() {
       freedBytes += queue.front().second;
       queue.pop();
     }
+    bufferedBytes_ = 0;
 
     if (freedBytes) {
       memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
@@ -233,6 +237,7 @@ LocalExchange::LocalExchange(
           planNodeId,
           "LocalExchange"),
       partition_{partition},
+      numaLocal_{ctx->queryConfig().numaLocalExchangeEnabled()},
       queue_{operatorCtx_->task()->getLocalExchangeQueue(
           ctx->splitGroupId,
           planNodeId,
@@ -250,6 +255,9 @@ BlockingReason LocalExchange::isBlocked(ContinueFuture* future) {
 }
 
 RowVectorPtr LocalExchange::getOutput() {
+  if (numaLocal_) {
+    queue_->setConsumerNumaNode(process::currentNumaNode());
+  }
   RowVectorPtr data;
   blockingReason_ = queue_->next(&future_, pool(), &data);
   if (blockingReason_ != BlockingReason::kNotBlocked) {
@@ -283,7 +291,15 @@ LocalPartition::LocalPartition(
           numPartitions_ == 1 ? nullptr
                               : planNode->partitionFunctionSpec().create(
                                     numPartitions_,
-                                    /*localExchange=*/true)) {
+                                    /*localExchange=*/true)),
+      numaLocal_{
+          numPartitions_ > 1 &&
+          ctx->queryConfig().numaLocalExchangeEnabled() &&
+          dynamic_cast<const RoundRobinPartitionFunctionSpec*>(
+              &planNode->partitionFunctionSpec()) != nullptr},
+      maxNumaLocalQueueBytes_{static_cast<int64_t>(
+          ctx->queryConfig().maxLocalExchangeBufferSize() /
+          std::max<size_t>(numPartitions_, 1))} {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
@@ -314,6 +330,23 @@ void LocalPartition::allocateIndexBuffers(
   }
 }
 
+// static
+uint32_t LocalPartition::numaLocalPartition(
+    const std::vector<std::shared_ptr<LocalExchangeQueue>>& queues,
+    uint32_t partition,
+    int32_t node,
+    int64_t maxQueueBytes) {
+  for (size_t i = 0; i < queues.size(); ++i) {
+    const auto candidate = (partition + i) % queues.size();
+    const auto& queue = queues[candidate];
+    if (queue->consumerNumaNode() == node &&
+        queue->bufferedBytes() < maxQueueBytes) {
+      return candidate;
+    }
+  }
+  return partition;
+}
+
 RowVectorPtr LocalPartition::wrapChildren(
     const RowVectorPtr& input,
     vector_size_t size,
@@ -359,9 +392,16 @@ void LocalPartition::addInput(RowVectorPtr input) {
       ? 0
       : partitionFunction_->partition(*input, partitions_);
   if (singlePartition.has_value()) {
+    const auto partition = numaLocal_
+        ? numaLocalPartition(
+              queues_,
+              singlePartition.value(),
+              process::currentNumaNode(),
+              maxNumaLocalQueueBytes_)
+        : singlePartition.value();
     ContinueFuture future;
-    auto blockingReason = queues_[singlePartition.value()]->enqueue(
-        input, input->retainedSize(), &future);
+    auto blockingReason =
+        queues_[partition]->enqueue(input, input->retainedSize(), &future);
     if (blockingReason != BlockingReason::kNotBlocked) {
       blockingReasons_.push_back(blockingReason);
       futures_.push_back(std::move(future));
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/process/Numa.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
@@ -126,6 +127,22 @@ class LocalExchangeQueue {
     return vectorPool_->pop();
   }
 
+  /// Records the NUMA node the consumer of this queue runs on.
+  void setConsumerNumaNode(int32_t node) {
+    consumerNumaNode_ = node;
+  }
+
+  /// Returns the NUMA node the consumer of this queue last ran on, kNoNumaNode
+  /// if not recorded.
+  int32_t consumerNumaNode() const {
+    return consumerNumaNode_;
+  }
+
+  /// Returns the size in bytes of the data buffered in this queue.
+  int64_t bufferedBytes() const {
+    return bufferedBytes_;
+  }
+
   /// Returns true if all producers have sent no more data signal.
   bool testingProducersDone() const;
 
@@ -146,6 +163,8 @@ class LocalExchangeQueue {
   int pendingProducers_{0};
   bool noMoreProducers_{false};
   bool closed_{false};
+  tsan_atomic<int32_t> consumerNumaNode_{process::kNoNumaNode};
+  tsan_atomic<int64_t> bufferedBytes_{0};
 };
 
 /// Fetches data for a single partition produced by local exchange from
@@ -180,6 +199,8 @@ class LocalExchange : public SourceOperator {
 
  private:
   const int partition_;
+  // If true, records the NUMA node this runs on in 'queue_'.
+  const bool numaLocal_;
   const std::shared_ptr<LocalExchangeQueue> queue_{nullptr};
   ContinueFuture future_;
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
@@ -216,6 +237,18 @@ class LocalPartition : public Operator {
 
   bool isFinished() override;
 
+  /// Returns the partition that a round robin batch for 'partition' goes to
+  /// when the producer runs on NUMA node 'node'. This is the first partition,
+  /// starting at 'partition', whose consumer last ran on 'node' and whose
+  /// queue buffers less than 'maxQueueBytes'. Returns 'partition' if there is
+  /// none, so that batches are not piled on the consumers of one node when
+  /// these fall behind.
+  static uint32_t numaLocalPartition(
+      const std::vector<std::shared_ptr<LocalExchangeQueue>>& queues,
+      uint32_t partition,
+      int32_t node,
+      int64_t maxQueueBytes);
+
  protected:
   void prepareForInput(RowVectorPtr& input);
 
@@ -230,6 +263,12 @@ class LocalPartition : public Operator {
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // If true, round robin batches go to the consumers on the NUMA node of the
+  // producer when there are any.
+  const bool numaLocal_;
+  // The share of the local exchange buffer of one queue. A round robin batch
+  // goes to a queue on the producer's node only if the queue buffers less.
+  const int64_t maxNumaLocalQueueBytes_;
 
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
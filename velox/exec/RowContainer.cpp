@@ -1029,6 +1029,9 @@ void RowContainer::clear() {
 
   rows_.clear();
   stringAllocator_->clear();
+  if (accumulatorAllocator_ != nullptr) {
+    accumulatorAllocator_->clear();
+  }
   numRows_ = 0;
   numRowsWithNormalizedKey_ = 0;
   normalizedKeySize_ = originalNormalizedKeySize_;
@@ -1083,13 +1086,29 @@ void RowContainer::extractProbedFlags(
   }
 }
 
+void RowContainer::setSeparateAccumulatorAllocator() {
+  VELOX_CHECK_EQ(numRows_, 0);
+  VELOX_CHECK_NULL(accumulatorAllocator_);
+  accumulatorAllocator_ = std::make_unique<HashStringAllocator>(pool());
+}
+
+void RowContainer::freezeAllocatorsAndExecute(
+    const std::function<void()>& func) {
+  if (accumulatorAllocator_ == nullptr) {
+    stringAllocator_->freezeAndExecute(func);
+    return;
+  }
+  stringAllocator_->freezeAndExecute(
+      [&]() { accumulatorAllocator_->freezeAndExecute(func); });
+}
+
 std::optional<int64_t> RowContainer::estimateRowSize() const {
   if (numRows_ == 0) {
     return std::nullopt;
   }
   int64_t freeBytes = rows_.freeBytes() + fixedRowSize_ * numFreeRows_;
   int64_t usedSize = rows_.allocatedBytes() - freeBytes +
-      stringAllocator_->retainedSize() - stringAllocator_->freeSpace();
+      variableLengthRetainedBytes() - freeSpace().second;
   int64_t rowSize = usedSize / numRows_;
   VELOX_CHECK_GT(
       rowSize, 0, "Estimated row size of the RowContainer must be positive.");
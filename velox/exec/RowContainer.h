@@ -327,6 +327,13 @@ class RowContainer {
              : 0);
   }
 
+  /// Returns the size of the out-of-line variable length data of 'row'. Only
+  /// valid if rowSizeOffset() is non-zero.
+  uint32_t& variableRowSize(char* row) const {
+    VELOX_DCHECK(rowSizeOffset_);
+    return *reinterpret_cast<uint32_t*>(row + rowSizeOffset_);
+  }
+
   /// Sets all fields, aggregates, keys and dependents to null. Used when making
   /// a row with uninitialized keys for aggregates with no-op partial
   /// aggregation.
@@ -389,6 +396,31 @@ class RowContainer {
     return *stringAllocator_;
   }
 
+  /// Makes the accumulators allocate their variable length state from an
+  /// allocator of their own instead of the one shared with keys and dependent
+  /// columns. This allows clearing and rebuilding the accumulator state
+  /// without touching the keys. Must be called before any row is added.
+  void setSeparateAccumulatorAllocator();
+
+  bool hasSeparateAccumulatorAllocator() const {
+    return accumulatorAllocator_ != nullptr;
+  }
+
+  /// Returns the allocator for the variable length state of accumulators.
+  HashStringAllocator& accumulatorAllocator() {
+    return accumulatorAllocator_ ? *accumulatorAllocator_ : *stringAllocator_;
+  }
+
+  /// Returns the bytes retained by the allocators for variable length data.
+  uint64_t variableLengthRetainedBytes() const {
+    return stringAllocator_->retainedSize() +
+        (accumulatorAllocator_ ? accumulatorAllocator_->retainedSize() : 0);
+  }
+
+  /// Runs 'func' with the allocators for variable length data frozen. See
+  /// HashStringAllocator::freezeAndExecute().
+  void freezeAllocatorsAndExecute(const std::function<void()>& func);
+
   /// Returns the number of used rows in 'this'. This is the number of rows a
   /// RowContainerIterator would access.
   int64_t numRows() const {
@@ -776,7 +808,7 @@ class RowContainer {
       uint64_t* result) const;
 
   uint64_t allocatedBytes() const {
-    return rows_.allocatedBytes() + stringAllocator_->retainedSize();
+    return rows_.allocatedBytes() + variableLengthRetainedBytes();
   }
 
   /// Returns the number of fixed size rows that can be allocated without
@@ -785,7 +817,8 @@ class RowContainer {
   std::pair<uint64_t, uint64_t> freeSpace() const {
     return std::make_pair<uint64_t, uint64_t>(
         rows_.freeBytes() / fixedRowSize_ + numFreeRows_,
-        stringAllocator_->freeSpace());
+        stringAllocator_->freeSpace() +
+            (accumulatorAllocator_ ? accumulatorAllocator_->freeSpace() : 0));
   }
 
   /// Returns the average size of rows in bytes stored in this container.
@@ -1017,11 +1050,6 @@ class RowContainer {
     return *reinterpret_cast<char**>(row + kNextFreeOffset);
   }
 
-  uint32_t& variableRowSize(char* row) const {
-    VELOX_DCHECK(rowSizeOffset_);
-    return *reinterpret_cast<uint32_t*>(row + rowSizeOffset_);
-  }
-
   template <TypeKind Kind>
   inline void storeWithNulls(
       const DecodedVector& decoded,
@@ -1507,6 +1535,10 @@ class RowContainer {
 
   const std::unique_ptr<HashStringAllocator> stringAllocator_;
 
+  // Allocator for the variable length state of accumulators if separate from
+  // 'stringAllocator_'. See setSeparateAccumulatorAllocator().
+  std::unique_ptr<HashStringAllocator> accumulatorAllocator_;
+
   // Indicates if we can add new row to this row container. It is set to false
   // after user calls 'getRowPartitions()' to create 'rowPartitions' object for
   // parallel join build.
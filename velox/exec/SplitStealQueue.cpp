@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SplitStealQueue.h"
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::exec {
+
+SplitStealQueue::DividedSplit::DividedSplit(
+    std::shared_ptr<connector::ConnectorSplit> split,
+    uint64_t chunkBytes)
+    : split_(std::move(split)),
+      size_(split_->divisibleSize()),
+      chunkBytes_(std::max<uint64_t>(
+          chunkBytes,
+          bits::divRoundUp(size_, kMaxChunks))),
+      numChunks_(
+          static_cast<uint32_t>(bits::divRoundUp(size_, chunkBytes_))) {
+  VELOX_CHECK_GT(chunkBytes, 0);
+  VELOX_CHECK_GT(size_, 0);
+}
+
+std::shared_ptr<connector::ConnectorSplit>
+SplitStealQueue::DividedSplit::nextChunk() {
+  if (nextChunk_.load() >= numChunks_) {
+    return nullptr;
+  }
+  const auto chunk = nextChunk_++;
+  if (chunk >= numChunks_) {
+    return nullptr;
+  }
+  const uint64_t offset = chunk * chunkBytes_;
+  return split_->subSplit(offset, std::min(chunkBytes_, size_ - offset));
+}
+
+bool SplitStealQueue::DividedSplit::chunkFinished() {
+  const auto numFinished = ++numFinishedChunks_;
+  VELOX_CHECK_LE(numFinished, numChunks_);
+  return numFinished == numChunks_;
+}
+
+SplitStealQueue::SplitStealQueue(uint64_t chunkBytes)
+    : chunkBytes_(chunkBytes) {
+  VELOX_CHECK_GT(chunkBytes_, 0);
+}
+
+std::shared_ptr<connector::ConnectorSplit> SplitStealQueue::divide(
+    const std::shared_ptr<connector::ConnectorSplit>& split,
+    std::shared_ptr<DividedSplit>& dividedSplit) {
+  dividedSplit = nullptr;
+  if (split->divisibleSize() <= chunkBytes_) {
+    return nullptr;
+  }
+  auto newSplit = std::make_shared<DividedSplit>(split, chunkBytes_);
+  // The first chunk is claimed before the split is visible to other drivers.
+  auto chunk = newSplit->nextChunk();
+  VELOX_CHECK_NOT_NULL(chunk);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    splits_.push_back(newSplit);
+  }
+  dividedSplit = std::move(newSplit);
+  return chunk;
+}
+
+std::shared_ptr<connector::ConnectorSplit> SplitStealQueue::steal(
+    std::shared_ptr<DividedSplit>& dividedSplit) {
+  dividedSplit = nullptr;
+  std::lock_guard<std::mutex> l(mutex_);
+  for (;;) {
+    std::shared_ptr<DividedSplit> best;
+    for (auto it = splits_.begin(); it != splits_.end();) {
+      const auto numUnclaimed = (*it)->numUnclaimedChunks();
+      if (numUnclaimed == 0) {
+        it = splits_.erase(it);
+        continue;
+      }
+      if (best == nullptr || numUnclaimed > best->numUnclaimedChunks()) {
+        best = *it;
+      }
+      ++it;
+    }
+    if (best == nullptr) {
+      return nullptr;
+    }
+    // The owner or a driver that stole from 'best' before may claim the
+    // remaining chunks between the check above and here.
+    if (auto chunk = best->nextChunk()) {
+      dividedSplit = std::move(best);
+      return chunk;
+    }
+  }
+}
+
+size_t SplitStealQueue::numSplits() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return splits_.size();
+}
+
+} // namespace facebook::velox::exec
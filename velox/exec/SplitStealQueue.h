@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <deque>
+#include <mutex>
+
+#include "velox/connectors/Connector.h"
+
+namespace facebook::velox::exec {
+
+/// Divides the splits of a table scan into chunks of byte ranges, e.g. a few
+/// stripes or row groups each, that the scan drivers of the same plan node
+/// claim one at a time. A driver that runs out of splits steals the unclaimed
+/// chunks of the splits other drivers are reading instead of idling while a
+/// few large splits finish. Shared by the table scan operators of a plan node
+/// in a split group. Thread safe.
+class SplitStealQueue {
+ public:
+  /// A split divided into chunks. The chunks are handed out in order through a
+  /// cursor shared by the driver that divided the split and the drivers that
+  /// steal from it.
+  class DividedSplit {
+   public:
+    /// Upper bound on the number of chunks of a split. Chunks are made larger
+    /// than 'chunkBytes' if needed.
+    static constexpr uint32_t kMaxChunks = 1 << 16;
+
+    DividedSplit(
+        std::shared_ptr<connector::ConnectorSplit> split,
+        uint64_t chunkBytes);
+
+    /// Claims the next chunk. Returns nullptr if all chunks are claimed.
+    std::shared_ptr<connector::ConnectorSplit> nextChunk();
+
+    /// Invoked after a claimed chunk has been read. Returns true if this was
+    /// the last chunk of the split to finish.
+    bool chunkFinished();
+
+    /// Returns the number of chunks not claimed yet.
+    uint32_t numUnclaimedChunks() const {
+      const auto next = nextChunk_.load();
+      return next >= numChunks_ ? 0 : numChunks_ - next;
+    }
+
+    uint32_t numChunks() const {
+      return numChunks_;
+    }
+
+    const std::shared_ptr<connector::ConnectorSplit>& split() const {
+      return split_;
+    }
+
+   private:
+    const std::shared_ptr<connector::ConnectorSplit> split_;
+    const uint64_t size_;
+    const uint64_t chunkBytes_;
+    const uint32_t numChunks_;
+
+    std::atomic_uint32_t nextChunk_{0};
+    std::atomic_uint32_t numFinishedChunks_{0};
+  };
+
+  /// 'chunkBytes' is the size of the byte range of a chunk.
+  explicit SplitStealQueue(uint64_t chunkBytes);
+
+  SplitStealQueue(const SplitStealQueue&) = delete;
+  SplitStealQueue& operator=(const SplitStealQueue&) = delete;
+
+  /// Divides 'split' into chunks and returns the first chunk, claimed for the
+  /// caller. The other chunks can be stolen from then on. Sets 'dividedSplit'
+  /// to the divided split. Returns nullptr and sets 'dividedSplit' to nullptr
+  /// if 'split' does not divide into more than one chunk.
+  std::shared_ptr<connector::ConnectorSplit> divide(
+      const std::shared_ptr<connector::ConnectorSplit>& split,
+      std::shared_ptr<DividedSplit>& dividedSplit);
+
+  /// Claims a chunk of the divided split with the most unclaimed chunks and
+  /// sets 'dividedSplit' to that split. Returns nullptr if no split has
+  /// unclaimed chunks.
+  std::shared_ptr<connector::ConnectorSplit> steal(
+      std::shared_ptr<DividedSplit>& dividedSplit);
+
+  uint64_t chunkBytes() const {
+    return chunkBytes_;
+  }
+
+  /// Returns the number of divided splits that may have unclaimed chunks.
+  size_t numSplits() const;
+
+ private:
+  const uint64_t chunkBytes_;
+
+  mutable std::mutex mutex_;
+  std::deque<std::shared_ptr<DividedSplit>> splits_;
+};
+
+} // namespace facebook::velox::exec
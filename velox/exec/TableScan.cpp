@@ -50,6 +50,9 @@ TableScan::TableScan(
       getOutputTimeLimitMs_(
           driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()),
       scaledController_(driverCtx_->task->getScaledScanControllerLocked(
+          driverCtx_->splitGroupId,
+          planNodeId())),
+      splitStealQueue_(driverCtx_->task->getSplitStealQueueLocked(
           driverCtx_->splitGroupId,
           planNodeId())) {
   readBatchSize_ = driverCtx_->queryConfig().preferredOutputBatchRows();
@@ -115,20 +118,29 @@ RowVectorPtr TableScan::getOutput() {
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
+      // Continues with the chunks of the split of the previous chunk, then
+      // takes a new split from the task and steals chunks of the splits of
+      // other drivers once the task has no more splits.
+      auto connectorSplit = nextChunk();
       exec::Split split;
-      curStatus_ = "getOutput: task->getSplitOrFuture";
-      blockingReason_ = driverCtx_->task->getSplitOrFuture(
-          driverCtx_->splitGroupId,
-          planNodeId(),
-          split,
-          blockingFuture_,
-          maxPreloadedSplits_,
-          splitPreloader_);
-      if (blockingReason_ != BlockingReason::kNotBlocked) {
-        return nullptr;
+      if (connectorSplit == nullptr) {
+        curStatus_ = "getOutput: task->getSplitOrFuture";
+        blockingReason_ = driverCtx_->task->getSplitOrFuture(
+            driverCtx_->splitGroupId,
+            planNodeId(),
+            split,
+            blockingFuture_,
+            maxPreloadedSplits_,
+            splitPreloader_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          return nullptr;
+        }
+        if (!split.hasConnectorSplit()) {
+          connectorSplit = stealChunk();
+        }
       }
 
-      if (!split.hasConnectorSplit()) {
+      if (connectorSplit == nullptr && !split.hasConnectorSplit()) {
         noMoreSplits_ = true;
         dynamicFilters_.clear();
         if (dataSource_) {
@@ -149,10 +161,12 @@ RowVectorPtr TableScan::getOutput() {
         return nullptr;
       }
 
-      if (FOLLY_UNLIKELY(splitTracer_ != nullptr)) {
-        splitTracer_->write(split);
+      if (split.hasConnectorSplit()) {
+        if (FOLLY_UNLIKELY(splitTracer_ != nullptr)) {
+          splitTracer_->write(split);
+        }
+        connectorSplit = divideSplit(split.connectorSplit);
       }
-      const auto& connectorSplit = split.connectorSplit;
       currentSplitWeight_ = connectorSplit->splitWeight;
       needNewSplit_ = false;
 
@@ -217,8 +231,10 @@ RowVectorPtr TableScan::getOutput() {
             RuntimeCounter(
                 addSplitTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
       }
-      curStatus_ = "getOutput: updating stats_.numSplits";
-      ++stats_.wlock()->numSplits;
+      if (split.hasConnectorSplit()) {
+        curStatus_ = "getOutput: updating stats_.numSplits";
+        ++stats_.wlock()->numSplits;
+      }
 
       curStatus_ = "getOutput: dataSource_->estimatedRowSize";
       const auto estimatedRowSize = dataSource_->estimatedRowSize();
@@ -308,8 +324,7 @@ RowVectorPtr TableScan::getOutput() {
     const bool emptySplit = currNumRawInputRows == rawInputRowsSinceLastSplit_;
     rawInputRowsSinceLastSplit_ = currNumRawInputRows;
 
-    curStatus_ = "getOutput: task->splitFinished";
-    driverCtx_->task->splitFinished(true, currentSplitWeight_);
+    splitFinished();
     needNewSplit_ = true;
 
     // We only update scaled controller when we have finished a non-empty split.
@@ -324,6 +339,54 @@ RowVectorPtr TableScan::getOutput() {
   }
 }
 
+std::shared_ptr<connector::ConnectorSplit> TableScan::nextChunk() {
+  if (dividedSplit_ == nullptr) {
+    return nullptr;
+  }
+  curStatus_ = "getOutput: dividedSplit_->nextChunk";
+  auto chunk = dividedSplit_->nextChunk();
+  if (chunk == nullptr) {
+    dividedSplit_ = nullptr;
+  }
+  return chunk;
+}
+
+std::shared_ptr<connector::ConnectorSplit> TableScan::divideSplit(
+    const std::shared_ptr<connector::ConnectorSplit>& split) {
+  VELOX_CHECK_NULL(dividedSplit_);
+  // A preloaded split is read whole since its data source has been prepared
+  // for the whole split.
+  if (splitStealQueue_ == nullptr || split->dataSource != nullptr) {
+    return split;
+  }
+  curStatus_ = "getOutput: splitStealQueue_->divide";
+  auto chunk = splitStealQueue_->divide(split, dividedSplit_);
+  return chunk != nullptr ? chunk : split;
+}
+
+std::shared_ptr<connector::ConnectorSplit> TableScan::stealChunk() {
+  VELOX_CHECK_NULL(dividedSplit_);
+  if (splitStealQueue_ == nullptr) {
+    return nullptr;
+  }
+  curStatus_ = "getOutput: splitStealQueue_->steal";
+  auto chunk = splitStealQueue_->steal(dividedSplit_);
+  if (chunk != nullptr) {
+    stats_.wlock()->addRuntimeStat(kNumStolenSplitChunks, RuntimeCounter(1));
+  }
+  return chunk;
+}
+
+void TableScan::splitFinished() {
+  // The split is finished when the last of its chunks is read, by this or by
+  // another driver.
+  if (dividedSplit_ != nullptr && !dividedSplit_->chunkFinished()) {
+    return;
+  }
+  curStatus_ = "getOutput: task->splitFinished";
+  driverCtx_->task->splitFinished(true, currentSplitWeight_);
+}
+
 bool TableScan::shouldWaitForScaleUp() {
   if (scaledController_ == nullptr) {
     return false;
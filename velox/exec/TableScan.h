@@ -18,6 +18,7 @@
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ScaledScanController.h"
+#include "velox/exec/SplitStealQueue.h"
 
 namespace facebook::velox::exec {
 
@@ -60,6 +61,10 @@ class TableScan : public SourceOperator {
   /// all the splits have been dispatched.
   static inline const std::string kNumRunningScaleThreads{
       "numRunningScaleThreads"};
+  /// The number of split chunks read that were stolen from the splits of other
+  /// drivers.
+  static inline const std::string kNumStolenSplitChunks{
+      "numStolenSplitChunks"};
 
   std::shared_ptr<ScaledScanController> testingScaledController() const {
     return scaledController_;
@@ -85,6 +90,22 @@ class TableScan : public SourceOperator {
   // done, it will be made when needed.
   void preload(const std::shared_ptr<connector::ConnectorSplit>& split);
 
+  // Returns the next chunk of 'dividedSplit_' or nullptr if its chunks are all
+  // claimed.
+  std::shared_ptr<connector::ConnectorSplit> nextChunk();
+
+  // Returns the first chunk of 'split' if 'split' is divided into chunks and
+  // 'split' otherwise.
+  std::shared_ptr<connector::ConnectorSplit> divideSplit(
+      const std::shared_ptr<connector::ConnectorSplit>& split);
+
+  // Returns a chunk of a split of another driver or nullptr if there is none.
+  std::shared_ptr<connector::ConnectorSplit> stealChunk();
+
+  // Invoked after the current split or chunk has been read. Reports the split
+  // as finished to the task unless other chunks of it are still being read.
+  void splitFinished();
+
   // Invoked by scan operator to check if it needs to stop to wait for scale up.
   bool shouldWaitForScaleUp();
 
@@ -110,6 +131,13 @@ class TableScan : public SourceOperator {
   // operators instantiated from the same table scan node.
   const std::shared_ptr<ScaledScanController> scaledController_;
 
+  // If set, splits are divided into chunks that the scan operators of the same
+  // table scan node read one at a time and steal from each other.
+  const std::shared_ptr<SplitStealQueue> splitStealQueue_;
+
+  // The divided split of the chunk being read, if any.
+  std::shared_ptr<SplitStealQueue::DividedSplit> dividedSplit_;
+
   vector_size_t readBatchSize_;
 
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
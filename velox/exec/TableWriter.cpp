@@ -175,6 +175,10 @@ BlockingReason TableWriter::isBlocked(ContinueFuture* future) {
     *future = std::move(blockingFuture_);
     return blockingReason_;
   }
+  if (!noMoreInput_ && !closed_ && dataSink_ != nullptr &&
+      dataSink_->isBlocked(future)) {
+    return BlockingReason::kWaitForConnector;
+  }
   return BlockingReason::kNotBlocked;
 }
 
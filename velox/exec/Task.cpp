@@ -1140,6 +1140,11 @@ void Task::createSplitGroupStateLocked(uint32_t splitGroupId) {
       addScaledScanControllerLocked(
           splitGroupId, tableScanNodeId, factory->numDrivers);
     }
+    if (queryCtx_->queryConfig().tableScanSplitChunkBytes() > 0 &&
+        factory->needsTableScan(tableScanNodeId)) {
+      VELOX_CHECK(!tableScanNodeId.empty());
+      addSplitStealQueueLocked(splitGroupId, tableScanNodeId);
+    }
   }
 }
 
@@ -1681,6 +1686,30 @@ void Task::addScaledScanControllerLocked(
           queryCtx_->queryConfig().tableScanScaleUpMemoryUsageRatio()));
 }
 
+std::shared_ptr<SplitStealQueue> Task::getSplitStealQueueLocked(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  auto it = splitGroupState.splitStealQueues.find(planNodeId);
+  if (it == splitGroupState.splitStealQueues.end()) {
+    return nullptr;
+  }
+  VELOX_CHECK_NOT_NULL(it->second);
+  return it->second;
+}
+
+void Task::addSplitStealQueueLocked(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  const auto chunkBytes = queryCtx_->queryConfig().tableScanSplitChunkBytes();
+  VELOX_CHECK_GT(chunkBytes, 0);
+
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  VELOX_CHECK_EQ(splitGroupState.splitStealQueues.count(planNodeId), 0);
+  splitGroupState.splitStealQueues.emplace(
+      planNodeId, std::make_shared<SplitStealQueue>(chunkBytes));
+}
+
 void Task::splitFinished(bool fromTableScan, int64_t splitWeight) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   ++taskStats_.numFinishedSplits;
@@ -121,6 +121,10 @@ struct SplitGroupState {
   std::unordered_map<core::PlanNodeId, std::shared_ptr<ScaledScanController>>
       scaledScanControllers;
 
+  /// Map of split steal queues keyed on TableScan plan node ID.
+  std::unordered_map<core::PlanNodeId, std::shared_ptr<SplitStealQueue>>
+      splitStealQueues;
+
   /// Drivers created and still running for this split group.
   /// The split group is finished when this numbers reaches zero.
   uint32_t numRunningDrivers{0};
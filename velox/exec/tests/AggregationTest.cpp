@@ -27,6 +27,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashAggregation.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/PrefixSort.h"
 #include "velox/exec/Values.h"
@@ -1220,6 +1221,88 @@ TEST_F(AggregationTest, spillAll) {
   }
 }
 
+TEST_F(AggregationTest, accumulatorCompaction) {
+  auto inputs = makeVectors(rowType_, 100, 10);
+
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation({"c0"}, {"array_agg(c1)", "sum(c2)"})
+                  .planNode();
+
+  auto results = AssertQueryBuilder(plan).copyResults(pool_.get());
+
+  // Accumulators in a separate allocator give the same results with and
+  // without spilling.
+  AssertQueryBuilder(plan)
+      .config(QueryConfig::kAggregationCompactionFragmentationRatio, "0.1")
+      .assertResults(results);
+
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan)
+          .spillDirectory(tempDirectory->getPath())
+          .config(QueryConfig::kSpillEnabled, true)
+          .config(QueryConfig::kAggregationSpillEnabled, true)
+          .config(QueryConfig::kAggregationCompactionFragmentationRatio, "0.1")
+          .assertResults(results);
+  auto stats = task->taskStats().pipelineStats;
+  ASSERT_LT(
+      0, stats[0].operatorStats[1].runtimeStats[Operator::kSpillRuns].count);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
+DEBUG_ONLY_TEST_F(AggregationTest, compactFragmentedAccumulators) {
+  // Each batch appends a few strings to the array of every group. The
+  // unused tails of the blocks the arrays grow into are left free.
+  constexpr int32_t kNumBatches = 20;
+  constexpr int32_t kBatchSize = 1'000;
+  const std::string chars(60, 'x');
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(kBatchSize, [](auto row) { return row % 100; }),
+        makeFlatVector<StringView>(
+            kBatchSize,
+            [&](auto row) {
+              return StringView(chars.data(), 10 + (i * kBatchSize + row) % 50);
+            }),
+    }));
+  }
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation({"c0"}, {"array_agg(c1)"})
+                  .planNode();
+  auto results = AssertQueryBuilder(plan).copyResults(pool_.get());
+
+  std::atomic_int32_t numInputs{0};
+  std::atomic_uint64_t compactedBytes{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::GroupingSet::addInputForActiveRows",
+      std::function<void(GroupingSet*)>(([&](GroupingSet* groupingSet) {
+        if (++numInputs == kNumBatches) {
+          compactedBytes =
+              groupingSet->compactAccumulators(/*withinReservation=*/false);
+        }
+      })));
+
+  auto task =
+      AssertQueryBuilder(plan)
+          .config(QueryConfig::kAggregationCompactionFragmentationRatio, "0.01")
+          .config(QueryConfig::kAggregationCompactionMinBytes, "0")
+          .maxDrivers(1)
+          .assertResults(results);
+  ASSERT_GT(compactedBytes, 0);
+  auto stats = task->taskStats().pipelineStats;
+  ASSERT_GE(
+      stats[0]
+          .operatorStats[1]
+          .runtimeStats[HashAggregation::kCompactedAccumulatorBytes]
+          .sum,
+      compactedBytes);
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
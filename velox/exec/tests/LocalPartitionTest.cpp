@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/Numa.h"
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -672,6 +674,87 @@ TEST_F(LocalPartitionTest, unionAllLocalExchange) {
   }
 }
 
+TEST_F(LocalPartitionTest, numaLocalRoundRobin) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(
+        makeRowVector({makeFlatSequence<int32_t>(i * 100, 100)}));
+  }
+  createDuckDbTable(vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localPartitionRoundRobin(
+                      {PlanBuilder(planNodeIdGenerator)
+                           .values(vectors)
+                           .planNode()})
+                  .project({"c0 + 1"})
+                  .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(4)
+      .config(core::QueryConfig::kNumaLocalExchangeEnabled, "true")
+      .config(
+          core::QueryConfig::kDriverNumaNode,
+          std::to_string(process::currentNumaNode()))
+      .assertResults("SELECT c0 + 1 FROM tmp");
+}
+
+TEST_F(LocalPartitionTest, numaLocalPartition) {
+  constexpr int64_t kMaxQueueBytes = 100;
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(1 << 20);
+  auto vectorPool = std::make_shared<LocalExchangeVectorPool>(0);
+  std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
+  for (auto i = 0; i < 4; ++i) {
+    queues.push_back(
+        std::make_shared<LocalExchangeQueue>(memoryManager, vectorPool, i));
+    queues.back()->addProducer();
+    // The consumers of the odd queues run on node 0, the others on node 1.
+    queues.back()->setConsumerNumaNode(i % 2 == 0 ? 1 : 0);
+  }
+  const auto partition = [&](uint32_t start, int32_t node) {
+    return LocalPartition::numaLocalPartition(
+        queues, start, node, kMaxQueueBytes);
+  };
+
+  // Batches go to the next queue whose consumer runs on the producer's node.
+  EXPECT_EQ(partition(0, 0), 1);
+  EXPECT_EQ(partition(2, 0), 3);
+  EXPECT_EQ(partition(3, 0), 3);
+  EXPECT_EQ(partition(1, 1), 2);
+  // Without a consumer on the producer's node, batches are round robin.
+  EXPECT_EQ(partition(2, 2), 2);
+
+  // A queue on the producer's node that buffers its share is skipped.
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  ContinueFuture future;
+  ASSERT_EQ(
+      queues[1]->enqueue(data, kMaxQueueBytes, &future),
+      BlockingReason::kNotBlocked);
+  EXPECT_EQ(queues[1]->bufferedBytes(), kMaxQueueBytes);
+  EXPECT_EQ(partition(0, 0), 3);
+
+  // With all queues on the producer's node full, batches are round robin.
+  ASSERT_EQ(
+      queues[3]->enqueue(data, kMaxQueueBytes, &future),
+      BlockingReason::kNotBlocked);
+  EXPECT_EQ(partition(0, 0), 0);
+  EXPECT_EQ(partition(2, 0), 2);
+
+  // A queue is preferred again once its consumer catches up.
+  RowVectorPtr output;
+  ASSERT_EQ(
+      queues[1]->next(&future, pool(), &output), BlockingReason::kNotBlocked);
+  ASSERT_NE(output, nullptr);
+  EXPECT_EQ(queues[1]->bufferedBytes(), 0);
+  EXPECT_EQ(partition(0, 0), 1);
+
+  for (auto& queue : queues) {
+    queue->close();
+    EXPECT_EQ(queue->bufferedBytes(), 0);
+  }
+}
+
 namespace {
 using BlockingCallback = std::function<BlockingReason(ContinueFuture*)>;
 using FinishCallback = std::function<void(bool)>;
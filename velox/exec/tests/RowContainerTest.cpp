@@ -2316,6 +2316,46 @@ TEST_F(RowContainerTest, columnHasNulls) {
   }
 }
 
+TEST_F(RowContainerTest, separateAccumulatorAllocator) {
+  auto rowContainer = makeRowContainer({BIGINT()}, {VARCHAR()}, false);
+  ASSERT_FALSE(rowContainer->hasSeparateAccumulatorAllocator());
+  ASSERT_EQ(
+      &rowContainer->accumulatorAllocator(), &rowContainer->stringAllocator());
+
+  rowContainer->setSeparateAccumulatorAllocator();
+  ASSERT_TRUE(rowContainer->hasSeparateAccumulatorAllocator());
+  auto& accumulatorAllocator = rowContainer->accumulatorAllocator();
+  ASSERT_NE(&accumulatorAllocator, &rowContainer->stringAllocator());
+
+  accumulatorAllocator.allocate(1'000);
+  rowContainer->stringAllocator().allocate(1'000);
+  ASSERT_GT(accumulatorAllocator.retainedSize(), 0);
+  ASSERT_EQ(
+      rowContainer->variableLengthRetainedBytes(),
+      rowContainer->stringAllocator().retainedSize() +
+          accumulatorAllocator.retainedSize());
+  ASSERT_EQ(
+      rowContainer->freeSpace().second,
+      rowContainer->stringAllocator().freeSpace() +
+          accumulatorAllocator.freeSpace());
+
+  // Both allocators are frozen while spilling.
+  rowContainer->freezeAllocatorsAndExecute([&]() {
+    VELOX_ASSERT_THROW(
+        accumulatorAllocator.allocate(1'000),
+        "The HashStringAllocator is immutable.");
+    VELOX_ASSERT_THROW(
+        rowContainer->stringAllocator().allocate(1'000),
+        "The HashStringAllocator is immutable.");
+  });
+
+  rowContainer->newRow();
+  VELOX_ASSERT_THROW(rowContainer->setSeparateAccumulatorAllocator(), "");
+
+  rowContainer->clear();
+  ASSERT_EQ(accumulatorAllocator.retainedSize(), 0);
+}
+
 TEST_F(RowContainerTest, store) {
   const uint64_t kNumRows = 1000;
   auto rowVectorWithNulls = makeRowVector({
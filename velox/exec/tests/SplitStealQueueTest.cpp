@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SplitStealQueue.h"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using facebook::velox::connector::hive::HiveConnectorSplit;
+
+namespace {
+
+std::shared_ptr<HiveConnectorSplit> makeSplit(
+    uint64_t start,
+    uint64_t length,
+    dwio::common::FileFormat format = dwio::common::FileFormat::DWRF) {
+  return std::make_shared<HiveConnectorSplit>(
+      "test", "/tmp/file", format, start, length);
+}
+
+const HiveConnectorSplit& asHive(
+    const std::shared_ptr<connector::ConnectorSplit>& split) {
+  return *std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+}
+
+TEST(SplitStealQueueTest, divide) {
+  SplitStealQueue queue(100);
+  std::shared_ptr<SplitStealQueue::DividedSplit> dividedSplit;
+
+  // Splits that fit in one chunk or cannot be divided are read whole.
+  EXPECT_EQ(queue.divide(makeSplit(0, 100), dividedSplit), nullptr);
+  EXPECT_EQ(dividedSplit, nullptr);
+  EXPECT_EQ(
+      queue.divide(
+          makeSplit(0, 1'000, dwio::common::FileFormat::TEXT), dividedSplit),
+      nullptr);
+  EXPECT_EQ(
+      queue.divide(
+          makeSplit(0, std::numeric_limits<uint64_t>::max()), dividedSplit),
+      nullptr);
+  EXPECT_EQ(queue.numSplits(), 0);
+
+  auto chunk = queue.divide(makeSplit(1'000, 250), dividedSplit);
+  ASSERT_NE(dividedSplit, nullptr);
+  EXPECT_EQ(dividedSplit->numChunks(), 3);
+  EXPECT_EQ(dividedSplit->numUnclaimedChunks(), 2);
+  EXPECT_EQ(asHive(chunk).start, 1'000);
+  EXPECT_EQ(asHive(chunk).length, 100);
+  chunk = dividedSplit->nextChunk();
+  EXPECT_EQ(asHive(chunk).start, 1'100);
+  EXPECT_EQ(asHive(chunk).length, 100);
+  chunk = dividedSplit->nextChunk();
+  EXPECT_EQ(asHive(chunk).start, 1'200);
+  EXPECT_EQ(asHive(chunk).length, 50);
+  EXPECT_EQ(dividedSplit->nextChunk(), nullptr);
+
+  EXPECT_FALSE(dividedSplit->chunkFinished());
+  EXPECT_FALSE(dividedSplit->chunkFinished());
+  EXPECT_TRUE(dividedSplit->chunkFinished());
+}
+
+TEST(SplitStealQueueTest, steal) {
+  SplitStealQueue queue(100);
+  std::shared_ptr<SplitStealQueue::DividedSplit> owned1;
+  std::shared_ptr<SplitStealQueue::DividedSplit> owned2;
+  std::shared_ptr<SplitStealQueue::DividedSplit> stolen;
+  EXPECT_EQ(queue.steal(stolen), nullptr);
+
+  queue.divide(makeSplit(0, 300), owned1);
+  queue.divide(makeSplit(0, 500), owned2);
+  EXPECT_EQ(queue.numSplits(), 2);
+
+  // Steals from the split with the most unclaimed chunks.
+  auto chunk = queue.steal(stolen);
+  EXPECT_EQ(stolen, owned2);
+  EXPECT_EQ(asHive(chunk).start, 100);
+  chunk = queue.steal(stolen);
+  EXPECT_EQ(stolen, owned2);
+  EXPECT_EQ(asHive(chunk).start, 200);
+  chunk = queue.steal(stolen);
+  EXPECT_EQ(asHive(chunk).start, 100);
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_NE(queue.steal(stolen), nullptr);
+  }
+  EXPECT_EQ(queue.steal(stolen), nullptr);
+  EXPECT_EQ(stolen, nullptr);
+  EXPECT_EQ(owned1->nextChunk(), nullptr);
+  EXPECT_EQ(owned2->nextChunk(), nullptr);
+  EXPECT_EQ(queue.numSplits(), 0);
+}
+
+TEST(SplitStealQueueTest, maxChunks) {
+  SplitStealQueue queue(1);
+  std::shared_ptr<SplitStealQueue::DividedSplit> dividedSplit;
+  const uint64_t size = 10 * SplitStealQueue::DividedSplit::kMaxChunks;
+  queue.divide(makeSplit(0, size), dividedSplit);
+  EXPECT_EQ(
+      dividedSplit->numChunks(), SplitStealQueue::DividedSplit::kMaxChunks);
+}
+
+TEST(SplitStealQueueTest, concurrent) {
+  constexpr int32_t kNumSplits = 20;
+  constexpr int32_t kNumThreads = 8;
+  SplitStealQueue queue(10);
+  std::atomic_int32_t nextSplit{0};
+  std::atomic_uint64_t numBytes{0};
+  std::atomic_int32_t numFinishedSplits{0};
+
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      std::shared_ptr<SplitStealQueue::DividedSplit> dividedSplit;
+      for (;;) {
+        std::shared_ptr<connector::ConnectorSplit> chunk;
+        if (dividedSplit != nullptr) {
+          chunk = dividedSplit->nextChunk();
+        }
+        if (chunk == nullptr) {
+          const auto split = nextSplit++;
+          if (split < kNumSplits) {
+            chunk = queue.divide(makeSplit(0, 1'000 + split), dividedSplit);
+          } else {
+            chunk = queue.steal(dividedSplit);
+          }
+        }
+        if (chunk == nullptr) {
+          return;
+        }
+        numBytes += asHive(chunk).length;
+        if (dividedSplit->chunkFinished()) {
+          ++numFinishedSplits;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(numFinishedSplits.load(), kNumSplits);
+  EXPECT_EQ(
+      numBytes.load(), kNumSplits * 1'000 + kNumSplits * (kNumSplits - 1) / 2);
+}
+
+} // namespace
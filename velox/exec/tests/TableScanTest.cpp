@@ -17,6 +17,7 @@
 #include <shared_mutex>
 
 #include <fmt/ranges.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/experimental/EventCount.h>
 #include <folly/synchronization/Baton.h>
 #include <folly/synchronization/Latch.h>
@@ -1412,6 +1413,119 @@ TEST_F(TableScanTest, count) {
   EXPECT_EQ(numRead, 10'000);
 }
 
+TEST_F(TableScanTest, splitAggregationPushdown) {
+  using AggregateKind = HiveColumnHandle::AggregateKind;
+  auto data = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(
+           1'000, [](auto row) { return row - 500; }, nullEvery(7)),
+       makeFlatVector<std::string>(
+           1'000, [](auto row) { return fmt::format("s{}", row % 100); })});
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {data});
+
+  auto aggregate = [](const std::string& name,
+                      AggregateKind kind,
+                      const TypePtr& inputType,
+                      const TypePtr& resultType) {
+    return std::make_shared<HiveColumnHandle>(
+        name,
+        HiveColumnHandle::ColumnType::kAggregate,
+        resultType,
+        inputType,
+        std::vector<common::Subfield>{},
+        HiveColumnHandle::ColumnParseParameters{},
+        kind);
+  };
+  auto outputType = ROW(
+      {"count", "count_c0", "min_c0", "max_c0", "null_count_c0"},
+      {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  ColumnHandleMap assignments = {
+      {"count", aggregate("", AggregateKind::kCount, BIGINT(), BIGINT())},
+      {"count_c0", aggregate("c0", AggregateKind::kCount, BIGINT(), BIGINT())},
+      {"min_c0", aggregate("c0", AggregateKind::kMin, BIGINT(), BIGINT())},
+      {"max_c0", aggregate("c0", AggregateKind::kMax, BIGINT(), BIGINT())},
+      {"null_count_c0",
+       aggregate("c0", AggregateKind::kNullCount, BIGINT(), BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())},
+  };
+  auto dataColumns = ROW({"c0", "c1", "ds"}, {BIGINT(), VARCHAR(), VARCHAR()});
+  auto makeSplit = [&] {
+    return HiveConnectorSplitBuilder(filePath->getPath())
+        .partitionKey("ds", "2024-01-01")
+        .build();
+  };
+  auto numSplitsFromStats = [](const std::shared_ptr<Task>& task) {
+    auto stats = getTableScanRuntimeStats(task);
+    auto it = stats.find("numSplitsAggregatedFromStats");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  // The filter on the partition key passes for all rows of the split, so the
+  // aggregates are answered from the file statistics.
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(outputType)
+                  .dataColumns(dataColumns)
+                  .subfieldFilter("ds = '2024-01-01'")
+                  .assignments(assignments)
+                  .endTableScan()
+                  .planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .split(makeSplit())
+                  .split(makeSplit())
+                  .assertResults(makeRowVector(
+                      outputType->names(),
+                      {makeFlatVector<int64_t>({1'000, 1'000}),
+                       makeFlatVector<int64_t>({857, 857}),
+                       makeFlatVector<int64_t>({-499, -499}),
+                       makeFlatVector<int64_t>({499, 499}),
+                       makeFlatVector<int64_t>({143, 143})}));
+  EXPECT_EQ(numSplitsFromStats(task), 2);
+
+  // The filter on the data column excludes some rows, so the aggregates are
+  // computed from the decoded rows.
+  plan = PlanBuilder()
+             .startTableScan()
+             .outputType(outputType)
+             .dataColumns(dataColumns)
+             .subfieldFilter("c0 >= 0")
+             .assignments(assignments)
+             .endTableScan()
+             .planNode();
+  task = AssertQueryBuilder(plan)
+             .split(makeSplit())
+             .assertResults(makeRowVector(
+                 outputType->names(),
+                 {makeFlatVector<int64_t>({429}),
+                  makeFlatVector<int64_t>({429}),
+                  makeFlatVector<int64_t>({0}),
+                  makeFlatVector<int64_t>({499}),
+                  makeFlatVector<int64_t>({0})}));
+  EXPECT_EQ(numSplitsFromStats(task), 0);
+
+  // Statistics are not used for min and max of strings.
+  outputType = ROW({"min_c1", "max_c1"}, {VARCHAR(), VARCHAR()});
+  plan = PlanBuilder()
+             .startTableScan()
+             .outputType(outputType)
+             .assignments(
+                 {{"min_c1",
+                   aggregate("c1", AggregateKind::kMin, VARCHAR(), VARCHAR())},
+                  {"max_c1",
+                   aggregate(
+                       "c1", AggregateKind::kMax, VARCHAR(), VARCHAR())}})
+             .endTableScan()
+             .planNode();
+  task = AssertQueryBuilder(plan)
+             .split(makeSplit())
+             .assertResults(makeRowVector(
+                 outputType->names(),
+                 {makeFlatVector<std::string>({"s0"}),
+                  makeFlatVector<std::string>({"s99"})}));
+  EXPECT_EQ(numSplitsFromStats(task), 0);
+}
+
 TEST_F(TableScanTest, batchSize) {
   // Make a wide row of many BIGINT columns to ensure that row size is
   // larger than 1KB.
@@ -2698,6 +2812,49 @@ TEST_F(TableScanTest, statsBasedAndRegularSkippingComplexTypes) {
       "SELECT * FROM tmp WHERE c0 <= 10 OR c0 between 600 AND 650 OR c0 >= 21234");
 }
 
+TEST_F(TableScanTest, parallelDecoding) {
+  auto rowType = ROW(
+      {"c0", "c1", "c2", "c3", "c4"},
+      {BIGINT(), VARCHAR(), DOUBLE(), ARRAY(INTEGER()), BIGINT()});
+  auto filePaths = makeFilePaths(2);
+  auto vectors = makeVectors(2, 5'000, rowType);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // Decoding runs on the CPU executor of the connector, apart from its IO
+  // executor.
+  auto decodeExecutor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  const auto config = std::make_shared<config::ConfigBase>(
+      std::unordered_map<std::string, std::string>());
+  connector::unregisterConnector(kHiveConnectorId);
+  connector::registerConnector(
+      connector::getConnectorFactory(
+          connector::hive::HiveConnectorFactory::kHiveConnectorName)
+          ->newConnector(
+              kHiveConnectorId,
+              config,
+              ioExecutor_.get(),
+              decodeExecutor.get()));
+
+  // The filter on c0 is evaluated by the reader before the other columns are
+  // decoded.
+  auto plan =
+      PlanBuilder(pool_.get()).tableScan(rowType, {"c0 >= 0"}).planNode();
+  for (const auto* parallelism : {"0", "4"}) {
+    SCOPED_TRACE(fmt::format("parallelism {}", parallelism));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .connectorSessionProperty(
+            kHiveConnectorId,
+            connector::hive::HiveConfig::kDecodingParallelismSession,
+            parallelism)
+        .splits(makeHiveConnectorSplits(filePaths))
+        .assertResults("SELECT * FROM tmp WHERE c0 >= 0");
+  }
+  resetHiveConnector(config);
+}
+
 TEST_F(TableScanTest, filterPushdown) {
   auto rowType =
       ROW({"c0", "c1", "c2", "c3"}, {TINYINT(), BIGINT(), DOUBLE(), BOOLEAN()});
@@ -5482,6 +5639,83 @@ TEST_F(TableScanTest, footerIOCount) {
   ASSERT_GT(stats.at("footerBufferOverread").sum, 0);
 }
 
+TEST_F(TableScanTest, splitChunks) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  // Writes one stripe per vector.
+  writeToFile(
+      filePath->getPath(),
+      vectors,
+      std::make_shared<dwrf::Config>(),
+      []() { return std::make_unique<dwrf::RowThresholdFlushPolicy>(1'000); });
+  createDuckDbTable(vectors);
+  const uint64_t fileSize = fs::file_size(filePath->getPath());
+
+  auto plan = PlanBuilder().tableScan(rowType_).planNode();
+  for (const auto maxDrivers : {1, 4}) {
+    SCOPED_TRACE(fmt::format("maxDrivers {}", maxDrivers));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kTableScanSplitChunkBytes, fileSize / 8)
+            .maxDrivers(maxDrivers)
+            .split(makeHiveConnectorSplit(filePath->getPath(), 0, fileSize))
+            .assertResults("SELECT * FROM tmp");
+    // The chunks of the split are read by one or more drivers, but the split
+    // is counted once.
+    EXPECT_EQ(getTableScanStats(task).numSplits, 1);
+    EXPECT_EQ(task->taskStats().numFinishedSplits, 1);
+    if (maxDrivers == 1) {
+      EXPECT_EQ(
+          getTableScanRuntimeStats(task).count(
+              TableScan::kNumStolenSplitChunks),
+          0);
+    }
+  }
+}
+
+TEST_F(TableScanTest, combinedSplit) {
+  auto vectors = makeVectors(6, 100);
+  auto filePaths = makeFilePaths(vectors.size());
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto makeCombinedSplit = [&](int32_t begin, int32_t end) {
+    std::vector<std::shared_ptr<connector::hive::HiveConnectorSplit>> splits;
+    for (auto i = begin; i < end; ++i) {
+      splits.push_back(makeHiveConnectorSplit(filePaths[i]->getPath()));
+    }
+    return std::make_shared<connector::hive::HiveCombinedSplit>(
+        kHiveConnectorId, std::move(splits));
+  };
+
+  auto plan = tableScanNode();
+  for (const auto prefetchFiles : {0, 2, 10}) {
+    SCOPED_TRACE(fmt::format("prefetchFiles {}", prefetchFiles));
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits = {
+        makeCombinedSplit(0, 4), makeCombinedSplit(4, 6)};
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .connectorSessionProperty(
+                kHiveConnectorId,
+                connector::hive::HiveConfig::kCombinedSplitPrefetchFilesSession,
+                std::to_string(prefetchFiles))
+            .splits(splits)
+            .assertResults("SELECT * FROM tmp");
+    EXPECT_EQ(getTableScanStats(task).numSplits, 2);
+    EXPECT_EQ(
+        getTableScanRuntimeStats(task).at("numCombinedSplitFiles").sum, 6);
+  }
+
+  // Filters apply to each file.
+  auto task = assertQuery(
+      PlanBuilder().tableScan(rowType_, {}, "c0 % 3 = 0").planNode(),
+      makeCombinedSplit(0, 6),
+      "SELECT * FROM tmp WHERE c0 % 3 = 0");
+  EXPECT_EQ(getTableScanStats(task).numSplits, 1);
+}
+
 TEST_F(TableScanTest, statsBasedFilterReorderDisabled) {
   gflags::FlagSaver gflagSaver;
   // Disable prefetch to avoid test flakiness.
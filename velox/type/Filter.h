@@ -1966,6 +1966,16 @@ class BytesValues final : public Filter {
     return values_;
   }
 
+  /// The smallest of 'values()'.
+  const std::string& lower() const {
+    return lower_;
+  }
+
+  /// The largest of 'values()'.
+  const std::string& upper() const {
+    return upper_;
+  }
+
   bool testingEquals(const Filter& other) const final;
 
  private: